@@ -77,6 +77,8 @@ AC_CHECK_FUNCS([malloc_trim])
 AC_CHECK_FUNCS([memalign])
 AC_CHECK_FUNCS([posix_memalign])
 AC_CHECK_FUNCS([mremap])
+AC_CHECK_FUNCS([memfd_create])
+AC_CHECK_FUNCS([process_vm_readv])
 AC_CHECK_FUNCS([sched_setaffinity sched_getaffinity])
 AC_CHECK_FUNCS([cpuset_setaffinity cpuset_getaffinity])
 
@@ -193,6 +195,38 @@ AC_CHECK_HEADERS([sys/capability.h],
 AC_CHECK_DECLS([PR_SET_PTRACER], [], [], [#include <sys/prctl.h>])
 
 
+#
+# Check for pidfd_open() and pidfd_getfd() system calls
+#
+AC_CHECK_DECLS([SYS_pidfd_open, SYS_pidfd_getfd], [], [],
+               [#include <sys/syscall.h>])
+
+
+#
+# io_uring support for event sets. The ring is driven through raw system calls,
+# so only the kernel headers are required. Multi-shot poll requests need kernel
+# headers not older than 5.13, which is when IORING_FEAT_RSRC_TAGS was added.
+#
+AC_CHECK_DECLS([__NR_io_uring_setup, IORING_FEAT_RSRC_TAGS], [], [],
+               [#include <sys/syscall.h>
+                #include <linux/io_uring.h>])
+AS_IF([test "x$ac_cv_have_decl___NR_io_uring_setup" = xyes -a \
+            "x$ac_cv_have_decl_IORING_FEAT_RSRC_TAGS" = xyes],
+      [AC_DEFINE([HAVE_IO_URING], 1, [Define to 1 to enable io_uring support])])
+
+
+#
+# MSG_ZEROCOPY socket send support
+#
+AC_CHECK_DECLS([SO_ZEROCOPY, MSG_ZEROCOPY, SO_EE_ORIGIN_ZEROCOPY], [], [],
+               [#include <sys/socket.h>
+                #include <linux/errqueue.h>])
+AS_IF([test "x$ac_cv_have_decl_SO_ZEROCOPY" = xyes -a \
+            "x$ac_cv_have_decl_MSG_ZEROCOPY" = xyes -a \
+            "x$ac_cv_have_decl_SO_EE_ORIGIN_ZEROCOPY" = xyes],
+      [AC_DEFINE([HAVE_MSG_ZEROCOPY], 1, [Define to 1 to enable MSG_ZEROCOPY support])])
+
+
 #
 # ipv6 s6_addr32/__u6_addr32 shortcuts for in6_addr
 # ip header structure layout name
@@ -635,6 +635,12 @@ run_ucx_perftest() {
 	ucp_test_args="-b $ucx_inst_ptest/test_types_short_ucp \
 				-b $ucx_inst_ptest/msg_pow2_short -w 1"
 
+	# tag matching and stream tests on multi-threaded workers
+	grep -E "_(tag|stream)_" $ucx_inst_ptest/test_types_short_ucp > \
+		$ucx_inst_ptest/test_types_short_ucp_mt
+	ucp_mt_test_args="-b $ucx_inst_ptest/test_types_short_ucp_mt \
+				-b $ucx_inst_ptest/msg_pow2_short -w 1 -T 4 -M multi"
+
 	# IP ifaces
 	ip_ifaces=$(get_active_ip_ifaces)
 
@@ -674,6 +680,16 @@ run_ucx_perftest() {
 
 			# Run UCP performance test with 2 threads
 			$MPIRUN -np 2 -x UCX_NET_DEVICES=$dev -x UCX_TLS=$tls $AFFINITY $ucx_perftest $ucp_test_args -T 2
+
+			if [ "$tls" == "tcp" ]
+			then
+				# Run UCT performance test on a multi-threaded worker
+				$MPIRUN -np 2 $AFFINITY $ucx_perftest $uct_test_args -d $ucx_dev $opt_transports -M multi
+
+				# Run UCP tag/stream performance test with 4 threads on
+				# multi-threaded workers
+				$MPIRUN -np 2 -x UCX_NET_DEVICES=$dev -x UCX_TLS=$tls $AFFINITY $ucx_perftest $ucp_mt_test_args
+			fi
 		else
 			export UCX_NET_DEVICES=$dev
 			export UCX_TLS=$tls
@@ -688,6 +704,19 @@ run_ucx_perftest() {
 			# Run UCP performance test with 2 threads
 			run_client_server_app "$ucx_perftest" "$ucp_test_args -T 2" "$(hostname)" 0 0
 
+			if [ "$tls" == "tcp" ]
+			then
+				# Run UCT performance test on a multi-threaded worker
+				run_client_server_app "$ucx_perftest" \
+					"$uct_test_args -d ${ucx_dev} ${opt_transports} -M multi" \
+					"$(hostname)" 0 0
+
+				# Run UCP tag/stream performance test with 4 threads on
+				# multi-threaded workers
+				run_client_server_app "$ucx_perftest" "$ucp_mt_test_args" \
+					"$(hostname)" 0 0
+			fi
+
 			unset UCX_NET_DEVICES
 			unset UCX_TLS
 		fi
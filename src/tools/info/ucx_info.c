@@ -40,6 +40,7 @@ static void usage() {
     printf("                    'r' : remote memory access\n");
     printf("                    't' : tag matching \n");
     printf("                    'm' : active messages \n");
+    printf("                    's' : stream \n");
     printf("                    'w' : wakeup\n");
     printf("                  Modifiers to use in combination with above features:\n");
     printf("                    'e' : error handling\n");
@@ -149,6 +150,9 @@ int main(int argc, char **argv)
                 case 'm':
                     ucp_features |= UCP_FEATURE_AM;
                     break;
+                case 's':
+                    ucp_features |= UCP_FEATURE_STREAM;
+                    break;
                 case 'e':
                     ucp_ep_params.field_mask |= UCP_EP_PARAM_FIELD_ERR_HANDLING_MODE;
                     ucp_ep_params.err_mode    = UCP_ERR_HANDLING_MODE_PEER;
@@ -52,6 +52,8 @@ typedef enum {
                                             ucp_worker_wait_mem() */
     UCX_PERF_TEST_TYPE_STREAM_UNI,       /* Unidirectional stream */
     UCX_PERF_TEST_TYPE_STREAM_BI,        /* Bidirectional stream */
+    UCX_PERF_TEST_TYPE_MIXED,            /* Ping-pong rounds alternating with
+                                            unidirectional bursts */
     UCX_PERF_TEST_TYPE_LAST
 } ucx_perf_test_type_t;
 
@@ -460,6 +460,93 @@ public:
         return UCS_OK;
     }
 
+    /* A phase of fc_window ping-pong rounds is followed by a burst of
+     * fc_window messages which is acknowledged only by its last message, so
+     * the load of the responder alternates between latency and throughput */
+    bool is_mixed_ack(ucx_perf_counter_t iter)
+    {
+        unsigned burst = m_perf.params.uct.fc_window;
+
+        return ((iter / burst) % 2 == 0) || ((iter % burst) == (burst - 1));
+    }
+
+    ucs_status_t run_mixed()
+    {
+        psn_t send_sn, *recv_sn, sn;
+        ucx_perf_counter_t iter;
+        unsigned my_index;
+        uct_ep_h ep;
+        uint64_t remote_addr;
+        uct_rkey_t rkey;
+        void *buffer;
+        size_t length;
+
+        if (CMD != UCX_PERF_CMD_AM) {
+            ucs_error("Cannot run this test in mixed mode");
+            return UCS_ERR_INVALID_PARAM;
+        }
+
+        length = ucx_perf_get_message_size(&m_perf.params);
+        ucs_assert(length >= sizeof(psn_t));
+
+        recv_sn = &m_last_recvd_sn;
+
+        uct_perf_test_prepare_iov_buffer();
+
+        sn = std::numeric_limits<uint8_t>::max();
+        set_recv_sn(recv_sn, m_perf.uct.recv_mem.mem_type, &sn);
+
+        uct_perf_barrier(&m_perf);
+
+        my_index = rte_call(&m_perf, group_index);
+
+        ucx_perf_test_start_clock(&m_perf);
+
+        buffer      = m_perf.send_buffer;
+        remote_addr = m_perf.uct.peers[1 - my_index].remote_addr;
+        rkey        = m_perf.uct.peers[1 - my_index].rkey.rkey;
+        ep          = m_perf.uct.peers[1 - my_index].ep;
+
+        send_sn = 0;
+        iter    = 0;
+        if (my_index == 0) {
+            UCX_PERF_TEST_FOREACH(&m_perf) {
+                send_b(ep, send_sn, send_sn - 1, buffer, length, remote_addr,
+                       rkey, NULL);
+                ucx_perf_update(&m_perf, 1, length);
+
+                if (is_mixed_ack(iter++)) {
+                    do {
+                        progress_responder();
+                        sn = get_recv_sn(recv_sn,
+                                         m_perf.uct.recv_mem.mem_type);
+                    } while (sn != send_sn);
+                }
+
+                ++send_sn;
+            }
+        } else if (my_index == 1) {
+            UCX_PERF_TEST_FOREACH(&m_perf) {
+                do {
+                    progress_responder();
+                    sn = get_recv_sn(recv_sn, m_perf.uct.recv_mem.mem_type);
+                } while (UCS_CIRCULAR_COMPARE8(sn, <, send_sn));
+
+                if (is_mixed_ack(iter++)) {
+                    send_b(ep, send_sn, send_sn - 1, buffer, length,
+                           remote_addr, rkey, NULL);
+                }
+
+                ucx_perf_update(&m_perf, 1, length);
+                ++send_sn;
+            }
+        }
+
+        flush(1 - my_index);
+        ucx_perf_get_time(&m_perf);
+        return UCS_OK;
+    }
+
     ucs_status_t run_stream_req_uni(bool flow_control, bool send_window,
                                     bool direction_to_responder)
     {
@@ -661,6 +748,8 @@ public:
             default:
                 return UCS_ERR_INVALID_PARAM;
             }
+        case UCX_PERF_TEST_TYPE_MIXED:
+            return run_mixed();
         case UCX_PERF_TEST_TYPE_STREAM_BI:
         default:
             return UCS_ERR_INVALID_PARAM;
@@ -707,6 +796,7 @@ ucs_status_t uct_perf_test_dispatch(ucx_perf_context_t *perf)
         (UCX_PERF_CMD_PUT, UCX_PERF_TEST_TYPE_PINGPONG),
         (UCX_PERF_CMD_ADD, UCX_PERF_TEST_TYPE_PINGPONG),
         (UCX_PERF_CMD_AM,  UCX_PERF_TEST_TYPE_STREAM_UNI),
+        (UCX_PERF_CMD_AM,  UCX_PERF_TEST_TYPE_MIXED),
         (UCX_PERF_CMD_PUT, UCX_PERF_TEST_TYPE_STREAM_UNI),
         (UCX_PERF_CMD_GET, UCX_PERF_TEST_TYPE_STREAM_UNI),
         (UCX_PERF_CMD_ADD, UCX_PERF_TEST_TYPE_STREAM_UNI),
@@ -117,6 +117,10 @@ test_type_t tests[] = {
     {"am_bw", UCX_PERF_API_UCT, UCX_PERF_CMD_AM, UCX_PERF_TEST_TYPE_STREAM_UNI,
      "active message bandwidth / message rate", "overhead", 1},
 
+    {"am_mixed", UCX_PERF_API_UCT, UCX_PERF_CMD_AM, UCX_PERF_TEST_TYPE_MIXED,
+     "active message latency / rate with alternating ping-pong and bursts",
+     "latency", 1},
+
     {"put_bw", UCX_PERF_API_UCT, UCX_PERF_CMD_PUT, UCX_PERF_TEST_TYPE_STREAM_UNI,
      "put bandwidth / message rate", "overhead", 1},
 
@@ -0,0 +1,155 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCP_AM_EAGER_INL_
+#define UCP_AM_EAGER_INL_
+
+#include <ucp/core/ucp_am.h>
+#include <ucp/core/ucp_am.inl>
+#include <ucp/core/ucp_ep.inl>
+#include <ucp/core/ucp_mm.h>
+#include <ucp/core/ucp_request.inl>
+#include <ucp/proto/proto_common.inl>
+
+
+static UCS_F_ALWAYS_INLINE int
+ucp_am_check_init_params(const ucp_proto_init_params_t *init_params,
+                         uint8_t forbidden_op_flags)
+{
+    const ucp_proto_select_param_t *select_param = init_params->select_param;
+
+    return ((select_param->op_id == UCP_OP_ID_AM_SEND) ||
+            (select_param->op_id == UCP_OP_ID_AM_SEND_REPLY)) &&
+           !(select_param->op_flags & forbidden_op_flags);
+}
+
+static UCS_F_ALWAYS_INLINE int
+ucp_am_eager_check_init_params(const ucp_proto_init_params_t *init_params)
+{
+    return ucp_am_check_init_params(init_params,
+                                    UCP_PROTO_SELECT_OP_FLAG_AM_RNDV);
+}
+
+static UCS_F_ALWAYS_INLINE int
+ucp_am_proto_is_reply(const ucp_proto_select_param_t *select_param)
+{
+    return select_param->op_id == UCP_OP_ID_AM_SEND_REPLY;
+}
+
+/* Size of the header of a single-fragment active message */
+static UCS_F_ALWAYS_INLINE size_t
+ucp_am_single_hdr_size(const ucp_proto_select_param_t *select_param)
+{
+    return ucp_am_proto_is_reply(select_param) ? sizeof(ucp_am_reply_hdr_t) :
+                                                 sizeof(ucp_am_hdr_t);
+}
+
+static UCS_F_ALWAYS_INLINE ucp_am_id_t
+ucp_am_single_am_id(const ucp_request_t *req)
+{
+    return ucp_am_proto_is_reply(&req->send.proto_config->select_param) ?
+                   UCP_AM_ID_SINGLE_REPLY : UCP_AM_ID_SINGLE;
+}
+
+/* Fill the header of a single-fragment active message, return its size */
+static UCS_F_ALWAYS_INLINE size_t
+ucp_am_fill_single_header(ucp_am_reply_hdr_t *hdr, ucp_request_t *req)
+{
+    ucp_am_fill_header(&hdr->super, req);
+    if (!ucp_am_proto_is_reply(&req->send.proto_config->select_param)) {
+        return sizeof(hdr->super);
+    }
+
+    hdr->ep_id = ucp_send_request_get_ep_remote_id(req);
+    return sizeof(*hdr);
+}
+
+static UCS_F_ALWAYS_INLINE void
+ucp_am_proto_set_first_hdr(ucp_request_t *req, ucp_am_first_hdr_t *hdr)
+{
+    ucp_am_fill_header(&hdr->super.super, req);
+    hdr->super.ep_id = ucp_send_request_get_ep_remote_id(req);
+    hdr->msg_id      = req->send.msg_proto.message_id;
+    hdr->total_size  = req->send.state.dt_iter.length;
+}
+
+static UCS_F_ALWAYS_INLINE void
+ucp_am_proto_set_middle_hdr(ucp_request_t *req, ucp_am_mid_hdr_t *hdr)
+{
+    hdr->msg_id = req->send.msg_proto.message_id;
+    hdr->offset = req->send.state.dt_iter.offset;
+    hdr->ep_id  = ucp_send_request_get_ep_remote_id(req);
+}
+
+/*
+ * Zero-copy active message protocols send the user header from a registered
+ * buffer, as an additional iov entry after the payload. Make sure the lane
+ * can send such a message, and that the largest user header fits into the
+ * registered buffer.
+ */
+static UCS_F_ALWAYS_INLINE int
+ucp_am_zcopy_check_lane(const ucp_proto_init_params_t *init_params,
+                        ucp_lane_index_t lane, size_t hdr_size)
+{
+    const uct_iface_attr_t *iface_attr;
+
+    iface_attr = ucp_proto_common_get_iface_attr(init_params, lane);
+    return (iface_attr->cap.am.max_iov >= 2) &&
+           (iface_attr->cap.am.max_hdr >= hdr_size) &&
+           (ucp_am_max_header_size(init_params->worker) <=
+            init_params->worker->context->config.ext.seg_size);
+}
+
+/* Fill the iov entry which points to the user header packed by
+ * ucp_am_zcopy_pack_user_header(). Return the number of entries filled. */
+static UCS_F_ALWAYS_INLINE size_t
+ucp_am_zcopy_user_header_iov(ucp_request_t *req, ucp_lane_index_t lane,
+                             uct_iov_t *iov)
+{
+    ucp_mem_desc_t *reg_desc = req->send.msg_proto.am.reg_desc;
+
+    if (req->send.msg_proto.am.header_length == 0) {
+        return 0;
+    }
+
+    iov->buffer = reg_desc + 1;
+    iov->length = req->send.msg_proto.am.header_length;
+    iov->memh   = ucp_memh2uct(reg_desc->memh,
+                               ucp_ep_md_index(req->send.ep, lane));
+    iov->stride = 0;
+    iov->count  = 1;
+    return 1;
+}
+
+/* Register the send buffer and pack the user header to a registered buffer */
+static UCS_F_ALWAYS_INLINE ucs_status_t
+ucp_am_proto_zcopy_request_init(ucp_request_t *req, ucp_md_map_t md_map)
+{
+    ucs_status_t status;
+
+    status = ucp_proto_request_zcopy_init(req, md_map,
+                                          ucp_am_proto_zcopy_completion);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    status = ucp_am_zcopy_pack_user_header(req);
+    if (status != UCS_OK) {
+        ucp_proto_request_zcopy_cleanup(req);
+        return status;
+    }
+
+    return UCS_OK;
+}
+
+static UCS_F_ALWAYS_INLINE ucs_status_t
+ucp_am_proto_zcopy_complete_success(ucp_request_t *req)
+{
+    ucp_am_zcopy_release_user_header(req);
+    return ucp_proto_request_zcopy_complete_success(req);
+}
+
+#endif
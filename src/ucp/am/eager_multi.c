@@ -0,0 +1,261 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "eager.inl"
+
+#include <ucp/proto/proto_multi.inl>
+
+
+static UCS_F_ALWAYS_INLINE void
+ucp_am_eager_multi_request_init(ucp_request_t *req)
+{
+    req->send.msg_proto.message_id = req->send.ep->worker->am_message_id++;
+}
+
+static ucs_status_t
+ucp_am_eager_multi_init_common(ucp_proto_multi_init_params_t *params)
+{
+    if (!ucp_am_eager_check_init_params(&params->super.super)) {
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    params->super.overhead   = 10e-9; /* for multiple lanes management */
+    params->super.latency    = 0;
+    params->super.hdr_size   = sizeof(ucp_am_first_hdr_t);
+    params->first.lane_type  = UCP_LANE_TYPE_AM;
+    params->middle.lane_type = UCP_LANE_TYPE_AM_BW;
+    params->max_lanes        =
+            params->super.super.worker->context->config.ext.max_eager_lanes;
+
+    return ucp_proto_multi_init(params);
+}
+
+/* Maximal payload of the current fragment, which is sent on the lane
+ * described by 'lpriv'. The first fragment carries the user header too. */
+static UCS_F_ALWAYS_INLINE size_t
+ucp_am_eager_multi_max_payload(ucp_request_t *req,
+                               const ucp_proto_multi_lane_priv_t *lpriv)
+{
+    if (req->send.state.dt_iter.offset != 0) {
+        return ucp_proto_multi_max_payload(req, lpriv,
+                                           sizeof(ucp_am_mid_hdr_t));
+    }
+
+    return ucp_proto_multi_max_payload(req, lpriv,
+                                       sizeof(ucp_am_first_hdr_t) +
+                                       req->send.msg_proto.am.header_length);
+}
+
+static ucs_status_t
+ucp_am_eager_multi_bcopy_proto_init(const ucp_proto_init_params_t *init_params)
+{
+    ucp_context_t *context               = init_params->worker->context;
+    ucp_proto_multi_init_params_t params = {
+        .super.super         = *init_params,
+        .super.cfg_thresh    = context->config.ext.bcopy_thresh,
+        .super.cfg_priority  = 20,
+        .super.min_frag_offs = UCP_PROTO_COMMON_OFFSET_INVALID,
+        .super.max_frag_offs = ucs_offsetof(uct_iface_attr_t, cap.am.max_bcopy),
+        .super.flags         = UCP_PROTO_COMMON_INIT_FLAG_MEM_TYPE,
+        .first.tl_cap_flags  = UCT_IFACE_FLAG_AM_BCOPY,
+        .middle.tl_cap_flags = UCT_IFACE_FLAG_AM_BCOPY,
+    };
+
+    return ucp_am_eager_multi_init_common(&params);
+}
+
+static size_t ucp_am_eager_multi_bcopy_pack_first(void *dest, void *arg)
+{
+    ucp_am_first_hdr_t              *hdr = dest;
+    ucp_proto_multi_pack_ctx_t *pack_ctx = arg;
+    ucp_request_t *req                   = pack_ctx->req;
+    size_t packed_size;
+
+    ucp_am_proto_set_first_hdr(req, hdr);
+    packed_size = ucp_proto_multi_data_pack(pack_ctx, hdr + 1);
+    if (req->send.msg_proto.am.header_length != 0) {
+        /* User header is packed to the end of the first fragment */
+        ucp_am_pack_user_header(UCS_PTR_BYTE_OFFSET(hdr + 1, packed_size),
+                                req);
+    }
+
+    return sizeof(*hdr) + packed_size + req->send.msg_proto.am.header_length;
+}
+
+static size_t ucp_am_eager_multi_bcopy_pack_middle(void *dest, void *arg)
+{
+    ucp_am_mid_hdr_t                *hdr = dest;
+    ucp_proto_multi_pack_ctx_t *pack_ctx = arg;
+
+    ucp_am_proto_set_middle_hdr(pack_ctx->req, hdr);
+    return sizeof(*hdr) + ucp_proto_multi_data_pack(pack_ctx, hdr + 1);
+}
+
+static UCS_F_ALWAYS_INLINE ucs_status_t
+ucp_am_eager_multi_bcopy_send_func(ucp_request_t *req,
+                                   const ucp_proto_multi_lane_priv_t *lpriv,
+                                   ucp_datatype_iter_t *next_iter)
+{
+    ucp_ep_t *ep                        = req->send.ep;
+    ucp_proto_multi_pack_ctx_t pack_ctx = {
+        .req         = req,
+        .max_payload = ucp_am_eager_multi_max_payload(req, lpriv),
+        .next_iter   = next_iter
+    };
+    uct_pack_callback_t pack_cb;
+    ssize_t packed_size;
+    ucp_am_id_t am_id;
+
+    if (req->send.state.dt_iter.offset == 0) {
+        am_id   = UCP_AM_ID_FIRST;
+        pack_cb = ucp_am_eager_multi_bcopy_pack_first;
+    } else {
+        am_id   = UCP_AM_ID_MIDDLE;
+        pack_cb = ucp_am_eager_multi_bcopy_pack_middle;
+    }
+
+    packed_size = uct_ep_am_bcopy(ep->uct_eps[lpriv->super.lane], am_id,
+                                  pack_cb, &pack_ctx, 0);
+    if (ucs_likely(packed_size >= 0)) {
+        return UCS_OK;
+    } else {
+        return (ucs_status_t)packed_size;
+    }
+}
+
+static ucs_status_t
+ucp_am_eager_multi_bcopy_progress(uct_pending_req_t *uct_req)
+{
+    ucp_request_t *req = ucs_container_of(uct_req, ucp_request_t, send.uct);
+
+    return ucp_proto_multi_bcopy_progress(
+            req, req->send.proto_config->priv,
+            ucp_am_eager_multi_request_init,
+            ucp_am_eager_multi_bcopy_send_func,
+            ucp_proto_request_bcopy_complete_success);
+}
+
+static ucp_proto_t ucp_am_eager_multi_bcopy_proto = {
+    .name       = "am/egr/multi/bcopy",
+    .flags      = 0,
+    .init       = ucp_am_eager_multi_bcopy_proto_init,
+    .config_str = ucp_proto_multi_config_str,
+    .progress   = ucp_am_eager_multi_bcopy_progress
+};
+UCP_PROTO_REGISTER(&ucp_am_eager_multi_bcopy_proto);
+
+static ucs_status_t
+ucp_am_eager_multi_zcopy_proto_init(const ucp_proto_init_params_t *init_params)
+{
+    ucp_context_t *context               = init_params->worker->context;
+    const ucp_proto_multi_priv_t *mpriv  = init_params->priv;
+    ucp_proto_multi_init_params_t params = {
+        .super.super         = *init_params,
+        .super.cfg_thresh    = context->config.ext.zcopy_thresh,
+        .super.cfg_priority  = 30,
+        .super.min_frag_offs = ucs_offsetof(uct_iface_attr_t, cap.am.min_zcopy),
+        .super.max_frag_offs = ucs_offsetof(uct_iface_attr_t, cap.am.max_zcopy),
+        .super.flags         = UCP_PROTO_COMMON_INIT_FLAG_SEND_ZCOPY,
+        .first.tl_cap_flags  = UCT_IFACE_FLAG_AM_ZCOPY,
+        .middle.tl_cap_flags = UCT_IFACE_FLAG_AM_ZCOPY,
+    };
+    ucp_lane_index_t i;
+    ucs_status_t status;
+
+    status = ucp_am_eager_multi_init_common(&params);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    /* The first fragment must fit the largest user header and at least one
+     * byte of payload */
+    if (mpriv->lanes[0].max_frag <= (sizeof(ucp_am_first_hdr_t) +
+                                     ucp_am_max_header_size(init_params->worker))) {
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    for (i = 0; i < mpriv->num_lanes; ++i) {
+        if (!ucp_am_zcopy_check_lane(init_params, mpriv->lanes[i].super.lane,
+                                     sizeof(ucp_am_first_hdr_t))) {
+            return UCS_ERR_UNSUPPORTED;
+        }
+    }
+
+    return UCS_OK;
+}
+
+static UCS_F_ALWAYS_INLINE ucs_status_t
+ucp_am_eager_multi_zcopy_send_func(ucp_request_t *req,
+                                   const ucp_proto_multi_lane_priv_t *lpriv,
+                                   ucp_datatype_iter_t *next_iter)
+{
+    union {
+        ucp_am_first_hdr_t first;
+        ucp_am_mid_hdr_t   middle;
+    } hdr;
+    ucp_am_id_t am_id;
+    size_t hdr_size;
+    uct_iov_t iov[2];
+    size_t iovcnt;
+
+    ucp_datatype_iter_next_iov(&req->send.state.dt_iter, lpriv->super.memh_index,
+                               ucp_am_eager_multi_max_payload(req, lpriv),
+                               next_iter, &iov[0]);
+
+    if (req->send.state.dt_iter.offset == 0) {
+        am_id    = UCP_AM_ID_FIRST;
+        hdr_size = sizeof(hdr.first);
+        ucp_am_proto_set_first_hdr(req, &hdr.first);
+        iovcnt   = 1 + ucp_am_zcopy_user_header_iov(req, lpriv->super.lane,
+                                                    &iov[1]);
+    } else {
+        am_id    = UCP_AM_ID_MIDDLE;
+        hdr_size = sizeof(hdr.middle);
+        ucp_am_proto_set_middle_hdr(req, &hdr.middle);
+        iovcnt   = 1;
+    }
+
+    return uct_ep_am_zcopy(req->send.ep->uct_eps[lpriv->super.lane], am_id, &hdr,
+                           hdr_size, iov, iovcnt, 0, &req->send.state.uct_comp);
+}
+
+static ucs_status_t ucp_am_eager_multi_zcopy_progress(uct_pending_req_t *self)
+{
+    ucp_request_t                  *req = ucs_container_of(self, ucp_request_t,
+                                                           send.uct);
+    const ucp_proto_multi_priv_t *mpriv = req->send.proto_config->priv;
+    ucs_status_t status;
+
+    if (!(req->flags & UCP_REQUEST_FLAG_PROTO_INITIALIZED)) {
+        status = ucp_am_proto_zcopy_request_init(req, mpriv->reg_md_map);
+        if (status != UCS_OK) {
+            ucp_proto_request_abort(req, status);
+            return UCS_OK; /* remove from pending after request is completed */
+        }
+
+        ucp_proto_multi_request_init(req);
+        ucp_am_eager_multi_request_init(req);
+        req->flags |= UCP_REQUEST_FLAG_PROTO_INITIALIZED;
+    }
+
+    return ucp_proto_multi_progress(req, mpriv,
+                                    ucp_am_eager_multi_zcopy_send_func,
+                                    ucp_request_invoke_uct_completion_success,
+                                    UCS_BIT(UCP_DATATYPE_CONTIG));
+}
+
+static ucp_proto_t ucp_am_eager_multi_zcopy_proto = {
+    .name       = "am/egr/multi/zcopy",
+    .flags      = 0,
+    .init       = ucp_am_eager_multi_zcopy_proto_init,
+    .config_str = ucp_proto_multi_config_str,
+    .progress   = ucp_am_eager_multi_zcopy_progress
+};
+UCP_PROTO_REGISTER(&ucp_am_eager_multi_zcopy_proto);
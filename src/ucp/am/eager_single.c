@@ -0,0 +1,264 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "eager.inl"
+
+#include <ucp/proto/proto_single.inl>
+
+
+static UCS_F_ALWAYS_INLINE void
+ucp_am_eager_pack_user_header(ucp_request_t *req, void *dest)
+{
+    if (req->send.msg_proto.am.header_length != 0) {
+        ucp_am_pack_user_header(dest, req);
+    }
+}
+
+static ucs_status_t ucp_am_eager_short_progress(uct_pending_req_t *self)
+{
+    ucp_request_t                   *req = ucs_container_of(self, ucp_request_t,
+                                                            send.uct);
+    const ucp_proto_single_priv_t *spriv = req->send.proto_config->priv;
+    size_t length                        = req->send.state.dt_iter.length;
+    size_t header_length                 = req->send.msg_proto.am.header_length;
+    const void *buffer                   = req->send.state.dt_iter.type.contig.buffer;
+    ucp_am_reply_hdr_t hdr;
+    ucs_status_t status;
+    size_t hdr_size;
+    void *tx_buffer;
+    void *data;
+
+    hdr_size = ucp_am_fill_single_header(&hdr, req);
+    if ((hdr_size == sizeof(hdr.super)) && (header_length == 0)) {
+        status = uct_ep_am_short(req->send.ep->uct_eps[spriv->super.lane],
+                                 UCP_AM_ID_SINGLE, hdr.super.u64, buffer,
+                                 length);
+    } else {
+        /* UCT AM short header is 8 bytes, so the rest of the AM header, the
+         * payload and the user header are sent as short message data */
+        tx_buffer = ucs_alloca(hdr_size - sizeof(hdr.super) + length +
+                               header_length);
+        memcpy(tx_buffer, &hdr.ep_id, hdr_size - sizeof(hdr.super));
+        data = UCS_PTR_BYTE_OFFSET(tx_buffer, hdr_size - sizeof(hdr.super));
+        memcpy(data, buffer, length);
+        ucp_am_eager_pack_user_header(req, UCS_PTR_BYTE_OFFSET(data, length));
+
+        status = uct_ep_am_short(req->send.ep->uct_eps[spriv->super.lane],
+                                 ucp_am_single_am_id(req), hdr.super.u64,
+                                 tx_buffer, hdr_size - sizeof(hdr.super) +
+                                            length + header_length);
+    }
+    if (ucs_unlikely(status == UCS_ERR_NO_RESOURCE)) {
+        req->send.lane = spriv->super.lane; /* for pending add */
+        return status;
+    }
+
+    ucp_datatype_iter_cleanup(&req->send.state.dt_iter,
+                              UCS_BIT(UCP_DATATYPE_CONTIG));
+
+    ucs_assert(status != UCS_INPROGRESS);
+    ucp_request_complete_send(req, status);
+    return UCS_OK;
+}
+
+static ucs_status_t
+ucp_am_eager_short_proto_init(const ucp_proto_init_params_t *init_params)
+{
+    const ucp_proto_select_param_t *select_param = init_params->select_param;
+    ucp_proto_single_init_params_t params = {
+        .super.super         = *init_params,
+        .super.latency       = -150e-9, /* no extra memory access to fetch data */
+        .super.overhead      = 0,
+        .super.cfg_thresh    = UCS_MEMUNITS_AUTO,
+        .super.cfg_priority  = 0,
+        .super.min_frag_offs = UCP_PROTO_COMMON_OFFSET_INVALID,
+        .super.max_frag_offs = ucs_offsetof(uct_iface_attr_t, cap.am.max_short),
+        .super.hdr_size      = ucp_am_single_hdr_size(select_param),
+        .super.flags         = UCP_PROTO_COMMON_INIT_FLAG_MAX_FRAG,
+        .lane_type           = UCP_LANE_TYPE_AM,
+        .tl_cap_flags        = UCT_IFACE_FLAG_AM_SHORT
+    };
+
+    if (!ucp_am_eager_check_init_params(init_params) ||
+        /* short protocol requires contig/host */
+        (select_param->dt_class != UCP_DATATYPE_CONTIG) ||
+        !UCP_MEM_IS_HOST(select_param->mem_type)) {
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    return ucp_proto_single_init(&params);
+}
+
+static ucp_proto_t ucp_am_eager_short_proto = {
+    .name       = "am/egr/short",
+    .flags      = UCP_PROTO_FLAG_AM_SHORT,
+    .init       = ucp_am_eager_short_proto_init,
+    .config_str = ucp_proto_single_config_str,
+    .progress   = ucp_am_eager_short_progress
+};
+UCP_PROTO_REGISTER(&ucp_am_eager_short_proto);
+
+static size_t ucp_am_eager_single_bcopy_pack(void *dest, void *arg)
+{
+    ucp_request_t *req = arg;
+    ucp_datatype_iter_t next_iter;
+    size_t hdr_size, packed_size;
+    void *payload;
+
+    ucs_assert(req->send.state.dt_iter.offset == 0);
+
+    hdr_size    = ucp_am_fill_single_header(dest, req);
+    payload     = UCS_PTR_BYTE_OFFSET(dest, hdr_size);
+    packed_size = ucp_datatype_iter_next_pack(&req->send.state.dt_iter,
+                                              req->send.ep->worker, SIZE_MAX,
+                                              &next_iter, payload);
+    ucp_am_eager_pack_user_header(req,
+                                  UCS_PTR_BYTE_OFFSET(payload, packed_size));
+
+    return hdr_size + packed_size + req->send.msg_proto.am.header_length;
+}
+
+static ucs_status_t ucp_am_eager_single_bcopy_progress(uct_pending_req_t *self)
+{
+    ucp_request_t                   *req = ucs_container_of(self, ucp_request_t,
+                                                            send.uct);
+    const ucp_proto_single_priv_t *spriv = req->send.proto_config->priv;
+
+    return ucp_proto_am_bcopy_single_progress(
+            req, ucp_am_single_am_id(req), spriv->super.lane,
+            ucp_am_eager_single_bcopy_pack, req,
+            ucp_am_single_hdr_size(&req->send.proto_config->select_param) +
+                    req->send.state.dt_iter.length +
+                    req->send.msg_proto.am.header_length,
+            ucp_proto_request_bcopy_complete_success);
+}
+
+static ucs_status_t
+ucp_am_eager_single_bcopy_proto_init(const ucp_proto_init_params_t *init_params)
+{
+    ucp_context_t *context                = init_params->worker->context;
+    ucp_proto_single_init_params_t params = {
+        .super.super         = *init_params,
+        .super.latency       = 0,
+        .super.overhead      = 5e-9,
+        .super.cfg_thresh    = context->config.ext.bcopy_thresh,
+        .super.cfg_priority  = 20,
+        .super.min_frag_offs = UCP_PROTO_COMMON_OFFSET_INVALID,
+        .super.max_frag_offs = ucs_offsetof(uct_iface_attr_t, cap.am.max_bcopy),
+        .super.hdr_size      = ucp_am_single_hdr_size(init_params->select_param),
+        .super.flags         = UCP_PROTO_COMMON_INIT_FLAG_MAX_FRAG,
+        .lane_type           = UCP_LANE_TYPE_AM,
+        .tl_cap_flags        = UCT_IFACE_FLAG_AM_BCOPY
+    };
+
+    if (!ucp_am_eager_check_init_params(init_params)) {
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    return ucp_proto_single_init(&params);
+}
+
+static ucp_proto_t ucp_am_eager_single_bcopy_proto = {
+    .name       = "am/egr/single/bcopy",
+    .flags      = 0,
+    .init       = ucp_am_eager_single_bcopy_proto_init,
+    .config_str = ucp_proto_single_config_str,
+    .progress   = ucp_am_eager_single_bcopy_progress
+};
+UCP_PROTO_REGISTER(&ucp_am_eager_single_bcopy_proto);
+
+static ucs_status_t
+ucp_am_eager_single_zcopy_proto_init(const ucp_proto_init_params_t *init_params)
+{
+    ucp_context_t *context                = init_params->worker->context;
+    size_t hdr_size                       =
+            ucp_am_single_hdr_size(init_params->select_param);
+    const ucp_proto_single_priv_t *spriv  = init_params->priv;
+    ucp_proto_single_init_params_t params = {
+        .super.super         = *init_params,
+        .super.latency       = 0,
+        .super.overhead      = 0,
+        .super.cfg_thresh    = context->config.ext.zcopy_thresh,
+        .super.cfg_priority  = 30,
+        .super.min_frag_offs = ucs_offsetof(uct_iface_attr_t, cap.am.min_zcopy),
+        .super.max_frag_offs = ucs_offsetof(uct_iface_attr_t, cap.am.max_zcopy),
+        .super.hdr_size      = hdr_size,
+        .super.flags         = UCP_PROTO_COMMON_INIT_FLAG_SEND_ZCOPY |
+                               UCP_PROTO_COMMON_INIT_FLAG_MAX_FRAG,
+        .lane_type           = UCP_LANE_TYPE_AM,
+        .tl_cap_flags        = UCT_IFACE_FLAG_AM_ZCOPY
+    };
+    ucs_status_t status;
+
+    if (!ucp_am_eager_check_init_params(init_params)) {
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    status = ucp_proto_single_init(&params);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    if (!ucp_am_zcopy_check_lane(init_params, spriv->super.lane, hdr_size)) {
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    return UCS_OK;
+}
+
+static ucs_status_t ucp_am_eager_single_zcopy_progress(uct_pending_req_t *self)
+{
+    ucp_request_t                   *req = ucs_container_of(self, ucp_request_t,
+                                                            send.uct);
+    const ucp_proto_single_priv_t *spriv = req->send.proto_config->priv;
+    ucp_datatype_iter_t next_iter;
+    ucp_am_reply_hdr_t hdr;
+    ucs_status_t status;
+    ucp_md_map_t md_map;
+    uct_iov_t iov[2];
+    size_t hdr_size;
+    size_t iovcnt;
+
+    ucs_assert(req->send.state.dt_iter.offset == 0);
+
+    if (!(req->flags & UCP_REQUEST_FLAG_PROTO_INITIALIZED)) {
+        md_map = (spriv->reg_md == UCP_NULL_RESOURCE) ? 0 : UCS_BIT(spriv->reg_md);
+        status = ucp_am_proto_zcopy_request_init(req, md_map);
+        if (status != UCS_OK) {
+            ucp_proto_request_abort(req, status);
+            return UCS_OK; /* remove from pending after request is completed */
+        }
+
+        req->flags |= UCP_REQUEST_FLAG_PROTO_INITIALIZED;
+    }
+
+    hdr_size = ucp_am_fill_single_header(&hdr, req);
+    ucp_datatype_iter_next_iov(&req->send.state.dt_iter, spriv->super.memh_index,
+                               SIZE_MAX, &next_iter, &iov[0]);
+    iovcnt   = 1 + ucp_am_zcopy_user_header_iov(req, spriv->super.lane, &iov[1]);
+    status   = uct_ep_am_zcopy(req->send.ep->uct_eps[spriv->super.lane],
+                               ucp_am_single_am_id(req), &hdr, hdr_size, iov,
+                               iovcnt, 0, &req->send.state.uct_comp);
+    UCS_PROFILE_REQUEST_EVENT_CHECK_STATUS(req, "am_zcopy_only", iov[0].length,
+                                           status);
+
+    return ucp_proto_single_status_handle(
+            req, ucp_am_proto_zcopy_complete_success, spriv->super.lane,
+            status);
+}
+
+static ucp_proto_t ucp_am_eager_single_zcopy_proto = {
+    .name       = "am/egr/single/zcopy",
+    .flags      = 0,
+    .init       = ucp_am_eager_single_zcopy_proto_init,
+    .config_str = ucp_proto_single_config_str,
+    .progress   = ucp_am_eager_single_zcopy_progress
+};
+UCP_PROTO_REGISTER(&ucp_am_eager_single_zcopy_proto);
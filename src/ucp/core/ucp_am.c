@@ -10,12 +10,15 @@
 #endif
 
 #include "ucp_am.h"
+#include "ucp_am.inl"
 
 #include <ucp/core/ucp_ep.h>
 #include <ucp/core/ucp_ep.inl>
 #include <ucp/core/ucp_worker.h>
 #include <ucp/core/ucp_context.h>
+#include <ucp/am/eager.inl>
 #include <ucp/rndv/rndv.h>
+#include <ucp/rndv/proto_rndv.h>
 #include <ucp/proto/proto_am.inl>
 #include <ucp/dt/dt.h>
 #include <ucp/dt/dt.inl>
@@ -133,28 +136,6 @@ size_t ucp_am_max_header_size(ucp_worker_h worker)
     return ucs_min(max_am_header, UINT32_MAX);
 }
 
-static void ucp_am_rndv_send_ats(ucp_worker_h worker,
-                                 ucp_am_rndv_rts_hdr_t *rts,
-                                 ucs_status_t status)
-{
-    ucp_request_t *req;
-    ucp_ep_h ep;
-
-    UCP_WORKER_GET_EP_BY_ID(&ep, worker, rts->super.sreq.ep_id, return,
-                            "AM RNDV ATS");
-    req = ucp_request_get(worker);
-    if (ucs_unlikely(req == NULL)) {
-        ucs_error("failed to allocate request for AM RNDV ATS");
-        return;
-    }
-
-    req->send.ep = ep;
-    req->flags   = 0;
-
-    ucp_rndv_req_send_ack(req, NULL, rts->super.sreq.req_id, status,
-                          UCP_AM_ID_RNDV_ATS, "send_ats");
-}
-
 UCS_PROFILE_FUNC_VOID(ucp_am_data_release, (worker, data),
                       ucp_worker_h worker, void *data)
 {
@@ -177,7 +158,7 @@ UCS_PROFILE_FUNC_VOID(ucp_am_data_release, (worker, data),
 
         /* This data is not needed (rndv receive was not initiated), send ATS
          * back to the sender to complete its send request. */
-        ucp_am_rndv_send_ats(worker, data, UCS_OK);
+        ucp_rndv_send_ats(worker, data, UCS_OK);
     }
 
     UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(worker);
@@ -285,14 +266,6 @@ ucp_am_get_short_max(const ucp_request_t *req, ssize_t max_short)
             max_short : -1;
 }
 
-static UCS_F_ALWAYS_INLINE void
-ucp_am_fill_header(ucp_am_hdr_t *hdr, ucp_request_t *req)
-{
-    hdr->am_id         = req->send.msg_proto.am.am_id;
-    hdr->flags         = req->send.msg_proto.am.flags;
-    hdr->header_length = req->send.msg_proto.am.header_length;
-}
-
 static UCS_F_ALWAYS_INLINE void
 ucp_am_fill_middle_header(ucp_am_mid_hdr_t *hdr, ucp_request_t *req)
 {
@@ -320,40 +293,6 @@ ucp_am_fill_short_header(ucp_am_hdr_t *hdr, uint16_t id, uint16_t flags,
     hdr->header_length = header_length;
 }
 
-static UCS_F_ALWAYS_INLINE void
-ucp_am_pack_user_header(void *buffer, ucp_request_t *req)
-{
-    ucp_dt_state_t hdr_state;
-
-    hdr_state.offset = 0ul;
-
-    ucp_dt_pack(req->send.ep->worker, ucp_dt_make_contig(1),
-                UCS_MEMORY_TYPE_HOST, buffer, req->send.msg_proto.am.header,
-                &hdr_state, req->send.msg_proto.am.header_length);
-}
-
-static UCS_F_ALWAYS_INLINE ucs_status_t
-ucp_am_zcopy_pack_user_header(ucp_request_t *req)
-{
-    ucp_mem_desc_t *reg_desc;
-
-    if (req->send.msg_proto.am.header_length == 0) {
-        return UCS_OK;
-    }
-
-    ucs_assert(req->send.msg_proto.am.header != NULL);
-
-    reg_desc = ucp_worker_mpool_get(&req->send.ep->worker->reg_mp);
-    if (ucs_unlikely(reg_desc == NULL)) {
-        return UCS_ERR_NO_MEMORY;
-    }
-
-    ucp_am_pack_user_header(reg_desc + 1, req);
-    req->send.msg_proto.am.reg_desc = reg_desc;
-
-    return UCS_OK;
-}
-
 ucs_status_t ucp_worker_set_am_recv_handler(ucp_worker_h worker,
                                             const ucp_am_handler_param_t *param)
 {
@@ -621,9 +560,7 @@ static UCS_F_ALWAYS_INLINE void ucp_am_zcopy_complete_common(ucp_request_t *req)
 {
     ucs_assert(req->send.state.uct_comp.count == 0);
 
-    if (req->send.msg_proto.am.header_length > 0) {
-        ucs_mpool_put_inline(req->send.msg_proto.am.reg_desc);
-    }
+    ucp_am_zcopy_release_user_header(req);
 
     ucp_request_send_buffer_dereg(req); /* TODO register+lane change */
 }
@@ -659,6 +596,15 @@ void ucp_am_zcopy_completion(uct_completion_t *self)
     }
 }
 
+void ucp_am_proto_zcopy_completion(uct_completion_t *self)
+{
+    ucp_request_t *req = ucs_container_of(self, ucp_request_t,
+                                          send.state.uct_comp);
+
+    ucp_am_zcopy_release_user_header(req);
+    ucp_proto_request_zcopy_completion(self);
+}
+
 static ucs_status_t ucp_am_zcopy_single(uct_pending_req_t *self)
 {
     ucp_request_t *req = ucs_container_of(self, ucp_request_t, send.uct);
@@ -771,6 +717,80 @@ static ucs_status_t ucp_am_send_start_rndv(ucp_request_t *sreq)
     return ucp_rndv_reg_send_buffer(sreq);
 }
 
+static ucs_status_t
+ucp_am_rndv_proto_init(const ucp_proto_init_params_t *init_params)
+{
+    ucp_context_h context                    = init_params->worker->context;
+    ucp_proto_rndv_ctrl_init_params_t params = {
+        .super.super        = *init_params,
+        .super.latency      = 0,
+        .super.overhead     = 40e-9,
+        .super.cfg_thresh   = context->config.ext.rndv_thresh,
+        .super.cfg_priority = 60,
+        .super.flags        = UCP_PROTO_COMMON_INIT_FLAG_RESPONSE,
+        .remote_op_id       = UCP_OP_ID_RNDV_RECV,
+        .perf_bias          = context->config.ext.rndv_perf_diff / 100.0,
+        .mem_info.type      = init_params->select_param->mem_type,
+        .mem_info.sys_dev   = init_params->select_param->sys_dev
+    };
+    ucs_status_t status;
+
+    if (!ucp_am_check_init_params(init_params,
+                                  UCP_PROTO_SELECT_OP_FLAG_AM_EAGER) ||
+        (init_params->select_param->dt_class != UCP_DATATYPE_CONTIG)) {
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    /* Rendezvous can still be sent if it is requested by
+     * UCP_AM_SEND_FLAG_RNDV or by the configured threshold */
+    status = ucp_proto_rndv_ctrl_init(&params);
+    if (status == UCS_OK) {
+        return UCS_OK;
+    }
+
+    return ucp_proto_rndv_ctrl_am_lane_init(&params);
+}
+
+/*
+ * The data is transferred by the existing RTS/RTR/ATS flow, so convert the
+ * request to the legacy send state and start the rendezvous from here.
+ */
+static ucs_status_t ucp_am_rndv_proto_progress(uct_pending_req_t *self)
+{
+    ucp_request_t *req          = ucs_container_of(self, ucp_request_t,
+                                                   send.uct);
+    ucp_datatype_iter_t dt_iter = req->send.state.dt_iter;
+    ucs_status_t status;
+
+    ucs_assert(dt_iter.dt_class == UCP_DATATYPE_CONTIG);
+
+    req->flags            |= UCP_REQUEST_FLAG_SEND_AM;
+    req->send.buffer       = dt_iter.type.contig.buffer;
+    req->send.datatype     = ucp_dt_make_contig(1);
+    req->send.length       = dt_iter.length;
+    req->send.mem_type     = dt_iter.mem_info.type;
+    req->send.lane         = ucp_ep_get_am_lane(req->send.ep);
+    req->send.pending_lane = UCP_NULL_LANE;
+    ucp_request_send_state_init(req, req->send.datatype, req->send.length);
+
+    status = ucp_am_send_start_rndv(req);
+    if (status != UCS_OK) {
+        ucp_request_complete_send(req, status);
+        return UCS_OK;
+    }
+
+    return req->send.uct.func(self);
+}
+
+static ucp_proto_t ucp_am_rndv_proto = {
+    .name       = "am/rndv",
+    .flags      = 0,
+    .init       = ucp_am_rndv_proto_init,
+    .config_str = ucp_proto_rndv_ctrl_config_str,
+    .progress   = ucp_am_rndv_proto_progress
+};
+UCP_PROTO_REGISTER(&ucp_am_rndv_proto);
+
 static void ucp_am_send_req_init(ucp_request_t *req, ucp_ep_h ep,
                                  const void *header, size_t header_length,
                                  const void *buffer, ucp_datatype_t datatype,
@@ -897,7 +917,7 @@ ucp_am_send_req(ucp_request_t *req, size_t count,
      * If it is completed immediately, release the request and return the status.
      * Otherwise, return the request.
      */
-    ucp_request_send(req, 0);
+    ucp_request_send_am_batch(req, msg_config, proto);
     if (req->flags & UCP_REQUEST_FLAG_COMPLETED) {
         ucp_request_imm_cmpl_param(param, req, send);
     }
@@ -907,6 +927,17 @@ ucp_am_send_req(ucp_request_t *req, size_t count,
     return req + 1;
 }
 
+static UCS_F_ALWAYS_INLINE uint8_t ucp_am_send_op_flags(uint32_t flags)
+{
+    if (flags & UCP_AM_SEND_FLAG_EAGER) {
+        return UCP_PROTO_SELECT_OP_FLAG_AM_EAGER;
+    } else if (flags & UCP_AM_SEND_FLAG_RNDV) {
+        return UCP_PROTO_SELECT_OP_FLAG_AM_RNDV;
+    }
+
+    return 0;
+}
+
 static UCS_F_ALWAYS_INLINE ucs_status_t
 ucp_am_try_send_short(ucp_ep_h ep, uint16_t id, uint32_t flags,
                       const void *header, size_t header_length,
@@ -941,6 +972,7 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_am_send_nbx,
                  size_t header_length, const void *buffer, size_t count,
                  const ucp_request_param_t *param)
 {
+    size_t contig_length = 0;
     ucs_status_t status;
     ucs_status_ptr_t ret;
     ucp_datatype_t datatype;
@@ -963,18 +995,20 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_am_send_nbx,
         status = ucp_am_try_send_short(ep, id, flags, header, header_length,
                                        buffer, count);
         ucp_request_send_check_status(status, ret, goto out);
-        datatype = ucp_dt_make_contig(1);
+        datatype      = ucp_dt_make_contig(1);
+        contig_length = count;
     } else if (attr_mask == UCP_OP_ATTR_FIELD_DATATYPE) {
         datatype = param->datatype;
         if (ucs_likely(UCP_DT_IS_CONTIG(datatype))) {
-            status = ucp_am_try_send_short(ep, id, flags, header,
-                                           header_length, buffer,
-                                           ucp_contig_dt_length(datatype,
-                                                                count));
+            contig_length = ucp_contig_dt_length(datatype, count);
+            status        = ucp_am_try_send_short(ep, id, flags, header,
+                                                  header_length, buffer,
+                                                  contig_length);
             ucp_request_send_check_status(status, ret, goto out);
         }
     } else {
-        datatype = ucp_dt_make_contig(1);
+        datatype      = ucp_dt_make_contig(1);
+        contig_length = count;
     }
 
     if (ucs_unlikely(param->op_attr_mask & UCP_OP_ATTR_FLAG_FORCE_IMM_CMPL)) {
@@ -992,6 +1026,26 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_am_send_nbx,
                                 {ret = UCS_STATUS_PTR(UCS_ERR_NO_MEMORY);
                                  goto out;});
 
+    /* Rendezvous of non-contiguous data is supported only by the legacy
+     * protocols */
+    if (ep->worker->context->config.ext.proto_enable &&
+        (!(flags & UCP_AM_SEND_FLAG_RNDV) || UCP_DT_IS_CONTIG(datatype))) {
+        req->send.msg_proto.am.am_id         = id;
+        req->send.msg_proto.am.flags         = flags;
+        req->send.msg_proto.am.header        = (void*)header;
+        req->send.msg_proto.am.header_length = header_length;
+
+        ret = ucp_proto_request_send_op(ep, &ucp_ep_config(ep)->proto_select,
+                                        UCP_WORKER_CFG_INDEX_NULL, req,
+                                        (flags & UCP_AM_SEND_FLAG_REPLY) ?
+                                                UCP_OP_ID_AM_SEND_REPLY :
+                                                UCP_OP_ID_AM_SEND,
+                                        buffer, count, datatype, contig_length,
+                                        param, header_length,
+                                        ucp_am_send_op_flags(flags));
+        goto out;
+    }
+
     ucp_am_send_req_init(req, ep, header, header_length, buffer, datatype,
                          count, flags, id, param);
 
@@ -1093,7 +1147,7 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_am_recv_data_nbx,
         ucp_rndv_receive(worker, req, &rts->super, rts + 1);
     } else {
         /* Nothing to receive, send ack to sender to complete its request */
-        ucp_am_rndv_send_ats(worker, rts, UCS_OK);
+        ucp_rndv_send_ats(worker, &rts->super, UCS_OK);
         ucp_request_complete_am_recv(req, UCS_OK);
         desc->flags |= UCP_RECV_DESC_FLAG_COMPLETED;
     }
@@ -1536,7 +1590,7 @@ ucs_status_t ucp_am_rndv_process_rts(void *arg, void *data, size_t length,
 out_send_ats:
     /* Some error occured or user does not need this data. Send ATS back to the
      * sender to complete its send request. */
-    ucp_am_rndv_send_ats(worker, rts, status);
+    ucp_rndv_send_ats(worker, &rts->super, status);
 
 out:
     if ((desc != NULL) && !(desc->flags & UCP_RECV_DESC_FLAG_UCT_DESC)) {
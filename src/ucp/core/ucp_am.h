@@ -96,6 +96,8 @@ size_t ucp_am_max_header_size(ucp_worker_h worker);
 ucs_status_t ucp_am_rndv_process_rts(void *arg, void *data, size_t length,
                                      unsigned tl_flags);
 
+void ucp_am_proto_zcopy_completion(uct_completion_t *self);
+
 UCS_ARRAY_DECLARE_TYPE(ucp_am_cbs, unsigned, ucp_am_entry_t)
 
 
@@ -0,0 +1,68 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCP_AM_INL_
+#define UCP_AM_INL_
+
+#include "ucp_am.h"
+#include "ucp_worker.h"
+#include "ucp_request.h"
+
+#include <ucp/dt/dt.inl>
+#include <ucs/datastruct/mpool.inl>
+
+
+static UCS_F_ALWAYS_INLINE void
+ucp_am_fill_header(ucp_am_hdr_t *hdr, ucp_request_t *req)
+{
+    hdr->am_id         = req->send.msg_proto.am.am_id;
+    hdr->flags         = req->send.msg_proto.am.flags;
+    hdr->header_length = req->send.msg_proto.am.header_length;
+}
+
+static UCS_F_ALWAYS_INLINE void
+ucp_am_pack_user_header(void *buffer, ucp_request_t *req)
+{
+    ucp_dt_state_t hdr_state;
+
+    hdr_state.offset = 0ul;
+
+    ucp_dt_pack(req->send.ep->worker, ucp_dt_make_contig(1),
+                UCS_MEMORY_TYPE_HOST, buffer, req->send.msg_proto.am.header,
+                &hdr_state, req->send.msg_proto.am.header_length);
+}
+
+static UCS_F_ALWAYS_INLINE ucs_status_t
+ucp_am_zcopy_pack_user_header(ucp_request_t *req)
+{
+    ucp_mem_desc_t *reg_desc;
+
+    if (req->send.msg_proto.am.header_length == 0) {
+        return UCS_OK;
+    }
+
+    ucs_assert(req->send.msg_proto.am.header != NULL);
+
+    reg_desc = ucp_worker_mpool_get(&req->send.ep->worker->reg_mp);
+    if (ucs_unlikely(reg_desc == NULL)) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    ucp_am_pack_user_header(reg_desc + 1, req);
+    req->send.msg_proto.am.reg_desc = reg_desc;
+
+    return UCS_OK;
+}
+
+static UCS_F_ALWAYS_INLINE void
+ucp_am_zcopy_release_user_header(ucp_request_t *req)
+{
+    if (req->send.msg_proto.am.header_length > 0) {
+        ucs_mpool_put_inline(req->send.msg_proto.am.reg_desc);
+    }
+}
+
+#endif
@@ -55,7 +55,14 @@ const char *ucp_operation_names[] = {
     [UCP_OP_ID_TAG_SEND_SYNC] = "tag_send_sync",
     [UCP_OP_ID_PUT]           = "put",
     [UCP_OP_ID_GET]           = "get",
+    [UCP_OP_ID_AM_SEND]       = "am_send",
+    [UCP_OP_ID_AM_SEND_REPLY] = "am_send_reply",
+    [UCP_OP_ID_STREAM_SEND]   = "stream_send",
+    [UCP_OP_ID_AMO_POST]      = "amo_post",
+    [UCP_OP_ID_AMO_FETCH]     = "amo_fetch",
+    [UCP_OP_ID_AMO_CSWAP]     = "amo_cswap",
     [UCP_OP_ID_RNDV_RECV]     = "rndv_recv",
+    [UCP_OP_ID_RNDV_SEND]     = "rndv_send",
     [UCP_OP_ID_LAST]          = NULL
 };
 
@@ -179,6 +186,12 @@ static ucs_config_field_t ucp_config_table[] = {
    "Segment size that is used to perform data transfer when doing RKEY PTR progress",
    ucs_offsetof(ucp_config_t, ctx.rkey_ptr_seg_size), UCS_CONFIG_TYPE_MEMUNITS},
 
+  {"RKEY_PTR_NT_THRESH", "auto",
+   "Message size starting from which RKEY PTR progress copies data to host\n"
+   "memory using non-temporal memory access, to avoid evicting the working set\n"
+   "of other requests from the cache. \"auto\" means the last level cache size.",
+   ucs_offsetof(ucp_config_t, ctx.rkey_ptr_nt_thresh), UCS_CONFIG_TYPE_MEMUNITS},
+
   {"ZCOPY_THRESH", "auto",
    "Threshold for switching from buffer copy to zero copy protocol",
    ucs_offsetof(ucp_config_t, ctx.zcopy_thresh), UCS_CONFIG_TYPE_MEMUNITS},
@@ -265,6 +278,13 @@ static ucs_config_field_t ucp_config_table[] = {
    "and the resulting performance.\n",
    ucs_offsetof(ucp_config_t, ctx.estimated_num_ppn), UCS_CONFIG_TYPE_ULUNITS},
 
+  {"MPOOL_THREAD_CACHE", "32",
+   "Number of free objects to cache per application thread in the worker memory\n"
+   "pools (requests, receive descriptors, remote keys), when the worker is\n"
+   "created in multi-threaded mode. The cache reduces contention on the shared\n"
+   "free list. 0 - disable the cache.",
+   ucs_offsetof(ucp_config_t, ctx.mpool_tcache_size), UCS_CONFIG_TYPE_UINT},
+
   {"RNDV_FRAG_SIZE", "512k",
    "RNDV fragment size \n",
    ucs_offsetof(ucp_config_t, ctx.rndv_frag_size), UCS_CONFIG_TYPE_MEMUNITS},
@@ -1370,6 +1390,18 @@ static ucs_status_t ucp_fill_config(ucp_context_h context,
     ucs_debug("estimated bcopy bandwidth is %f",
               context->config.ext.bcopy_bw);
 
+    if (context->config.ext.rkey_ptr_nt_thresh == UCS_MEMUNITS_AUTO) {
+        /* Copy with non-temporal access only when the data does not fit into
+         * the last level cache. If the cache size is unknown, never do it */
+        context->config.ext.rkey_ptr_nt_thresh =
+                ucs_cpu_get_cache_size(UCS_CPU_CACHE_L3);
+        if (context->config.ext.rkey_ptr_nt_thresh == 0) {
+            context->config.ext.rkey_ptr_nt_thresh = UCS_MEMUNITS_INF;
+        }
+    }
+    ucs_debug("rkey_ptr non-temporal copy threshold is %zu",
+              context->config.ext.rkey_ptr_nt_thresh);
+
     /* always init MT lock in context even though it is disabled by user,
      * because we need to use context lock to protect ucp_mm_ and ucp_rkey_
      * routines */
@@ -57,10 +57,14 @@ typedef struct ucp_context_config {
     ucp_rndv_mode_t                        rndv_mode;
     /** RKEY PTR segment size */
     size_t                                 rkey_ptr_seg_size;
+    /** RKEY PTR message size to use non-temporal copy */
+    size_t                                 rkey_ptr_nt_thresh;
     /** Estimation of bcopy bandwidth */
     double                                 bcopy_bw;
     /** Segment size in the worker pre-registered memory pool */
     size_t                                 seg_size;
+    /** Size of per-thread cache in worker memory pools */
+    unsigned                               mpool_tcache_size;
     /** RNDV pipeline fragment size */
     size_t                                 rndv_frag_size;
     /** RNDV pipline send threshold */
@@ -269,6 +273,8 @@ typedef struct ucp_am_handler {
     ucp_am_tracer_t               tracer;
     uint32_t                      flags;
     uct_am_callback_t             proxy_cb;
+    uct_am_recv_direct_callback_t recv_direct_cb;
+    size_t                        recv_direct_hdr_len;
 } ucp_am_handler_t;
 
 typedef struct ucp_tl_iface_atomic_flags {
@@ -303,6 +309,17 @@ typedef struct ucp_tl_iface_atomic_flags {
     }
 
 
+/**
+ * Defines a handler which provides the destination for the payload of large
+ * active messages, on transports which support receiving it directly.
+ */
+#define UCP_DEFINE_AM_RECV_DIRECT(_id, _cb, _hdr_len) \
+    UCS_STATIC_INIT { \
+        ucp_am_handlers[_id].recv_direct_cb      = _cb; \
+        ucp_am_handlers[_id].recv_direct_hdr_len = _hdr_len; \
+    }
+
+
 /**
  * Defines a proxy handler which counts received messages on ucp_worker_iface_t
  * context. It's used to determine if there is activity on a transport interface.
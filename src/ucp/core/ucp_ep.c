@@ -23,6 +23,7 @@
 #include <ucp/tag/offload.h>
 #include <ucp/proto/proto_select.h>
 #include <ucp/rndv/rndv.h>
+#include <ucp/rma/rma.h>
 #include <ucp/stream/stream.h>
 #include <ucp/core/ucp_listener.h>
 #include <ucs/datastruct/queue.h>
@@ -69,6 +70,8 @@ static uct_iface_t ucp_failed_tl_iface = {
         .ep_am_short_iov     = (uct_ep_am_short_iov_func_t)ucs_empty_function_return_ep_timeout,
         .ep_am_bcopy         = (uct_ep_am_bcopy_func_t)ucs_empty_function_return_bc_ep_timeout,
         .ep_am_zcopy         = (uct_ep_am_zcopy_func_t)ucs_empty_function_return_ep_timeout,
+        .ep_am_batch_begin   = (uct_ep_am_batch_begin_func_t)ucs_empty_function,
+        .ep_am_batch_commit  = (uct_ep_am_batch_commit_func_t)ucs_empty_function,
         .ep_atomic_cswap64   = (uct_ep_atomic_cswap64_func_t)ucs_empty_function_return_ep_timeout,
         .ep_atomic_cswap32   = (uct_ep_atomic_cswap32_func_t)ucs_empty_function_return_ep_timeout,
         .ep_atomic64_post    = (uct_ep_atomic64_post_func_t)ucs_empty_function_return_ep_timeout,
@@ -841,6 +844,7 @@ void ucp_ep_disconnected(ucp_ep_h ep, int force)
 
     ucp_stream_ep_cleanup(ep);
     ucp_am_ep_cleanup(ep);
+    ucp_amo_ep_cleanup(ep);
 
     ep->flags &= ~UCP_EP_FLAG_USED;
 
@@ -1735,6 +1739,8 @@ ucs_status_t ucp_ep_config_init(ucp_worker_h worker, ucp_ep_config_t *config,
     config->tag.max_eager_short.memtype_off          = -1;
     config->am_u.max_eager_short.memtype_on          = -1;
     config->am_u.max_eager_short.memtype_off         = -1;
+    config->stream.max_eager_short.memtype_on        = -1;
+    config->stream.max_eager_short.memtype_off       = -1;
 
     for (lane = 0; lane < config->key.num_lanes; ++lane) {
         rsc_index = config->key.lanes[lane].rsc_index;
@@ -1918,6 +1924,9 @@ ucs_status_t ucp_ep_config_init(ucp_worker_h worker, ucp_ep_config_t *config,
             ucp_ep_config_set_memtype_thresh(&config->am_u.max_eager_short,
                                              am_max_eager_short,
                                              context->num_mem_type_detect_mds);
+            ucp_ep_config_set_memtype_thresh(&config->stream.max_eager_short,
+                                             config->am.max_short,
+                                             context->num_mem_type_detect_mds);
 
             /* All keys must fit in RNDV packet.
              * TODO remove some MDs if they don't
@@ -2294,7 +2303,7 @@ static void ucp_ep_config_print(FILE *stream, ucp_worker_h worker,
     }
 
     if (context->config.features &
-        (UCP_FEATURE_TAG|UCP_FEATURE_RMA|UCP_FEATURE_AM)) {
+        (UCP_FEATURE_TAG|UCP_FEATURE_RMA|UCP_FEATURE_AM|UCP_FEATURE_STREAM)) {
         fprintf(stream, "#\n");
         fprintf(stream, "# %23s: mds ", "rma_bw");
         ucs_for_each_bit(md_index, config->key.rma_bw_md_map) {
@@ -2302,7 +2311,8 @@ static void ucp_ep_config_print(FILE *stream, ucp_worker_h worker,
         }
     }
 
-    if (context->config.features & (UCP_FEATURE_TAG | UCP_FEATURE_AM)) {
+    if (context->config.features &
+        (UCP_FEATURE_TAG | UCP_FEATURE_AM | UCP_FEATURE_STREAM)) {
         fprintf(stream, "rndv_rkey_size %zu\n", config->rndv.rkey_size);
     }
 }
@@ -329,6 +329,9 @@ struct ucp_ep_config {
         /* Protocols used for stream operations
          * (currently it's only AM based). */
         const ucp_request_send_proto_t   *proto;
+
+        /* Maximal size for eager short */
+        ucp_memtype_thresh_t             max_eager_short;
     } stream;
 
     struct {
@@ -399,6 +402,9 @@ typedef struct {
     ucs_ptr_map_key_t        remote_ep_id; /* Remote EP ID */
     ucp_err_handler_cb_t     err_cb; /* Error handler */
     ucp_ep_close_proto_req_t close_req; /* Close protocol request */
+    ucs_queue_head_t         stream_asm_q; /* Stream data which is waiting for
+                                              a preceding message to be
+                                              assembled */
 } ucp_ep_ext_control_t;
 
 
@@ -74,6 +74,7 @@ UCP_PROXY_EP_DEFINE_OP(ssize_t, am_bcopy, uint8_t, uct_pack_callback_t, void*,
                        unsigned)
 UCP_PROXY_EP_DEFINE_OP(ucs_status_t, am_zcopy, uint8_t, const void*, unsigned,
                        const uct_iov_t*, size_t, unsigned, uct_completion_t*)
+UCP_PROXY_EP_DEFINE_OP(void, am_batch_begin, unsigned)
 UCP_PROXY_EP_DEFINE_OP(ucs_status_t, atomic_cswap64, uint64_t, uint64_t,
                        uint64_t, uct_rkey_t, uint64_t*, uct_completion_t*)
 UCP_PROXY_EP_DEFINE_OP(ucs_status_t, atomic_cswap32, uint32_t, uint32_t,
@@ -106,6 +107,13 @@ UCP_PROXY_EP_DEFINE_OP(ucs_status_t, check, unsigned, uct_completion_t*)
 UCP_PROXY_EP_DEFINE_OP(ucs_status_t, get_address, uct_ep_addr_t*)
 UCP_PROXY_EP_DEFINE_OP(ucs_status_t, connect_to_ep, const uct_device_addr_t*,
                        const uct_ep_addr_t*)
+
+static void ucp_proxy_ep_am_batch_commit(uct_ep_h ep)
+{
+    ucp_proxy_ep_t *proxy_ep = ucs_derived_of(ep, ucp_proxy_ep_t);
+    uct_ep_am_batch_commit(proxy_ep->uct_ep);
+}
+
 static UCS_CLASS_DEFINE_NAMED_DELETE_FUNC(ucp_proxy_ep_destroy, ucp_proxy_ep_t,
                                           uct_ep_t);
 
@@ -136,6 +144,8 @@ UCS_CLASS_INIT_FUNC(ucp_proxy_ep_t, const uct_iface_ops_t *ops, ucp_ep_h ucp_ep,
     UCP_PROXY_EP_SET_OP(ep_am_short_iov);
     UCP_PROXY_EP_SET_OP(ep_am_bcopy);
     UCP_PROXY_EP_SET_OP(ep_am_zcopy);
+    UCP_PROXY_EP_SET_OP(ep_am_batch_begin);
+    UCP_PROXY_EP_SET_OP(ep_am_batch_commit);
     UCP_PROXY_EP_SET_OP(ep_atomic_cswap64);
     UCP_PROXY_EP_SET_OP(ep_atomic_cswap32);
     UCP_PROXY_EP_SET_OP(ep_atomic64_post);
@@ -216,6 +216,7 @@ struct ucp_request {
                     ucs_queue_elem_t     queue_elem;
                     ucs_ptr_map_key_t    req_id;         /* sender's request ID */
                     ucp_rkey_h           rkey;           /* key for remote send buffer */
+                    int                  nontemporal;    /* copy with non-temporal access */
                 } rkey_ptr;
 
                 struct {
@@ -255,6 +256,8 @@ struct ucp_request {
                     ucp_rkey_h            rkey;        /* Remote memory key */
                     uint64_t              value;       /* Atomic argument */
                     uct_atomic_op_t       uct_op;      /* Requested UCT AMO */
+                    ucs_queue_elem_t      queue;       /* Elem in worker queue of
+                                                          atomics to batch */
                 } amo;
 
                 struct {
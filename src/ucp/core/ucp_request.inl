@@ -275,6 +275,49 @@ ucp_request_send(ucp_request_t *req, unsigned pending_flags)
     while (!ucp_request_try_send(req, pending_flags));
 }
 
+/**
+ * Start sending a request which was initialized by @ref ucp_request_send_start.
+ * If the request is fragmented to several active messages on the AM lane, the
+ * transport is allowed to publish the fragments together.
+ *
+ * @param [in]  req             Request to start.
+ * @param [in]  msg_config      Message configuration of the request.
+ * @param [in]  proto           Protocol of the request.
+ */
+static UCS_F_ALWAYS_INLINE void
+ucp_request_send_am_batch(ucp_request_t *req,
+                          const ucp_ep_msg_config_t *msg_config,
+                          const ucp_request_send_proto_t *proto)
+{
+    ucp_ep_h ep           = req->send.ep;
+    ucp_lane_index_t lane = ucp_ep_get_am_lane(ep);
+    size_t frag_size;
+    uct_ep_h uct_ep;
+
+    if (req->send.uct.func == proto->bcopy_multi) {
+        frag_size = msg_config->max_bcopy;
+    } else if (req->send.uct.func == proto->zcopy_multi) {
+        frag_size = msg_config->max_zcopy;
+    } else {
+        frag_size = 0;
+    }
+
+    if ((frag_size == 0) || (lane == UCP_NULL_LANE) ||
+        /* not connected yet, e.g. a client-server endpoint */
+        (ucp_ep_get_rsc_index(ep, lane) == UCP_NULL_RESOURCE) ||
+        !(ucp_ep_get_iface_attr(ep, lane)->cap.flags &
+          UCT_IFACE_FLAG_AM_BATCH)) {
+        ucp_request_send(req, 0);
+        return;
+    }
+
+    uct_ep = ep->uct_eps[lane];
+    uct_ep_am_batch_begin(uct_ep, ucs_div_round_up(req->send.length,
+                                                   frag_size));
+    ucp_request_send(req, 0);
+    uct_ep_am_batch_commit(uct_ep);
+}
+
 static UCS_F_ALWAYS_INLINE
 void ucp_request_send_generic_dt_finish(ucp_request_t *req)
 {
@@ -107,9 +107,16 @@ typedef enum {
     UCP_OP_ID_TAG_SEND_SYNC,
     UCP_OP_ID_PUT,
     UCP_OP_ID_GET,
+    UCP_OP_ID_AM_SEND,
+    UCP_OP_ID_AM_SEND_REPLY,
+    UCP_OP_ID_STREAM_SEND,
+    UCP_OP_ID_AMO_POST,
+    UCP_OP_ID_AMO_FETCH,
+    UCP_OP_ID_AMO_CSWAP,
     UCP_OP_ID_API_LAST,
 
     UCP_OP_ID_RNDV_RECV = UCP_OP_ID_API_LAST,
+    UCP_OP_ID_RNDV_SEND,
     UCP_OP_ID_LAST
 } ucp_operation_id_t;
 
@@ -152,6 +159,14 @@ typedef enum {
                                           defined AM */
     UCP_AM_ID_SINGLE_REPLY      =  26, /* Single fragment user defined AM
                                           carrying remote ep for reply */
+    UCP_AM_ID_STREAM_FIRST      =  27, /* First fragment of STREAM data sent by
+                                          multiple lanes */
+    UCP_AM_ID_STREAM_MIDDLE     =  28, /* Middle or last fragment of STREAM
+                                          data sent by multiple lanes */
+    UCP_AM_ID_ATOMIC_BATCH_REQ  =  29, /* Batch of remote memory atomic
+                                          requests */
+    UCP_AM_ID_ATOMIC_BATCH_REP  =  30, /* Reply to a batch of remote memory
+                                          atomic requests */
     UCP_AM_ID_LAST
 } ucp_am_id_t;
 
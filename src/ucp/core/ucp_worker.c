@@ -75,7 +75,8 @@ static ucs_stats_class_t ucp_worker_stats_class = {
         [UCP_WORKER_STAT_TAG_RX_RNDV_UNEXP]        = "rx_rndv_rts_unexp",
         [UCP_WORKER_STAT_TAG_RX_RNDV_GET_ZCOPY]    = "rx_rndv_get_zcopy",
         [UCP_WORKER_STAT_TAG_RX_RNDV_SEND_RTR]     = "rx_rndv_send_rtr",
-        [UCP_WORKER_STAT_TAG_RX_RNDV_RKEY_PTR]     = "rx_rndv_rkey_ptr"
+        [UCP_WORKER_STAT_TAG_RX_RNDV_RKEY_PTR]     = "rx_rndv_rkey_ptr",
+        [UCP_WORKER_STAT_TAG_RX_RNDV_RKEY_PTR_NT]  = "rx_rndv_rkey_ptr_nt"
     }
 };
 #endif
@@ -152,6 +153,7 @@ static void ucp_worker_set_am_handlers(ucp_worker_iface_t *wiface, int is_proxy)
 {
     ucp_worker_h worker   = wiface->worker;
     ucp_context_h context = worker->context;
+    uct_am_recv_direct_callback_t recv_direct_cb;
     ucs_status_t status;
     unsigned am_id;
 
@@ -178,6 +180,7 @@ static void ucp_worker_set_am_handlers(ucp_worker_iface_t *wiface, int is_proxy)
             continue;
         }
 
+        recv_direct_cb = ucp_am_handlers[am_id].recv_direct_cb;
         if (is_proxy && (ucp_am_handlers[am_id].proxy_cb != NULL)) {
             /* we care only about sync active messages, and this also makes sure
              * the counter is not accessed from another thread.
@@ -187,6 +190,8 @@ static void ucp_worker_set_am_handlers(ucp_worker_iface_t *wiface, int is_proxy)
                                               ucp_am_handlers[am_id].proxy_cb,
                                               wiface,
                                               ucp_am_handlers[am_id].flags);
+            /* messages received directly would bypass the proxy counter */
+            recv_direct_cb = NULL;
         } else {
             status = uct_iface_set_am_handler(wiface->iface, am_id,
                                               ucp_am_handlers[am_id].cb,
@@ -197,6 +202,17 @@ static void ucp_worker_set_am_handlers(ucp_worker_iface_t *wiface, int is_proxy)
             ucs_fatal("failed to set active message handler id %d: %s", am_id,
                       ucs_status_string(status));
         }
+
+        if (wiface->attr.cap.flags & UCT_IFACE_FLAG_AM_RECV_DIRECT) {
+            status = uct_iface_set_am_recv_direct_handler(
+                    wiface->iface, am_id,
+                    ucp_am_handlers[am_id].recv_direct_hdr_len,
+                    recv_direct_cb, worker);
+            if (status != UCS_OK) {
+                ucs_fatal("failed to set direct receive handler id %d: %s",
+                          am_id, ucs_status_string(status));
+            }
+        }
     }
 }
 
@@ -229,6 +245,11 @@ static void ucp_worker_remove_am_handlers(ucp_worker_h worker)
                 (void)uct_iface_set_am_handler(wiface->iface,
                                                am_id, ucp_stub_am_handler,
                                                worker, UCT_CB_FLAG_ASYNC);
+                if (wiface->attr.cap.flags & UCT_IFACE_FLAG_AM_RECV_DIRECT) {
+                    (void)uct_iface_set_am_recv_direct_handler(wiface->iface,
+                                                               am_id, 0, NULL,
+                                                               NULL);
+                }
             }
         }
     }
@@ -1727,6 +1748,19 @@ char *ucp_worker_print_used_tls(const ucp_ep_config_key_t *key,
     return info;
 }
 
+static ucs_status_t
+ucp_worker_mpool_tcache_enable(ucp_worker_h worker, ucs_mpool_t *mp)
+{
+    unsigned tcache_size = worker->context->config.ext.mpool_tcache_size;
+
+    /* Per-thread caches are useful only if several threads use the worker */
+    if (!(worker->flags & UCP_WORKER_FLAG_MT) || (tcache_size == 0)) {
+        return UCS_OK;
+    }
+
+    return ucs_mpool_tcache_enable(mp, tcache_size);
+}
+
 static ucs_status_t ucp_worker_init_mpools(ucp_worker_h worker)
 {
     size_t           max_mp_entry_size = 0;
@@ -1754,6 +1788,11 @@ static ucs_status_t ucp_worker_init_mpools(ucp_worker_h worker)
         goto err;
     }
 
+    status = ucp_worker_mpool_tcache_enable(worker, &worker->req_mp);
+    if (status != UCS_OK) {
+        goto err_req_mp_cleanup;
+    }
+
     /* Create memory pool for small rkeys */
     status = ucs_mpool_init(&worker->rkey_mp, 0,
                             sizeof(ucp_rkey_t) +
@@ -1764,6 +1803,11 @@ static ucs_status_t ucp_worker_init_mpools(ucp_worker_h worker)
         goto err_req_mp_cleanup;
     }
 
+    status = ucp_worker_mpool_tcache_enable(worker, &worker->rkey_mp);
+    if (status != UCS_OK) {
+        goto err_rkey_mp_cleanup;
+    }
+
     /* Create memory pool for incoming UCT messages without a UCT descriptor */
     status = ucs_mpool_init(&worker->am_mp, 0,
                             max_mp_entry_size + UCP_WORKER_HEADROOM_SIZE,
@@ -1773,6 +1817,11 @@ static ucs_status_t ucp_worker_init_mpools(ucp_worker_h worker)
         goto err_rkey_mp_cleanup;
     }
 
+    status = ucp_worker_mpool_tcache_enable(worker, &worker->am_mp);
+    if (status != UCS_OK) {
+        goto err_am_mp_cleanup;
+    }
+
     /* Create memory pool of bounce buffers */
     status = ucs_mpool_init(&worker->reg_mp, 0,
                             context->config.ext.seg_size + sizeof(ucp_mem_desc_t),
@@ -1827,7 +1876,7 @@ ucp_worker_get_ep_config(ucp_worker_h worker, const ucp_ep_config_key_t *key,
 {
     ucp_context_h context = worker->context;
     ucp_worker_cfg_index_t ep_cfg_index;
-    ucp_proto_select_short_t tag_short;
+    ucp_proto_select_short_t tag_short, am_short, stream_short;
     ucp_ep_config_t *ep_config;
     ucp_memtype_thresh_t *max_eager_short;
     ucs_status_t status;
@@ -1879,6 +1928,42 @@ ucp_worker_get_ep_config(ucp_worker_h worker, const ucp_ep_config_key_t *key,
 
         max_eager_short->memtype_off = tag_short.max_length_unknown_mem;
         max_eager_short->memtype_on  = tag_short.max_length_host_mem;
+
+        if (context->config.features & UCP_FEATURE_AM) {
+            /* Set threshold for short active message send */
+            ucp_proto_select_short_init(worker, &ep_config->proto_select,
+                                        ep_cfg_index, UCP_WORKER_CFG_INDEX_NULL,
+                                        UCP_OP_ID_AM_SEND, 0,
+                                        UCP_PROTO_FLAG_AM_SHORT, &am_short);
+            /* short protocol should be either disabled, or use key->am_lane */
+            ucs_assert((am_short.max_length_host_mem < 0) ||
+                       (am_short.lane == key->am_lane));
+        } else {
+            ucp_proto_select_short_disable(&am_short);
+        }
+
+        ep_config->am_u.max_eager_short.memtype_off =
+                am_short.max_length_unknown_mem;
+        ep_config->am_u.max_eager_short.memtype_on  =
+                am_short.max_length_host_mem;
+
+        if (context->config.features & UCP_FEATURE_STREAM) {
+            /* Set threshold for short stream send */
+            ucp_proto_select_short_init(worker, &ep_config->proto_select,
+                                        ep_cfg_index, UCP_WORKER_CFG_INDEX_NULL,
+                                        UCP_OP_ID_STREAM_SEND, 0,
+                                        UCP_PROTO_FLAG_AM_SHORT, &stream_short);
+            /* short protocol should be either disabled, or use key->am_lane */
+            ucs_assert((stream_short.max_length_host_mem < 0) ||
+                       (stream_short.lane == key->am_lane));
+        } else {
+            ucp_proto_select_short_disable(&stream_short);
+        }
+
+        ep_config->stream.max_eager_short.memtype_off =
+                stream_short.max_length_unknown_mem;
+        ep_config->stream.max_eager_short.memtype_on  =
+                stream_short.max_length_host_mem;
     }
 
     if (print_cfg) {
@@ -2023,6 +2108,7 @@ ucs_status_t ucp_worker_create(ucp_context_h context,
     worker->num_ifaces           = 0;
     worker->am_message_id        = ucs_generate_uuid(0);
     worker->rkey_ptr_cb_id       = UCS_CALLBACKQ_ID_NULL;
+    worker->amo_batch_cb_id      = UCS_CALLBACKQ_ID_NULL;
     worker->keepalive.cb_id      = UCS_CALLBACKQ_ID_NULL;
     worker->keepalive.last_round = 0;
     worker->keepalive.lane_map   = 0;
@@ -2030,8 +2116,10 @@ ucs_status_t ucp_worker_create(ucp_context_h context,
     worker->keepalive.iter_count = 0;
     ucp_worker_keepalive_reset(worker);
     ucs_queue_head_init(&worker->rkey_ptr_reqs);
+    ucs_queue_head_init(&worker->amo_batch_q);
     ucs_list_head_init(&worker->arm_ifaces);
     ucs_list_head_init(&worker->stream_ready_eps);
+    ucs_queue_head_init(&worker->stream_mid_q);
     ucs_list_head_init(&worker->all_eps);
     kh_init_inplace(ucp_worker_rkey_config, &worker->rkey_config_hash);
     kh_init_inplace(ucp_worker_discard_uct_ep_hash, &worker->discard_uct_ep_hash);
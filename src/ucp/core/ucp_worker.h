@@ -114,6 +114,7 @@ enum {
     UCP_WORKER_STAT_TAG_RX_RNDV_GET_ZCOPY,
     UCP_WORKER_STAT_TAG_RX_RNDV_SEND_RTR,
     UCP_WORKER_STAT_TAG_RX_RNDV_RKEY_PTR,
+    UCP_WORKER_STAT_TAG_RX_RNDV_RKEY_PTR_NT,
 
     UCP_WORKER_STAT_LAST
 };
@@ -237,6 +238,8 @@ typedef struct ucp_worker {
     void                             *user_data;          /* User-defined data */
     ucs_strided_alloc_t              ep_alloc;            /* Endpoint allocator */
     ucs_list_link_t                  stream_ready_eps;    /* List of EPs with received stream data */
+    ucs_queue_head_t                 stream_mid_q;        /* Queue of stream middle fragments, which
+                                                           * arrived before the first one */
     ucs_list_link_t                  all_eps;             /* List of all endpoints */
     ucs_conn_match_ctx_t             conn_match_ctx;      /* Endpoint-to-endpoint matching context */
     ucp_worker_iface_t               **ifaces;            /* Array of pointers to interfaces,
@@ -251,6 +254,9 @@ typedef struct ucp_worker {
     ucs_queue_head_t                 rkey_ptr_reqs;       /* Queue of submitted RKEY PTR requests that
                                                            * are in-progress */
     uct_worker_cb_id_t               rkey_ptr_cb_id;      /* RKEY PTR worker callback queue ID */
+    ucs_queue_head_t                 amo_batch_q;         /* Queue of software atomic requests
+                                                           * waiting to be sent in a batch */
+    uct_worker_cb_id_t               amo_batch_cb_id;     /* Atomic batch worker callback queue ID */
     ucp_tag_match_t                  tm;                  /* Tag-matching queues and offload info */
     ucs_array_t(ucp_am_cbs)          am;                  /* Array of AM callbacks and their data */
     uint64_t                         am_message_id;       /* For matching long AMs */
@@ -96,7 +96,7 @@ ucp_datatype_iter_init(ucp_context_h context, void *buffer, size_t count,
     } else {
         ucs_assert(dt_iter->dt_class == UCP_DATATYPE_GENERIC);
         ucp_datatype_generic_iter_init(context, buffer, count, datatype, dt_iter);
-        *sg_count = 1;
+        *sg_count = 0;
     }
 }
 
@@ -54,7 +54,9 @@ enum {
     UCP_PROTO_FLAG_PUT_SHORT = UCS_BIT(1), /* The protocol uses only uct_ep_put_short() */
     UCP_PROTO_FLAG_TAG_SHORT = UCS_BIT(2), /* The protocol uses only
                                               uct_ep_tag_eager_short() */
-    UCP_PROTO_FLAG_INVALID   = UCS_BIT(3)  /* The protocol is a placeholder */
+    UCP_PROTO_FLAG_INVALID   = UCS_BIT(3), /* The protocol is a placeholder */
+    UCP_PROTO_FLAG_RNDV_RTR  = UCS_BIT(4)  /* The protocol asks the remote peer
+                                              to send the data (RTR) */
 };
 
 
@@ -88,6 +88,21 @@ ucp_proto_request_zcopy_complete_success(ucp_request_t *req)
     return UCS_OK;
 }
 
+/* Message length which was used to select the protocol for the request */
+static UCS_F_ALWAYS_INLINE size_t
+ucp_proto_request_select_length(const ucp_request_t *req)
+{
+    ucp_operation_id_t op_id = req->send.proto_config->select_param.op_id;
+
+    if ((op_id == UCP_OP_ID_AM_SEND) || (op_id == UCP_OP_ID_AM_SEND_REPLY)) {
+        /* Active message user header is sent together with the data */
+        return req->send.state.dt_iter.length +
+               req->send.msg_proto.am.header_length;
+    }
+
+    return req->send.state.dt_iter.length;
+}
+
 /* Select protocol for the request and initialize protocol-related fields */
 static UCS_F_ALWAYS_INLINE ucs_status_t
 ucp_proto_request_set_proto(ucp_worker_h worker, ucp_ep_h ep,
@@ -133,7 +148,8 @@ ucp_proto_request_send_op(ucp_ep_h ep, ucp_proto_select_t *proto_select,
                           ucp_worker_cfg_index_t rkey_cfg_index,
                           ucp_request_t *req, ucp_operation_id_t op_id,
                           const void *buffer, size_t count, ucp_datatype_t datatype,
-                          size_t contig_length, const ucp_request_param_t *param)
+                          size_t contig_length, const ucp_request_param_t *param,
+                          size_t header_length, uint8_t op_flags)
 {
     ucp_worker_h worker     = ep->worker;
     ucp_proto_select_param_t sel_param;
@@ -149,10 +165,14 @@ ucp_proto_request_send_op(ucp_ep_h ep, ucp_proto_select_t *proto_select,
     ucp_proto_select_param_init(&sel_param, op_id, param->op_attr_mask,
                                 req->send.state.dt_iter.dt_class,
                                 &req->send.state.dt_iter.mem_info, sg_count);
+    sel_param.op_flags |= op_flags;
 
+    /* User header is sent together with the data, so take it into account when
+     * selecting the protocol */
     status = ucp_proto_request_set_proto(worker, ep, req, proto_select,
                                          rkey_cfg_index, &sel_param,
-                                         contig_length);
+                                         req->send.state.dt_iter.length +
+                                         header_length);
     if (status != UCS_OK) {
         goto out_put_request;
     }
@@ -49,7 +49,7 @@ static ucs_status_t ucp_proto_reconfig_select_progress(uct_pending_req_t *self)
     status = ucp_proto_request_set_proto(worker, ep, req, proto_select,
                                          rkey_cfg_index,
                                          &req->send.proto_config->select_param,
-                                         req->send.state.dt_iter.length);
+                                         ucp_proto_request_select_length(req));
     if (status != UCS_OK) {
         /* will try again later */
         return UCS_ERR_NO_RESOURCE;
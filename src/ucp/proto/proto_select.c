@@ -985,6 +985,14 @@ void ucp_proto_select_param_str(const ucp_proto_select_param_t *select_param,
         ucs_string_buffer_appendf(strb, ", fast-completion");
     }
 
+    if (select_param->op_flags & UCP_PROTO_SELECT_OP_FLAG_AM_EAGER) {
+        ucs_string_buffer_appendf(strb, ", eager");
+    }
+
+    if (select_param->op_flags & UCP_PROTO_SELECT_OP_FLAG_AM_RNDV) {
+        ucs_string_buffer_appendf(strb, ", rndv");
+    }
+
     ucs_string_buffer_appendf(strb, ")");
 }
 
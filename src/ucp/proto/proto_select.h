@@ -20,6 +20,19 @@
 #define UCP_PROTO_SELECT_OP_ATTR_MASK   UCP_OP_ATTR_FLAG_FAST_CMPL
 
 
+/**
+ * Operation flags which are not derived from ucp_request_param_t.op_attr_mask,
+ * but still affect protocol selection decision.
+ */
+enum {
+    /* Active message must be sent by an eager protocol */
+    UCP_PROTO_SELECT_OP_FLAG_AM_EAGER = UCS_BIT(6),
+
+    /* Active message must be sent by a rendezvous protocol */
+    UCP_PROTO_SELECT_OP_FLAG_AM_RNDV  = UCS_BIT(7)
+};
+
+
 /** Maximal length of ucp_proto_select_param_str() */
 #define UCP_PROTO_SELECT_PARAM_STR_MAX 128
 
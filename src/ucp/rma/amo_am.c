@@ -0,0 +1,432 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "rma.inl"
+
+#include <ucp/core/ucp_worker.h>
+#include <ucp/core/ucp_request.inl>
+#include <ucp/proto/proto_single.inl>
+#include <ucs/profile/profile.h>
+
+
+/* Maximal number of atomic operations sent in a single message */
+#define UCP_AMO_BATCH_MAX_COUNT UINT8_MAX
+
+
+typedef struct {
+    ucp_ep_h         ep;
+    size_t           max_length; /* Maximal size of the message */
+    ucs_queue_head_t post_q;     /* Packed operations which are completed
+                                    once the message is sent */
+} ucp_amo_batch_pack_ctx_t;
+
+
+static UCS_F_ALWAYS_INLINE size_t ucp_amo_batch_num_args(ucp_request_t *req)
+{
+    return (req->send.amo.uct_op == UCT_ATOMIC_OP_CSWAP) ? 2 : 1;
+}
+
+static size_t ucp_amo_batch_pack(void *dest, void *arg)
+{
+    ucp_amo_batch_pack_ctx_t *pack_ctx = arg;
+    ucp_worker_h worker                = pack_ctx->ep->worker;
+    ucp_atomic_batch_hdr_t *hdr        = dest;
+    size_t length                      = sizeof(*hdr);
+    ucp_atomic_batch_entry_t *entry;
+    size_t size, entry_length;
+    ucs_queue_iter_t iter;
+    ucp_request_t *req;
+    unsigned count;
+
+    count      = 0;
+    hdr->ep_id = ucp_ep_remote_id(pack_ctx->ep);
+
+    ucs_queue_for_each_safe(req, iter, &worker->amo_batch_q, send.amo.queue) {
+        if (req->send.ep != pack_ctx->ep) {
+            continue;
+        }
+
+        size         = req->send.state.dt_iter.length;
+        entry_length = sizeof(*entry) + (size * ucp_amo_batch_num_args(req));
+        if ((count == UCP_AMO_BATCH_MAX_COUNT) ||
+            ((length + entry_length) > pack_ctx->max_length)) {
+            break;
+        }
+
+        entry          = UCS_PTR_BYTE_OFFSET(dest, length);
+        entry->address = req->send.amo.remote_addr;
+        entry->req_id  = req->send.amo.sreq_id;
+        entry->length  = size;
+        entry->opcode  = req->send.amo.uct_op;
+        memcpy(entry + 1, &req->send.amo.value, size);
+        if (req->send.amo.uct_op == UCT_ATOMIC_OP_CSWAP) {
+            /* the swap argument is passed in the result buffer */
+            memcpy(UCS_PTR_BYTE_OFFSET(entry + 1, size),
+                   req->send.state.dt_iter.type.contig.buffer, size);
+        }
+
+        length += entry_length;
+        ++count;
+
+        /* Fetching operations are tracked by their request id from now on,
+         * since they may be completed by the reply even before
+         * uct_ep_am_bcopy() returns */
+        ucs_queue_del_iter(&worker->amo_batch_q, iter);
+        if (req->send.amo.sreq_id == UCP_REQUEST_ID_INVALID) {
+            ucs_queue_push(&pack_ctx->post_q, &req->send.amo.queue);
+        }
+    }
+
+    ucs_assert(count > 0);
+    hdr->count = count;
+    return length;
+}
+
+static void ucp_amo_batch_purge(ucp_ep_h ep, ucs_status_t status, int ep_valid)
+{
+    ucp_worker_h worker = ep->worker;
+    ucs_queue_head_t purged_q;
+    ucs_queue_iter_t iter;
+    ucp_request_t *req;
+
+    ucs_queue_head_init(&purged_q);
+    ucs_queue_for_each_safe(req, iter, &worker->amo_batch_q, send.amo.queue) {
+        if (req->send.ep == ep) {
+            ucs_queue_del_iter(&worker->amo_batch_q, iter);
+            ucs_queue_push(&purged_q, &req->send.amo.queue);
+        }
+    }
+
+    ucs_queue_for_each_extract(req, &purged_q, send.amo.queue, 1) {
+        if (req->send.amo.sreq_id != UCP_REQUEST_ID_INVALID) {
+            ucp_worker_del_request_id(worker, req, req->send.amo.sreq_id);
+        }
+
+        ucp_request_complete_send(req, status);
+        if (ep_valid) {
+            ucp_ep_rma_remote_request_completed(ep);
+        } else {
+            ucp_worker_flush_ops_count_dec(worker);
+        }
+    }
+}
+
+static ucs_status_t ucp_amo_batch_send(ucp_ep_h ep)
+{
+    ucp_lane_index_t lane = ucp_ep_get_am_lane(ep);
+    ucp_amo_batch_pack_ctx_t pack_ctx;
+    ssize_t packed_len;
+    ucp_request_t *req;
+
+    pack_ctx.ep         = ep;
+    pack_ctx.max_length = ucp_ep_config(ep)->am.max_bcopy;
+    ucs_queue_head_init(&pack_ctx.post_q);
+
+    packed_len = uct_ep_am_bcopy(ep->uct_eps[lane], UCP_AM_ID_ATOMIC_BATCH_REQ,
+                                 ucp_amo_batch_pack, &pack_ctx, 0);
+    if (ucs_unlikely(packed_len < 0)) {
+        if (packed_len != UCS_ERR_NO_RESOURCE) {
+            ucp_amo_batch_purge(ep, (ucs_status_t)packed_len, 1);
+        }
+        return (ucs_status_t)packed_len;
+    }
+
+    ucs_queue_for_each_extract(req, &pack_ctx.post_q, send.amo.queue, 1) {
+        ucp_request_complete_send(req, UCS_OK);
+    }
+
+    return UCS_OK;
+}
+
+static unsigned ucp_amo_batch_progress(void *arg)
+{
+    ucp_worker_h worker = arg;
+    unsigned count      = 0;
+    ucp_request_t *req;
+    ucs_status_t status;
+
+    while (!ucs_queue_is_empty(&worker->amo_batch_q)) {
+        req    = ucs_queue_head_elem_non_empty(&worker->amo_batch_q,
+                                               ucp_request_t, send.amo.queue);
+        status = ucp_amo_batch_send(req->send.ep);
+        if (status == UCS_ERR_NO_RESOURCE) {
+            /* retry on the next progress */
+            break;
+        }
+
+        ++count;
+    }
+
+    if (ucs_queue_is_empty(&worker->amo_batch_q)) {
+        uct_worker_progress_unregister_safe(worker->uct,
+                                            &worker->amo_batch_cb_id);
+    }
+
+    return count;
+}
+
+void ucp_amo_ep_cleanup(ucp_ep_h ep)
+{
+    ucp_worker_h worker = ep->worker;
+
+    ucp_amo_batch_purge(ep, UCS_ERR_CANCELED, 0);
+    if (ucs_queue_is_empty(&worker->amo_batch_q)) {
+        uct_worker_progress_unregister_safe(worker->uct,
+                                            &worker->amo_batch_cb_id);
+    }
+}
+
+static ucs_status_t ucp_proto_amo_am_progress(uct_pending_req_t *self)
+{
+    ucp_request_t                   *req = ucs_container_of(self, ucp_request_t,
+                                                            send.uct);
+    ucp_ep_h ep                          = req->send.ep;
+    ucp_worker_h worker                  = ep->worker;
+    const ucp_proto_single_priv_t *spriv = req->send.proto_config->priv;
+    ucs_status_t status;
+
+    if (!(req->flags & UCP_REQUEST_FLAG_PROTO_INITIALIZED)) {
+        status = ucp_ep_resolve_remote_id(ep, spriv->super.lane);
+        if (status != UCS_OK) {
+            return status;
+        }
+
+        if (!(ep->flags & UCP_EP_FLAG_REMOTE_ID)) {
+            /* wait on the wireup endpoint until the connection is
+             * established, since the batch may be sent only to a known peer */
+            req->send.lane = spriv->super.lane;
+            return UCS_ERR_NO_RESOURCE;
+        }
+
+        req->send.amo.sreq_id =
+                (req->send.proto_config->select_param.op_id ==
+                 UCP_OP_ID_AMO_POST) ? UCP_REQUEST_ID_INVALID :
+                                       ucp_send_request_get_id(req);
+        req->flags           |= UCP_REQUEST_FLAG_PROTO_INITIALIZED;
+    }
+
+    /* The operation is sent from the progress, together with other operations
+     * to the same peer which are issued until then. It is accounted as sent
+     * already, so flush would wait for its completion. */
+    ucp_worker_flush_ops_count_inc(worker);
+    ucp_ep_rma_remote_request_sent(ep);
+    ucs_queue_push(&worker->amo_batch_q, &req->send.amo.queue);
+    uct_worker_progress_register_safe(worker->uct, ucp_amo_batch_progress,
+                                      worker, 0, &worker->amo_batch_cb_id);
+    return UCS_OK;
+}
+
+static ucs_status_t
+ucp_proto_amo_am_init(const ucp_proto_init_params_t *init_params)
+{
+    ucp_proto_single_init_params_t params = {
+        .super.super         = *init_params,
+        .super.latency       = 0,
+        .super.overhead      = 40e-9,
+        .super.cfg_thresh    = UCS_MEMUNITS_AUTO,
+        .super.cfg_priority  = 0,
+        .super.min_frag_offs = UCP_PROTO_COMMON_OFFSET_INVALID,
+        .super.max_frag_offs = ucs_offsetof(uct_iface_attr_t, cap.am.max_bcopy),
+        .super.hdr_size      = sizeof(ucp_atomic_batch_hdr_t) +
+                               sizeof(ucp_atomic_batch_entry_t) +
+                               (2 * sizeof(uint64_t)),
+        .super.flags         = UCP_PROTO_COMMON_INIT_FLAG_MAX_FRAG,
+        .lane_type           = UCP_LANE_TYPE_AM,
+        .tl_cap_flags        = UCT_IFACE_FLAG_AM_BCOPY
+    };
+
+    UCP_AMO_PROTO_INIT_CHECK(init_params);
+
+    if (!ucp_proto_amo_cpu_atomics_allowed(init_params)) {
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    if (init_params->select_param->op_id != UCP_OP_ID_AMO_POST) {
+        params.super.flags |= UCP_PROTO_COMMON_INIT_FLAG_RESPONSE;
+    }
+
+    return ucp_proto_single_init(&params);
+}
+
+static ucp_proto_t ucp_amo_am_proto = {
+    .name       = "amo/am/bcopy",
+    .flags      = 0,
+    .init       = ucp_proto_amo_am_init,
+    .config_str = ucp_proto_single_config_str,
+    .progress   = ucp_proto_amo_am_progress
+};
+UCP_PROTO_REGISTER(&ucp_amo_am_proto);
+
+static size_t ucp_amo_batch_pack_reply(void *dest, void *arg)
+{
+    ucp_request_t *req = arg;
+
+    memcpy(dest, req->send.buffer, req->send.length);
+    return req->send.length;
+}
+
+static ucs_status_t ucp_amo_batch_progress_reply(uct_pending_req_t *self)
+{
+    ucp_request_t *req = ucs_container_of(self, ucp_request_t, send.uct);
+    ucp_ep_t *ep       = req->send.ep;
+    ssize_t packed_len;
+
+    req->send.lane = ucp_ep_get_am_lane(ep);
+    packed_len     = uct_ep_am_bcopy(ep->uct_eps[req->send.lane],
+                                     UCP_AM_ID_ATOMIC_BATCH_REP,
+                                     ucp_amo_batch_pack_reply, req, 0);
+    if (packed_len < 0) {
+        return (ucs_status_t)packed_len;
+    }
+
+    ucs_assert(packed_len == req->send.length);
+    ucs_free(req->send.buffer);
+    ucp_request_put(req);
+    return UCS_OK;
+}
+
+UCS_PROFILE_FUNC(ucs_status_t, ucp_atomic_batch_req_handler,
+                 (arg, data, length, am_flags), void *arg, void *data,
+                 size_t length, unsigned am_flags)
+{
+    ucp_atomic_batch_hdr_t *hdr     = data;
+    ucp_worker_h worker             = arg;
+    ucp_atomic_batch_entry_t *entry = (ucp_atomic_batch_entry_t*)(hdr + 1);
+    ucp_atomic_batch_rep_hdr_t *rep_hdr;
+    ucp_atomic_batch_result_t *rep_result;
+    ucp_atomic_reply_t result;
+    size_t size, num_args;
+    ucp_request_t *req;
+    unsigned i;
+    ucp_ep_h ep;
+    int fetch;
+
+    /* allow getting closed EP to be used for sending a completion or AMO data
+     * to enable flush on a peer
+     */
+    UCP_WORKER_GET_EP_BY_ID(&ep, worker, hdr->ep_id, return UCS_OK,
+                            "SW AMO batch request");
+
+    req = ucp_request_get(worker);
+    if (req == NULL) {
+        ucs_error("failed to allocate atomic batch reply");
+        return UCS_OK;
+    }
+
+    rep_hdr = ucs_malloc(sizeof(*rep_hdr) + (hdr->count * sizeof(*rep_result)),
+                         "atomic_batch_reply");
+    if (rep_hdr == NULL) {
+        ucs_error("failed to allocate atomic batch reply data");
+        ucp_request_put(req);
+        return UCS_OK;
+    }
+
+    rep_hdr->ep_id       = ucp_ep_remote_id(ep);
+    rep_hdr->count       = hdr->count;
+    rep_hdr->num_results = 0;
+    rep_result           = (ucp_atomic_batch_result_t*)(rep_hdr + 1);
+
+    /* Operations are performed in the order they were issued */
+    for (i = 0; i < hdr->count; ++i) {
+        size     = entry->length;
+        fetch    = entry->req_id != UCP_REQUEST_ID_INVALID;
+        num_args = (entry->opcode == UCT_ATOMIC_OP_CSWAP) ? 2 : 1;
+        ucp_amo_cpu_do_op(entry->opcode, size, fetch, (void*)entry->address,
+                          entry + 1, UCS_PTR_BYTE_OFFSET(entry + 1, size),
+                          &result);
+        if (fetch) {
+            rep_result->req_id = entry->req_id;
+            rep_result->data   = result;
+            ++rep_result;
+            ++rep_hdr->num_results;
+        }
+
+        entry = UCS_PTR_BYTE_OFFSET(entry + 1, size * num_args);
+    }
+
+    req->flags         = 0;
+    req->send.ep       = ep;
+    req->send.buffer   = rep_hdr;
+    req->send.length   = UCS_PTR_BYTE_DIFF(rep_hdr, rep_result);
+    req->send.uct.func = ucp_amo_batch_progress_reply;
+    ucp_request_send(req, 0);
+
+    return UCS_OK;
+}
+
+UCS_PROFILE_FUNC(ucs_status_t, ucp_atomic_batch_rep_handler,
+                 (arg, data, length, am_flags), void *arg, void *data,
+                 size_t length, unsigned am_flags)
+{
+    ucp_atomic_batch_rep_hdr_t *hdr   = data;
+    ucp_worker_h worker               = arg;
+    ucp_atomic_batch_result_t *result = (ucp_atomic_batch_result_t*)(hdr + 1);
+    ucp_request_t *req;
+    unsigned i;
+    ucp_ep_h ep;
+
+    UCP_WORKER_GET_EP_BY_ID(&ep, worker, hdr->ep_id, return UCS_OK,
+                            "SW AMO batch reply");
+
+    for (i = 0; i < hdr->num_results; ++i, ++result) {
+        UCP_WORKER_EXTRACT_REQUEST_BY_ID(&req, worker, result->req_id, continue,
+                                         "ATOMIC_BATCH_REP %p", hdr);
+        memcpy(req->send.state.dt_iter.type.contig.buffer, &result->data,
+               req->send.state.dt_iter.length);
+        ucp_request_complete_send(req, UCS_OK);
+    }
+
+    for (i = 0; i < hdr->count; ++i) {
+        ucp_ep_rma_remote_request_completed(ep);
+    }
+
+    return UCS_OK;
+}
+
+static void ucp_amo_batch_dump_packet(ucp_worker_h worker,
+                                      uct_am_trace_type_t type, uint8_t id,
+                                      const void *data, size_t length,
+                                      char *buffer, size_t max)
+{
+    const ucp_atomic_batch_rep_hdr_t *reph;
+    const ucp_atomic_batch_hdr_t *hdr;
+    size_t header_len;
+    char *p;
+
+    switch (id) {
+    case UCP_AM_ID_ATOMIC_BATCH_REQ:
+        hdr = data;
+        snprintf(buffer, max, "ATOMIC_BATCH_REQ [ep_id 0x%"PRIx64" count %u]",
+                 hdr->ep_id, hdr->count);
+        header_len = sizeof(*hdr);
+        break;
+    case UCP_AM_ID_ATOMIC_BATCH_REP:
+        reph = data;
+        snprintf(buffer, max,
+                 "ATOMIC_BATCH_REP [ep_id 0x%"PRIx64" count %u results %u]",
+                 reph->ep_id, reph->count, reph->num_results);
+        header_len = sizeof(*reph);
+        break;
+    default:
+        return;
+    }
+
+    p = buffer + strlen(buffer);
+    ucp_dump_payload(worker->context, p, buffer + max - p,
+                     UCS_PTR_BYTE_OFFSET(data, header_len),
+                     length - header_len);
+}
+
+UCP_DEFINE_AM(UCP_FEATURE_AMO, UCP_AM_ID_ATOMIC_BATCH_REQ,
+              ucp_atomic_batch_req_handler, ucp_amo_batch_dump_packet, 0);
+UCP_DEFINE_AM(UCP_FEATURE_AMO, UCP_AM_ID_ATOMIC_BATCH_REP,
+              ucp_atomic_batch_rep_handler, ucp_amo_batch_dump_packet, 0);
+
+UCP_DEFINE_AM_PROXY(UCP_AM_ID_ATOMIC_BATCH_REQ);
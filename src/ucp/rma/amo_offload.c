@@ -0,0 +1,131 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "rma.inl"
+
+#include <ucp/core/ucp_request.inl>
+#include <ucp/proto/proto_single.inl>
+
+
+static void ucp_proto_amo_offload_completion(uct_completion_t *self)
+{
+    ucp_request_t *req = ucs_container_of(self, ucp_request_t,
+                                          send.state.uct_comp);
+
+    ucp_request_complete_send(req, self->status);
+}
+
+static UCS_F_ALWAYS_INLINE ucs_status_t
+ucp_proto_amo_offload_send(ucp_request_t *req, uct_ep_h uct_ep,
+                           uct_rkey_t tl_rkey)
+{
+    ucp_operation_id_t op_id = req->send.proto_config->select_param.op_id;
+    uct_atomic_op_t opcode   = req->send.amo.uct_op;
+    uint64_t remote_addr     = req->send.amo.remote_addr;
+    uint64_t value           = req->send.amo.value;
+    void *result             = req->send.state.dt_iter.type.contig.buffer;
+    uct_completion_t *comp   = &req->send.state.uct_comp;
+
+    if (req->send.state.dt_iter.length == sizeof(uint64_t)) {
+        switch (op_id) {
+        case UCP_OP_ID_AMO_POST:
+            return uct_ep_atomic64_post(uct_ep, opcode, value, remote_addr,
+                                        tl_rkey);
+        case UCP_OP_ID_AMO_FETCH:
+            return uct_ep_atomic64_fetch(uct_ep, opcode, value, result,
+                                         remote_addr, tl_rkey, comp);
+        default:
+            /* the swap argument is passed in the result buffer */
+            return uct_ep_atomic_cswap64(uct_ep, value, *(uint64_t*)result,
+                                         remote_addr, tl_rkey, result, comp);
+        }
+    }
+
+    ucs_assert(req->send.state.dt_iter.length == sizeof(uint32_t));
+    switch (op_id) {
+    case UCP_OP_ID_AMO_POST:
+        return uct_ep_atomic32_post(uct_ep, opcode, value, remote_addr,
+                                    tl_rkey);
+    case UCP_OP_ID_AMO_FETCH:
+        return uct_ep_atomic32_fetch(uct_ep, opcode, value, result,
+                                     remote_addr, tl_rkey, comp);
+    default:
+        return uct_ep_atomic_cswap32(uct_ep, value, *(uint32_t*)result,
+                                     remote_addr, tl_rkey, result, comp);
+    }
+}
+
+static ucs_status_t ucp_proto_amo_offload_progress(uct_pending_req_t *self)
+{
+    ucp_request_t                   *req = ucs_container_of(self, ucp_request_t,
+                                                            send.uct);
+    const ucp_proto_single_priv_t *spriv = req->send.proto_config->priv;
+    ucp_rkey_h rkey                      = req->send.amo.rkey;
+    ucs_status_t status;
+
+    if (!(req->flags & UCP_REQUEST_FLAG_PROTO_INITIALIZED)) {
+        ucp_proto_completion_init(&req->send.state.uct_comp,
+                                  ucp_proto_amo_offload_completion);
+        req->flags |= UCP_REQUEST_FLAG_PROTO_INITIALIZED;
+    }
+
+    ucs_assert(spriv->super.rkey_index != UCP_NULL_RESOURCE);
+    status = ucp_proto_amo_offload_send(
+            req, req->send.ep->uct_eps[spriv->super.lane],
+            rkey->tl_rkey[spriv->super.rkey_index].rkey.rkey);
+    if (status == UCS_INPROGRESS) {
+        return UCS_OK;
+    } else if (ucs_unlikely(status == UCS_ERR_NO_RESOURCE)) {
+        req->send.lane = spriv->super.lane; /* for pending add */
+        return status;
+    }
+
+    ucp_request_complete_send(req, status);
+    return UCS_OK;
+}
+
+static ucs_status_t
+ucp_proto_amo_offload_init(const ucp_proto_init_params_t *init_params)
+{
+    ucp_operation_id_t op_id              = init_params->select_param->op_id;
+    ucp_proto_single_init_params_t params = {
+        .super.super         = *init_params,
+        .super.latency       = 0,
+        .super.overhead      = 0,
+        .super.cfg_thresh    = UCS_MEMUNITS_AUTO,
+        .super.cfg_priority  = 0,
+        .super.min_frag_offs = UCP_PROTO_COMMON_OFFSET_INVALID,
+        .super.max_frag_offs = UCP_PROTO_COMMON_OFFSET_INVALID,
+        .super.hdr_size      = 0,
+        .super.flags         = UCP_PROTO_COMMON_INIT_FLAG_RECV_ZCOPY |
+                               UCP_PROTO_COMMON_INIT_FLAG_REMOTE_ACCESS,
+        .lane_type           = UCP_LANE_TYPE_AMO,
+        .tl_cap_flags        = 0
+    };
+
+    UCP_AMO_PROTO_INIT_CHECK(init_params);
+
+    if (op_id != UCP_OP_ID_AMO_POST) {
+        params.super.flags |= UCP_PROTO_COMMON_INIT_FLAG_RESPONSE;
+    }
+
+    /* Atomic lanes are selected by wireup to support all atomic operations
+     * required by the context features, so no need to check the operation */
+    return ucp_proto_single_init(&params);
+}
+
+static ucp_proto_t ucp_amo_offload_proto = {
+    .name       = "amo/offload",
+    .flags      = 0,
+    .init       = ucp_proto_amo_offload_init,
+    .config_str = ucp_proto_single_config_str,
+    .progress   = ucp_proto_amo_offload_progress
+};
+UCP_PROTO_REGISTER(&ucp_amo_offload_proto);
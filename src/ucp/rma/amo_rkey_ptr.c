@@ -0,0 +1,95 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "rma.inl"
+
+#include <ucp/core/ucp_request.inl>
+#include <ucp/proto/proto_single.h>
+
+
+static ucs_status_t ucp_proto_amo_rkey_ptr_progress(uct_pending_req_t *self)
+{
+    ucp_request_t                   *req = ucs_container_of(self, ucp_request_t,
+                                                            send.uct);
+    const ucp_proto_single_priv_t *spriv = req->send.proto_config->priv;
+    ucp_operation_id_t op_id = req->send.proto_config->select_param.op_id;
+    size_t size              = req->send.state.dt_iter.length;
+    void *buffer             = req->send.state.dt_iter.type.contig.buffer;
+    ucp_tl_rkey_t *tl_rkey;
+    ucp_atomic_reply_t result;
+    ucs_status_t status;
+    void *ptr;
+
+    tl_rkey = &req->send.amo.rkey->tl_rkey[spriv->super.rkey_index];
+    status  = uct_rkey_ptr(tl_rkey->cmpt, &tl_rkey->rkey,
+                           req->send.amo.remote_addr, &ptr);
+    if (ucs_unlikely(status != UCS_OK)) {
+        ucp_request_complete_send(req, status);
+        return UCS_OK;
+    }
+
+    /* the swap argument is passed in the result buffer */
+    ucp_amo_cpu_do_op(req->send.amo.uct_op, size, op_id != UCP_OP_ID_AMO_POST,
+                      ptr, &req->send.amo.value, buffer, &result);
+    if (op_id != UCP_OP_ID_AMO_POST) {
+        memcpy(buffer, &result, size);
+    }
+
+    ucp_request_complete_send(req, UCS_OK);
+    return UCS_OK;
+}
+
+static ucs_status_t
+ucp_proto_amo_rkey_ptr_init(const ucp_proto_init_params_t *init_params)
+{
+    const ucp_ep_config_key_t *ep_config_key     = init_params->ep_config_key;
+    const ucp_rkey_config_key_t *rkey_config_key = init_params->rkey_config_key;
+    ucp_proto_single_priv_t *spriv               = init_params->priv;
+    ucp_proto_common_init_params_t params        = {
+        .super = *init_params
+    };
+    ucp_proto_caps_t *caps                       = init_params->caps;
+    ucp_lane_index_t lane;
+
+    UCP_AMO_PROTO_INIT_CHECK(init_params);
+
+    lane = ep_config_key->rkey_ptr_lane;
+    if ((lane == UCP_NULL_LANE) || (rkey_config_key == NULL) ||
+        !UCP_MEM_IS_HOST(rkey_config_key->mem_type) ||
+        !(rkey_config_key->md_map &
+          UCS_BIT(ep_config_key->lanes[lane].dst_md_index)) ||
+        !ucp_proto_amo_cpu_atomics_allowed(init_params)) {
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    *init_params->priv_size = sizeof(*spriv);
+    ucp_proto_common_lane_priv_init(&params, 0, lane, &spriv->super);
+    spriv->reg_md = UCP_NULL_RESOURCE;
+
+    /* The operation is performed by the CPU directly on the remote memory, so
+     * the cost is a single atomic instruction on a shared cache line */
+    caps->cfg_thresh           = UCS_MEMUNITS_AUTO;
+    caps->cfg_priority         = 0;
+    caps->min_length           = 0;
+    caps->num_ranges           = 1;
+    caps->ranges[0].max_length = SIZE_MAX;
+    caps->ranges[0].perf       = ucs_linear_func_make(50e-9, 0);
+
+    return UCS_OK;
+}
+
+static ucp_proto_t ucp_amo_rkey_ptr_proto = {
+    .name       = "amo/rkey_ptr",
+    .flags      = 0,
+    .init       = ucp_proto_amo_rkey_ptr_init,
+    .config_str = ucp_proto_single_config_str,
+    .progress   = ucp_proto_amo_rkey_ptr_progress
+};
+UCP_PROTO_REGISTER(&ucp_amo_rkey_ptr_proto);
@@ -14,6 +14,8 @@
 
 #include <ucp/core/ucp_mm.h>
 #include <ucp/core/ucp_ep.inl>
+#include <ucp/core/ucp_rkey.inl>
+#include <ucp/proto/proto_common.inl>
 #include <ucs/profile/profile.h>
 #include <ucs/debug/log.h>
 #include <ucs/sys/stubs.h>
@@ -154,7 +156,9 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_atomic_op_nbx,
                  size_t count, uint64_t remote_addr, ucp_rkey_h rkey,
                  const ucp_request_param_t *param)
 {
+    ucp_worker_h worker = ep->worker;
     ucs_status_ptr_t status_p;
+    ucp_operation_id_t op_id;
     ucs_status_t status;
     ucp_request_t *req;
     uint64_t value;
@@ -191,6 +195,36 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_atomic_op_nbx,
                   (param->op_attr_mask & UCP_OP_ATTR_FIELD_CALLBACK) ?
                   param->cb.send : NULL);
 
+    if (worker->context->config.ext.proto_enable) {
+        req = ucp_request_get_param(worker, param,
+                                    {status_p = UCS_STATUS_PTR(UCS_ERR_NO_MEMORY);
+                                    goto out;});
+        req->send.amo.uct_op      = ucp_uct_atomic_op_table[opcode];
+        req->send.amo.remote_addr = remote_addr;
+        req->send.amo.rkey        = rkey;
+        req->send.amo.value       = value;
+
+        if (!(param->op_attr_mask & UCP_OP_ATTR_FIELD_REPLY_BUFFER)) {
+            op_id = UCP_OP_ID_AMO_POST;
+        } else {
+            op_id  = (opcode == UCP_ATOMIC_OP_CSWAP) ? UCP_OP_ID_AMO_CSWAP :
+                                                       UCP_OP_ID_AMO_FETCH;
+            /* the result is written to the reply buffer, which also holds the
+             * swap argument of compare-swap */
+            buffer = param->reply_buffer;
+        }
+
+        status_p = ucp_proto_request_send_op(
+                ep, &ucp_rkey_config(worker, rkey)->proto_select,
+                rkey->cfg_index, req, op_id, buffer, 1, param->datatype,
+                op_size, param, 0, 0);
+        if ((op_id == UCP_OP_ID_AMO_POST) && UCS_PTR_IS_PTR(status_p)) {
+            ucp_request_release(status_p);
+            status_p = UCS_STATUS_PTR(UCS_OK);
+        }
+        goto out;
+    }
+
     status = UCP_RKEY_RESOLVE(rkey, ep, amo);
     if (status != UCS_OK) {
         status_p = UCS_STATUS_PTR(status);
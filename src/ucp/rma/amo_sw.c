@@ -11,7 +11,6 @@
 #include "rma.h"
 #include "rma.inl"
 
-#include <ucs/arch/atomic.h>
 #include <ucs/profile/profile.h>
 
 
@@ -137,65 +136,15 @@ static ucs_status_t ucp_progress_atomic_reply(uct_pending_req_t *self)
     return UCS_OK;
 }
 
-#define DEFINE_AMO_SW_OP(_bits) \
-    static void ucp_amo_sw_do_op##_bits(const ucp_atomic_req_hdr_t *atomicreqh) \
-    { \
-        uint##_bits##_t *ptr  = (void*)atomicreqh->address; \
-        uint##_bits##_t *args = (void*)(atomicreqh + 1); \
-        \
-       switch (atomicreqh->opcode) { \
-        case UCT_ATOMIC_OP_ADD: \
-            ucs_atomic_add##_bits(ptr, args[0]); \
-            break; \
-        case UCT_ATOMIC_OP_AND: \
-            ucs_atomic_and##_bits(ptr, args[0]); \
-            break; \
-        case UCT_ATOMIC_OP_OR: \
-            ucs_atomic_or##_bits(ptr, args[0]); \
-            break; \
-        case UCT_ATOMIC_OP_XOR: \
-            ucs_atomic_xor##_bits(ptr, args[0]); \
-            break; \
-        default: \
-            ucs_fatal("invalid opcode: %d", atomicreqh->opcode); \
-        } \
-    }
-
-#define DEFINE_AMO_SW_FOP(_bits) \
-    static void ucp_amo_sw_do_fop##_bits(const ucp_atomic_req_hdr_t *atomicreqh, \
-                                         ucp_atomic_reply_t *result) \
-    { \
-        uint##_bits##_t *ptr  = (void*)atomicreqh->address; \
-        uint##_bits##_t *args = (void*)(atomicreqh + 1); \
-        \
-        switch (atomicreqh->opcode) { \
-        case UCT_ATOMIC_OP_ADD: \
-            result->reply##_bits = ucs_atomic_fadd##_bits(ptr, args[0]); \
-            break; \
-        case UCT_ATOMIC_OP_AND: \
-            result->reply##_bits = ucs_atomic_fand##_bits(ptr, args[0]); \
-            break; \
-        case UCT_ATOMIC_OP_OR: \
-            result->reply##_bits = ucs_atomic_for##_bits(ptr, args[0]); \
-            break; \
-        case UCT_ATOMIC_OP_XOR: \
-            result->reply##_bits = ucs_atomic_fxor##_bits(ptr, args[0]); \
-            break; \
-        case UCT_ATOMIC_OP_SWAP: \
-            result->reply##_bits = ucs_atomic_swap##_bits(ptr, args[0]); \
-            break; \
-        case UCT_ATOMIC_OP_CSWAP: \
-            result->reply##_bits = ucs_atomic_cswap##_bits(ptr, args[0], args[1]); \
-            break; \
-        default: \
-            ucs_fatal("invalid opcode: %d", atomicreqh->opcode); \
-        } \
-    }
+static void ucp_amo_sw_do_op(const ucp_atomic_req_hdr_t *atomicreqh, int fetch,
+                             ucp_atomic_reply_t *result)
+{
+    const void *args = atomicreqh + 1;
 
-DEFINE_AMO_SW_OP(32)
-DEFINE_AMO_SW_OP(64)
-DEFINE_AMO_SW_FOP(32)
-DEFINE_AMO_SW_FOP(64)
+    ucp_amo_cpu_do_op(atomicreqh->opcode, atomicreqh->length, fetch,
+                      (void*)atomicreqh->address, args,
+                      UCS_PTR_BYTE_OFFSET(args, atomicreqh->length), result);
+}
 
 UCS_PROFILE_FUNC(ucs_status_t, ucp_atomic_req_handler, (arg, data, length, am_flags),
                  void *arg, void *data, size_t length, unsigned am_flags)
@@ -225,16 +174,7 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_atomic_req_handler, (arg, data, length, am_fl
 
     if (atomicreqh->req.req_id == UCP_REQUEST_ID_INVALID) {
         /* atomic operation without result */
-        switch (atomicreqh->length) {
-        case sizeof(uint32_t):
-            ucp_amo_sw_do_op32(atomicreqh);
-            break;
-        case sizeof(uint64_t):
-            ucp_amo_sw_do_op64(atomicreqh);
-            break;
-        default:
-            ucs_fatal("invalid atomic length: %u", atomicreqh->length);
-        }
+        ucp_amo_sw_do_op(atomicreqh, 0, NULL);
         ucp_rma_sw_send_cmpl(ep);
     } else {
         /* atomic operation with result */
@@ -244,16 +184,7 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_atomic_req_handler, (arg, data, length, am_fl
             return UCS_OK;
         }
 
-        switch (atomicreqh->length) {
-        case sizeof(uint32_t):
-            ucp_amo_sw_do_fop32(atomicreqh, &req->send.atomic_reply.data);
-            break;
-        case sizeof(uint64_t):
-            ucp_amo_sw_do_fop64(atomicreqh, &req->send.atomic_reply.data);
-            break;
-        default:
-            ucs_fatal("invalid atomic length: %u", atomicreqh->length);
-        }
+        ucp_amo_sw_do_op(atomicreqh, 1, &req->send.atomic_reply.data);
 
         req->flags                    = 0;
         req->send.ep                  = ep;
@@ -76,6 +76,33 @@ typedef struct {
 } UCS_S_PACKED ucp_atomic_req_hdr_t;
 
 
+typedef struct {
+    uint64_t                  ep_id;
+    uint8_t                   count;   /* Number of atomic operations */
+} UCS_S_PACKED ucp_atomic_batch_hdr_t;
+
+
+typedef struct {
+    uint64_t                  address;
+    uint64_t                  req_id;  /* invalid req_id if no reply */
+    uint8_t                   length;
+    uint8_t                   opcode;
+} UCS_S_PACKED ucp_atomic_batch_entry_t;
+
+
+typedef struct {
+    uint64_t                  ep_id;
+    uint8_t                   count;   /* Number of completed operations */
+    uint8_t                   num_results;
+} UCS_S_PACKED ucp_atomic_batch_rep_hdr_t;
+
+
+typedef struct {
+    uint64_t                  req_id;
+    ucp_atomic_reply_t        data;
+} UCS_S_PACKED ucp_atomic_batch_result_t;
+
+
 extern ucp_rma_proto_t ucp_rma_basic_proto;
 extern ucp_rma_proto_t ucp_rma_sw_proto;
 extern ucp_amo_proto_t ucp_amo_basic_proto;
@@ -90,6 +117,8 @@ void ucp_ep_flush_remote_completed(ucp_request_t *req);
 
 void ucp_rma_sw_send_cmpl(ucp_ep_h ep);
 
+void ucp_amo_ep_cleanup(ucp_ep_h ep);
+
 /*
  * Check RMA protocol requirements
  */
@@ -99,5 +128,15 @@ void ucp_rma_sw_send_cmpl(ucp_ep_h ep);
         return UCS_ERR_UNSUPPORTED; \
     }
 
+/*
+ * Check AMO protocol requirements
+ */
+#define UCP_AMO_PROTO_INIT_CHECK(_init_params) \
+    if (((_init_params)->select_param->op_id    <  UCP_OP_ID_AMO_POST) || \
+        ((_init_params)->select_param->op_id    >  UCP_OP_ID_AMO_CSWAP) || \
+        ((_init_params)->select_param->dt_class != UCP_DATATYPE_CONTIG)) { \
+        return UCS_ERR_UNSUPPORTED; \
+    }
+
 
 #endif
@@ -11,9 +11,97 @@
 
 #include <ucp/api/ucp.h>
 #include <ucp/core/ucp_request.inl>
+#include <ucp/proto/proto_common.h>
+#include <ucs/arch/atomic.h>
 #include <ucs/debug/log.h>
 
 
+/*
+ * The operands are passed by pointer and loaded separately for every opcode,
+ * as in the software atomic protocol wire format, since passing them by value
+ * through the switch may be miscompiled together with the inline assembly
+ * atomics by some GCC versions.
+ */
+#define UCP_AMO_CPU_DEFINE_OPS(_bits) \
+    static UCS_F_ALWAYS_INLINE void \
+    ucp_amo_cpu_post##_bits(uct_atomic_op_t opcode, uint##_bits##_t *ptr, \
+                            const uint##_bits##_t *value) \
+    { \
+        switch (opcode) { \
+        case UCT_ATOMIC_OP_ADD: \
+            ucs_atomic_add##_bits(ptr, *value); \
+            break; \
+        case UCT_ATOMIC_OP_AND: \
+            ucs_atomic_and##_bits(ptr, *value); \
+            break; \
+        case UCT_ATOMIC_OP_OR: \
+            ucs_atomic_or##_bits(ptr, *value); \
+            break; \
+        case UCT_ATOMIC_OP_XOR: \
+            ucs_atomic_xor##_bits(ptr, *value); \
+            break; \
+        default: \
+            ucs_fatal("invalid opcode: %d", opcode); \
+        } \
+    } \
+    \
+    static UCS_F_ALWAYS_INLINE uint##_bits##_t \
+    ucp_amo_cpu_fetch##_bits(uct_atomic_op_t opcode, uint##_bits##_t *ptr, \
+                             const uint##_bits##_t *value, \
+                             const uint##_bits##_t *swap) \
+    { \
+        switch (opcode) { \
+        case UCT_ATOMIC_OP_ADD: \
+            return ucs_atomic_fadd##_bits(ptr, *value); \
+        case UCT_ATOMIC_OP_AND: \
+            return ucs_atomic_fand##_bits(ptr, *value); \
+        case UCT_ATOMIC_OP_OR: \
+            return ucs_atomic_for##_bits(ptr, *value); \
+        case UCT_ATOMIC_OP_XOR: \
+            return ucs_atomic_fxor##_bits(ptr, *value); \
+        case UCT_ATOMIC_OP_SWAP: \
+            return ucs_atomic_swap##_bits(ptr, *value); \
+        case UCT_ATOMIC_OP_CSWAP: \
+            return ucs_atomic_cswap##_bits(ptr, *value, *swap); \
+        default: \
+            ucs_fatal("invalid opcode: %d", opcode); \
+        } \
+    }
+
+UCP_AMO_CPU_DEFINE_OPS(32)
+UCP_AMO_CPU_DEFINE_OPS(64)
+
+
+/*
+ * Perform an atomic operation on local memory by the CPU. For compare-swap,
+ * 'value' points to the compare argument and 'swap' to the value to store.
+ */
+static UCS_F_ALWAYS_INLINE void
+ucp_amo_cpu_do_op(uct_atomic_op_t opcode, size_t size, int fetch, void *ptr,
+                  const void *value, const void *swap,
+                  ucp_atomic_reply_t *result)
+{
+    switch (size) {
+    case sizeof(uint32_t):
+        if (fetch) {
+            result->reply32 = ucp_amo_cpu_fetch32(opcode, ptr, value, swap);
+        } else {
+            ucp_amo_cpu_post32(opcode, ptr, value);
+        }
+        break;
+    case sizeof(uint64_t):
+        if (fetch) {
+            result->reply64 = ucp_amo_cpu_fetch64(opcode, ptr, value, swap);
+        } else {
+            ucp_amo_cpu_post64(opcode, ptr, value);
+        }
+        break;
+    default:
+        ucs_fatal("invalid atomic length: %zu", size);
+    }
+}
+
+
 /* TODO: remove it after AMO API is implemented via NBX  */
 static UCS_F_ALWAYS_INLINE ucs_status_ptr_t
 ucp_rma_send_request_cb(ucp_request_t *req, ucp_send_callback_t cb)
@@ -126,6 +214,36 @@ ucp_rma_sw_do_am_bcopy(ucp_request_t *req, uint8_t id, ucp_lane_index_t lane,
     return (ucs_status_t)packed_len;
 }
 
+/*
+ * Atomics performed by the CPU are not atomic with respect to atomics performed
+ * by a network device. So the remote memory may be updated by the CPU only if
+ * it cannot be reached by an atomic lane of the device.
+ */
+static UCS_F_ALWAYS_INLINE int
+ucp_proto_amo_cpu_atomics_allowed(const ucp_proto_init_params_t *init_params)
+{
+    const ucp_ep_config_key_t *ep_config_key     = init_params->ep_config_key;
+    const ucp_rkey_config_key_t *rkey_config_key = init_params->rkey_config_key;
+    const uct_iface_attr_t *iface_attr;
+    ucp_lane_index_t lane;
+
+    for (lane = 0; lane < ep_config_key->num_lanes; ++lane) {
+        if (!(ep_config_key->lanes[lane].lane_types &
+              UCS_BIT(UCP_LANE_TYPE_AMO))) {
+            continue;
+        }
+
+        iface_attr = ucp_proto_common_get_iface_attr(init_params, lane);
+        if ((iface_attr->cap.flags & UCT_IFACE_FLAG_ATOMIC_DEVICE) &&
+            (rkey_config_key->md_map &
+             UCS_BIT(ep_config_key->lanes[lane].dst_md_index))) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
 static UCS_F_ALWAYS_INLINE uct_rkey_t
 ucp_rma_request_get_tl_rkey(ucp_request_t *req, ucp_md_index_t rkey_index)
 {
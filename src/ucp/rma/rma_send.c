@@ -272,7 +272,7 @@ ucs_status_ptr_t ucp_put_nbx(ucp_ep_h ep, const void *buffer, size_t count,
                                         &ucp_rkey_config(worker, rkey)->proto_select,
                                         rkey->cfg_index, req, UCP_OP_ID_PUT,
                                         buffer, count, ucp_dt_make_contig(1),
-                                        count, param);
+                                        count, param, 0, 0);
     } else {
         status = UCP_RKEY_RESOLVE(rkey, ep, rma);
         if (status != UCS_OK) {
@@ -372,7 +372,7 @@ ucs_status_ptr_t ucp_get_nbx(ucp_ep_h ep, void *buffer, size_t count,
                                         &ucp_rkey_config(worker, rkey)->proto_select,
                                         rkey->cfg_index, req, UCP_OP_ID_GET,
                                         buffer, count, ucp_dt_make_contig(1),
-                                        count, param);
+                                        count, param, 0, 0);
     } else {
         status = UCP_RKEY_RESOLVE(rkey, ep, rma);
         if (status != UCS_OK) {
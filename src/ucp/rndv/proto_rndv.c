@@ -23,9 +23,15 @@ ucp_proto_rndv_ctrl_reg_md_map(const ucp_proto_rndv_ctrl_init_params_t *params)
     ucp_md_index_t md_index;
     ucp_md_map_t reg_md_map;
     ucp_lane_index_t lane;
+    uint64_t tl_cap_flag;
 
-    /* md_map is all lanes which support get_zcopy on the given mem_type and
-     * require remote key
+    /* The remote peer either fetches the data from the local buffer (RTS), or
+     * writes the data to the local buffer (RTR) */
+    tl_cap_flag = (params->remote_op_id == UCP_OP_ID_RNDV_SEND) ?
+                  UCT_IFACE_FLAG_PUT_ZCOPY : UCT_IFACE_FLAG_GET_ZCOPY;
+
+    /* md_map is all lanes which support get_zcopy (or put_zcopy) on the given
+     * mem_type and require remote key
      */
     reg_md_map = 0;
     for (lane = 0; lane < ep_config_key->num_lanes; ++lane) {
@@ -33,10 +39,10 @@ ucp_proto_rndv_ctrl_reg_md_map(const ucp_proto_rndv_ctrl_init_params_t *params)
             continue;
         }
 
-        /* Check the lane supports get_zcopy */
+        /* Check the lane supports the remote memory access */
         iface_attr = ucp_proto_common_get_iface_attr(&params->super.super,
                                                      lane);
-        if (!(iface_attr->cap.flags & UCT_IFACE_FLAG_GET_ZCOPY)) {
+        if (!(iface_attr->cap.flags & tl_cap_flag)) {
             continue;
         }
 
@@ -148,7 +154,10 @@ ucp_proto_rndv_ctrl_init(const ucp_proto_rndv_ctrl_init_params_t *params)
 
     /* Initialize estimated memory registration map */
     md_map = ucp_proto_rndv_ctrl_reg_md_map(params);
-    if (md_map == 0) {
+    if ((md_map == 0) && (params->remote_op_id != UCP_OP_ID_RNDV_SEND)) {
+        /* The sender can fall back to active messages when the receive
+         * buffer is not registered, but the receiver must have a remote key
+         * to fetch the data */
         ucs_trace("registration map is 0, memory type %s",
                   ucs_memory_type_names[params->mem_info.type]);
         return UCS_ERR_UNSUPPORTED;
@@ -203,6 +212,45 @@ ucp_proto_rndv_ctrl_init(const ucp_proto_rndv_ctrl_init_params_t *params)
     return UCS_OK;
 }
 
+ucs_status_t
+ucp_proto_rndv_ctrl_am_lane_init(const ucp_proto_rndv_ctrl_init_params_t *params)
+{
+    ucp_context_h context             = params->super.super.worker->context;
+    ucp_proto_rndv_ctrl_priv_t *rpriv = params->super.super.priv;
+    ucp_proto_caps_t *caps            = params->super.super.caps;
+    const uct_iface_attr_t *iface_attr;
+    double ctrl_latency;
+
+    rpriv->lane = ucp_proto_common_find_am_bcopy_lane(&params->super.super);
+    if (rpriv->lane == UCP_NULL_LANE) {
+        return UCS_ERR_NO_ELEM;
+    }
+
+    rpriv->md_map                  = 0;
+    rpriv->packed_rkey_size        = 0;
+    rpriv->remote_proto.thresholds = NULL;
+
+    iface_attr  = ucp_proto_common_get_iface_attr(&params->super.super,
+                                                  rpriv->lane);
+    ctrl_latency = (iface_attr->overhead * 2) +
+                   ucp_tl_iface_latency(context, &iface_attr->latency);
+
+    /* RTS, RTR and ATS messages, and the data is copied to and from the AM
+     * fragments on both sides */
+    *params->super.super.priv_size = sizeof(*rpriv);
+    caps->cfg_thresh               = params->super.cfg_thresh;
+    caps->cfg_priority             = params->super.cfg_priority;
+    caps->min_length               = 0;
+    caps->num_ranges               = 1;
+    caps->ranges[0].max_length     = SIZE_MAX;
+    caps->ranges[0].perf           = ucs_linear_func_make(
+            3 * ctrl_latency,
+            (1.0 / ucp_proto_common_iface_bandwidth(&params->super,
+                                                    iface_attr)) +
+            (2.0 / context->config.ext.bcopy_bw));
+    return UCS_OK;
+}
+
 void ucp_proto_rndv_ctrl_config_str(size_t min_length, size_t max_length,
                                     const void *priv, ucs_string_buffer_t *strb)
 {
@@ -213,13 +261,23 @@ void ucp_proto_rndv_ctrl_config_str(size_t min_length, size_t max_length,
     ucp_md_index_t md_index;
     char str[64];
 
-    /* Print message lane and memory domains list */
-    ucs_string_buffer_appendf(strb, "am-ln:%d mds:{", rpriv->lane);
-    ucs_for_each_bit(md_index, rpriv->md_map) {
-        ucs_string_buffer_appendf(strb, "%d,", md_index);
+    ucs_string_buffer_appendf(strb, "am-ln:%d ", rpriv->lane);
+
+    if (rpriv->remote_proto.thresholds == NULL) {
+        /* Remote protocol is unknown, see ucp_proto_rndv_ctrl_am_lane_init() */
+        ucs_string_buffer_rtrim(strb, " ");
+        return;
+    }
+
+    /* Print memory domains list */
+    if (rpriv->md_map != 0) {
+        ucs_string_buffer_appendf(strb, "mds:{");
+        ucs_for_each_bit(md_index, rpriv->md_map) {
+            ucs_string_buffer_appendf(strb, "%d,", md_index);
+        }
+        ucs_string_buffer_rtrim(strb, ",");
+        ucs_string_buffer_appendf(strb, "} ");
     }
-    ucs_string_buffer_rtrim(strb, ",");
-    ucs_string_buffer_appendf(strb, "} ");
 
     /* Print estimated remote protocols for each message size */
     thresh_elem = rpriv->remote_proto.thresholds;
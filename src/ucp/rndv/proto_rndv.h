@@ -84,6 +84,17 @@ ucs_status_t
 ucp_proto_rndv_ctrl_init(const ucp_proto_rndv_ctrl_init_params_t *params);
 
 
+/*
+ * Initialize the control-message protocol when the remote protocol could not
+ * be estimated (for example, there are no transports which require a remote
+ * key). The transfer is estimated as the fragmented rendezvous over the AM
+ * lane, so it is selected only when rendezvous is forced by a threshold or by
+ * an operation flag.
+ */
+ucs_status_t
+ucp_proto_rndv_ctrl_am_lane_init(const ucp_proto_rndv_ctrl_init_params_t *params);
+
+
 void ucp_proto_rndv_ctrl_config_str(size_t min_length, size_t max_length,
                                     const void *priv,
                                     ucs_string_buffer_t *strb);
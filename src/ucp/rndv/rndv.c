@@ -16,7 +16,9 @@
 #include <ucp/tag/tag_rndv.h>
 #include <ucp/tag/tag_match.inl>
 #include <ucp/tag/offload.h>
+#include <ucp/stream/stream.h>
 #include <ucp/proto/proto_am.inl>
+#include <ucp/proto/proto_select.inl>
 #include <ucs/datastruct/queue.h>
 
 
@@ -289,6 +291,28 @@ void ucp_rndv_req_send_ack(ucp_request_t *ack_req, ucp_request_t *req,
     ucp_request_send(ack_req, 0);
 }
 
+void ucp_rndv_send_ats(ucp_worker_h worker,
+                       const ucp_rndv_rts_hdr_t *rndv_rts_hdr,
+                       ucs_status_t status)
+{
+    ucp_request_t *req;
+    ucp_ep_h ep;
+
+    UCP_WORKER_GET_EP_BY_ID(&ep, worker, rndv_rts_hdr->sreq.ep_id, return,
+                            "RNDV ATS");
+    req = ucp_request_get(worker);
+    if (ucs_unlikely(req == NULL)) {
+        ucs_error("failed to allocate request for RNDV ATS");
+        return;
+    }
+
+    req->send.ep = ep;
+    req->flags   = 0;
+
+    ucp_rndv_req_send_ack(req, NULL, rndv_rts_hdr->sreq.req_id, status,
+                          UCP_AM_ID_RNDV_ATS, "send_ats");
+}
+
 static UCS_F_ALWAYS_INLINE void
 ucp_rndv_recv_req_complete(ucp_request_t *req, ucs_status_t status)
 {
@@ -1174,15 +1198,26 @@ static unsigned ucp_rndv_progress_rkey_ptr(void *arg)
                                       rndv_req->send.length - rreq->recv.state.offset);
     ucs_status_t status;
     size_t offset, new_offset;
+    const void *src;
     int last;
 
     offset     = rreq->recv.state.offset;
     new_offset = offset + seg_size;
     last       = new_offset == rndv_req->send.length;
-    status     = ucp_request_recv_data_unpack(rreq,
-                                              UCS_PTR_BYTE_OFFSET(rndv_req->send.buffer,
-                                                                  offset),
-                                              seg_size, offset, last);
+    src        = UCS_PTR_BYTE_OFFSET(rndv_req->send.buffer, offset);
+    if (rndv_req->send.rkey_ptr.nontemporal) {
+        /* contiguous host buffer, which was checked to fit the whole message */
+        ucs_memcpy_nontemporal(UCS_PTR_BYTE_OFFSET(rreq->recv.buffer, offset),
+                               src, seg_size);
+        if (last) {
+            ucs_memory_cpu_store_fence();
+        }
+        status = UCS_OK;
+    } else {
+        status = ucp_request_recv_data_unpack(rreq, src, seg_size, offset,
+                                              last);
+    }
+
     if (ucs_unlikely(status != UCS_OK) || last) {
         ucs_queue_pull_non_empty(&worker->rkey_ptr_reqs);
         ucp_rndv_recv_req_complete(rreq, status);
@@ -1195,6 +1230,11 @@ static unsigned ucp_rndv_progress_rkey_ptr(void *arg)
         }
     } else {
         rreq->recv.state.offset = new_offset;
+        /* Move to the end of the queue, so concurrent rendezvous requests
+         * make progress in turns instead of waiting for this one to finish */
+        ucs_queue_pull_non_empty(&worker->rkey_ptr_reqs);
+        ucs_queue_push(&worker->rkey_ptr_reqs,
+                       &rndv_req->send.rkey_ptr.queue_elem);
     }
 
     return 1;
@@ -1262,7 +1302,18 @@ static void ucp_rndv_do_rkey_ptr(ucp_request_t *rndv_req, ucp_request_t *rreq,
     rndv_req->send.rkey_ptr.rkey   = rkey;
     rndv_req->send.rkey_ptr.req_id = rndv_rts_hdr->sreq.req_id;
 
+    /* Large messages would only evict the working set of other requests from
+     * the cache, so copy them with non-temporal access when possible */
+    rndv_req->send.rkey_ptr.nontemporal =
+            (rndv_rts_hdr->size >= worker->context->config.ext.rkey_ptr_nt_thresh) &&
+            (rndv_rts_hdr->size <= rreq->recv.length) &&
+            UCP_DT_IS_CONTIG(rreq->recv.datatype) &&
+            (rreq->recv.mem_type == UCS_MEMORY_TYPE_HOST);
+
     UCP_WORKER_STAT_RNDV(ep->worker, RKEY_PTR, 1);
+    if (rndv_req->send.rkey_ptr.nontemporal) {
+        UCP_WORKER_STAT_RNDV(ep->worker, RKEY_PTR_NT, 1);
+    }
 
     ucs_queue_push(&worker->rkey_ptr_reqs, &rndv_req->send.rkey_ptr.queue_elem);
     uct_worker_progress_register_safe(worker->uct,
@@ -1283,6 +1334,50 @@ ucp_rndv_test_zcopy_scheme_support(size_t length, size_t min_zcopy,
             /* or can the message be split? */ split);
 }
 
+/*
+ * When the new protocols are enabled, select between fetching the data from
+ * the sender (GET) and asking the sender to write it (RTR) according to the
+ * estimated performance of the protocols for this message size.
+ */
+static int ucp_rndv_is_rtr_selected(ucp_ep_h ep, ucp_request_t *rreq,
+                                    const ucp_rndv_rts_hdr_t *rndv_rts_hdr,
+                                    const void *rkey_buf)
+{
+    ucp_worker_h worker = ep->worker;
+    const ucp_proto_threshold_elem_t *thresh_elem;
+    ucp_proto_select_param_t select_param;
+    ucp_rkey_config_key_t rkey_config_key;
+    ucp_worker_cfg_index_t rkey_cfg_index;
+    ucs_memory_info_t mem_info;
+    ucs_status_t status;
+
+    if (!worker->context->config.ext.proto_enable) {
+        return 0;
+    }
+
+    rkey_config_key.ep_cfg_index = ep->cfg_index;
+    rkey_config_key.md_map       = ucp_rkey_packed_md_map(rkey_buf) &
+                                   ucp_ep_config(ep)->key.reachable_md_map;
+    rkey_config_key.mem_type     = ucp_rkey_packed_mem_type(rkey_buf);
+
+    status = ucp_worker_get_rkey_config(worker, &rkey_config_key,
+                                        &rkey_cfg_index);
+    if (status != UCS_OK) {
+        return 0;
+    }
+
+    mem_info.type    = rreq->recv.mem_type;
+    mem_info.sys_dev = UCS_SYS_DEVICE_ID_UNKNOWN;
+    ucp_proto_select_param_init(&select_param, UCP_OP_ID_RNDV_RECV, 0,
+                                UCP_DATATYPE_CONTIG, &mem_info, 1);
+
+    thresh_elem = ucp_proto_select_lookup(
+            worker, &worker->rkey_config[rkey_cfg_index].proto_select,
+            ep->cfg_index, rkey_cfg_index, &select_param, rndv_rts_hdr->size);
+    return (thresh_elem != NULL) &&
+           (thresh_elem->proto_config.proto->flags & UCP_PROTO_FLAG_RNDV_RTR);
+}
+
 UCS_PROFILE_FUNC_VOID(ucp_rndv_receive, (worker, rreq, rndv_rts_hdr, rkey_buf),
                       ucp_worker_h worker, ucp_request_t *rreq,
                       const ucp_rndv_rts_hdr_t *rndv_rts_hdr,
@@ -1350,7 +1445,8 @@ UCS_PROFILE_FUNC_VOID(ucp_rndv_receive, (worker, rreq, rndv_rts_hdr, rkey_buf),
         if ((rndv_rts_hdr->address != 0) &&
             ucp_rndv_test_zcopy_scheme_support(rndv_rts_hdr->size,
                                                get_zcopy->min, get_zcopy->max,
-                                               get_zcopy->split)) {
+                                               get_zcopy->split) &&
+            !ucp_rndv_is_rtr_selected(ep, rreq, rndv_rts_hdr, rkey_buf)) {
             /* try to fetch the data with a get_zcopy operation */
             status = ucp_rndv_req_send_rma_get(rndv_req, rreq, rndv_rts_hdr,
                                                rkey_buf);
@@ -1423,6 +1519,8 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_rndv_rts_handler,
 
     if (rts_hdr->flags & UCP_RNDV_RTS_FLAG_TAG) {
         return ucp_tag_rndv_process_rts(worker, rts_hdr, length, tl_flags);
+    } else if (rts_hdr->flags & UCP_RNDV_RTS_FLAG_STREAM) {
+        return ucp_stream_rndv_process_rts(arg, data, length, tl_flags);
     } else {
         ucs_assert(rts_hdr->flags & UCP_RNDV_RTS_FLAG_AM);
         return ucp_am_rndv_process_rts(arg, data, length, tl_flags);
@@ -1966,6 +2064,9 @@ static void ucp_rndv_dump(ucp_worker_h worker, uct_am_trace_type_t type,
             rkey_buf = am_rts + 1;
             ucs_string_buffer_appendf(&rts_info, "AM am_id %u",
                                       am_rts->am.am_id);
+        } else if (rndv_rts_hdr->flags & UCP_RNDV_RTS_FLAG_STREAM) {
+            rkey_buf = (void*)(rndv_rts_hdr + 1);
+            ucs_string_buffer_appendf(&rts_info, "STREAM");
         } else {
             ucs_assert(rndv_rts_hdr->flags & UCP_RNDV_RTS_FLAG_TAG);
 
@@ -2013,16 +2114,16 @@ static void ucp_rndv_dump(ucp_worker_h worker, uct_am_trace_type_t type,
     }
 }
 
-UCP_DEFINE_AM(UCP_FEATURE_TAG | UCP_FEATURE_AM, UCP_AM_ID_RNDV_RTS,
-              ucp_rndv_rts_handler, ucp_rndv_dump, 0);
-UCP_DEFINE_AM(UCP_FEATURE_TAG | UCP_FEATURE_AM, UCP_AM_ID_RNDV_ATS,
-              ucp_rndv_ats_handler, ucp_rndv_dump, 0);
-UCP_DEFINE_AM(UCP_FEATURE_TAG | UCP_FEATURE_AM, UCP_AM_ID_RNDV_ATP,
-              ucp_rndv_atp_handler, ucp_rndv_dump, 0);
-UCP_DEFINE_AM(UCP_FEATURE_TAG | UCP_FEATURE_AM, UCP_AM_ID_RNDV_RTR,
-              ucp_rndv_rtr_handler, ucp_rndv_dump, 0);
-UCP_DEFINE_AM(UCP_FEATURE_TAG | UCP_FEATURE_AM, UCP_AM_ID_RNDV_DATA,
-              ucp_rndv_data_handler, ucp_rndv_dump, 0);
+UCP_DEFINE_AM(UCP_FEATURE_TAG | UCP_FEATURE_AM | UCP_FEATURE_STREAM,
+              UCP_AM_ID_RNDV_RTS, ucp_rndv_rts_handler, ucp_rndv_dump, 0);
+UCP_DEFINE_AM(UCP_FEATURE_TAG | UCP_FEATURE_AM | UCP_FEATURE_STREAM,
+              UCP_AM_ID_RNDV_ATS, ucp_rndv_ats_handler, ucp_rndv_dump, 0);
+UCP_DEFINE_AM(UCP_FEATURE_TAG | UCP_FEATURE_AM | UCP_FEATURE_STREAM,
+              UCP_AM_ID_RNDV_ATP, ucp_rndv_atp_handler, ucp_rndv_dump, 0);
+UCP_DEFINE_AM(UCP_FEATURE_TAG | UCP_FEATURE_AM | UCP_FEATURE_STREAM,
+              UCP_AM_ID_RNDV_RTR, ucp_rndv_rtr_handler, ucp_rndv_dump, 0);
+UCP_DEFINE_AM(UCP_FEATURE_TAG | UCP_FEATURE_AM | UCP_FEATURE_STREAM,
+              UCP_AM_ID_RNDV_DATA, ucp_rndv_data_handler, ucp_rndv_dump, 0);
 
 UCP_DEFINE_AM_PROXY(UCP_AM_ID_RNDV_RTS);
 UCP_DEFINE_AM_PROXY(UCP_AM_ID_RNDV_ATS);
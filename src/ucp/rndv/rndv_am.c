@@ -0,0 +1,55 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "proto_rndv.h"
+
+#include <ucp/core/ucp_request.inl>
+
+
+static ucs_status_t
+ucp_proto_rndv_am_bcopy_init(const ucp_proto_init_params_t *init_params)
+{
+    ucp_context_t *context               = init_params->worker->context;
+    ucp_proto_multi_init_params_t params = {
+        .super.super         = *init_params,
+        .super.cfg_thresh    = UCS_MEMUNITS_AUTO,
+        .super.cfg_priority  = 0,
+        .super.flags         = UCP_PROTO_COMMON_INIT_FLAG_MEM_TYPE,
+        .super.overhead      = 10e-9, /* for multiple lanes management */
+        .super.latency       = 0,
+        .max_lanes           = context->config.ext.max_rndv_lanes,
+        .first.tl_cap_flags  = UCT_IFACE_FLAG_AM_BCOPY,
+        .super.min_frag_offs = UCP_PROTO_COMMON_OFFSET_INVALID,
+        .super.max_frag_offs = ucs_offsetof(uct_iface_attr_t,
+                                            cap.am.max_bcopy),
+        .first.lane_type     = UCP_LANE_TYPE_AM,
+        .super.hdr_size      = sizeof(ucp_rndv_data_hdr_t),
+        .middle.tl_cap_flags = UCT_IFACE_FLAG_AM_BCOPY,
+        .middle.lane_type    = UCP_LANE_TYPE_AM_BW
+    };
+
+    /* The sender falls back to active messages in any rendezvous mode, if
+     * the receive buffer cannot be accessed remotely */
+    if ((init_params->select_param->op_id != UCP_OP_ID_RNDV_SEND) ||
+        (init_params->select_param->dt_class != UCP_DATATYPE_CONTIG)) {
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    return ucp_proto_multi_init(&params);
+}
+
+static ucp_proto_t ucp_rndv_am_bcopy_proto = {
+    .name       = "rndv/am/bcopy",
+    .flags      = 0,
+    .init       = ucp_proto_rndv_am_bcopy_init,
+    .config_str = ucp_proto_multi_config_str,
+    .progress   = (uct_pending_callback_t)ucs_empty_function_do_assert
+};
+UCP_PROTO_REGISTER(&ucp_rndv_am_bcopy_proto);
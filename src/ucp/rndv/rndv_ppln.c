@@ -0,0 +1,140 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "proto_rndv.h"
+
+#include <ucp/core/ucp_ep.inl>
+#include <ucp/core/ucp_request.inl>
+
+
+/*
+ * Pipeline protocols transfer GPU memory which cannot be accessed by the
+ * network transports, by staging it through host memory fragments of
+ * RNDV_FRAG_SIZE. The fragments are copied to/from the user buffer by the
+ * memory type endpoint, while the previous fragment is being transferred.
+ */
+static ucs_status_t
+ucp_proto_rndv_ppln_init(const ucp_proto_init_params_t *init_params,
+                         ucp_operation_id_t op_id, uint64_t tl_cap_flags,
+                         ptrdiff_t min_frag_offs, ptrdiff_t max_frag_offs)
+{
+    ucp_worker_h worker                  = init_params->worker;
+    ucp_context_t *context               = worker->context;
+    ucs_memory_type_t mem_type           = init_params->select_param->mem_type;
+    ucp_proto_caps_t *caps               = init_params->caps;
+    ucp_proto_multi_init_params_t params = {
+        .super.super         = *init_params,
+        .super.cfg_thresh    = UCS_MEMUNITS_AUTO,
+        .super.cfg_priority  = 0,
+        .super.flags         = UCP_PROTO_COMMON_INIT_FLAG_SEND_ZCOPY |
+                               UCP_PROTO_COMMON_INIT_FLAG_RECV_ZCOPY |
+                               UCP_PROTO_COMMON_INIT_FLAG_REMOTE_ACCESS,
+        .super.overhead      = 0,
+        .super.latency       = 0,
+        .max_lanes           = context->config.ext.max_rndv_lanes,
+        .first.tl_cap_flags  = tl_cap_flags,
+        .super.min_frag_offs = min_frag_offs,
+        .super.max_frag_offs = max_frag_offs,
+        .first.lane_type     = UCP_LANE_TYPE_RMA_BW,
+        .super.hdr_size      = 0,
+        .middle.tl_cap_flags = tl_cap_flags,
+        .middle.lane_type    = UCP_LANE_TYPE_RMA_BW
+    };
+    ucp_proto_select_param_t frag_select_param;
+    const uct_iface_attr_t *iface_attr;
+    ucs_linear_func_t copy_time;
+    ucs_linear_func_t *perf;
+    ucp_lane_index_t lane;
+    ucp_ep_h mem_type_ep;
+    ucs_status_t status;
+    unsigned i;
+
+    UCP_PROTO_RNDV_CHECK_PARAMS(init_params, op_id, UCP_RNDV_MODE_AUTO);
+
+    if (!UCP_MEM_IS_GPU(mem_type)) {
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    mem_type_ep = worker->mem_type_ep[mem_type];
+    if (mem_type_ep == NULL) {
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    lane = ucp_ep_config(mem_type_ep)->key.rma_bw_lanes[0];
+    if (lane == UCP_NULL_LANE) {
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    /* The network transfer is done from/to host memory fragments */
+    frag_select_param               = *init_params->select_param;
+    frag_select_param.mem_type      = UCS_MEMORY_TYPE_HOST;
+    frag_select_param.sys_dev       = UCS_SYS_DEVICE_ID_UNKNOWN;
+    params.super.super.select_param = &frag_select_param;
+
+    status = ucp_proto_rndv_bulk_init(&params);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    /* Copying the first fragment is not overlapped with the network transfer,
+     * and the rest is limited by the slower of the copy and the transfer */
+    iface_attr = ucp_ep_get_iface_attr(mem_type_ep, lane);
+    copy_time  = ucs_linear_func_make(
+            iface_attr->overhead,
+            1.0 / ucp_tl_iface_bandwidth(context, &iface_attr->bandwidth));
+    for (i = 0; i < caps->num_ranges; ++i) {
+        perf     = &caps->ranges[i].perf;
+        perf->c += ucs_linear_func_apply(copy_time,
+                                         context->config.ext.rndv_frag_size);
+        perf->m  = ucs_max(perf->m, copy_time.m);
+    }
+
+    return UCS_OK;
+}
+
+static ucs_status_t
+ucp_proto_rndv_get_ppln_init(const ucp_proto_init_params_t *init_params)
+{
+    return ucp_proto_rndv_ppln_init(init_params, UCP_OP_ID_RNDV_RECV,
+                                    UCT_IFACE_FLAG_GET_ZCOPY,
+                                    ucs_offsetof(uct_iface_attr_t,
+                                                 cap.get.min_zcopy),
+                                    ucs_offsetof(uct_iface_attr_t,
+                                                 cap.get.max_zcopy));
+}
+
+static ucp_proto_t ucp_rndv_get_ppln_proto = {
+    .name       = "rndv/get/ppln",
+    .flags      = 0,
+    .init       = ucp_proto_rndv_get_ppln_init,
+    .config_str = ucp_proto_rndv_bulk_config_str,
+    .progress   = (uct_pending_callback_t)ucs_empty_function_do_assert
+};
+UCP_PROTO_REGISTER(&ucp_rndv_get_ppln_proto);
+
+static ucs_status_t
+ucp_proto_rndv_put_ppln_init(const ucp_proto_init_params_t *init_params)
+{
+    return ucp_proto_rndv_ppln_init(init_params, UCP_OP_ID_RNDV_SEND,
+                                    UCT_IFACE_FLAG_PUT_ZCOPY,
+                                    ucs_offsetof(uct_iface_attr_t,
+                                                 cap.put.min_zcopy),
+                                    ucs_offsetof(uct_iface_attr_t,
+                                                 cap.put.max_zcopy));
+}
+
+static ucp_proto_t ucp_rndv_put_ppln_proto = {
+    .name       = "rndv/put/ppln",
+    .flags      = 0,
+    .init       = ucp_proto_rndv_put_ppln_init,
+    .config_str = ucp_proto_rndv_bulk_config_str,
+    .progress   = (uct_pending_callback_t)ucs_empty_function_do_assert
+};
+UCP_PROTO_REGISTER(&ucp_rndv_put_ppln_proto);
@@ -0,0 +1,45 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "proto_rndv.h"
+
+#include <ucp/core/ucp_request.inl>
+
+
+static ucs_status_t
+ucp_proto_rndv_rtr_init(const ucp_proto_init_params_t *init_params)
+{
+    ucp_proto_rndv_ctrl_init_params_t params = {
+        .super.super        = *init_params,
+        .super.latency      = 0,
+        .super.overhead     = 40e-9,
+        .super.cfg_thresh   = UCS_MEMUNITS_AUTO,
+        .super.cfg_priority = 0,
+        .super.flags        = UCP_PROTO_COMMON_INIT_FLAG_RESPONSE,
+        .remote_op_id       = UCP_OP_ID_RNDV_SEND,
+        .perf_bias          = 0.0,
+        .mem_info.type      = init_params->select_param->mem_type,
+        .mem_info.sys_dev   = init_params->select_param->sys_dev
+    };
+
+    UCP_PROTO_RNDV_CHECK_PARAMS(init_params, UCP_OP_ID_RNDV_RECV,
+                                UCP_RNDV_MODE_PUT_ZCOPY);
+
+    return ucp_proto_rndv_ctrl_init(&params);
+}
+
+static ucp_proto_t ucp_rndv_rtr_proto = {
+    .name       = "rndv/rtr",
+    .flags      = UCP_PROTO_FLAG_RNDV_RTR,
+    .init       = ucp_proto_rndv_rtr_init,
+    .config_str = ucp_proto_rndv_ctrl_config_str,
+    .progress   = (uct_pending_callback_t)ucs_empty_function_do_assert
+};
+UCP_PROTO_REGISTER(&ucp_rndv_rtr_proto);
@@ -17,6 +17,22 @@ typedef struct {
 } UCS_S_PACKED ucp_stream_am_hdr_t;
 
 
+typedef struct {
+    ucp_stream_am_hdr_t      super;
+    uint64_t                 msg_id;     /* Message ID, to match the middle
+                                            fragments */
+    size_t                   total_len;  /* Total length of the message */
+} UCS_S_PACKED ucp_stream_first_hdr_t;
+
+
+typedef struct {
+    ucp_stream_am_hdr_t      super;
+    uint64_t                 msg_id;     /* Message ID */
+    size_t                   offset;     /* Offset of the fragment data in the
+                                            message */
+} UCS_S_PACKED ucp_stream_mid_hdr_t;
+
+
 typedef struct {
     union {
         ucp_stream_am_hdr_t  hdr;
@@ -31,6 +47,9 @@ void ucp_stream_ep_cleanup(ucp_ep_h ep);
 
 void ucp_stream_ep_activate(ucp_ep_h ep);
 
+ucs_status_t ucp_stream_rndv_process_rts(void *arg, void *data, size_t length,
+                                         unsigned tl_flags);
+
 
 static UCS_F_ALWAYS_INLINE int ucp_stream_ep_is_queued(ucp_ep_ext_proto_t *ep_ext)
 {
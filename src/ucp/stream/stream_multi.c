@@ -0,0 +1,216 @@
+/**
+ * Copyright (C) Mellanox Technologies Ltd. 2021.  ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "stream.h"
+
+#include <ucp/core/ucp_request.inl>
+#include <ucp/proto/proto_multi.inl>
+
+
+static UCS_F_ALWAYS_INLINE void
+ucp_stream_multi_request_init(ucp_request_t *req)
+{
+    req->send.msg_proto.message_id = req->send.ep->worker->am_message_id++;
+}
+
+static UCS_F_ALWAYS_INLINE void
+ucp_stream_set_first_hdr(ucp_request_t *req, ucp_stream_first_hdr_t *hdr)
+{
+    hdr->super.ep_id = ucp_send_request_get_ep_remote_id(req);
+    hdr->msg_id      = req->send.msg_proto.message_id;
+    hdr->total_len   = req->send.state.dt_iter.length;
+}
+
+static UCS_F_ALWAYS_INLINE void
+ucp_stream_set_middle_hdr(ucp_request_t *req, ucp_stream_mid_hdr_t *hdr)
+{
+    hdr->super.ep_id = ucp_send_request_get_ep_remote_id(req);
+    hdr->msg_id      = req->send.msg_proto.message_id;
+    hdr->offset      = req->send.state.dt_iter.offset;
+}
+
+static ucs_status_t
+ucp_stream_multi_init_common(ucp_proto_multi_init_params_t *params)
+{
+    if (params->super.super.select_param->op_id != UCP_OP_ID_STREAM_SEND) {
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    /* The first fragment is sent on the AM lane, which defines the order of
+     * the messages on the receiver, and the rest are striped over the
+     * high-bandwidth AM lanes */
+    params->super.overhead   = 10e-9; /* for multiple lanes management */
+    params->super.latency    = 0;
+    params->super.hdr_size   = sizeof(ucp_stream_first_hdr_t);
+    params->first.lane_type  = UCP_LANE_TYPE_AM;
+    params->middle.lane_type = UCP_LANE_TYPE_AM_BW;
+    params->max_lanes        =
+            params->super.super.worker->context->config.ext.max_eager_lanes;
+
+    return ucp_proto_multi_init(params);
+}
+
+static ucs_status_t
+ucp_stream_bcopy_multi_proto_init(const ucp_proto_init_params_t *init_params)
+{
+    ucp_context_t *context               = init_params->worker->context;
+    ucp_proto_multi_init_params_t params = {
+        .super.super         = *init_params,
+        .super.cfg_thresh    = context->config.ext.bcopy_thresh,
+        .super.cfg_priority  = 20,
+        .super.min_frag_offs = UCP_PROTO_COMMON_OFFSET_INVALID,
+        .super.max_frag_offs = ucs_offsetof(uct_iface_attr_t, cap.am.max_bcopy),
+        .super.flags         = UCP_PROTO_COMMON_INIT_FLAG_MEM_TYPE,
+        .first.tl_cap_flags  = UCT_IFACE_FLAG_AM_BCOPY,
+        .middle.tl_cap_flags = UCT_IFACE_FLAG_AM_BCOPY,
+    };
+
+    return ucp_stream_multi_init_common(&params);
+}
+
+static size_t ucp_stream_bcopy_pack_first(void *dest, void *arg)
+{
+    ucp_stream_first_hdr_t          *hdr = dest;
+    ucp_proto_multi_pack_ctx_t *pack_ctx = arg;
+
+    ucp_stream_set_first_hdr(pack_ctx->req, hdr);
+    return sizeof(*hdr) + ucp_proto_multi_data_pack(pack_ctx, hdr + 1);
+}
+
+static size_t ucp_stream_bcopy_pack_middle(void *dest, void *arg)
+{
+    ucp_stream_mid_hdr_t            *hdr = dest;
+    ucp_proto_multi_pack_ctx_t *pack_ctx = arg;
+
+    ucp_stream_set_middle_hdr(pack_ctx->req, hdr);
+    return sizeof(*hdr) + ucp_proto_multi_data_pack(pack_ctx, hdr + 1);
+}
+
+static UCS_F_ALWAYS_INLINE ucs_status_t
+ucp_stream_bcopy_multi_send_func(ucp_request_t *req,
+                                 const ucp_proto_multi_lane_priv_t *lpriv,
+                                 ucp_datatype_iter_t *next_iter)
+{
+    ucp_ep_t *ep                        = req->send.ep;
+    ucp_proto_multi_pack_ctx_t pack_ctx = {
+        .req       = req,
+        .next_iter = next_iter
+    };
+    uct_pack_callback_t pack_cb;
+    ssize_t packed_size;
+    ucp_am_id_t am_id;
+    size_t hdr_size;
+
+    if (req->send.state.dt_iter.offset == 0) {
+        am_id    = UCP_AM_ID_STREAM_FIRST;
+        pack_cb  = ucp_stream_bcopy_pack_first;
+        hdr_size = sizeof(ucp_stream_first_hdr_t);
+    } else {
+        am_id    = UCP_AM_ID_STREAM_MIDDLE;
+        pack_cb  = ucp_stream_bcopy_pack_middle;
+        hdr_size = sizeof(ucp_stream_mid_hdr_t);
+    }
+    pack_ctx.max_payload = ucp_proto_multi_max_payload(req, lpriv, hdr_size);
+
+    packed_size = uct_ep_am_bcopy(ep->uct_eps[lpriv->super.lane], am_id,
+                                  pack_cb, &pack_ctx, 0);
+    if (ucs_likely(packed_size >= 0)) {
+        ucs_assert(packed_size >= hdr_size);
+        return UCS_OK;
+    } else {
+        return (ucs_status_t)packed_size;
+    }
+}
+
+static ucs_status_t ucp_stream_bcopy_multi_progress(uct_pending_req_t *uct_req)
+{
+    ucp_request_t *req = ucs_container_of(uct_req, ucp_request_t, send.uct);
+
+    return ucp_proto_multi_bcopy_progress(
+            req, req->send.proto_config->priv, ucp_stream_multi_request_init,
+            ucp_stream_bcopy_multi_send_func,
+            ucp_proto_request_bcopy_complete_success);
+}
+
+static ucp_proto_t ucp_stream_bcopy_multi_proto = {
+    .name       = "stream/egr/multi/bcopy",
+    .flags      = 0,
+    .init       = ucp_stream_bcopy_multi_proto_init,
+    .config_str = ucp_proto_multi_config_str,
+    .progress   = ucp_stream_bcopy_multi_progress
+};
+UCP_PROTO_REGISTER(&ucp_stream_bcopy_multi_proto);
+
+static ucs_status_t
+ucp_stream_zcopy_multi_proto_init(const ucp_proto_init_params_t *init_params)
+{
+    ucp_context_t *context               = init_params->worker->context;
+    ucp_proto_multi_init_params_t params = {
+        .super.super         = *init_params,
+        .super.cfg_thresh    = context->config.ext.zcopy_thresh,
+        .super.cfg_priority  = 30,
+        .super.min_frag_offs = ucs_offsetof(uct_iface_attr_t, cap.am.min_zcopy),
+        .super.max_frag_offs = ucs_offsetof(uct_iface_attr_t, cap.am.max_zcopy),
+        .super.flags         = UCP_PROTO_COMMON_INIT_FLAG_SEND_ZCOPY,
+        .first.tl_cap_flags  = UCT_IFACE_FLAG_AM_ZCOPY,
+        .middle.tl_cap_flags = UCT_IFACE_FLAG_AM_ZCOPY,
+    };
+
+    return ucp_stream_multi_init_common(&params);
+}
+
+static UCS_F_ALWAYS_INLINE ucs_status_t
+ucp_stream_zcopy_multi_send_func(ucp_request_t *req,
+                                 const ucp_proto_multi_lane_priv_t *lpriv,
+                                 ucp_datatype_iter_t *next_iter)
+{
+    union {
+        ucp_stream_first_hdr_t first;
+        ucp_stream_mid_hdr_t   middle;
+    } hdr;
+    ucp_am_id_t am_id;
+    size_t hdr_size;
+    uct_iov_t iov;
+
+    if (req->send.state.dt_iter.offset == 0) {
+        am_id    = UCP_AM_ID_STREAM_FIRST;
+        hdr_size = sizeof(hdr.first);
+        ucp_stream_set_first_hdr(req, &hdr.first);
+    } else {
+        am_id    = UCP_AM_ID_STREAM_MIDDLE;
+        hdr_size = sizeof(hdr.middle);
+        ucp_stream_set_middle_hdr(req, &hdr.middle);
+    }
+
+    ucp_datatype_iter_next_iov(&req->send.state.dt_iter, lpriv->super.memh_index,
+                               ucp_proto_multi_max_payload(req, lpriv, hdr_size),
+                               next_iter, &iov);
+    return uct_ep_am_zcopy(req->send.ep->uct_eps[lpriv->super.lane], am_id, &hdr,
+                           hdr_size, &iov, 1, 0, &req->send.state.uct_comp);
+}
+
+static ucs_status_t ucp_stream_zcopy_multi_progress(uct_pending_req_t *self)
+{
+    ucp_request_t *req = ucs_container_of(self, ucp_request_t, send.uct);
+
+    return ucp_proto_multi_zcopy_progress(req, req->send.proto_config->priv,
+                                          ucp_stream_multi_request_init,
+                                          ucp_stream_zcopy_multi_send_func,
+                                          ucp_proto_request_zcopy_completion);
+}
+
+static ucp_proto_t ucp_stream_zcopy_multi_proto = {
+    .name       = "stream/egr/multi/zcopy",
+    .flags      = 0,
+    .init       = ucp_stream_zcopy_multi_proto_init,
+    .config_str = ucp_proto_multi_config_str,
+    .progress   = ucp_stream_zcopy_multi_progress
+};
+UCP_PROTO_REGISTER(&ucp_stream_zcopy_multi_proto);
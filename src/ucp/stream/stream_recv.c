@@ -14,6 +14,7 @@
 #include <ucp/core/ucp_request.h>
 #include <ucp/core/ucp_request.inl>
 #include <ucp/stream/stream.h>
+#include <ucp/rndv/rndv.h>
 
 #include <ucs/datastruct/mpool.inl>
 #include <ucs/profile/profile.h>
@@ -60,6 +61,36 @@
     ((ucp_stream_am_data_t *)_data - 1)->rdesc
 
 
+#define ucp_stream_rdesc_asm(_rdesc)                                          \
+    ((ucp_stream_asm_desc_t *)((_rdesc) + 1))
+
+
+/*
+ * Stream message which is received by multiple fragments or by rendezvous
+ * protocol. It is placed right after the receive descriptor, which is
+ * allocated with malloc together with the payload buffer and pushed to the
+ * endpoint's assembly queue in the order of arrival of the first fragment (or
+ * the RTS). The messages which arrive later are kept in the assembly queue as
+ * well, until all preceding messages are received.
+ */
+typedef struct {
+    ucp_ep_h                 ep;         /* Receiving endpoint, or NULL if it
+                                            was destroyed during rendezvous */
+    uint64_t                 msg_id;     /* Message ID */
+    size_t                   remaining;  /* Length of the data which was not
+                                            received yet */
+} ucp_stream_asm_desc_t;
+
+
+static UCS_F_ALWAYS_INLINE void ucp_stream_rdesc_release(ucp_recv_desc_t *rdesc)
+{
+    if (ucs_unlikely(rdesc->flags & UCP_RECV_DESC_FLAG_MALLOC)) {
+        ucs_free(rdesc);
+    } else {
+        ucp_recv_desc_release(rdesc);
+    }
+}
+
 static UCS_F_ALWAYS_INLINE ucp_recv_desc_t *
 ucp_stream_rdesc_dequeue(ucp_ep_ext_proto_t *ep_ext)
 {
@@ -134,7 +165,7 @@ ucp_stream_rdesc_dequeue_and_release(ucp_recv_desc_t *rdesc,
                                                       ucp_recv_desc_t,
                                                       stream_queue));
     ucp_stream_rdesc_dequeue(ep_ext);
-    ucp_recv_desc_release(rdesc);
+    ucp_stream_rdesc_release(rdesc);
 }
 
 UCS_PROFILE_FUNC_VOID(ucp_stream_data_release, (ep, data),
@@ -144,7 +175,7 @@ UCS_PROFILE_FUNC_VOID(ucp_stream_data_release, (ep, data),
 
     UCP_WORKER_THREAD_CS_ENTER_CONDITIONAL(ep->worker);
 
-    ucp_recv_desc_release(rdesc);
+    ucp_stream_rdesc_release(rdesc);
 
     UCP_WORKER_THREAD_CS_EXIT_CONDITIONAL(ep->worker);
 }
@@ -400,72 +431,212 @@ out:
     return req;
 }
 
+/*
+ * Unpack the received data to the receive requests posted on the endpoint, and
+ * advance 'rdesc' by the unpacked length. The payload resides at
+ * 'rdesc->payload_offset' from 'base'. Return UCS_OK if all data was consumed.
+ */
 static UCS_F_ALWAYS_INLINE ucs_status_t
-ucp_stream_am_data_process(ucp_worker_t *worker, ucp_ep_ext_proto_t *ep_ext,
-                           ucp_stream_am_data_t *am_data, size_t length,
-                           unsigned am_flags)
+ucp_stream_process_expected(ucp_ep_ext_proto_t *ep_ext, void *base,
+                            ucp_recv_desc_t *rdesc)
 {
-    ucp_recv_desc_t  rdesc_tmp;
-    void            *payload;
-    ucp_recv_desc_t *rdesc;
-    ucp_request_t   *req;
-    ssize_t          unpacked;
+    ucp_request_t *req;
+    ssize_t unpacked;
 
-    rdesc_tmp.length         = length;
-    rdesc_tmp.payload_offset = sizeof(*am_data); /* add sizeof(*rdesc) only if
-                                                    am_data wont be handled in
-                                                    place */
-
-    /* First, process expected requests */
-    if (!ucp_stream_ep_has_data(ep_ext)) {
-        while (!ucs_queue_is_empty(&ep_ext->stream.match_q)) {
-            req      = ucs_queue_head_elem_non_empty(&ep_ext->stream.match_q,
-                                                     ucp_request_t, recv.queue);
-            payload  = UCS_PTR_BYTE_OFFSET(am_data, rdesc_tmp.payload_offset);
-            unpacked = ucp_stream_rdata_unpack(payload, rdesc_tmp.length, req);
-            if (ucs_unlikely(unpacked < 0)) {
-                ucs_fatal("failed to unpack from am_data %p with offset %u to request %p",
-                          am_data, rdesc_tmp.payload_offset, req);
-            } else if (unpacked == rdesc_tmp.length) {
-                if (ucp_request_can_complete_stream_recv(req)) {
-                    ucp_request_complete_stream_recv(req, ep_ext, UCS_OK);
-                }
-                return UCS_OK;
+    if (ucp_stream_ep_has_data(ep_ext)) {
+        return UCS_INPROGRESS;
+    }
+
+    while (!ucs_queue_is_empty(&ep_ext->stream.match_q)) {
+        req      = ucs_queue_head_elem_non_empty(&ep_ext->stream.match_q,
+                                                 ucp_request_t, recv.queue);
+        unpacked = ucp_stream_rdata_unpack(UCS_PTR_BYTE_OFFSET(base,
+                                                               rdesc->payload_offset),
+                                           rdesc->length, req);
+        if (ucs_unlikely(unpacked < 0)) {
+            ucs_fatal("failed to unpack from %p with offset %u to request %p",
+                      base, rdesc->payload_offset, req);
+        } else if (unpacked == rdesc->length) {
+            if (ucp_request_can_complete_stream_recv(req)) {
+                ucp_request_complete_stream_recv(req, ep_ext, UCS_OK);
             }
-            ucp_stream_rdesc_advance(&rdesc_tmp, unpacked, ep_ext);
-            /* This request is full, try next one */
-            ucs_assert(ucp_request_can_complete_stream_recv(req));
-            ucp_request_complete_stream_recv(req, ep_ext, UCS_OK);
+            return UCS_OK;
         }
+        ucp_stream_rdesc_advance(rdesc, unpacked, ep_ext);
+        /* This request is full, try next one */
+        ucs_assert(ucp_request_can_complete_stream_recv(req));
+        ucp_request_complete_stream_recv(req, ep_ext, UCS_OK);
     }
 
-    ucs_assert(rdesc_tmp.length > 0);
+    return UCS_INPROGRESS;
+}
+
+static UCS_F_ALWAYS_INLINE ucp_recv_desc_t *
+ucp_stream_rdesc_init(ucp_worker_t *worker, void *am_data,
+                      const ucp_recv_desc_t *rdesc_tmp, unsigned am_flags)
+{
+    ucp_recv_desc_t *rdesc;
 
-    /* Now, enqueue the rest of data */
     if (ucs_likely(!(am_flags & UCT_CB_PARAM_FLAG_DESC))) {
         rdesc = (ucp_recv_desc_t*)ucs_mpool_get_inline(&worker->am_mp);
         ucs_assertv_always(rdesc != NULL,
                            "ucp recv descriptor is not allocated");
-        rdesc->length         = rdesc_tmp.length;
+        rdesc->length         = rdesc_tmp->length;
         /* reset offset to improve locality */
-        rdesc->payload_offset = sizeof(*rdesc) + sizeof(*am_data);
+        rdesc->payload_offset = sizeof(*rdesc) + sizeof(ucp_stream_am_data_t);
         rdesc->flags          = 0;
         memcpy(ucp_stream_rdesc_payload(rdesc),
-               UCS_PTR_BYTE_OFFSET(am_data, rdesc_tmp.payload_offset),
-               rdesc_tmp.length);
+               UCS_PTR_BYTE_OFFSET(am_data, rdesc_tmp->payload_offset),
+               rdesc_tmp->length);
     } else {
         /* slowpath */
         rdesc                  = (ucp_recv_desc_t *)am_data - 1;
-        rdesc->length          = rdesc_tmp.length;
-        rdesc->payload_offset  = rdesc_tmp.payload_offset + sizeof(*rdesc);
+        rdesc->length          = rdesc_tmp->length;
+        rdesc->payload_offset  = rdesc_tmp->payload_offset + sizeof(*rdesc);
         rdesc->uct_desc_offset = UCP_WORKER_HEADROOM_PRIV_SIZE;
         rdesc->flags           = UCP_RECV_DESC_FLAG_UCT_DESC;
     }
 
-    ucp_ep_from_ext_proto(ep_ext)->flags |= UCP_EP_FLAG_STREAM_HAS_DATA;
+    return rdesc;
+}
+
+static UCS_F_ALWAYS_INLINE void
+ucp_stream_rdesc_enqueue(ucp_ep_h ep, ucp_recv_desc_t *rdesc)
+{
+    ucp_ep_ext_proto_t *ep_ext = ucp_ep_ext_proto(ep);
+
+    ep->flags |= UCP_EP_FLAG_STREAM_HAS_DATA;
     ucs_queue_push(&ep_ext->stream.match_q, &rdesc->stream_queue);
 
-    return UCS_INPROGRESS;
+    if (!ucp_stream_ep_is_queued(ep_ext) && (ep->flags & UCP_EP_FLAG_USED)) {
+        ucp_stream_ep_enqueue(ep_ext, ep->worker);
+    }
+}
+
+static UCS_F_ALWAYS_INLINE ucs_status_t
+ucp_stream_am_data_process(ucp_worker_t *worker, ucp_ep_h ep, void *am_data,
+                           size_t hdr_size, size_t length, unsigned am_flags)
+{
+    ucp_ep_ext_proto_t *ep_ext = ucp_ep_ext_proto(ep);
+    ucs_queue_head_t   *asm_q  = &ucp_ep_ext_control(ep)->stream_asm_q;
+    ucp_recv_desc_t     rdesc_tmp;
+    ucp_recv_desc_t    *rdesc;
+
+    rdesc_tmp.length         = length;
+    rdesc_tmp.payload_offset = hdr_size; /* add sizeof(*rdesc) only if am_data
+                                            wont be handled in place */
+
+    if (ucs_likely(ucs_queue_is_empty(asm_q))) {
+        /* First, process expected requests */
+        if (ucp_stream_process_expected(ep_ext, am_data,
+                                        &rdesc_tmp) == UCS_OK) {
+            return UCS_OK;
+        }
+
+        ucs_assert(rdesc_tmp.length > 0);
+
+        /* Now, enqueue the rest of data */
+        rdesc = ucp_stream_rdesc_init(worker, am_data, &rdesc_tmp, am_flags);
+        ucp_stream_rdesc_enqueue(ep, rdesc);
+    } else {
+        /* Preceding message is not received yet, keep the data after it */
+        rdesc = ucp_stream_rdesc_init(worker, am_data, &rdesc_tmp, am_flags);
+        ucs_queue_push(asm_q, &rdesc->stream_queue);
+    }
+
+    return (am_flags & UCT_CB_PARAM_FLAG_DESC) ? UCS_INPROGRESS : UCS_OK;
+}
+
+static ucp_recv_desc_t *
+ucp_stream_asm_rdesc_get(ucp_ep_h ep, uint64_t msg_id, size_t length)
+{
+    ucp_stream_asm_desc_t *asm_desc;
+    ucp_recv_desc_t *rdesc;
+
+    /* Sender does not use multi-fragment and rendezvous protocols for messages
+     * which can't be described by a receive descriptor */
+    ucs_assert(length <= UINT32_MAX);
+
+    rdesc = ucs_malloc(sizeof(*rdesc) + sizeof(*asm_desc) +
+                       sizeof(ucp_stream_am_data_t) + length,
+                       "ucp recv desc for long stream");
+    if (ucs_unlikely(rdesc == NULL)) {
+        ucs_error("ep %p: failed to allocate buffer for assembling stream"
+                  " data of %zu bytes", ep, length);
+        return NULL;
+    }
+
+    rdesc->length         = length;
+    rdesc->payload_offset = sizeof(*rdesc) + sizeof(*asm_desc) +
+                            sizeof(ucp_stream_am_data_t);
+    rdesc->flags          = UCP_RECV_DESC_FLAG_MALLOC;
+
+    asm_desc              = ucp_stream_rdesc_asm(rdesc);
+    asm_desc->ep          = ep;
+    asm_desc->msg_id      = msg_id;
+    asm_desc->remaining   = length;
+
+    ucs_queue_push(&ucp_ep_ext_control(ep)->stream_asm_q,
+                   &rdesc->stream_queue);
+    return rdesc;
+}
+
+static ucp_recv_desc_t *
+ucp_stream_asm_rdesc_find(ucp_ep_h ep, uint64_t msg_id)
+{
+    ucp_recv_desc_t *rdesc;
+
+    ucs_queue_for_each(rdesc, &ucp_ep_ext_control(ep)->stream_asm_q,
+                       stream_queue) {
+        if ((rdesc->flags & UCP_RECV_DESC_FLAG_MALLOC) &&
+            !(rdesc->flags & UCP_RECV_DESC_FLAG_RNDV_STARTED) &&
+            (ucp_stream_rdesc_asm(rdesc)->msg_id == msg_id)) {
+            return rdesc;
+        }
+    }
+
+    return NULL;
+}
+
+static UCS_F_ALWAYS_INLINE void
+ucp_stream_asm_rdesc_copy(ucp_recv_desc_t *rdesc, const void *data,
+                          size_t length, size_t offset)
+{
+    ucp_stream_asm_desc_t *asm_desc = ucp_stream_rdesc_asm(rdesc);
+
+    ucs_assertv((offset + length) <= rdesc->length,
+                "offset %zu length %zu total %u", offset, length,
+                rdesc->length);
+    ucs_assert(asm_desc->remaining >= length);
+
+    memcpy(UCS_PTR_BYTE_OFFSET(ucp_stream_rdesc_payload(rdesc), offset), data,
+           length);
+    asm_desc->remaining -= length;
+}
+
+/* Hand over the messages from the head of the assembly queue, which were
+ * completely received, to the user */
+static void ucp_stream_asm_progress(ucp_ep_h ep)
+{
+    ucp_ep_ext_proto_t *ep_ext = ucp_ep_ext_proto(ep);
+    ucs_queue_head_t *asm_q    = &ucp_ep_ext_control(ep)->stream_asm_q;
+    ucp_recv_desc_t *rdesc;
+
+    while (!ucs_queue_is_empty(asm_q)) {
+        rdesc = ucs_queue_head_elem_non_empty(asm_q, ucp_recv_desc_t,
+                                              stream_queue);
+        if ((rdesc->flags & UCP_RECV_DESC_FLAG_MALLOC) &&
+            (ucp_stream_rdesc_asm(rdesc)->remaining > 0)) {
+            break;
+        }
+
+        ucs_queue_pull_non_empty(asm_q);
+        if (ucp_stream_process_expected(ep_ext, rdesc, rdesc) == UCS_OK) {
+            ucp_stream_rdesc_release(rdesc);
+        } else {
+            ucp_stream_rdesc_enqueue(ep, rdesc);
+        }
+    }
 }
 
 void ucp_stream_ep_init(ucp_ep_h ep)
@@ -476,13 +647,18 @@ void ucp_stream_ep_init(ucp_ep_h ep)
         ep_ext->stream.ready_list.prev = NULL;
         ep_ext->stream.ready_list.next = NULL;
         ucs_queue_head_init(&ep_ext->stream.match_q);
+        ucs_queue_head_init(&ucp_ep_ext_control(ep)->stream_asm_q);
     }
 }
 
 void ucp_stream_ep_cleanup(ucp_ep_h ep)
 {
     ucp_ep_ext_proto_t* ep_ext;
+    ucp_stream_mid_hdr_t *mid_hdr;
+    ucs_queue_head_t *asm_q;
     ucp_request_t *req;
+    ucp_recv_desc_t *rdesc;
+    ucs_queue_iter_t iter;
     size_t length;
     void *data;
 
@@ -502,6 +678,30 @@ void ucp_stream_ep_cleanup(ucp_ep_h ep)
         ucp_stream_ep_dequeue(ep_ext);
     }
 
+    /* drop data which was not received completely */
+    asm_q = &ucp_ep_ext_control(ep)->stream_asm_q;
+    while (!ucs_queue_is_empty(asm_q)) {
+        rdesc = ucs_queue_pull_elem_non_empty(asm_q, ucp_recv_desc_t,
+                                              stream_queue);
+        if ((rdesc->flags & UCP_RECV_DESC_FLAG_RNDV_STARTED) &&
+            (ucp_stream_rdesc_asm(rdesc)->remaining > 0)) {
+            /* Rendezvous is in progress, the descriptor is released when it
+             * is completed */
+            ucp_stream_rdesc_asm(rdesc)->ep = NULL;
+        } else {
+            ucp_stream_rdesc_release(rdesc);
+        }
+    }
+
+    ucs_queue_for_each_safe(rdesc, iter, &ep->worker->stream_mid_q,
+                            stream_queue) {
+        mid_hdr = (ucp_stream_mid_hdr_t*)(rdesc + 1);
+        if (mid_hdr->super.ep_id == ucp_ep_local_id(ep)) {
+            ucs_queue_del_iter(&ep->worker->stream_mid_q, iter);
+            ucp_recv_desc_release(rdesc);
+        }
+    }
+
     /* cancel not completed requests */
     ucs_assert(!ucp_stream_ep_has_data(ep_ext));
     while (!ucs_queue_is_empty(&ep_ext->stream.match_q)) {
@@ -521,6 +721,96 @@ void ucp_stream_ep_activate(ucp_ep_h ep)
     }
 }
 
+static void ucp_stream_rndv_recv_completed(void *request, ucs_status_t status,
+                                           size_t length, void *user_data)
+{
+    ucp_recv_desc_t *rdesc          = user_data;
+    ucp_stream_asm_desc_t *asm_desc = ucp_stream_rdesc_asm(rdesc);
+    ucp_ep_h ep                     = asm_desc->ep;
+
+    if (ep == NULL) {
+        /* Endpoint was destroyed during the rendezvous */
+        ucs_free(rdesc);
+        return;
+    }
+
+    if (ucs_unlikely(status != UCS_OK)) {
+        ucs_error("ep %p: failed to receive %u bytes of stream data by"
+                  " rendezvous: %s", ep, rdesc->length,
+                  ucs_status_string(status));
+        ucs_queue_remove(&ucp_ep_ext_control(ep)->stream_asm_q,
+                         &rdesc->stream_queue);
+        ucs_free(rdesc);
+    } else {
+        asm_desc->remaining = 0;
+    }
+
+    ucp_stream_asm_progress(ep);
+}
+
+/*
+ * Stream data which is sent by rendezvous protocol is received to a staging
+ * buffer, since the receive requests are not matched to messages, and then
+ * handed over to the user in the order of the RTS arrival.
+ */
+ucs_status_t ucp_stream_rndv_process_rts(void *arg, void *data, size_t length,
+                                         unsigned tl_flags)
+{
+    ucp_worker_h worker     = arg;
+    ucp_rndv_rts_hdr_t *rts = data;
+    ucp_recv_desc_t *rdesc;
+    ucp_request_t *rreq;
+    ucs_status_t status;
+    ucp_ep_h ep;
+
+    UCP_WORKER_GET_VALID_EP_BY_ID(&ep, worker, rts->sreq.ep_id,
+                                  { status = UCS_ERR_CANCELED;
+                                    goto out_send_ats; },
+                                  "stream RTS");
+
+    if (ucs_unlikely(ep->flags & (UCP_EP_FLAG_CLOSED | UCP_EP_FLAG_FAILED))) {
+        status = UCS_ERR_CANCELED;
+        goto out_send_ats;
+    }
+
+    rreq = ucp_request_get(worker);
+    if (ucs_unlikely(rreq == NULL)) {
+        ucs_error("failed to allocate stream rendezvous receive request");
+        status = UCS_ERR_NO_MEMORY;
+        goto out_send_ats;
+    }
+
+    rdesc = ucp_stream_asm_rdesc_get(ep, 0, rts->size);
+    if (ucs_unlikely(rdesc == NULL)) {
+        ucp_request_put(rreq);
+        status = UCS_ERR_NO_MEMORY;
+        goto out_send_ats;
+    }
+
+    rdesc->flags        |= UCP_RECV_DESC_FLAG_RNDV_STARTED;
+
+    rreq->status         = UCS_OK;
+    rreq->flags          = UCP_REQUEST_FLAG_RECV_AM |
+                           UCP_REQUEST_FLAG_RELEASED;
+    rreq->recv.worker    = worker;
+    rreq->recv.buffer    = ucp_stream_rdesc_payload(rdesc);
+    rreq->recv.datatype  = ucp_dt_make_contig(1);
+    rreq->recv.length    = rts->size;
+    rreq->recv.mem_type  = UCS_MEMORY_TYPE_HOST;
+    rreq->recv.am.desc   = rdesc;
+    ucp_dt_recv_state_init(&rreq->recv.state, rreq->recv.buffer,
+                           rreq->recv.datatype, rts->size);
+    ucp_request_set_callback(rreq, recv.am.cb, ucp_stream_rndv_recv_completed,
+                             rdesc);
+
+    ucp_rndv_receive(worker, rreq, rts, rts + 1);
+    return UCS_OK;
+
+out_send_ats:
+    ucp_rndv_send_ats(worker, rts, status);
+    return UCS_OK;
+}
+
 static UCS_F_ALWAYS_INLINE ucs_status_t
 ucp_stream_am_handler(void *am_arg, void *am_data, size_t am_length,
                       unsigned am_flags)
@@ -528,14 +818,11 @@ ucp_stream_am_handler(void *am_arg, void *am_data, size_t am_length,
     ucp_worker_h          worker    = am_arg;
     ucp_stream_am_data_t *data      = am_data;
     ucp_ep_h              ep;
-    ucp_ep_ext_proto_t    *ep_ext;
-    ucs_status_t          status;
 
     ucs_assert(am_length >= sizeof(ucp_stream_am_hdr_t));
 
     UCP_WORKER_GET_VALID_EP_BY_ID(&ep, worker, data->hdr.ep_id, return UCS_OK,
                                   "stream data");
-    ep_ext = ucp_ep_ext_proto(ep);
 
     if (ucs_unlikely(ep->flags & (UCP_EP_FLAG_CLOSED |
                                   UCP_EP_FLAG_FAILED))) {
@@ -544,32 +831,140 @@ ucp_stream_am_handler(void *am_arg, void *am_data, size_t am_length,
         return UCS_OK;
     }
 
-    status = ucp_stream_am_data_process(worker, ep_ext, data,
-                                        am_length - sizeof(data->hdr),
-                                        am_flags);
-    if (status == UCS_OK) {
-        /* rdesc was processed in place */
+    return ucp_stream_am_data_process(worker, ep, data, sizeof(data->hdr),
+                                      am_length - sizeof(data->hdr), am_flags);
+}
+
+UCS_PROFILE_FUNC(ucs_status_t, ucp_stream_am_first_handler,
+                 (am_arg, am_data, am_length, am_flags),
+                 void *am_arg, void *am_data, size_t am_length,
+                 unsigned am_flags)
+{
+    ucp_worker_h worker               = am_arg;
+    ucp_stream_first_hdr_t *first_hdr = am_data;
+    size_t length                     = am_length - sizeof(*first_hdr);
+    ucp_recv_desc_t *rdesc, *mid_rdesc;
+    ucp_stream_mid_hdr_t *mid_hdr;
+    ucs_queue_iter_t iter;
+    ucp_ep_h ep;
+
+    UCP_WORKER_GET_VALID_EP_BY_ID(&ep, worker, first_hdr->super.ep_id,
+                                  return UCS_OK, "stream first fragment");
+
+    if (ucs_unlikely(ep->flags & (UCP_EP_FLAG_CLOSED |
+                                  UCP_EP_FLAG_FAILED))) {
+        ucs_trace_data("ep %p: stream is invalid", ep);
+        return UCS_OK;
+    }
+
+    if (length == first_hdr->total_len) {
+        /* The whole message fits into the first fragment */
+        return ucp_stream_am_data_process(worker, ep, am_data,
+                                          sizeof(*first_hdr), length,
+                                          am_flags);
+    }
+
+    rdesc = ucp_stream_asm_rdesc_get(ep, first_hdr->msg_id,
+                                     first_hdr->total_len);
+    if (ucs_unlikely(rdesc == NULL)) {
         return UCS_OK;
     }
 
-    ucs_assert(status == UCS_INPROGRESS);
+    ucp_stream_asm_rdesc_copy(rdesc, first_hdr + 1, length, 0);
 
-    if (!ucp_stream_ep_is_queued(ep_ext) && (ep->flags & UCP_EP_FLAG_USED)) {
-        ucp_stream_ep_enqueue(ep_ext, worker);
+    /* Copy the middle fragments which arrived before the first one */
+    ucs_queue_for_each_safe(mid_rdesc, iter, &worker->stream_mid_q,
+                            stream_queue) {
+        mid_hdr = (ucp_stream_mid_hdr_t*)(mid_rdesc + 1);
+        if ((mid_hdr->msg_id != first_hdr->msg_id) ||
+            (mid_hdr->super.ep_id != first_hdr->super.ep_id)) {
+            continue;
+        }
+
+        ucs_queue_del_iter(&worker->stream_mid_q, iter);
+        ucp_stream_asm_rdesc_copy(rdesc, mid_hdr + 1,
+                                  mid_rdesc->length - sizeof(*mid_hdr),
+                                  mid_hdr->offset);
+        ucp_recv_desc_release(mid_rdesc);
     }
 
-    return (am_flags & UCT_CB_PARAM_FLAG_DESC) ? UCS_INPROGRESS : UCS_OK;
+    ucp_stream_asm_progress(ep);
+    return UCS_OK;
+}
+
+UCS_PROFILE_FUNC(ucs_status_t, ucp_stream_am_middle_handler,
+                 (am_arg, am_data, am_length, am_flags),
+                 void *am_arg, void *am_data, size_t am_length,
+                 unsigned am_flags)
+{
+    ucp_worker_h worker           = am_arg;
+    ucp_stream_mid_hdr_t *mid_hdr = am_data;
+    ucp_recv_desc_t *rdesc, *mid_rdesc;
+    ucs_status_t status;
+    ucp_ep_h ep;
+
+    UCP_WORKER_GET_VALID_EP_BY_ID(&ep, worker, mid_hdr->super.ep_id,
+                                  return UCS_OK, "stream middle fragment");
+
+    if (ucs_unlikely(ep->flags & (UCP_EP_FLAG_CLOSED |
+                                  UCP_EP_FLAG_FAILED))) {
+        ucs_trace_data("ep %p: stream is invalid", ep);
+        return UCS_OK;
+    }
+
+    rdesc = ucp_stream_asm_rdesc_find(ep, mid_hdr->msg_id);
+    if (rdesc != NULL) {
+        /* First fragment already arrived, just copy the data */
+        ucp_stream_asm_rdesc_copy(rdesc, mid_hdr + 1,
+                                  am_length - sizeof(*mid_hdr),
+                                  mid_hdr->offset);
+        ucp_stream_asm_progress(ep);
+        return UCS_OK;
+    }
+
+    /* Keep the fragment until the first one arrives with the total length */
+    status = ucp_recv_desc_init(worker, am_data, am_length, 0, am_flags,
+                                sizeof(*mid_hdr), 0, 0, &mid_rdesc);
+    if (ucs_unlikely(UCS_STATUS_IS_ERR(status))) {
+        ucs_error("worker %p could not allocate desc for assembling stream",
+                  worker);
+        return UCS_OK;
+    }
+
+    ucs_queue_push(&worker->stream_mid_q, &mid_rdesc->stream_queue);
+    return status;
 }
 
 static void ucp_stream_am_dump(ucp_worker_h worker, uct_am_trace_type_t type,
                                uint8_t id, const void *data, size_t length,
                                char *buffer, size_t max)
 {
-    const ucp_stream_am_hdr_t *hdr    = data;
-    size_t                    hdr_len = sizeof(*hdr);
-    char                      *p;
+    const ucp_stream_am_hdr_t *hdr          = data;
+    const ucp_stream_first_hdr_t *first_hdr = data;
+    const ucp_stream_mid_hdr_t *mid_hdr     = data;
+    size_t hdr_len;
+    char *p;
+
+    switch (id) {
+    case UCP_AM_ID_STREAM_DATA:
+        snprintf(buffer, max, "STREAM ep_id 0x%"PRIx64, hdr->ep_id);
+        hdr_len = sizeof(*hdr);
+        break;
+    case UCP_AM_ID_STREAM_FIRST:
+        snprintf(buffer, max, "STREAM_FIRST ep_id 0x%"PRIx64" msg_id %"PRIu64
+                 " total_len %zu", hdr->ep_id, first_hdr->msg_id,
+                 first_hdr->total_len);
+        hdr_len = sizeof(*first_hdr);
+        break;
+    case UCP_AM_ID_STREAM_MIDDLE:
+        snprintf(buffer, max, "STREAM_MIDDLE ep_id 0x%"PRIx64" msg_id %"PRIu64
+                 " offset %zu", hdr->ep_id, mid_hdr->msg_id, mid_hdr->offset);
+        hdr_len = sizeof(*mid_hdr);
+        break;
+    default:
+        return;
+    }
 
-    snprintf(buffer, max, "STREAM ep_id 0x%"PRIx64, hdr->ep_id);
     p = buffer + strlen(buffer);
 
     ucs_assert(hdr->ep_id != UCP_EP_ID_INVALID);
@@ -579,5 +974,11 @@ static void ucp_stream_am_dump(ucp_worker_h worker, uct_am_trace_type_t type,
 
 UCP_DEFINE_AM(UCP_FEATURE_STREAM, UCP_AM_ID_STREAM_DATA, ucp_stream_am_handler,
               ucp_stream_am_dump, 0);
+UCP_DEFINE_AM(UCP_FEATURE_STREAM, UCP_AM_ID_STREAM_FIRST,
+              ucp_stream_am_first_handler, ucp_stream_am_dump, 0);
+UCP_DEFINE_AM(UCP_FEATURE_STREAM, UCP_AM_ID_STREAM_MIDDLE,
+              ucp_stream_am_middle_handler, ucp_stream_am_dump, 0);
 
 UCP_DEFINE_AM_PROXY(UCP_AM_ID_STREAM_DATA);
+UCP_DEFINE_AM_PROXY(UCP_AM_ID_STREAM_FIRST);
+UCP_DEFINE_AM_PROXY(UCP_AM_ID_STREAM_MIDDLE);
@@ -13,6 +13,9 @@
 #include <ucp/core/ucp_worker.h>
 #include <ucp/core/ucp_context.h>
 #include <ucp/proto/proto_am.inl>
+#include <ucp/proto/proto_common.inl>
+#include <ucp/rndv/rndv.h>
+#include <ucp/rndv/proto_rndv.h>
 #include <ucp/stream/stream.h>
 #include <ucp/dt/dt.h>
 #include <ucp/dt/dt.inl>
@@ -108,13 +111,40 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_stream_send_nb,
 static UCS_F_ALWAYS_INLINE ucs_status_t
 ucp_stream_send_nbx_am_short(ucp_ep_t *ep, const void *buffer, size_t length)
 {
-    if (ucs_likely((ssize_t)length <= ucp_ep_config(ep)->am.max_short)) {
+    /* Note that max_eager_short.memtype_on is always initialized to real
+     * max_short value
+     */
+    if (ucs_likely((ssize_t)length <=
+                   ucp_ep_config(ep)->stream.max_eager_short.memtype_on)) {
         return UCS_PROFILE_CALL(ucp_stream_send_am_short, ep, buffer, length);
     }
 
     return UCS_ERR_NO_RESOURCE;
 }
 
+/*
+ * The receiver assembles the messages of the new protocols in descriptors with
+ * 32-bit length, so larger messages, as well as generic datatypes whose length
+ * is not known in advance, are sent by the legacy protocols.
+ */
+static UCS_F_ALWAYS_INLINE int
+ucp_stream_send_is_proto(ucp_ep_h ep, const void *buffer, size_t count,
+                         ucp_datatype_t datatype, size_t contig_length)
+{
+    if (!ep->worker->context->config.ext.proto_enable) {
+        return 0;
+    }
+
+    switch (datatype & UCP_DATATYPE_CLASS_MASK) {
+    case UCP_DATATYPE_CONTIG:
+        return contig_length <= UINT32_MAX;
+    case UCP_DATATYPE_IOV:
+        return ucp_dt_iov_length(buffer, count) <= UINT32_MAX;
+    default:
+        return 0;
+    }
+}
+
 UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_stream_send_nbx,
                  (ep, buffer, count, param),
                  ucp_ep_h ep, const void *buffer, size_t count,
@@ -122,6 +152,7 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_stream_send_nbx,
 {
     ucp_datatype_t datatype;
     ucp_request_t *req;
+    size_t contig_length;
     size_t length;
     ucs_status_t status;
     ucs_status_ptr_t ret;
@@ -173,6 +204,9 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_stream_send_nbx,
         datatype = ucp_request_param_datatype(param);
     }
 
+    contig_length = UCP_DT_IS_CONTIG(datatype) ?
+                    ucp_contig_dt_length(datatype, count) : 0;
+
     if (ucs_unlikely(param->op_attr_mask & UCP_OP_ATTR_FLAG_FORCE_IMM_CMPL)) {
         ret = UCS_STATUS_PTR(UCS_ERR_NO_RESOURCE);
         goto out;
@@ -184,6 +218,15 @@ UCS_PROFILE_FUNC(ucs_status_ptr_t, ucp_stream_send_nbx,
                                     goto out;
                                 });
 
+    if (ucp_stream_send_is_proto(ep, buffer, count, datatype,
+                                 contig_length)) {
+        ret = ucp_proto_request_send_op(ep, &ucp_ep_config(ep)->proto_select,
+                                        UCP_WORKER_CFG_INDEX_NULL, req,
+                                        UCP_OP_ID_STREAM_SEND, buffer, count,
+                                        datatype, contig_length, param, 0, 0);
+        goto out;
+    }
+
     ucp_stream_send_req_init(req, ep, buffer, datatype, count, flags, param);
 
     ret = ucp_stream_send_req(req, count, &ucp_ep_config(ep)->am, param,
@@ -302,3 +345,100 @@ const ucp_request_send_proto_t ucp_stream_am_proto = {
     .zcopy_completion        = ucp_proto_am_zcopy_completion,
     .only_hdr_size           = sizeof(ucp_stream_am_hdr_t)
 };
+
+static size_t ucp_stream_rndv_rts_pack(void *dest, void *arg)
+{
+    ucp_request_t *sreq = arg;
+
+    return ucp_rndv_rts_pack(sreq, dest, sizeof(ucp_rndv_rts_hdr_t),
+                             UCP_RNDV_RTS_FLAG_STREAM);
+}
+
+static ucs_status_t ucp_stream_rndv_rts_progress(uct_pending_req_t *self)
+{
+    ucp_request_t *sreq = ucs_container_of(self, ucp_request_t, send.uct);
+    size_t max_rts_size;
+    ucs_status_t status;
+
+    max_rts_size = sizeof(ucp_rndv_rts_hdr_t) +
+                   ucp_ep_config(sreq->send.ep)->rndv.rkey_size;
+
+    status = ucp_do_am_single(self, UCP_AM_ID_RNDV_RTS,
+                              ucp_stream_rndv_rts_pack, max_rts_size);
+    return ucp_rndv_rts_handle_status_from_pending(sreq, status);
+}
+
+static ucs_status_t
+ucp_stream_rndv_proto_init(const ucp_proto_init_params_t *init_params)
+{
+    ucp_context_h context                    = init_params->worker->context;
+    ucp_proto_rndv_ctrl_init_params_t params = {
+        .super.super        = *init_params,
+        .super.latency      = 0,
+        .super.overhead     = 40e-9,
+        .super.cfg_thresh   = context->config.ext.rndv_thresh,
+        .super.cfg_priority = 60,
+        .super.flags        = UCP_PROTO_COMMON_INIT_FLAG_RESPONSE,
+        .remote_op_id       = UCP_OP_ID_RNDV_RECV,
+        .perf_bias          = context->config.ext.rndv_perf_diff / 100.0,
+        .mem_info.type      = init_params->select_param->mem_type,
+        .mem_info.sys_dev   = init_params->select_param->sys_dev
+    };
+
+    ucs_status_t status;
+
+    if ((init_params->select_param->op_id != UCP_OP_ID_STREAM_SEND) ||
+        (init_params->select_param->dt_class != UCP_DATATYPE_CONTIG)) {
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    status = ucp_proto_rndv_ctrl_init(&params);
+    if (status == UCS_OK) {
+        return UCS_OK;
+    }
+
+    return ucp_proto_rndv_ctrl_am_lane_init(&params);
+}
+
+/*
+ * The data is transferred by the existing RTS/RTR/ATS flow, and the receiver
+ * fetches it to a staging descriptor which is queued on the stream endpoint
+ * in the order of arrival of the RTS.
+ */
+static ucs_status_t ucp_stream_rndv_proto_progress(uct_pending_req_t *self)
+{
+    ucp_request_t *req          = ucs_container_of(self, ucp_request_t,
+                                                   send.uct);
+    ucp_datatype_iter_t dt_iter = req->send.state.dt_iter;
+    ucs_status_t status;
+
+    ucs_assert(dt_iter.dt_class == UCP_DATATYPE_CONTIG);
+
+    req->send.buffer       = dt_iter.type.contig.buffer;
+    req->send.datatype     = ucp_dt_make_contig(1);
+    req->send.length       = dt_iter.length;
+    req->send.mem_type     = dt_iter.mem_info.type;
+    req->send.lane         = ucp_ep_get_am_lane(req->send.ep);
+    req->send.pending_lane = UCP_NULL_LANE;
+    ucp_request_send_state_init(req, req->send.datatype, req->send.length);
+
+    ucp_send_request_set_id(req);
+    req->send.uct.func = ucp_stream_rndv_rts_progress;
+
+    status = ucp_rndv_reg_send_buffer(req);
+    if (status != UCS_OK) {
+        ucp_request_complete_send(req, status);
+        return UCS_OK;
+    }
+
+    return req->send.uct.func(self);
+}
+
+static ucp_proto_t ucp_stream_rndv_proto = {
+    .name       = "stream/rndv",
+    .flags      = 0,
+    .init       = ucp_stream_rndv_proto_init,
+    .config_str = ucp_proto_rndv_ctrl_config_str,
+    .progress   = ucp_stream_rndv_proto_progress
+};
+UCP_PROTO_REGISTER(&ucp_stream_rndv_proto);
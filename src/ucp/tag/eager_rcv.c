@@ -225,6 +225,197 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_eager_middle_handler,
                                            0);
 }
 
+/* State of an eager fragment whose payload is received directly by the
+ * transport, allocated from the worker AM memory pool */
+typedef struct {
+    uct_completion_t comp;
+    ucp_worker_h     worker;
+    ucp_request_t    *req;
+    uint64_t         msg_id;
+    size_t           offset;
+    size_t           length;
+    void             *bounce; /* Temporary buffer, if the data must be unpacked */
+} ucp_eager_recv_direct_t;
+
+
+static UCS_F_ALWAYS_INLINE int
+ucp_eager_recv_direct_is_contig(ucp_request_t *req, size_t offset,
+                                size_t length)
+{
+    return (req->status == UCS_OK) &&
+           UCP_DT_IS_CONTIG(req->recv.datatype) &&
+           (req->recv.mem_type == UCS_MEMORY_TYPE_HOST) &&
+           ((offset + length) <= req->recv.length);
+}
+
+static void ucp_eager_recv_direct_completion(uct_completion_t *self)
+{
+    ucp_eager_recv_direct_t *rd = ucs_container_of(self,
+                                                   ucp_eager_recv_direct_t,
+                                                   comp);
+    ucp_request_t *req          = rd->req;
+    ucp_tag_match_t *tm         = &rd->worker->tm;
+    khiter_t iter;
+    int last;
+
+    last = (req->recv.remaining == rd->length);
+
+    if (ucs_likely(req->status == UCS_OK)) {
+        if (ucs_unlikely(self->status != UCS_OK)) {
+            req->status = self->status;
+        } else if (rd->bounce != NULL) {
+            req->status = ucp_request_recv_data_unpack(req, rd->bounce,
+                                                       rd->length, rd->offset,
+                                                       last);
+        }
+    }
+
+    ucs_free(rd->bounce);
+
+    ucs_assertv(req->recv.remaining >= rd->length,
+                "req->recv.remaining=%zu length=%zu", req->recv.remaining,
+                rd->length);
+    req->recv.remaining -= rd->length;
+
+    if (last) {
+        /* the request could be on the fragments hash if other fragments are
+         * still expected, or if the first fragment is not the last one */
+        iter = kh_get(ucp_tag_frag_hash, &tm->frag_hash, rd->msg_id);
+        if (iter != kh_end(&tm->frag_hash)) {
+            kh_del(ucp_tag_frag_hash, &tm->frag_hash, iter);
+        }
+
+        ucp_request_complete_tag_recv(req, req->status);
+    }
+
+    ucs_mpool_put_inline(rd);
+}
+
+static UCS_F_ALWAYS_INLINE ucp_eager_recv_direct_t*
+ucp_eager_recv_direct_get(ucp_worker_h worker)
+{
+    ucp_eager_recv_direct_t *rd;
+
+    UCS_STATIC_ASSERT(sizeof(*rd) <=
+                      (sizeof(ucp_recv_desc_t) + UCP_WORKER_HEADROOM_PRIV_SIZE));
+
+    rd = ucs_mpool_get_inline(&worker->am_mp);
+    if (rd == NULL) {
+        return NULL;
+    }
+
+    rd->comp.func   = ucp_eager_recv_direct_completion;
+    rd->comp.count  = 1;
+    rd->comp.status = UCS_OK;
+    rd->worker      = worker;
+    rd->bounce      = NULL;
+    return rd;
+}
+
+static UCS_F_ALWAYS_INLINE void
+ucp_eager_recv_direct_start(ucp_eager_recv_direct_t *rd, ucp_request_t *req,
+                            uint64_t msg_id, size_t offset, size_t length,
+                            void **payload_p, uct_completion_t **comp_p)
+{
+    rd->req    = req;
+    rd->msg_id = msg_id;
+    rd->offset = offset;
+    rd->length = length;
+    *payload_p = UCS_PTR_BYTE_OFFSET(req->recv.buffer, offset);
+    *comp_p    = &rd->comp;
+}
+
+static ucs_status_t
+ucp_eager_first_recv_direct(void *arg, void *data, size_t length,
+                            void **payload_p, uct_completion_t **comp_p)
+{
+    ucp_worker_h worker               = arg;
+    ucp_eager_first_hdr_t *eagerf_hdr = data;
+    size_t recv_len                   = length - sizeof(*eagerf_hdr);
+    ucp_eager_recv_direct_t *rd;
+    ucp_request_t *req;
+
+    rd = ucp_eager_recv_direct_get(worker);
+    if (rd == NULL) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    req = ucp_tag_exp_search(&worker->tm, eagerf_hdr->super.super.tag);
+    if (req == NULL) {
+        /* unexpected message is stored by the active message handler */
+        ucs_mpool_put_inline(rd);
+        return UCS_ERR_NO_ELEM;
+    }
+
+    ucp_eager_expected_handler(worker, req, data, recv_len,
+                               eagerf_hdr->super.super.tag,
+                               UCP_RECV_DESC_FLAG_EAGER);
+
+    req->recv.tag.info.length =
+    req->recv.remaining       = eagerf_hdr->total_len;
+
+    /* The request was already removed from the expected queue, so the payload
+     * has to be received even if it cannot be placed in the user buffer */
+    if (!ucp_eager_recv_direct_is_contig(req, 0, recv_len)) {
+        rd->bounce = ucs_malloc(recv_len, "eager_recv_direct");
+        if (rd->bounce == NULL) {
+            ucs_error("failed to allocate %zu bytes for eager receive",
+                      recv_len);
+            ucs_mpool_put_inline(rd);
+            return UCS_ERR_NO_MEMORY;
+        }
+    }
+
+    ucp_eager_recv_direct_start(rd, req, eagerf_hdr->msg_id, 0, recv_len,
+                                payload_p, comp_p);
+    if (rd->bounce != NULL) {
+        *payload_p = rd->bounce;
+    }
+
+    ucp_tag_frag_list_process_queue(&worker->tm, req, eagerf_hdr->msg_id
+                                    UCS_STATS_ARG(UCP_WORKER_STAT_TAG_RX_EAGER_CHUNK_EXP));
+    return UCS_OK;
+}
+
+static ucs_status_t
+ucp_eager_middle_recv_direct(void *arg, void *data, size_t length,
+                             void **payload_p, uct_completion_t **comp_p)
+{
+    ucp_worker_h worker         = arg;
+    ucp_eager_middle_hdr_t *hdr = data;
+    size_t recv_len             = length - sizeof(*hdr);
+    ucp_tag_frag_match_t *matchq;
+    ucp_eager_recv_direct_t *rd;
+    ucp_request_t *req;
+    khiter_t iter;
+
+    iter = kh_get(ucp_tag_frag_hash, &worker->tm.frag_hash, hdr->msg_id);
+    if (iter == kh_end(&worker->tm.frag_hash)) {
+        return UCS_ERR_NO_ELEM;
+    }
+
+    matchq = &kh_value(&worker->tm.frag_hash, iter);
+    if (ucp_tag_frag_match_is_unexp(matchq)) {
+        return UCS_ERR_NO_ELEM;
+    }
+
+    req = matchq->exp_req;
+    if (!ucp_eager_recv_direct_is_contig(req, hdr->offset, recv_len)) {
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    rd = ucp_eager_recv_direct_get(worker);
+    if (rd == NULL) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    UCP_WORKER_STAT_EAGER_CHUNK(worker, EXP);
+
+    ucp_eager_recv_direct_start(rd, req, hdr->msg_id, hdr->offset, recv_len,
+                                payload_p, comp_p);
+    return UCS_OK;
+}
+
 UCS_PROFILE_FUNC(ucs_status_t, ucp_eager_sync_only_handler,
                  (arg, data, length, am_flags),
                  void *arg, void *data, size_t length, unsigned am_flags)
@@ -519,6 +710,11 @@ UCP_DEFINE_AM(UCP_FEATURE_TAG, UCP_AM_ID_EAGER_SYNC_ACK,
 UCP_DEFINE_AM(UCP_FEATURE_TAG, UCP_AM_ID_OFFLOAD_SYNC_ACK,
               ucp_eager_offload_sync_ack_handler, ucp_eager_dump, 0);
 
+UCP_DEFINE_AM_RECV_DIRECT(UCP_AM_ID_EAGER_FIRST, ucp_eager_first_recv_direct,
+                          sizeof(ucp_eager_first_hdr_t));
+UCP_DEFINE_AM_RECV_DIRECT(UCP_AM_ID_EAGER_MIDDLE, ucp_eager_middle_recv_direct,
+                          sizeof(ucp_eager_middle_hdr_t));
+
 UCP_DEFINE_AM_PROXY(UCP_AM_ID_EAGER_ONLY);
 UCP_DEFINE_AM_PROXY(UCP_AM_ID_EAGER_FIRST);
 UCP_DEFINE_AM_PROXY(UCP_AM_ID_EAGER_MIDDLE);
@@ -1164,7 +1164,8 @@ ucp_wireup_add_am_bw_lanes(const ucp_wireup_select_params_t *select_params,
 
     /* Check if we need active message BW lanes */
     if (!(ucp_ep_get_context_features(ep) & (UCP_FEATURE_TAG |
-                                             UCP_FEATURE_AM)) ||
+                                             UCP_FEATURE_AM |
+                                             UCP_FEATURE_STREAM)) ||
         (ep_init_flags & UCP_EP_INIT_FLAG_MEM_TYPE) ||
         (context->config.ext.max_eager_lanes < 2)) {
         return UCS_OK;
@@ -1252,7 +1253,7 @@ ucp_wireup_add_rma_bw_lanes(const ucp_wireup_select_params_t *select_params,
     if (ep_init_flags & UCP_EP_INIT_FLAG_MEM_TYPE) {
         md_reg_flag = 0;
     } else if (ucp_ep_get_context_features(ep) &
-               (UCP_FEATURE_TAG | UCP_FEATURE_AM)) {
+               (UCP_FEATURE_TAG | UCP_FEATURE_AM | UCP_FEATURE_STREAM)) {
         /* if needed for RNDV, need only access for remote registered memory */
         md_reg_flag = UCT_MD_FLAG_REG;
     } else {
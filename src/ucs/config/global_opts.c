@@ -14,6 +14,7 @@
 #include <ucs/profile/profile.h>
 #include <ucs/debug/assert.h>
 #include <ucs/debug/log.h>
+#include <ucs/memory/numa.h>
 #include <ucs/sys/compiler.h>
 #include <ucs/sys/string.h>
 #include <sys/signal.h>
@@ -28,6 +29,8 @@ ucs_global_opts_t ucs_global_opts = {
     .log_buffer_size       = 1024,
     .log_data_size         = 0,
     .mpool_fifo            = 0,
+    .mpool_numa_placement  = UCS_NUMA_PLACEMENT_DEFAULT,
+    .mpool_numa_node       = 0,
     .handle_errors         = UCS_BIT(UCS_HANDLE_ERROR_BACKTRACE),
     .error_signals         = { NULL, 0 },
     .error_mail_to         = "",
@@ -110,6 +113,20 @@ static ucs_config_field_t ucs_global_opts_table[] = {
   ucs_offsetof(ucs_global_opts_t, mpool_fifo), UCS_CONFIG_TYPE_BOOL},
 #endif
 
+ {"MPOOL_NUMA_PLACEMENT", "default",
+  "NUMA placement of memory pool chunks allocated from the heap, by mmap or\n"
+  "from huge pages:\n"
+  " default    - Do not set a memory policy, pages are placed on first touch.\n"
+  " local      - Prefer the NUMA node of the CPU which allocates the chunk.\n"
+  " interleave - Interleave the pages over all NUMA nodes.\n"
+  " node       - Prefer the NUMA node specified by UCX_MPOOL_NUMA_NODE.",
+  ucs_offsetof(ucs_global_opts_t, mpool_numa_placement),
+  UCS_CONFIG_TYPE_ENUM(ucs_numa_placement_names)},
+
+ {"MPOOL_NUMA_NODE", "0",
+  "NUMA node for memory pool chunks when UCX_MPOOL_NUMA_PLACEMENT=node.",
+  ucs_offsetof(ucs_global_opts_t, mpool_numa_node), UCS_CONFIG_TYPE_UINT},
+
  {"HANDLE_ERRORS",
 #if ENABLE_DEBUG_DATA
   "bt,freeze",
@@ -52,6 +52,12 @@ typedef struct {
      * debugging because object pointers are not recycled. */
     int                        mpool_fifo;
 
+    /* NUMA placement of memory pool chunks */
+    ucs_numa_placement_t       mpool_numa_placement;
+
+    /* NUMA node of memory pool chunks, used with "node" placement */
+    unsigned                   mpool_numa_node;
+
     /* Handle errors mode */
     unsigned                   handle_errors;
 
@@ -70,6 +70,20 @@ typedef enum ucs_on_off_auto_value {
 } ucs_on_off_auto_value_t;
 
 
+/**
+ * Placement of internal memory buffers (memory pool chunks, shared memory
+ * FIFOs) on NUMA nodes.
+ */
+typedef enum {
+    UCS_NUMA_PLACEMENT_DEFAULT,    /* Do not set a policy, use first-touch */
+    UCS_NUMA_PLACEMENT_LOCAL,      /* Prefer the node of the CPU which the
+                                      allocating thread is running on */
+    UCS_NUMA_PLACEMENT_INTERLEAVE, /* Interleave pages over all nodes */
+    UCS_NUMA_PLACEMENT_NODE,       /* Prefer an explicitly specified node */
+    UCS_NUMA_PLACEMENT_LAST
+} ucs_numa_placement_t;
+
+
 /**
  * Error handling modes
  */
@@ -12,12 +12,24 @@
 #include "mpool.inl"
 #include "queue.h"
 
+#include <ucs/arch/cpu.h>
 #include <ucs/debug/log.h>
+#include <ucs/debug/memtrack.h>
+#include <ucs/config/global_opts.h>
+#include <ucs/memory/numa.h>
 #include <ucs/sys/math.h>
 #include <ucs/sys/checker.h>
 #include <ucs/sys/sys.h>
 
 
+__thread int ucs_mpool_thread_index = -1;
+
+static pthread_mutex_t ucs_mpool_thread_index_lock = PTHREAD_MUTEX_INITIALIZER;
+static uint8_t ucs_mpool_thread_index_used[UCS_MPOOL_TCACHE_MAX_THREADS];
+static pthread_once_t ucs_mpool_thread_index_once = PTHREAD_ONCE_INIT;
+static pthread_key_t ucs_mpool_thread_index_key;
+
+
 static inline unsigned ucs_mpool_elem_total_size(ucs_mpool_data_t *data)
 {
     return ucs_align_up_pow2(data->elem_size, data->alignment);
@@ -68,6 +80,7 @@ ucs_status_t ucs_mpool_init(ucs_mpool_t *mp, size_t priv_size,
     }
 
     mp->freelist              = NULL;
+    mp->tcaches               = NULL;
     mp->data->elem_size       = sizeof(ucs_mpool_elem_t) + elem_size;
     mp->data->alignment       = alignment;
     mp->data->align_offset    = sizeof(ucs_mpool_elem_t) + align_offset;
@@ -77,6 +90,7 @@ ucs_status_t ucs_mpool_init(ucs_mpool_t *mp, size_t priv_size,
     mp->data->chunks          = NULL;
     mp->data->ops             = ops;
     mp->data->name            = ucs_strdup(name, "mpool_data_name");
+    mp->data->tcache_size     = 0;
 
     if (mp->data->name == NULL) {
         ucs_error("Failed to allocate memory pool data name");
@@ -95,13 +109,230 @@ err_strdup:
     return UCS_ERR_NO_MEMORY;
 }
 
+static void ucs_mpool_thread_index_release(void *arg)
+{
+    int index = (uintptr_t)arg - 1;
+
+    /* Per-thread caches of this index remain in the memory pools, and will be
+     * used by the next thread which gets the same index */
+    pthread_mutex_lock(&ucs_mpool_thread_index_lock);
+    ucs_mpool_thread_index_used[index] = 0;
+    pthread_mutex_unlock(&ucs_mpool_thread_index_lock);
+    ucs_mpool_thread_index = -1;
+}
+
+static void ucs_mpool_thread_index_key_init(void)
+{
+    int ret;
+
+    ret = pthread_key_create(&ucs_mpool_thread_index_key,
+                             ucs_mpool_thread_index_release);
+    if (ret != 0) {
+        ucs_fatal("pthread_key_create() failed: %m");
+    }
+}
+
+static int ucs_mpool_thread_index_get(void)
+{
+    int index;
+
+    if (ucs_likely(ucs_mpool_thread_index >= 0)) {
+        return ucs_mpool_thread_index;
+    }
+
+    pthread_once(&ucs_mpool_thread_index_once, ucs_mpool_thread_index_key_init);
+
+    pthread_mutex_lock(&ucs_mpool_thread_index_lock);
+    for (index = 0; index < UCS_MPOOL_TCACHE_MAX_THREADS; ++index) {
+        if (!ucs_mpool_thread_index_used[index]) {
+            ucs_mpool_thread_index_used[index] = 1;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&ucs_mpool_thread_index_lock);
+
+    if (index == UCS_MPOOL_TCACHE_MAX_THREADS) {
+        return -1;
+    }
+
+    /* Store index+1, since NULL value would not invoke the destructor */
+    pthread_setspecific(ucs_mpool_thread_index_key, (void*)(uintptr_t)(index + 1));
+    ucs_mpool_thread_index = index;
+    return index;
+}
+
+/* Returns the cache of the calling thread, or NULL if it cannot be created */
+static ucs_mpool_tcache_t *ucs_mpool_tcache_get_or_create(ucs_mpool_t *mp)
+{
+    ucs_mpool_tcache_t *tcache;
+    int index, ret;
+
+    index = ucs_mpool_thread_index_get();
+    if (index < 0) {
+        return NULL;
+    }
+
+    if (ucs_likely(mp->tcaches[index] != NULL)) {
+        return mp->tcaches[index];
+    }
+
+    /* Only the owner thread creates and accesses its cache */
+    ret = ucs_posix_memalign((void**)&tcache, UCS_SYS_CACHE_LINE_SIZE,
+                             sizeof(*tcache) +
+                             (mp->data->tcache_size * sizeof(*tcache->elems)),
+                             "mpool_tcache");
+    if (ret != 0) {
+        ucs_debug("mpool %s: failed to allocate thread cache",
+                  ucs_mpool_name(mp));
+        return NULL;
+    }
+
+    tcache->count       = 0;
+    tcache->size        = mp->data->tcache_size;
+    mp->tcaches[index]  = tcache;
+    return tcache;
+}
+
+/* Lock must be held */
+static ucs_mpool_elem_t *ucs_mpool_freelist_pull(ucs_mpool_t *mp)
+{
+    ucs_mpool_elem_t *elem;
+
+    if (mp->freelist == NULL) {
+        ucs_mpool_grow(mp, mp->data->elems_per_chunk);
+        if (mp->freelist == NULL) {
+            return NULL;
+        }
+    }
+
+    elem = mp->freelist;
+    VALGRIND_MAKE_MEM_DEFINED(elem, sizeof *elem);
+    mp->freelist = elem->next;
+    VALGRIND_MAKE_MEM_NOACCESS(elem, sizeof *elem);
+    return elem;
+}
+
+/* Lock must be held */
+static void ucs_mpool_tcache_flush(ucs_mpool_t *mp, ucs_mpool_tcache_t *tcache,
+                                   unsigned count)
+{
+    ucs_mpool_elem_t *elem;
+
+    while (tcache->count > count) {
+        elem = tcache->elems[--tcache->count];
+        VALGRIND_MAKE_MEM_DEFINED(elem, sizeof *elem);
+        ucs_mpool_add_to_freelist(mp, elem, 0);
+        VALGRIND_MAKE_MEM_NOACCESS(elem, sizeof *elem);
+    }
+}
+
+ucs_status_t ucs_mpool_tcache_enable(ucs_mpool_t *mp, unsigned tcache_size)
+{
+    ucs_status_t status;
+
+    if (tcache_size < 2) {
+        ucs_error("mpool %s: invalid thread cache size %u",
+                  ucs_mpool_name(mp), tcache_size);
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    ucs_assert(mp->tcaches == NULL);
+    ucs_assert(mp->data->chunks == NULL);
+
+    status = ucs_spinlock_init(&mp->data->tcache_lock, 0);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    mp->tcaches = ucs_calloc(UCS_MPOOL_TCACHE_MAX_THREADS,
+                             sizeof(*mp->tcaches), "mpool_tcaches");
+    if (mp->tcaches == NULL) {
+        ucs_error("mpool %s: failed to allocate thread caches",
+                  ucs_mpool_name(mp));
+        ucs_spinlock_destroy(&mp->data->tcache_lock);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    mp->data->tcache_size = tcache_size;
+    ucs_debug("mpool %s: enabled thread cache of %u elements",
+              ucs_mpool_name(mp), tcache_size);
+    return UCS_OK;
+}
+
+void *ucs_mpool_tcache_get_slow(ucs_mpool_t *mp)
+{
+    ucs_mpool_tcache_t *tcache = ucs_mpool_tcache_get_or_create(mp);
+    ucs_mpool_elem_t *elem;
+
+    ucs_spin_lock(&mp->data->tcache_lock);
+    if (tcache == NULL) {
+        elem = ucs_mpool_freelist_pull(mp);
+        ucs_spin_unlock(&mp->data->tcache_lock);
+        if (elem == NULL) {
+            return NULL;
+        }
+
+        VALGRIND_MAKE_MEM_DEFINED(elem, sizeof *elem);
+        elem->mpool = mp;
+        VALGRIND_MAKE_MEM_NOACCESS(elem, sizeof *elem);
+        VALGRIND_MEMPOOL_ALLOC(mp, elem + 1,
+                               mp->data->elem_size - sizeof(ucs_mpool_elem_t));
+        return elem + 1;
+    }
+
+    /* Refill half of the cache in one go */
+    while (tcache->count < (tcache->size / 2)) {
+        elem = ucs_mpool_freelist_pull(mp);
+        if (elem == NULL) {
+            break;
+        }
+        tcache->elems[tcache->count++] = elem;
+    }
+    ucs_spin_unlock(&mp->data->tcache_lock);
+
+    if (tcache->count == 0) {
+        return NULL;
+    }
+
+    return ucs_mpool_tcache_get_inline(mp);
+}
+
+void ucs_mpool_tcache_put_slow(ucs_mpool_t *mp, ucs_mpool_elem_t *elem)
+{
+    ucs_mpool_tcache_t *tcache = ucs_mpool_tcache_get_or_create(mp);
+
+    ucs_spin_lock(&mp->data->tcache_lock);
+    if (tcache == NULL) {
+        ucs_mpool_add_to_freelist(mp, elem, 0);
+    } else {
+        /* Flush half of the cache in one go, to leave room for next puts */
+        ucs_mpool_tcache_flush(mp, tcache, tcache->size / 2);
+        tcache->elems[tcache->count++] = elem;
+    }
+    ucs_spin_unlock(&mp->data->tcache_lock);
+}
+
 void ucs_mpool_cleanup(ucs_mpool_t *mp, int leak_check)
 {
     ucs_mpool_chunk_t *chunk, *next_chunk;
     ucs_mpool_elem_t *elem, *next_elem;
     ucs_mpool_data_t *data = mp->data;
+    unsigned index;
     void *obj;
 
+    /* Return all elements from per-thread caches to the free list */
+    if (mp->tcaches != NULL) {
+        for (index = 0; index < UCS_MPOOL_TCACHE_MAX_THREADS; ++index) {
+            if (mp->tcaches[index] != NULL) {
+                ucs_mpool_tcache_flush(mp, mp->tcaches[index], 0);
+                ucs_free(mp->tcaches[index]);
+            }
+        }
+        ucs_free(mp->tcaches);
+        mp->tcaches = NULL;
+        ucs_spinlock_destroy(&data->tcache_lock);
+    }
+
     /* Cleanup all elements in the freelist and set their header to NULL to mark
      * them as released for the leak check.
      */
@@ -158,6 +389,15 @@ const char *ucs_mpool_name(ucs_mpool_t *mp)
 
 int ucs_mpool_is_empty(ucs_mpool_t *mp)
 {
+    ucs_mpool_tcache_t *tcache;
+
+    if (mp->tcaches != NULL) {
+        tcache = ucs_mpool_tcache_lookup(mp);
+        if ((tcache != NULL) && (tcache->count > 0)) {
+            return 0;
+        }
+    }
+
     return (mp->freelist == NULL) && (mp->data->quota == 0);
 }
 
@@ -243,10 +483,35 @@ void *ucs_mpool_get_grow(ucs_mpool_t *mp)
     return ucs_mpool_get(mp);
 }
 
+static void ucs_mpool_chunk_numa_bind(ucs_mpool_t *mp, void *chunk,
+                                      size_t size)
+{
+    ucs_numa_placement_t placement = ucs_global_opts.mpool_numa_placement;
+    ucs_status_t status;
+
+    if (placement == UCS_NUMA_PLACEMENT_DEFAULT) {
+        return;
+    }
+
+    /* Placement is best-effort, the chunk is usable anyway */
+    status = ucs_numa_mem_bind(chunk, size, placement,
+                               ucs_global_opts.mpool_numa_node);
+    if (status != UCS_OK) {
+        ucs_debug("mpool %s: failed to set %s NUMA placement of chunk %p: %s",
+                  ucs_mpool_name(mp), ucs_numa_placement_names[placement],
+                  chunk, ucs_status_string(status));
+    }
+}
+
 ucs_status_t ucs_mpool_chunk_malloc(ucs_mpool_t *mp, size_t *size_p, void **chunk_p)
 {
     *chunk_p = ucs_malloc(*size_p, ucs_mpool_name(mp));
-    return (*chunk_p == NULL) ? UCS_ERR_NO_MEMORY : UCS_OK;
+    if (*chunk_p == NULL) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    ucs_mpool_chunk_numa_bind(mp, *chunk_p, *size_p);
+    return UCS_OK;
 }
 
 void ucs_mpool_chunk_free(ucs_mpool_t *mp, void *chunk)
@@ -271,6 +536,8 @@ ucs_status_t ucs_mpool_chunk_mmap(ucs_mpool_t *mp, size_t *size_p, void **chunk_
         return UCS_ERR_NO_MEMORY;
     }
 
+    ucs_mpool_chunk_numa_bind(mp, chunk, real_size);
+
     chunk->size = real_size;
     *size_p     = real_size - sizeof(*chunk);
     *chunk_p    = chunk + 1;
@@ -324,6 +591,7 @@ ucs_status_t ucs_mpool_hugetlb_malloc(ucs_mpool_t *mp, size_t *size_p, void **ch
     return UCS_ERR_NO_MEMORY;
 
 out_ok:
+    ucs_mpool_chunk_numa_bind(mp, chunk, real_size);
     *size_p  = real_size - sizeof(*chunk);
     *chunk_p = chunk + 1;
     return UCS_OK;
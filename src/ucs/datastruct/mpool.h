@@ -9,6 +9,7 @@
 
 #include <stddef.h>
 #include <ucs/type/status.h>
+#include <ucs/type/spinlock.h>
 #include <ucs/sys/compiler_def.h>
 
 BEGIN_C_DECLS
@@ -20,6 +21,14 @@ typedef union  ucs_mpool_elem    ucs_mpool_elem_t;
 typedef struct ucs_mpool         ucs_mpool_t;
 typedef struct ucs_mpool_data    ucs_mpool_data_t;
 typedef struct ucs_mpool_ops     ucs_mpool_ops_t;
+typedef struct ucs_mpool_tcache  ucs_mpool_tcache_t;
+
+
+/**
+ * Maximal number of threads which can have a per-thread cache in a memory pool.
+ * Other threads use the shared free list.
+ */
+#define UCS_MPOOL_TCACHE_MAX_THREADS 128
 
 
 /**
@@ -64,6 +73,19 @@ struct ucs_mpool_chunk {
 struct ucs_mpool {
     ucs_mpool_elem_t       *freelist;  /* List of available elements */
     ucs_mpool_data_t       *data;      /* Slow-path data */
+    ucs_mpool_tcache_t     **tcaches;  /* Per-thread caches, indexed by thread
+                                          index, or NULL if disabled */
+};
+
+
+/**
+ * Per-thread cache of free elements (magazine). It is accessed only by the
+ * owning thread, and refilled from / flushed to the shared free list in bulk.
+ */
+struct ucs_mpool_tcache {
+    unsigned               count;      /* Number of cached elements */
+    unsigned               size;       /* Maximal number of cached elements */
+    ucs_mpool_elem_t       *elems[0];  /* Stack of cached elements */
 };
 
 
@@ -80,6 +102,10 @@ struct ucs_mpool_data {
     ucs_mpool_chunk_t      *chunks;         /* List of allocated chunks */
     ucs_mpool_ops_t        *ops;            /* Memory pool operations */
     char                   *name;           /* Name - used for debugging */
+    unsigned               tcache_size;     /* Per-thread cache size, 0 - disabled */
+    ucs_spinlock_t         tcache_lock;     /* Protects the free list and the
+                                               chunks if per-thread caches are
+                                               enabled */
 };
 
 
@@ -152,6 +178,23 @@ ucs_status_t ucs_mpool_init(ucs_mpool_t *mp, size_t priv_size,
                             ucs_mpool_ops_t *ops, const char *name);
 
 
+/**
+ * Enable per-thread caches of free elements in a memory pool. Must be called
+ * right after @ref ucs_mpool_init, before any element is allocated.
+ *
+ * When enabled, get/put operations on the memory pool are thread-safe and do
+ * not require an external lock. Every thread keeps up to @a tcache_size free
+ * elements in a local cache, which is refilled from or flushed to the shared
+ * free list in bulk of @a tcache_size / 2 elements.
+ *
+ * @param mp               Memory pool structure.
+ * @param tcache_size      Maximal number of elements in a per-thread cache.
+ *
+ * @return UCS status code.
+ */
+ucs_status_t ucs_mpool_tcache_enable(ucs_mpool_t *mp, unsigned tcache_size);
+
+
 /**
  * Cleanup a memory pool and release all its memory.
  *
@@ -226,6 +269,27 @@ void ucs_mpool_grow(ucs_mpool_t *mp, unsigned num_elems);
 void *ucs_mpool_get_grow(ucs_mpool_t *mp);
 
 
+/**
+ * Allocate an object when the per-thread cache of the calling thread is empty
+ * or was not created yet. Used internally by ucs_mpool_get().
+ *
+ * @param mp               Memory pool structure.
+ *
+ * @return New allocated object, or NULL if cannot allocate.
+ */
+void *ucs_mpool_tcache_get_slow(ucs_mpool_t *mp);
+
+
+/**
+ * Return an object when the per-thread cache of the calling thread is full
+ * or was not created yet. Used internally by ucs_mpool_put().
+ *
+ * @param mp               Memory pool structure.
+ * @param elem             Element to return.
+ */
+void ucs_mpool_tcache_put_slow(ucs_mpool_t *mp, ucs_mpool_elem_t *elem);
+
+
 /**
  * heap-based chunk allocator.
  */
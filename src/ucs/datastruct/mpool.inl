@@ -14,11 +14,47 @@
 #include <ucs/sys/sys.h>
 
 
+/* Index of the calling thread in memory pool per-thread caches, or -1 */
+extern __thread int ucs_mpool_thread_index;
+
+
+static UCS_F_ALWAYS_INLINE ucs_mpool_tcache_t *
+ucs_mpool_tcache_lookup(ucs_mpool_t *mp)
+{
+    int index = ucs_mpool_thread_index;
+
+    return ucs_likely(index >= 0) ? mp->tcaches[index] : NULL;
+}
+
+static UCS_F_ALWAYS_INLINE void *ucs_mpool_tcache_get_inline(ucs_mpool_t *mp)
+{
+    ucs_mpool_tcache_t *tcache = ucs_mpool_tcache_lookup(mp);
+    ucs_mpool_elem_t *elem;
+    void *obj;
+
+    if (ucs_unlikely((tcache == NULL) || (tcache->count == 0))) {
+        return ucs_mpool_tcache_get_slow(mp);
+    }
+
+    elem = tcache->elems[--tcache->count];
+    VALGRIND_MAKE_MEM_DEFINED(elem, sizeof *elem);
+    elem->mpool = mp;
+    VALGRIND_MAKE_MEM_NOACCESS(elem, sizeof *elem);
+
+    obj = elem + 1;
+    VALGRIND_MEMPOOL_ALLOC(mp, obj, mp->data->elem_size - sizeof(ucs_mpool_elem_t));
+    return obj;
+}
+
 static inline void *ucs_mpool_get_inline(ucs_mpool_t *mp)
 {
     ucs_mpool_elem_t *elem;
     void *obj;
 
+    if (mp->tcaches != NULL) {
+        return ucs_mpool_tcache_get_inline(mp);
+    }
+
     if (ucs_unlikely(mp->freelist == NULL)) {
         return ucs_mpool_get_grow(mp);
     }
@@ -71,11 +107,25 @@ static inline ucs_mpool_t *ucs_mpool_obj_owner(void *obj)
 
 static inline void ucs_mpool_put_inline(void *obj)
 {
+    ucs_mpool_tcache_t *tcache;
     ucs_mpool_elem_t *elem;
     ucs_mpool_t *mp;
 
     elem = ucs_mpool_obj_to_elem(obj);
     mp   = elem->mpool;
+
+    if (mp->tcaches != NULL) {
+        tcache = ucs_mpool_tcache_lookup(mp);
+        if (ucs_likely((tcache != NULL) && (tcache->count < tcache->size))) {
+            tcache->elems[tcache->count++] = elem;
+        } else {
+            ucs_mpool_tcache_put_slow(mp, elem);
+        }
+        VALGRIND_MAKE_MEM_NOACCESS(elem, sizeof *elem);
+        VALGRIND_MEMPOOL_FREE(mp, obj);
+        return;
+    }
+
     ucs_mpool_add_to_freelist(mp, elem,
                               ENABLE_DEBUG_DATA && ucs_global_opts.mpool_fifo);
     VALGRIND_MAKE_MEM_NOACCESS(elem, sizeof *elem);
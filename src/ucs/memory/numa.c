@@ -12,6 +12,8 @@
 
 #include <ucs/debug/assert.h>
 #include <ucs/debug/log.h>
+#include <ucs/sys/math.h>
+#include <ucs/sys/sys.h>
 #include <stdint.h>
 #include <sched.h>
 
@@ -23,6 +25,14 @@ const char *ucs_numa_policy_names[] = {
     [UCS_NUMA_POLICY_LAST]      = NULL,
 };
 
+const char *ucs_numa_placement_names[] = {
+    [UCS_NUMA_PLACEMENT_DEFAULT]    = "default",
+    [UCS_NUMA_PLACEMENT_LOCAL]      = "local",
+    [UCS_NUMA_PLACEMENT_INTERLEAVE] = "interleave",
+    [UCS_NUMA_PLACEMENT_NODE]       = "node",
+    [UCS_NUMA_PLACEMENT_LAST]       = NULL
+};
+
 #if HAVE_NUMA
 
 
@@ -71,4 +81,150 @@ int ucs_numa_node_of_cpu(int cpu)
     return cpu_numa_nodes[cpu] - 1;
 }
 
+int ucs_numa_num_nodes(void)
+{
+    if (numa_available() < 0) {
+        return 1;
+    }
+
+    return numa_num_configured_nodes();
+}
+
+int ucs_numa_current_node(void)
+{
+    int cpu;
+
+    if (numa_available() < 0) {
+        return -1;
+    }
+
+    cpu = sched_getcpu();
+    if (cpu < 0) {
+        return -1;
+    }
+
+    return ucs_numa_node_of_cpu(cpu);
+}
+
+ucs_status_t ucs_numa_mem_bind(void *address, size_t length,
+                               ucs_numa_placement_t placement, int node)
+{
+    size_t page_size = ucs_get_page_size();
+    struct bitmask *nodemask;
+    uintptr_t start, end;
+    ucs_status_t status;
+    int mode, ret;
+
+    if (placement == UCS_NUMA_PLACEMENT_DEFAULT) {
+        return UCS_OK;
+    }
+
+    if (numa_available() < 0) {
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    start = ucs_align_up_pow2((uintptr_t)address, page_size);
+    end   = ucs_align_down_pow2((uintptr_t)address + length, page_size);
+    if (start >= end) {
+        return UCS_OK;
+    }
+
+    nodemask = numa_allocate_nodemask();
+    if (nodemask == NULL) {
+        ucs_warn("failed to allocate NUMA node mask");
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    numa_bitmask_clearall(nodemask);
+
+    switch (placement) {
+    case UCS_NUMA_PLACEMENT_LOCAL:
+        node = ucs_numa_current_node();
+        /* fall through */
+    case UCS_NUMA_PLACEMENT_NODE:
+        if ((node < 0) || (node > numa_max_node())) {
+            ucs_debug("invalid NUMA node %d for %s placement", node,
+                      ucs_numa_placement_names[placement]);
+            status = UCS_ERR_INVALID_PARAM;
+            goto out_free_nodemask;
+        }
+
+        numa_bitmask_setbit(nodemask, node);
+        mode = MPOL_PREFERRED;
+        break;
+    case UCS_NUMA_PLACEMENT_INTERLEAVE:
+        for (node = 0; node <= numa_max_node(); ++node) {
+            if (numa_bitmask_isbitset(numa_all_nodes_ptr, node)) {
+                numa_bitmask_setbit(nodemask, node);
+            }
+        }
+        mode = MPOL_INTERLEAVE;
+        break;
+    default:
+        ucs_error("unexpected NUMA placement %d", placement);
+        status = UCS_ERR_INVALID_PARAM;
+        goto out_free_nodemask;
+    }
+
+    ret = mbind((void*)start, end - start, mode, numa_nodemask_p(nodemask),
+                numa_nodemask_size(nodemask), MPOL_MF_MOVE);
+    if (ret != 0) {
+        ucs_debug("mbind(0x%lx..0x%lx, %s) failed: %m", start, end,
+                  ucs_numa_placement_names[placement]);
+        status = UCS_ERR_IO_ERROR;
+        goto out_free_nodemask;
+    }
+
+    ucs_trace("0x%lx..0x%lx: set NUMA placement to %s", start, end,
+              ucs_numa_placement_names[placement]);
+    status = UCS_OK;
+
+out_free_nodemask:
+    numa_free_nodemask(nodemask);
+    return status;
+}
+
+int ucs_numa_node_of_addr(const void *address)
+{
+    void *page = (void*)ucs_align_down_pow2((uintptr_t)address,
+                                            ucs_get_page_size());
+    int node, ret;
+
+    if (numa_available() < 0) {
+        return -1;
+    }
+
+    /* with nodes=NULL, move_pages() only reports the current node of the page */
+    ret = move_pages(0, 1, &page, NULL, &node, 0);
+    if ((ret != 0) || (node < 0)) {
+        return -1;
+    }
+
+    return node;
+}
+
+#else
+
+int ucs_numa_num_nodes(void)
+{
+    return 1;
+}
+
+int ucs_numa_current_node(void)
+{
+    return -1;
+}
+
+ucs_status_t ucs_numa_mem_bind(void *address, size_t length,
+                               ucs_numa_placement_t placement, int node)
+{
+    return (placement == UCS_NUMA_PLACEMENT_DEFAULT) ? UCS_OK :
+           UCS_ERR_UNSUPPORTED;
+}
+
+int ucs_numa_node_of_addr(const void *address)
+{
+    return -1;
+}
+
 #endif
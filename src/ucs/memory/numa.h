@@ -11,7 +11,9 @@
 #  include "config.h"
 #endif
 
+#include <ucs/config/types.h>
 #include <ucs/debug/memtrack.h>
+#include <ucs/type/status.h>
 
 #if HAVE_NUMA
 #include <numaif.h>
@@ -57,9 +59,53 @@ typedef enum {
 
 
 extern const char *ucs_numa_policy_names[];
+extern const char *ucs_numa_placement_names[];
 
 
 int ucs_numa_node_of_cpu(int cpu);
 
 
+/**
+ * @return Number of configured NUMA nodes, or 1 if NUMA is not supported.
+ */
+int ucs_numa_num_nodes(void);
+
+
+/**
+ * @return NUMA node of the CPU the calling thread is currently running on, or
+ *         -1 if it cannot be determined.
+ */
+int ucs_numa_current_node(void);
+
+
+/**
+ * Set the NUMA placement policy of a memory range. Only the pages which are
+ * fully contained in the range are affected, since partial pages at the edges
+ * may belong to other allocations. Pages which were already faulted in are
+ * migrated according to the new policy.
+ *
+ * @param [in]  address    Start of the memory range.
+ * @param [in]  length     Length of the memory range.
+ * @param [in]  placement  Placement policy to apply.
+ * @param [in]  node       NUMA node to use with @ref UCS_NUMA_PLACEMENT_NODE,
+ *                         ignored otherwise.
+ *
+ * @return UCS_OK if the policy was set, UCS_ERR_UNSUPPORTED if NUMA is not
+ *         supported, or another error code if the policy could not be set.
+ */
+ucs_status_t ucs_numa_mem_bind(void *address, size_t length,
+                               ucs_numa_placement_t placement, int node);
+
+
+/**
+ * Query the NUMA node a memory page currently resides on.
+ *
+ * @param [in]  address    Address inside the page to query.
+ *
+ * @return NUMA node of the page, or -1 if the page is not present or NUMA is
+ *         not supported.
+ */
+int ucs_numa_node_of_addr(const void *address);
+
+
 #endif
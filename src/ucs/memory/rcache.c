@@ -9,6 +9,7 @@
 #endif
 
 #include <ucs/arch/atomic.h>
+#include <ucs/arch/cpu.h>
 #include <ucs/type/class.h>
 #include <ucs/datastruct/queue.h>
 #include <ucs/debug/log.h>
@@ -57,11 +58,14 @@ enum {
     /* Region is expected to reach a reference count of 0 and be destroyed */
     UCS_RCACHE_REGION_PUT_FLAG_MUST_DESTROY = UCS_BIT(2),
     /* Region is expected to be present in the page table  */
-    UCS_RCACHE_REGION_PUT_FLAG_IN_PGTABLE   = UCS_BIT(3)
+    UCS_RCACHE_REGION_PUT_FLAG_IN_PGTABLE   = UCS_BIT(3),
 #else
     UCS_RCACHE_REGION_PUT_FLAG_MUST_DESTROY = 0,
-    UCS_RCACHE_REGION_PUT_FLAG_IN_PGTABLE   = 0
+    UCS_RCACHE_REGION_PUT_FLAG_IN_PGTABLE   = 0,
 #endif
+    /* Move the region to the tail of the LRU list, since the caller has just
+     * finished using it */
+    UCS_RCACHE_REGION_PUT_FLAG_LRU_ADD      = UCS_BIT(4)
 };
 
 
@@ -78,6 +82,18 @@ typedef struct {
 } ucs_rcache_region_validate_pfn_t;
 
 
+/*
+ * Per-thread state of a lock-free page table reader. A thread publishes the
+ * rcache whose page table it is looking up in its own record, so a cache hit
+ * does not write to a cache line shared with other threads. Writers wait for
+ * all records to stop pointing to their rcache before changing the page table.
+ */
+typedef struct ucs_rcache_reader {
+    ucs_rcache_t * volatile  rcache;  /**< rcache being read, or NULL */
+    ucs_list_link_t          list;    /**< Entry in the global readers list */
+} ucs_rcache_reader_t;
+
+
 #ifdef ENABLE_STATS
 static ucs_stats_class_t ucs_rcache_stats_class = {
     .name = "rcache",
@@ -93,6 +109,7 @@ static ucs_stats_class_t ucs_rcache_stats_class = {
         [UCS_RCACHE_PUTS]               = "puts",
         [UCS_RCACHE_REGS]               = "mem_regs",
         [UCS_RCACHE_DEREGS]             = "mem_deregs",
+        [UCS_RCACHE_EVICTS]             = "regions_evicted",
     }
 };
 #endif
@@ -101,6 +118,170 @@ static ucs_stats_class_t ucs_rcache_stats_class = {
 static pthread_mutex_t ucs_rcache_global_list_lock = PTHREAD_MUTEX_INITIALIZER;
 static UCS_LIST_HEAD(ucs_rcache_global_list);
 
+static pthread_mutex_t ucs_rcache_readers_lock = PTHREAD_MUTEX_INITIALIZER;
+static UCS_LIST_HEAD(ucs_rcache_readers_list);
+static pthread_once_t ucs_rcache_readers_once = PTHREAD_ONCE_INIT;
+static pthread_key_t ucs_rcache_readers_key;
+static __thread ucs_rcache_reader_t *ucs_rcache_thread_reader = NULL;
+
+static void ucs_rcache_reader_destroy(void *arg)
+{
+    ucs_rcache_reader_t *reader = arg;
+
+    ucs_assert(reader->rcache == NULL);
+
+    pthread_mutex_lock(&ucs_rcache_readers_lock);
+    ucs_list_del(&reader->list);
+    pthread_mutex_unlock(&ucs_rcache_readers_lock);
+
+    ucs_free(reader);
+    ucs_rcache_thread_reader = NULL;
+}
+
+static void ucs_rcache_readers_key_init(void)
+{
+    int ret;
+
+    ret = pthread_key_create(&ucs_rcache_readers_key,
+                             ucs_rcache_reader_destroy);
+    if (ret != 0) {
+        ucs_fatal("pthread_key_create() failed: %m");
+    }
+}
+
+static ucs_rcache_reader_t *ucs_rcache_reader_create(void)
+{
+    ucs_rcache_reader_t *reader;
+    int ret;
+
+    pthread_once(&ucs_rcache_readers_once, ucs_rcache_readers_key_init);
+
+    ret = ucs_posix_memalign((void**)&reader, UCS_SYS_CACHE_LINE_SIZE,
+                             ucs_align_up_pow2(sizeof(*reader),
+                                               UCS_SYS_CACHE_LINE_SIZE),
+                             "rcache_reader");
+    if (ret != 0) {
+        ucs_debug("failed to allocate rcache reader, using locked lookup");
+        return NULL;
+    }
+
+    reader->rcache = NULL;
+
+    pthread_mutex_lock(&ucs_rcache_readers_lock);
+    ucs_list_add_tail(&ucs_rcache_readers_list, &reader->list);
+    pthread_mutex_unlock(&ucs_rcache_readers_lock);
+
+    ret = pthread_setspecific(ucs_rcache_readers_key, reader);
+    if (ret != 0) {
+        ucs_rcache_reader_destroy(reader);
+        return NULL;
+    }
+
+    ucs_rcache_thread_reader = reader;
+    return reader;
+}
+
+static UCS_F_ALWAYS_INLINE ucs_rcache_reader_t *ucs_rcache_reader_get(void)
+{
+    if (ucs_likely(ucs_rcache_thread_reader != NULL)) {
+        return ucs_rcache_thread_reader;
+    }
+
+    return ucs_rcache_reader_create();
+}
+
+/*
+ * Enter lock-free read mode of the page table.
+ * Returns nonzero if succeeded, or 0 if a writer is active and the caller has
+ * to take 'pgt_lock' instead.
+ */
+static UCS_F_ALWAYS_INLINE int
+ucs_rcache_read_begin(ucs_rcache_t *rcache, ucs_rcache_reader_t *reader)
+{
+    reader->rcache = rcache;
+    /* Order the store to the reader record before the load of the writer
+     * flag; pairs with the fence in ucs_rcache_readers_wait() */
+    ucs_memory_bus_fence();
+    if (ucs_likely(!rcache->pgt_write_pending)) {
+        return 1;
+    }
+
+    reader->rcache = NULL;
+    return 0;
+}
+
+static UCS_F_ALWAYS_INLINE void
+ucs_rcache_read_end(ucs_rcache_reader_t *reader)
+{
+    /* Complete all page table accesses before letting writers proceed */
+    ucs_memory_cpu_fence();
+    reader->rcache = NULL;
+}
+
+/*
+ * Wait for all lock-free readers of the page table to leave. 'pgt_lock' must
+ * be held in write mode, so no new lock-free reader can enter.
+ * If 'blocking' is 0, returns 0 instead of waiting when there are readers.
+ */
+static int ucs_rcache_readers_wait(ucs_rcache_t *rcache, int blocking)
+{
+    ucs_rcache_reader_t *reader;
+    int ret = 1;
+
+    rcache->pgt_write_pending = 1;
+    ucs_memory_bus_fence();
+
+    pthread_mutex_lock(&ucs_rcache_readers_lock);
+    ucs_list_for_each(reader, &ucs_rcache_readers_list, list) {
+        while (reader->rcache == rcache) {
+            if (!blocking) {
+                ret = 0;
+                goto out;
+            }
+            sched_yield();
+        }
+    }
+out:
+    pthread_mutex_unlock(&ucs_rcache_readers_lock);
+    return ret;
+}
+
+/* Take the page table lock for write, excluding both locked and lock-free
+ * readers */
+static void ucs_rcache_pgt_wrlock(ucs_rcache_t *rcache)
+{
+    pthread_rwlock_wrlock(&rcache->pgt_lock);
+    ucs_rcache_readers_wait(rcache, 1);
+}
+
+/*
+ * Try to take the page table lock for write without blocking. Fails also if
+ * there are lock-free readers, since the caller may be one of them (e.g when
+ * called from a memory event handler).
+ * Returns 0 if the lock was taken.
+ */
+static int ucs_rcache_pgt_trywrlock(ucs_rcache_t *rcache)
+{
+    if (pthread_rwlock_trywrlock(&rcache->pgt_lock)) {
+        return -1;
+    }
+
+    if (!ucs_rcache_readers_wait(rcache, 0)) {
+        rcache->pgt_write_pending = 0;
+        pthread_rwlock_unlock(&rcache->pgt_lock);
+        return -1;
+    }
+
+    return 0;
+}
+
+static void ucs_rcache_pgt_wrunlock(ucs_rcache_t *rcache)
+{
+    ucs_memory_cpu_store_fence();
+    rcache->pgt_write_pending = 0;
+    pthread_rwlock_unlock(&rcache->pgt_lock);
+}
+
 static void __ucs_rcache_region_log(const char *file, int line, const char *function,
                                     ucs_log_level_t level, ucs_rcache_t *rcache,
                                     ucs_rcache_region_t *region, const char *fmt,
@@ -288,6 +469,44 @@ static void ucs_rcache_find_regions(ucs_rcache_t *rcache, ucs_pgt_addr_t from,
                              ucs_rcache_region_collect_callback, list);
 }
 
+/* LRU lock must be held */
+static void ucs_rcache_region_lru_remove(ucs_rcache_t *rcache,
+                                         ucs_rcache_region_t *region)
+{
+    if (!(region->lru_flags & UCS_RCACHE_LRU_FLAG_IN_LRU)) {
+        return;
+    }
+
+    ucs_rcache_region_trace(rcache, region, "lru remove");
+    ucs_list_del(&region->lru_list);
+    region->lru_flags &= ~UCS_RCACHE_LRU_FLAG_IN_LRU;
+}
+
+/* LRU lock must be held */
+static void ucs_rcache_region_lru_add(ucs_rcache_t *rcache,
+                                      ucs_rcache_region_t *region)
+{
+    /* Move the region to the tail, as the most recently used one */
+    ucs_rcache_region_lru_remove(rcache, region);
+    ucs_rcache_region_trace(rcache, region, "lru add");
+    ucs_list_add_tail(&rcache->lru.list, &region->lru_list);
+    region->lru_flags |= UCS_RCACHE_LRU_FLAG_IN_LRU;
+}
+
+static UCS_F_ALWAYS_INLINE int
+ucs_rcache_lru_is_enabled(ucs_rcache_t *rcache)
+{
+    return (rcache->params.max_regions != ULONG_MAX) ||
+           (rcache->params.max_size != SIZE_MAX);
+}
+
+static UCS_F_ALWAYS_INLINE int
+ucs_rcache_lru_is_over_limit(ucs_rcache_t *rcache)
+{
+    return (rcache->num_regions > rcache->params.max_regions) ||
+           (rcache->total_size > rcache->params.max_size);
+}
+
 /* Lock must be held in write mode */
 static void ucs_mem_region_destroy_internal(ucs_rcache_t *rcache,
                                             ucs_rcache_region_t *region)
@@ -298,6 +517,15 @@ static void ucs_mem_region_destroy_internal(ucs_rcache_t *rcache,
                 region->super.start, region->super.end, rcache->name);
     ucs_assert(!(region->flags & UCS_RCACHE_REGION_FLAG_PGTABLE));
 
+    ucs_spin_lock(&rcache->lru.lock);
+    ucs_rcache_region_lru_remove(rcache, region);
+    ucs_spin_unlock(&rcache->lru.lock);
+
+    ucs_assert(rcache->num_regions > 0);
+    ucs_assert(rcache->total_size >= (region->super.end - region->super.start));
+    --rcache->num_regions;
+    rcache->total_size -= region->super.end - region->super.start;
+
     if (region->flags & UCS_RCACHE_REGION_FLAG_REGISTERED) {
         UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_DEREGS, 1);
         {
@@ -320,10 +548,23 @@ static inline void ucs_rcache_region_put_internal(ucs_rcache_t *rcache,
                                                   ucs_rcache_region_t *region,
                                                   unsigned flags)
 {
+    uint32_t refcount;
+
     ucs_rcache_region_trace(rcache, region, "put region, flags 0x%x", flags);
 
     ucs_assert(region->refcount > 0);
-    if (ucs_likely(ucs_atomic_fsub32(&region->refcount, 1) != 1)) {
+    if (flags & UCS_RCACHE_REGION_PUT_FLAG_LRU_ADD) {
+        /* Update the LRU and the reference count atomically with respect to
+         * eviction, which checks the reference count under LRU lock */
+        ucs_spin_lock(&rcache->lru.lock);
+        ucs_rcache_region_lru_add(rcache, region);
+        refcount = ucs_atomic_fsub32(&region->refcount, 1);
+        ucs_spin_unlock(&rcache->lru.lock);
+    } else {
+        refcount = ucs_atomic_fsub32(&region->refcount, 1);
+    }
+
+    if (ucs_likely(refcount != 1)) {
         ucs_assert(!(flags & UCS_RCACHE_REGION_PUT_FLAG_MUST_DESTROY));
         return;
     }
@@ -339,13 +580,13 @@ static inline void ucs_rcache_region_put_internal(ucs_rcache_t *rcache,
 
     /* Destroy region and de-register memory */
     if (flags & UCS_RCACHE_REGION_PUT_FLAG_TAKE_PGLOCK) {
-        pthread_rwlock_wrlock(&rcache->pgt_lock);
+        ucs_rcache_pgt_wrlock(rcache);
     }
 
     ucs_mem_region_destroy_internal(rcache, region);
 
     if (flags & UCS_RCACHE_REGION_PUT_FLAG_TAKE_PGLOCK) {
-        pthread_rwlock_unlock(&rcache->pgt_lock);
+        ucs_rcache_pgt_wrunlock(rcache);
     }
 }
 
@@ -393,6 +634,56 @@ static void ucs_rcache_invalidate_range(ucs_rcache_t *rcache, ucs_pgt_addr_t sta
     }
 }
 
+/* Lock must be held in write mode */
+static void ucs_rcache_lru_evict(ucs_rcache_t *rcache)
+{
+    unsigned num_evicted, num_skipped;
+    ucs_rcache_region_t *region;
+
+    num_evicted = 0;
+    num_skipped = 0;
+
+    ucs_spin_lock(&rcache->lru.lock);
+    while (!ucs_list_is_empty(&rcache->lru.list) &&
+           ucs_rcache_lru_is_over_limit(rcache)) {
+        region = ucs_list_head(&rcache->lru.list, ucs_rcache_region_t,
+                               lru_list);
+        ucs_rcache_region_lru_remove(rcache, region);
+
+        if (!(region->flags & UCS_RCACHE_REGION_FLAG_PGTABLE) ||
+            (region->refcount > 1)) {
+            /* The region is used by someone else, or it is going to be
+             * destroyed anyway. It is added back to the LRU on the last put.
+             */
+            ++num_skipped;
+            continue;
+        }
+
+        /* Drop the LRU lock, since destroying the region takes it */
+        ucs_spin_unlock(&rcache->lru.lock);
+
+        /* The region is referenced only by the page table, so it is
+         * destroyed right away */
+        ucs_rcache_region_trace(rcache, region, "evict");
+        ucs_rcache_region_invalidate(rcache, region,
+                                     UCS_RCACHE_REGION_PUT_FLAG_IN_PGTABLE |
+                                     UCS_RCACHE_REGION_PUT_FLAG_MUST_DESTROY);
+        UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_EVICTS, 1);
+        ++num_evicted;
+
+        ucs_spin_lock(&rcache->lru.lock);
+    }
+    ucs_spin_unlock(&rcache->lru.lock);
+
+    if (num_evicted > 0) {
+        ucs_debug("%s: evicted %u regions, skipped %u, usage: %lu regions "
+                  "(max: %lu), %zu bytes (max: %zu)", rcache->name,
+                  num_evicted, num_skipped, rcache->num_regions,
+                  rcache->params.max_regions, rcache->total_size,
+                  rcache->params.max_size);
+    }
+}
+
 /* Lock must be held in write mode */
 static void ucs_rcache_check_inv_queue(ucs_rcache_t *rcache, unsigned flags)
 {
@@ -473,12 +764,12 @@ static void ucs_rcache_unmapped_callback(ucm_event_type_t event_type,
      * This way we avoid queuing endless events on the invalidation queue when
      * no rcache operations are performed to clean it.
      */
-    if (!pthread_rwlock_trywrlock(&rcache->pgt_lock)) {
+    if (!ucs_rcache_pgt_trywrlock(rcache)) {
         ucs_rcache_invalidate_range(rcache, start, end,
                                     UCS_RCACHE_REGION_PUT_FLAG_ADD_TO_GC);
         UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_UNMAPS, 1);
         ucs_rcache_check_inv_queue(rcache, UCS_RCACHE_REGION_PUT_FLAG_ADD_TO_GC);
-        pthread_rwlock_unlock(&rcache->pgt_lock);
+        ucs_rcache_pgt_wrunlock(rcache);
         return;
     }
 
@@ -662,7 +953,7 @@ ucs_rcache_create_region(ucs_rcache_t *rcache, void *address, size_t length,
     ucs_trace_func("rcache=%s, address=%p, length=%zu", rcache->name, address,
                    length);
 
-    pthread_rwlock_wrlock(&rcache->pgt_lock);
+    ucs_rcache_pgt_wrlock(rcache);
 
 retry:
     /* Align to page size */
@@ -714,6 +1005,9 @@ retry:
         goto out_unlock;
     }
 
+    ++rcache->num_regions;
+    rcache->total_size += end - start;
+
     /* If memory registration failed, keep the region and mark it as invalid,
      * to avoid numerous retries of registering the region.
      */
@@ -763,10 +1057,13 @@ retry:
 
     ucs_rcache_region_trace(rcache, region, "created");
 
+    /* Make room for the new region. It is in use, so it will not be evicted */
+    ucs_rcache_lru_evict(rcache);
+
 out_set_region:
     *region_p = region;
 out_unlock:
-    pthread_rwlock_unlock(&rcache->pgt_lock);
+    ucs_rcache_pgt_wrunlock(rcache);
     return status;
 }
 
@@ -776,36 +1073,60 @@ void ucs_rcache_region_hold(ucs_rcache_t *rcache, ucs_rcache_region_t *region)
     ucs_rcache_region_trace(rcache, region, "hold");
 }
 
-ucs_status_t ucs_rcache_get(ucs_rcache_t *rcache, void *address, size_t length,
-                            int prot, void *arg, ucs_rcache_region_t **region_p)
+/* Page table must be locked for read, or in lock-free read mode */
+static UCS_F_ALWAYS_INLINE int
+ucs_rcache_lookup(ucs_rcache_t *rcache, void *address, size_t length, int prot,
+                  ucs_rcache_region_t **region_p)
 {
     ucs_pgt_addr_t start = (uintptr_t)address;
     ucs_pgt_region_t *pgt_region;
     ucs_rcache_region_t *region;
 
+    UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_GETS, 1);
+    if (!ucs_queue_is_empty(&rcache->inv_q)) {
+        return 0;
+    }
+
+    pgt_region = UCS_PROFILE_CALL(ucs_pgtable_lookup, &rcache->pgtable, start);
+    if (ucs_unlikely(pgt_region == NULL)) {
+        return 0;
+    }
+
+    region = ucs_derived_of(pgt_region, ucs_rcache_region_t);
+    if (((start + length) > region->super.end) ||
+        !ucs_rcache_region_test(region, prot)) {
+        return 0;
+    }
+
+    ucs_rcache_region_hold(rcache, region);
+    ucs_rcache_region_validate_pfn(rcache, region);
+    *region_p = region;
+    UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_HITS_FAST, 1);
+    return 1;
+}
+
+ucs_status_t ucs_rcache_get(ucs_rcache_t *rcache, void *address, size_t length,
+                            int prot, void *arg, ucs_rcache_region_t **region_p)
+{
+    ucs_rcache_reader_t *reader;
+    int found;
+
     ucs_trace_func("rcache=%s, address=%p, length=%zu", rcache->name, address,
                    length);
 
-    pthread_rwlock_rdlock(&rcache->pgt_lock);
-    UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_GETS, 1);
-    if (ucs_queue_is_empty(&rcache->inv_q)) {
-        pgt_region = UCS_PROFILE_CALL(ucs_pgtable_lookup, &rcache->pgtable,
-                                      start);
-        if (ucs_likely(pgt_region != NULL)) {
-            region = ucs_derived_of(pgt_region, ucs_rcache_region_t);
-            if (((start + length) <= region->super.end) &&
-                ucs_rcache_region_test(region, prot))
-            {
-                ucs_rcache_region_hold(rcache, region);
-                ucs_rcache_region_validate_pfn(rcache, region);
-                *region_p = region;
-                UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_HITS_FAST, 1);
-                pthread_rwlock_unlock(&rcache->pgt_lock);
-                return UCS_OK;
-            }
-        }
+    reader = ucs_rcache_reader_get();
+    if (ucs_likely(reader != NULL) && ucs_rcache_read_begin(rcache, reader)) {
+        found = ucs_rcache_lookup(rcache, address, length, prot, region_p);
+        ucs_rcache_read_end(reader);
+    } else {
+        pthread_rwlock_rdlock(&rcache->pgt_lock);
+        found = ucs_rcache_lookup(rcache, address, length, prot, region_p);
+        pthread_rwlock_unlock(&rcache->pgt_lock);
+    }
+
+    if (ucs_likely(found)) {
+        return UCS_OK;
     }
-    pthread_rwlock_unlock(&rcache->pgt_lock);
 
     /* Fall back to slow version (with rw lock) in following cases:
      * - invalidation list not empty
@@ -818,9 +1139,25 @@ ucs_status_t ucs_rcache_get(ucs_rcache_t *rcache, void *address, size_t length,
 
 void ucs_rcache_region_put(ucs_rcache_t *rcache, ucs_rcache_region_t *region)
 {
-    ucs_rcache_region_put_internal(rcache, region,
-                                   UCS_RCACHE_REGION_PUT_FLAG_TAKE_PGLOCK);
+    unsigned flags = UCS_RCACHE_REGION_PUT_FLAG_TAKE_PGLOCK;
+
+    /* Without limits nothing is evicted, so avoid contending on LRU lock */
+    if (ucs_rcache_lru_is_enabled(rcache)) {
+        flags |= UCS_RCACHE_REGION_PUT_FLAG_LRU_ADD;
+    }
+
+    ucs_rcache_region_put_internal(rcache, region, flags);
     UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_PUTS, 1);
+
+    /* Regions which were in use while the cache grew above its limits are
+     * evicted once released. Do not block here if the page table is busy,
+     * eviction will be retried by the next put or registration.
+     */
+    if (ucs_unlikely(ucs_rcache_lru_is_over_limit(rcache)) &&
+        !ucs_rcache_pgt_trywrlock(rcache)) {
+        ucs_rcache_lru_evict(rcache);
+        ucs_rcache_pgt_wrunlock(rcache);
+    }
 }
 
 static void ucs_rcache_before_fork(void)
@@ -844,9 +1181,9 @@ static void ucs_rcache_before_fork(void)
              *   again on-demand.
              * - Other use cases shouldn't be affected
              */
-            pthread_rwlock_wrlock(&rcache->pgt_lock);
+            ucs_rcache_pgt_wrlock(rcache);
             ucs_rcache_invalidate_range(rcache, 0, UCS_PGT_ADDR_MAX, 0);
-            pthread_rwlock_unlock(&rcache->pgt_lock);
+            ucs_rcache_pgt_wrunlock(rcache);
         }
     }
     pthread_mutex_unlock(&ucs_rcache_global_list_lock);
@@ -931,15 +1268,22 @@ static UCS_CLASS_INIT_FUNC(ucs_rcache_t, const ucs_rcache_params_t *params,
         goto err_free_name;
     }
 
+    self->pgt_write_pending = 0;
+
     status = ucs_spinlock_init(&self->lock, 0);
     if (status != UCS_OK) {
         goto err_destroy_rwlock;
     }
 
+    status = ucs_spinlock_init(&self->lru.lock, 0);
+    if (status != UCS_OK) {
+        goto err_destroy_inv_q_lock;
+    }
+
     status = ucs_pgtable_init(&self->pgtable, ucs_rcache_pgt_dir_alloc,
                               ucs_rcache_pgt_dir_release);
     if (status != UCS_OK) {
-        goto err_destroy_inv_q_lock;
+        goto err_destroy_lru_lock;
     }
 
     mp_obj_size = ucs_max(sizeof(ucs_pgt_dir_t), sizeof(ucs_rcache_inv_entry_t));
@@ -952,6 +1296,9 @@ static UCS_CLASS_INIT_FUNC(ucs_rcache_t, const ucs_rcache_params_t *params,
 
     ucs_queue_head_init(&self->inv_q);
     ucs_list_head_init(&self->gc_list);
+    ucs_list_head_init(&self->lru.list);
+    self->num_regions = 0;
+    self->total_size  = 0;
 
     status = ucm_set_event_handler(params->ucm_events, params->ucm_event_priority,
                                    ucs_rcache_unmapped_callback, self);
@@ -973,6 +1320,8 @@ err_destroy_mp:
     ucs_mpool_cleanup(&self->mp, 1);
 err_cleanup_pgtable:
     ucs_pgtable_cleanup(&self->pgtable);
+err_destroy_lru_lock:
+    ucs_spinlock_destroy(&self->lru.lock);
 err_destroy_inv_q_lock:
     ucs_spinlock_destroy(&self->lock);
 err_destroy_rwlock:
@@ -993,9 +1342,11 @@ static UCS_CLASS_CLEANUP_FUNC(ucs_rcache_t)
     ucs_rcache_check_inv_queue(self, 0);
     ucs_rcache_check_gc_list(self);
     ucs_rcache_purge(self);
+    ucs_assert(ucs_list_is_empty(&self->lru.list));
 
     ucs_mpool_cleanup(&self->mp, 1);
     ucs_pgtable_cleanup(&self->pgtable);
+    ucs_spinlock_destroy(&self->lru.lock);
     ucs_spinlock_destroy(&self->lock);
     pthread_rwlock_destroy(&self->pgt_lock);
     UCS_STATS_NODE_FREE(self->stats);
@@ -54,6 +54,13 @@ enum {
     UCS_RCACHE_FLAG_PURGE_ON_FORK = UCS_BIT(1), /**< purge rcache on fork */
 };
 
+/*
+ * Region LRU flags.
+ */
+enum {
+    UCS_RCACHE_LRU_FLAG_IN_LRU = UCS_BIT(0) /**< Region is in the LRU list */
+};
+
 /*
  * Registration cache operations.
  */
@@ -122,6 +129,12 @@ struct ucs_rcache_params {
     void                   *context;            /**< User-defined context that will
                                                      be passed to mem_reg/mem_dereg */
     int                    flags;               /**< Flags */
+    unsigned long          max_regions;         /**< Maximal number of regions
+                                                     to keep in the cache. Unused
+                                                     regions are evicted in LRU
+                                                     order above this limit. */
+    size_t                 max_size;            /**< Maximal total size of the
+                                                     regions in the cache */
 };
 
 
@@ -133,6 +146,8 @@ struct ucs_rcache_region {
     ucs_status_t           status;   /**< Current status code */
     uint8_t                prot;     /**< Protection bits */
     uint16_t               flags;    /**< Status flags. Protected by page table lock. */
+    uint8_t                lru_flags; /**< LRU flags. Protected by LRU lock. */
+    ucs_list_link_t        lru_list; /**< LRU list element */
     union {
         uint64_t           priv;     /**< Used internally */
         unsigned long     *pfn;      /**< Pointer to PFN array. In case if requested 
@@ -23,6 +23,8 @@ enum {
     UCS_RCACHE_PUTS,                /* number of put operations */
     UCS_RCACHE_REGS,                /* number of memory registrations */
     UCS_RCACHE_DEREGS,              /* number of memory deregistrations */
+    UCS_RCACHE_EVICTS,              /* number of regions evicted because of
+                                       LRU limits */
     UCS_RCACHE_STAT_LAST
 };
 
@@ -32,6 +34,10 @@ struct ucs_rcache {
 
     pthread_rwlock_t         pgt_lock; /**< Protects the page table and all
                                             regions whose refcount is 0 */
+    volatile int             pgt_write_pending; /**< Set while 'pgt_lock' is
+                                                     held in write mode, to
+                                                     make lock-free readers fall
+                                                     back to 'pgt_lock' */
     ucs_pgtable_t            pgtable;  /**< page table to hold the regions */
 
 
@@ -52,6 +58,21 @@ struct ucs_rcache {
     ucs_list_link_t          gc_list;  /**< list for regions to destroy, regions
                                             could not be destroyed from memhook */
 
+    struct {
+        ucs_spinlock_t       lock;     /**< Protects 'lru.list' and the
+                                            'lru_flags' of all regions.
+                                            @note: This lock should always be
+                                            taken **after** 'pgt_lock'. */
+        ucs_list_link_t      list;     /**< List of regions which are not used
+                                            by anyone except the page table,
+                                            least recently used first */
+    } lru;
+
+    unsigned long            num_regions; /**< Number of regions in the cache,
+                                               protected by 'pgt_lock' */
+    size_t                   total_size;  /**< Total size of the regions in the
+                                               cache, protected by 'pgt_lock' */
+
     char                     *name;    /**< Name of the cache, for debug purpose */
     UCS_STATS_NODE_DECLARE(stats)
 
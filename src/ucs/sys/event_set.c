@@ -21,19 +21,110 @@
 #include <unistd.h>
 #include <sys/epoll.h>
 
+#if HAVE_IO_URING
+#include <ucs/arch/cpu.h>
+#include <ucs/datastruct/khash.h>
+#include <ucs/time/time.h>
+#include <ucs/type/spinlock.h>
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <poll.h>
+#endif
+
 
 enum {
     UCS_SYS_EVENT_SET_EXTERNAL_EVENT_FD = UCS_BIT(0),
+    UCS_SYS_EVENT_SET_IO_URING          = UCS_BIT(1),
+    UCS_SYS_EVENT_SET_ARMED             = UCS_BIT(2)  /* The event set file
+                                                         descriptor is waited
+                                                         on externally */
+};
+
+
+#if HAVE_IO_URING
+
+/* Number of submission queue entries */
+#define UCS_EVENT_SET_IO_URING_SQ_SIZE      256
+
+/* Completions of requests with this user data are not reported */
+#define UCS_EVENT_SET_IO_URING_UDATA_NONE   UINT64_MAX
+
+/* Kernel features the io_uring backend relies on */
+#define UCS_EVENT_SET_IO_URING_FEATURES \
+    (IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG | \
+     IORING_FEAT_RSRC_TAGS /* multi-shot poll was added in the same release */)
+
+
+enum {
+    UCS_EVENT_SET_IO_URING_FD_ARMED  = UCS_BIT(0), /* Poll request is posted */
+    UCS_EVENT_SET_IO_URING_FD_FAILED = UCS_BIT(1)  /* Poll request failed, do
+                                                      not re-arm it until the
+                                                      events are modified */
 };
 
+
+/* File descriptor registered in io_uring event set */
+typedef struct {
+    void                      *callback_data;
+    uint32_t                  gen;     /* Generation of the poll request, to
+                                          filter out stale completions */
+    ucs_event_set_types_t     events;
+    uint8_t                   flags;
+} ucs_event_set_io_uring_fd_t;
+
+
+KHASH_MAP_INIT_INT(ucs_event_set_fds, ucs_event_set_io_uring_fd_t);
+
+
+typedef struct {
+    void                      *ring_ptr;    /* Mapped SQ and CQ rings */
+    size_t                    ring_size;
+    struct io_uring_sqe       *sqes;        /* Mapped SQ entries array */
+    size_t                    sqes_size;
+    struct {
+        unsigned              *head;
+        unsigned              *tail;
+        unsigned              *flags;
+        unsigned              mask;
+        unsigned              entries;
+        unsigned              sqe_tail;     /* Tail of filled entries, which is
+                                               published to the kernel when
+                                               the entries are submitted */
+    } sq;
+    struct {
+        unsigned              *head;
+        unsigned              *tail;
+        unsigned              mask;
+        struct io_uring_cqe   *cqes;
+    } cq;
+    uint32_t                  gen;          /* Last used poll generation */
+    khash_t(ucs_event_set_fds) fds;         /* Registered file descriptors */
+    ucs_spinlock_t            lock;         /* Protects the rings and the fds,
+                                               since unlike epoll the set can't
+                                               be modified concurrently */
+} ucs_event_set_io_uring_t;
+
+#endif
+
+
 struct ucs_sys_event_set {
-    int      event_fd;
-    unsigned flags;
+    int                       event_fd;
+    unsigned                  flags;
+#if HAVE_IO_URING
+    ucs_event_set_io_uring_t  io_uring;
+#endif
 };
 
 const unsigned ucs_sys_event_set_max_wait_events =
     UCS_ALLOCA_MAX_SIZE / sizeof(struct epoll_event);
 
+const char *ucs_event_set_backend_names[] = {
+    [UCS_EVENT_SET_BACKEND_EPOLL]    = "epoll",
+    [UCS_EVENT_SET_BACKEND_IO_URING] = "io_uring",
+    [UCS_EVENT_SET_BACKEND_LAST]     = NULL
+};
+
 
 static inline int ucs_event_set_map_to_raw_events(ucs_event_set_types_t events)
 {
@@ -88,6 +179,570 @@ static ucs_sys_event_set_t *ucs_event_set_alloc(int event_fd, unsigned flags)
     return event_set;
 }
 
+#if HAVE_IO_URING
+
+static int ucs_event_set_io_uring_setup(unsigned entries,
+                                        struct io_uring_params *params)
+{
+    return syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int ucs_event_set_io_uring_enter(int fd, unsigned to_submit,
+                                        unsigned min_complete, unsigned flags,
+                                        void *arg, size_t arg_size)
+{
+    return syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags,
+                   arg, arg_size);
+}
+
+static inline uint64_t ucs_event_set_io_uring_udata(int fd, uint32_t gen)
+{
+    return ((uint64_t)gen << 32) | (uint32_t)fd;
+}
+
+/* Number of filled submission entries which were not consumed by the kernel */
+static inline unsigned
+ucs_event_set_io_uring_sq_pending(const ucs_event_set_io_uring_t *ring)
+{
+    unsigned head = *(volatile unsigned*)ring->sq.head;
+
+    ucs_memory_cpu_load_fence();
+    return ring->sq.sqe_tail - head;
+}
+
+static inline int
+ucs_event_set_io_uring_cq_empty(const ucs_event_set_io_uring_t *ring)
+{
+    unsigned tail = *(volatile unsigned*)ring->cq.tail;
+
+    ucs_memory_cpu_load_fence();
+    return *ring->cq.head == tail;
+}
+
+static ucs_status_t ucs_event_set_io_uring_create(ucs_sys_event_set_t **event_set_p)
+{
+    ucs_sys_event_set_t *event_set;
+    ucs_event_set_io_uring_t *ring;
+    struct io_uring_params params;
+    ucs_status_t status;
+    unsigned i;
+    int fd;
+
+    memset(&params, 0, sizeof(params));
+    fd = ucs_event_set_io_uring_setup(UCS_EVENT_SET_IO_URING_SQ_SIZE, &params);
+    if (fd < 0) {
+        ucs_debug("io_uring_setup() failed: %m");
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    if (!ucs_test_all_flags(params.features, UCS_EVENT_SET_IO_URING_FEATURES)) {
+        ucs_debug("io_uring features 0x%x do not include required 0x%x",
+                  params.features, UCS_EVENT_SET_IO_URING_FEATURES);
+        status = UCS_ERR_UNSUPPORTED;
+        goto err_close_fd;
+    }
+
+    event_set = ucs_event_set_alloc(fd, UCS_SYS_EVENT_SET_IO_URING);
+    if (event_set == NULL) {
+        status = UCS_ERR_NO_MEMORY;
+        goto err_close_fd;
+    }
+
+    /* SQ and CQ rings share the same mapping with IORING_FEAT_SINGLE_MMAP */
+    ring            = &event_set->io_uring;
+    ring->ring_size = ucs_max(params.sq_off.array +
+                              (params.sq_entries * sizeof(unsigned)),
+                              params.cq_off.cqes +
+                              (params.cq_entries * sizeof(struct io_uring_cqe)));
+    ring->ring_ptr  = mmap(NULL, ring->ring_size, PROT_READ | PROT_WRITE,
+                           MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (ring->ring_ptr == MAP_FAILED) {
+        ucs_error("failed to map io_uring rings: %m");
+        status = UCS_ERR_IO_ERROR;
+        goto err_free;
+    }
+
+    ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes      = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE,
+                           MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (ring->sqes == MAP_FAILED) {
+        ucs_error("failed to map io_uring submission entries: %m");
+        status = UCS_ERR_IO_ERROR;
+        goto err_unmap_rings;
+    }
+
+    ring->sq.head     = UCS_PTR_BYTE_OFFSET(ring->ring_ptr, params.sq_off.head);
+    ring->sq.tail     = UCS_PTR_BYTE_OFFSET(ring->ring_ptr, params.sq_off.tail);
+    ring->sq.flags    = UCS_PTR_BYTE_OFFSET(ring->ring_ptr, params.sq_off.flags);
+    ring->sq.mask     = *(unsigned*)UCS_PTR_BYTE_OFFSET(ring->ring_ptr,
+                                                        params.sq_off.ring_mask);
+    ring->sq.entries  = *(unsigned*)UCS_PTR_BYTE_OFFSET(ring->ring_ptr,
+                                                        params.sq_off.ring_entries);
+    ring->sq.sqe_tail = *ring->sq.tail;
+    ring->cq.head     = UCS_PTR_BYTE_OFFSET(ring->ring_ptr, params.cq_off.head);
+    ring->cq.tail     = UCS_PTR_BYTE_OFFSET(ring->ring_ptr, params.cq_off.tail);
+    ring->cq.mask     = *(unsigned*)UCS_PTR_BYTE_OFFSET(ring->ring_ptr,
+                                                        params.cq_off.ring_mask);
+    ring->cq.cqes     = UCS_PTR_BYTE_OFFSET(ring->ring_ptr, params.cq_off.cqes);
+    ring->gen         = 0;
+
+    /* Submission entries are consumed in order, so the indirection array can
+     * be an identity mapping */
+    for (i = 0; i < ring->sq.entries; ++i) {
+        ((unsigned*)UCS_PTR_BYTE_OFFSET(ring->ring_ptr,
+                                        params.sq_off.array))[i] = i;
+    }
+
+    kh_init_inplace(ucs_event_set_fds, &ring->fds);
+    ucs_spinlock_init(&ring->lock, 0);
+
+    ucs_debug("created io_uring event set %p fd %d sq %u cq %u", event_set, fd,
+              params.sq_entries, params.cq_entries);
+    *event_set_p = event_set;
+    return UCS_OK;
+
+err_unmap_rings:
+    munmap(ring->ring_ptr, ring->ring_size);
+err_free:
+    ucs_free(event_set);
+err_close_fd:
+    close(fd);
+    return status;
+}
+
+static void ucs_event_set_io_uring_cleanup(ucs_sys_event_set_t *event_set)
+{
+    ucs_event_set_io_uring_t *ring = &event_set->io_uring;
+
+    ucs_spinlock_destroy(&ring->lock);
+    kh_destroy_inplace(ucs_event_set_fds, &ring->fds);
+    munmap(ring->sqes, ring->sqes_size);
+    munmap(ring->ring_ptr, ring->ring_size);
+}
+
+/*
+ * Submit the pending requests, and if timeout_ms is not 0, wait until at least
+ * one completion is available or the timeout expires. Called with the lock
+ * held, which is released while blocking in the kernel.
+ */
+static ucs_status_t
+ucs_event_set_io_uring_submit(ucs_sys_event_set_t *event_set, int timeout_ms)
+{
+    ucs_event_set_io_uring_t *ring = &event_set->io_uring;
+    unsigned to_submit             = ucs_event_set_io_uring_sq_pending(ring);
+    struct io_uring_getevents_arg arg;
+    struct __kernel_timespec ts;
+    unsigned min_complete, flags;
+    size_t arg_size;
+    void *arg_p;
+    int ret;
+
+    if (timeout_ms == 0) {
+        /* Completions which did not fit the ring are moved to it only when
+         * the kernel is asked for events */
+        flags = (*(volatile unsigned*)ring->sq.flags & IORING_SQ_CQ_OVERFLOW) ?
+                IORING_ENTER_GETEVENTS : 0;
+        if ((to_submit == 0) && (flags == 0)) {
+            return UCS_OK;
+        }
+
+        min_complete = 0;
+    } else {
+        min_complete = 1;
+        flags        = IORING_ENTER_GETEVENTS;
+    }
+
+    if (timeout_ms > 0) {
+        memset(&arg, 0, sizeof(arg));
+        ts.tv_sec  = timeout_ms / UCS_MSEC_PER_SEC;
+        ts.tv_nsec = (timeout_ms % UCS_MSEC_PER_SEC) *
+                     (UCS_NSEC_PER_SEC / UCS_MSEC_PER_SEC);
+        arg.ts     = (uintptr_t)&ts;
+        arg_p      = &arg;
+        arg_size   = sizeof(arg);
+        flags     |= IORING_ENTER_EXT_ARG;
+    } else {
+        arg_p      = NULL;
+        arg_size   = 0;
+    }
+
+    /* Make the filled entries visible before publishing the new tail */
+    ucs_memory_cpu_store_fence();
+    *(volatile unsigned*)ring->sq.tail = ring->sq.sqe_tail;
+
+    if (min_complete == 0) {
+        ret = ucs_event_set_io_uring_enter(event_set->event_fd, to_submit,
+                                           min_complete, flags, arg_p,
+                                           arg_size);
+    } else {
+        ucs_spin_unlock(&ring->lock);
+        ret = ucs_event_set_io_uring_enter(event_set->event_fd, to_submit,
+                                           min_complete, flags, arg_p,
+                                           arg_size);
+        ucs_spin_lock(&ring->lock);
+    }
+
+    if (ucs_unlikely(ret < 0)) {
+        if ((errno == ETIME) || (errno == EBUSY) || (errno == EAGAIN)) {
+            /* Timed out, or the kernel could not consume the entries until
+             * the completions are reaped, they are submitted next time */
+            return UCS_OK;
+        } else if (errno == EINTR) {
+            return UCS_INPROGRESS;
+        }
+
+        ucs_error("io_uring_enter(fd=%d, to_submit=%u, min_complete=%u) "
+                  "failed: %m", event_set->event_fd, to_submit, min_complete);
+        return UCS_ERR_IO_ERROR;
+    }
+
+    return UCS_OK;
+}
+
+static struct io_uring_sqe *
+ucs_event_set_io_uring_get_sqe(ucs_sys_event_set_t *event_set)
+{
+    ucs_event_set_io_uring_t *ring = &event_set->io_uring;
+    struct io_uring_sqe *sqe;
+    ucs_status_t status;
+
+    if (ucs_event_set_io_uring_sq_pending(ring) == ring->sq.entries) {
+        status = ucs_event_set_io_uring_submit(event_set, 0);
+        if (status != UCS_OK) {
+            return NULL;
+        }
+
+        if (ucs_event_set_io_uring_sq_pending(ring) == ring->sq.entries) {
+            ucs_error("io_uring event set %p: submission queue is full",
+                      event_set);
+            return NULL;
+        }
+    }
+
+    sqe = &ring->sqes[ring->sq.sqe_tail & ring->sq.mask];
+    memset(sqe, 0, sizeof(*sqe));
+    ++ring->sq.sqe_tail;
+    return sqe;
+}
+
+static ucs_status_t
+ucs_event_set_io_uring_poll_add(ucs_sys_event_set_t *event_set, int fd,
+                                ucs_event_set_io_uring_fd_t *entry)
+{
+    struct io_uring_sqe *sqe;
+    unsigned poll_events;
+
+    sqe = ucs_event_set_io_uring_get_sqe(event_set);
+    if (sqe == NULL) {
+        return UCS_ERR_IO_ERROR;
+    }
+
+    poll_events = 0;
+    if (entry->events & UCS_EVENT_SET_EVREAD) {
+        poll_events |= POLLIN;
+    }
+    if (entry->events & UCS_EVENT_SET_EVWRITE) {
+        poll_events |= POLLOUT;
+    }
+    if (entry->events & UCS_EVENT_SET_EVERR) {
+        poll_events |= POLLERR;
+    }
+
+    sqe->opcode      = IORING_OP_POLL_ADD;
+    sqe->fd          = fd;
+    /* The 16-bit field is placed where the kernel expects the low half of the
+     * 32-bit mask on either endianness */
+    sqe->poll_events = poll_events;
+    /* A one-shot request re-armed after every completion behaves as
+     * level-triggered, since the kernel reports a ready file descriptor as
+     * soon as the request is posted. A multi-shot request is completed only
+     * on wake-ups, which behaves as edge-triggered. */
+    sqe->len         = (entry->events & UCS_EVENT_SET_EDGE_TRIGGERED) ?
+                       IORING_POLL_ADD_MULTI : 0;
+    sqe->user_data   = ucs_event_set_io_uring_udata(fd, entry->gen);
+    entry->flags     = UCS_EVENT_SET_IO_URING_FD_ARMED;
+    return UCS_OK;
+}
+
+static ucs_status_t
+ucs_event_set_io_uring_poll_remove(ucs_sys_event_set_t *event_set, int fd,
+                                   ucs_event_set_io_uring_fd_t *entry)
+{
+    struct io_uring_sqe *sqe;
+
+    if (!(entry->flags & UCS_EVENT_SET_IO_URING_FD_ARMED)) {
+        return UCS_OK;
+    }
+
+    sqe = ucs_event_set_io_uring_get_sqe(event_set);
+    if (sqe == NULL) {
+        return UCS_ERR_IO_ERROR;
+    }
+
+    sqe->opcode    = IORING_OP_POLL_REMOVE;
+    sqe->fd        = -1;
+    sqe->addr      = ucs_event_set_io_uring_udata(fd, entry->gen);
+    sqe->user_data = UCS_EVENT_SET_IO_URING_UDATA_NONE;
+    entry->flags  &= ~UCS_EVENT_SET_IO_URING_FD_ARMED;
+    return UCS_OK;
+}
+
+/* Pending requests are submitted by the next wait, unless the event set file
+ * descriptor is waited on externally and nobody may call the wait */
+static ucs_status_t
+ucs_event_set_io_uring_commit(ucs_sys_event_set_t *event_set)
+{
+    if (!(event_set->flags & UCS_SYS_EVENT_SET_ARMED)) {
+        return UCS_OK;
+    }
+
+    return ucs_event_set_io_uring_submit(event_set, 0);
+}
+
+static ucs_status_t
+ucs_event_set_io_uring_add(ucs_sys_event_set_t *event_set, int fd,
+                           ucs_event_set_types_t events, void *callback_data)
+{
+    ucs_event_set_io_uring_t *ring = &event_set->io_uring;
+    ucs_event_set_io_uring_fd_t *entry;
+    ucs_status_t status;
+    khiter_t iter;
+    int ret;
+
+    iter = kh_put(ucs_event_set_fds, &ring->fds, fd, &ret);
+    if (ret == UCS_KH_PUT_FAILED) {
+        ucs_error("io_uring event set %p: failed to add fd %d", event_set, fd);
+        return UCS_ERR_NO_MEMORY;
+    } else if (ret == UCS_KH_PUT_KEY_PRESENT) {
+        ucs_error("io_uring event set %p: fd %d is already added", event_set,
+                  fd);
+        return UCS_ERR_ALREADY_EXISTS;
+    }
+
+    entry                = &kh_val(&ring->fds, iter);
+    entry->callback_data = callback_data;
+    entry->events        = events;
+    entry->gen           = ++ring->gen;
+
+    status = ucs_event_set_io_uring_poll_add(event_set, fd, entry);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    return ucs_event_set_io_uring_commit(event_set);
+}
+
+static ucs_status_t
+ucs_event_set_io_uring_mod(ucs_sys_event_set_t *event_set, int fd,
+                           ucs_event_set_types_t events, void *callback_data)
+{
+    ucs_event_set_io_uring_t *ring = &event_set->io_uring;
+    ucs_event_set_io_uring_fd_t *entry;
+    ucs_status_t status;
+    khiter_t iter;
+
+    iter = kh_get(ucs_event_set_fds, &ring->fds, fd);
+    if (iter == kh_end(&ring->fds)) {
+        ucs_error("io_uring event set %p: fd %d is not found", event_set, fd);
+        return UCS_ERR_NO_ELEM;
+    }
+
+    /* The removal and the new request are submitted together later */
+    entry  = &kh_val(&ring->fds, iter);
+    status = ucs_event_set_io_uring_poll_remove(event_set, fd, entry);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    entry->callback_data = callback_data;
+    entry->events        = events;
+    entry->gen           = ++ring->gen;
+
+    status = ucs_event_set_io_uring_poll_add(event_set, fd, entry);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    return ucs_event_set_io_uring_commit(event_set);
+}
+
+static ucs_status_t
+ucs_event_set_io_uring_del(ucs_sys_event_set_t *event_set, int fd)
+{
+    ucs_event_set_io_uring_t *ring = &event_set->io_uring;
+    ucs_status_t status;
+    khiter_t iter;
+
+    iter = kh_get(ucs_event_set_fds, &ring->fds, fd);
+    if (iter == kh_end(&ring->fds)) {
+        ucs_error("io_uring event set %p: fd %d is not found", event_set, fd);
+        return UCS_ERR_NO_ELEM;
+    }
+
+    status = ucs_event_set_io_uring_poll_remove(event_set, fd,
+                                                &kh_val(&ring->fds, iter));
+    kh_del(ucs_event_set_fds, &ring->fds, iter);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    /* A posted poll request holds a reference to the file, so submit the
+     * removal right away to let the caller close the file descriptor */
+    return ucs_event_set_io_uring_submit(event_set, 0);
+}
+
+/* Returns nonzero if the completion was reported to the handler */
+static int
+ucs_event_set_io_uring_complete(ucs_sys_event_set_t *event_set,
+                                const struct io_uring_cqe *cqe,
+                                ucs_event_set_handler_t event_set_handler,
+                                void *arg)
+{
+    ucs_event_set_io_uring_t *ring = &event_set->io_uring;
+    int fd                         = (int)(uint32_t)cqe->user_data;
+    uint32_t gen                   = cqe->user_data >> 32;
+    ucs_event_set_io_uring_fd_t *entry;
+    ucs_event_set_types_t events;
+    void *callback_data;
+    khiter_t iter;
+
+    if (cqe->user_data == UCS_EVENT_SET_IO_URING_UDATA_NONE) {
+        return 0;
+    }
+
+    /* Skip completions of requests which were modified or removed */
+    iter = kh_get(ucs_event_set_fds, &ring->fds, fd);
+    if (iter == kh_end(&ring->fds)) {
+        return 0;
+    }
+
+    entry = &kh_val(&ring->fds, iter);
+    if (entry->gen != gen) {
+        return 0;
+    }
+
+    if (!(cqe->flags & IORING_CQE_F_MORE)) {
+        entry->flags &= ~UCS_EVENT_SET_IO_URING_FD_ARMED;
+    }
+
+    if (ucs_unlikely(cqe->res < 0)) {
+        ucs_debug("io_uring event set %p: poll on fd %d failed: %s",
+                  event_set, fd, strerror(-cqe->res));
+        entry->flags |= UCS_EVENT_SET_IO_URING_FD_FAILED;
+        events        = UCS_EVENT_SET_EVERR;
+    } else {
+        events        = 0;
+        if (cqe->res & POLLIN) {
+            events   |= UCS_EVENT_SET_EVREAD;
+        }
+        if (cqe->res & POLLOUT) {
+            events   |= UCS_EVENT_SET_EVWRITE;
+        }
+        if (cqe->res & POLLERR) {
+            events   |= UCS_EVENT_SET_EVERR;
+        }
+    }
+
+    /* The handler may modify the set, also from other threads */
+    callback_data = entry->callback_data;
+    ucs_spin_unlock(&ring->lock);
+    event_set_handler(callback_data, events, arg);
+    ucs_spin_lock(&ring->lock);
+
+    /* The handler could modify or remove the file descriptor, which also
+     * invalidates the entry pointer */
+    iter = kh_get(ucs_event_set_fds, &ring->fds, fd);
+    if (iter != kh_end(&ring->fds)) {
+        entry = &kh_val(&ring->fds, iter);
+        if ((entry->gen == gen) && (entry->flags == 0)) {
+            ucs_event_set_io_uring_poll_add(event_set, fd, entry);
+        }
+    }
+
+    return 1;
+}
+
+static ucs_status_t
+ucs_event_set_io_uring_wait(ucs_sys_event_set_t *event_set,
+                            unsigned *num_events, int timeout_ms,
+                            ucs_event_set_handler_t event_set_handler,
+                            void *arg)
+{
+    ucs_event_set_io_uring_t *ring = &event_set->io_uring;
+    unsigned count                 = 0;
+    ucs_time_t deadline            = 0;
+    struct io_uring_cqe cqe;
+    ucs_status_t status;
+    unsigned head, tail;
+    ucs_time_t now;
+
+    if (timeout_ms > 0) {
+        deadline = ucs_get_time() + ucs_time_from_msec(timeout_ms);
+    }
+
+    ucs_spin_lock(&ring->lock);
+
+    /* The caller progresses the event set, so changes can be batched again */
+    event_set->flags &= ~UCS_SYS_EVENT_SET_ARMED;
+
+    for (;;) {
+        /* Submit the pending requests, and block only if there are no
+         * completions to report yet. Completions are read from the shared
+         * ring, so polling with no pending requests does not enter the
+         * kernel. */
+        status = ucs_event_set_io_uring_submit(event_set,
+                                               ucs_event_set_io_uring_cq_empty(ring) ?
+                                               timeout_ms : 0);
+        if (ucs_unlikely(status != UCS_OK)) {
+            goto out;
+        }
+
+        head = *ring->cq.head;
+        tail = *(volatile unsigned*)ring->cq.tail;
+        ucs_memory_cpu_load_fence();
+
+        while ((head != tail) && (count < *num_events)) {
+            /* Release the entry before calling the handler, since the handler
+             * could post requests whose completions would need the space */
+            cqe = ring->cq.cqes[head & ring->cq.mask];
+            ucs_memory_cpu_fence();
+            *(volatile unsigned*)ring->cq.head = ++head;
+
+            count += ucs_event_set_io_uring_complete(event_set, &cqe,
+                                                     event_set_handler, arg);
+        }
+
+        if ((count > 0) || (timeout_ms == 0)) {
+            break;
+        }
+
+        /* Only stale completions were found, wait for the remaining time */
+        if (timeout_ms > 0) {
+            now = ucs_get_time();
+            if (now >= deadline) {
+                break;
+            }
+
+            timeout_ms = ucs_max(1, (int)ucs_time_to_msec(deadline - now));
+        }
+    }
+
+    ucs_trace_poll("io_uring event set (fd=%d, num_events=%u, timeout=%d) "
+                   "returned %u", event_set->event_fd, *num_events,
+                   timeout_ms, count);
+
+    /* Post the re-armed requests, so an external poller of the ring file
+     * descriptor would be notified about them */
+    status = ucs_event_set_io_uring_submit(event_set, 0);
+
+out:
+    ucs_spin_unlock(&ring->lock);
+    *num_events = count;
+    return status;
+}
+
+#endif
+
 ucs_status_t ucs_event_set_create_from_fd(ucs_sys_event_set_t **event_set_p,
                                           int event_fd)
 {
@@ -125,6 +780,28 @@ err_close_event_fd:
     return status;
 }
 
+ucs_status_t ucs_event_set_create_backend(ucs_sys_event_set_t **event_set_p,
+                                          ucs_event_set_backend_t backend)
+{
+#if HAVE_IO_URING
+    ucs_status_t status;
+
+    if (backend == UCS_EVENT_SET_BACKEND_IO_URING) {
+        status = ucs_event_set_io_uring_create(event_set_p);
+        if (status != UCS_ERR_UNSUPPORTED) {
+            return status;
+        }
+    }
+#endif
+
+    if (backend != UCS_EVENT_SET_BACKEND_EPOLL) {
+        ucs_debug("%s event set is not supported, falling back to epoll",
+                  ucs_event_set_backend_names[backend]);
+    }
+
+    return ucs_event_set_create(event_set_p);
+}
+
 ucs_status_t ucs_event_set_add(ucs_sys_event_set_t *event_set, int fd,
                                ucs_event_set_types_t events,
                                void *callback_data)
@@ -132,6 +809,18 @@ ucs_status_t ucs_event_set_add(ucs_sys_event_set_t *event_set, int fd,
     struct epoll_event raw_event;
     int ret;
 
+#if HAVE_IO_URING
+    if (event_set->flags & UCS_SYS_EVENT_SET_IO_URING) {
+        ucs_status_t status;
+
+        ucs_spin_lock(&event_set->io_uring.lock);
+        status = ucs_event_set_io_uring_add(event_set, fd, events,
+                                            callback_data);
+        ucs_spin_unlock(&event_set->io_uring.lock);
+        return status;
+    }
+#endif
+
     memset(&raw_event, 0, sizeof(raw_event));
     raw_event.events   = ucs_event_set_map_to_raw_events(events);
     raw_event.data.ptr = callback_data;
@@ -153,6 +842,18 @@ ucs_status_t ucs_event_set_mod(ucs_sys_event_set_t *event_set, int fd,
     struct epoll_event raw_event;
     int ret;
 
+#if HAVE_IO_URING
+    if (event_set->flags & UCS_SYS_EVENT_SET_IO_URING) {
+        ucs_status_t status;
+
+        ucs_spin_lock(&event_set->io_uring.lock);
+        status = ucs_event_set_io_uring_mod(event_set, fd, events,
+                                            callback_data);
+        ucs_spin_unlock(&event_set->io_uring.lock);
+        return status;
+    }
+#endif
+
     memset(&raw_event, 0, sizeof(raw_event));
     raw_event.events   = ucs_event_set_map_to_raw_events(events);
     raw_event.data.ptr = callback_data;
@@ -171,6 +872,17 @@ ucs_status_t ucs_event_set_del(ucs_sys_event_set_t *event_set, int fd)
 {
     int ret;
 
+#if HAVE_IO_URING
+    if (event_set->flags & UCS_SYS_EVENT_SET_IO_URING) {
+        ucs_status_t status;
+
+        ucs_spin_lock(&event_set->io_uring.lock);
+        status = ucs_event_set_io_uring_del(event_set, fd);
+        ucs_spin_unlock(&event_set->io_uring.lock);
+        return status;
+    }
+#endif
+
     ret = epoll_ctl(event_set->event_fd, EPOLL_CTL_DEL, fd, NULL);
     if (ret < 0) {
         ucs_error("epoll_ctl(event_fd=%d, DEL, fd=%d) failed: %m",
@@ -193,6 +905,13 @@ ucs_status_t ucs_event_set_wait(ucs_sys_event_set_t *event_set,
     ucs_assert(num_events != NULL);
     ucs_assert(*num_events <= ucs_sys_event_set_max_wait_events);
 
+#if HAVE_IO_URING
+    if (event_set->flags & UCS_SYS_EVENT_SET_IO_URING) {
+        return ucs_event_set_io_uring_wait(event_set, num_events, timeout_ms,
+                                           event_set_handler, arg);
+    }
+#endif
+
     events = ucs_alloca(sizeof(*events) * *num_events);
 
     nready = epoll_wait(event_set->event_fd, events, *num_events, timeout_ms);
@@ -221,6 +940,12 @@ ucs_status_t ucs_event_set_wait(ucs_sys_event_set_t *event_set,
 
 void ucs_event_set_cleanup(ucs_sys_event_set_t *event_set)
 {
+#if HAVE_IO_URING
+    if (event_set->flags & UCS_SYS_EVENT_SET_IO_URING) {
+        ucs_event_set_io_uring_cleanup(event_set);
+    }
+#endif
+
     if (!(event_set->flags & UCS_SYS_EVENT_SET_EXTERNAL_EVENT_FD)) {
         close(event_set->event_fd);
     }
@@ -234,3 +959,28 @@ ucs_status_t ucs_event_set_fd_get(ucs_sys_event_set_t *event_set,
     *event_fd_p = event_set->event_fd;
     return UCS_OK;
 }
+
+ucs_status_t ucs_event_set_arm(ucs_sys_event_set_t *event_set)
+{
+#if HAVE_IO_URING
+    ucs_status_t status;
+
+    if (event_set->flags & UCS_SYS_EVENT_SET_IO_URING) {
+        ucs_spin_lock(&event_set->io_uring.lock);
+        event_set->flags |= UCS_SYS_EVENT_SET_ARMED;
+        status            = ucs_event_set_io_uring_submit(event_set, 0);
+        ucs_spin_unlock(&event_set->io_uring.lock);
+        return status;
+    }
+#endif
+
+    /* epoll reports the events of a modified set right away */
+    return UCS_OK;
+}
+
+ucs_event_set_backend_t
+ucs_event_set_backend_get(const ucs_sys_event_set_t *event_set)
+{
+    return (event_set->flags & UCS_SYS_EVENT_SET_IO_URING) ?
+           UCS_EVENT_SET_BACKEND_IO_URING : UCS_EVENT_SET_BACKEND_EPOLL;
+}
@@ -45,6 +45,17 @@ typedef enum {
     UCS_EVENT_SET_EDGE_TRIGGERED = UCS_BIT(3)
 } ucs_event_set_type_t;
 
+/**
+ * Mechanism used by an event set to wait for events
+ */
+typedef enum {
+    UCS_EVENT_SET_BACKEND_EPOLL,    /* epoll(7) */
+    UCS_EVENT_SET_BACKEND_IO_URING, /* Poll requests on an io_uring(7) ring */
+    UCS_EVENT_SET_BACKEND_LAST
+} ucs_event_set_backend_t;
+
+extern const char *ucs_event_set_backend_names[];
+
 /* The maximum possible number of events based on system constraints */
 extern const unsigned ucs_sys_event_set_max_wait_events;
 
@@ -69,6 +80,24 @@ ucs_status_t ucs_event_set_create_from_fd(ucs_sys_event_set_t **event_set_p,
  */
 ucs_status_t ucs_event_set_create(ucs_sys_event_set_t **event_set_p);
 
+/**
+ * Allocate ucs_sys_event_set_t structure which uses a specific backend. If the
+ * io_uring backend is requested, but it is not supported by the system, epoll
+ * is used instead.
+ *
+ * The io_uring backend keeps modifications of the registered events pending
+ * and submits them together with the next @ref ucs_event_set_wait, and does
+ * not enter the kernel at all to collect the events which are already
+ * available. Edge-triggered events require multi-shot poll support.
+ *
+ * @param [out] event_set_p  Event set pointer to initialize.
+ * @param [in]  backend      Backend to use.
+ *
+ * @return UCS_OK on success or an error code on failure.
+ */
+ucs_status_t ucs_event_set_create_backend(ucs_sys_event_set_t **event_set_p,
+                                          ucs_event_set_backend_t backend);
+
 /**
  * Register the target event.
  *
@@ -145,4 +174,26 @@ void ucs_event_set_cleanup(ucs_sys_event_set_t *event_set);
 ucs_status_t ucs_event_set_fd_get(ucs_sys_event_set_t *event_set,
                                   int *event_fd_p);
 
+/**
+ * Prepare the event set to be waited on through its file descriptor, which is
+ * returned by @ref ucs_event_set_fd_get, instead of @ref ucs_event_set_wait.
+ * Pending modifications of the registered events are submitted, and until the
+ * next @ref ucs_event_set_wait the modifications are not batched.
+ *
+ * @param [in]  event_set    Event set created by ucs_event_set_create.
+ *
+ * @return UCS_OK on success or an error code on failure.
+ */
+ucs_status_t ucs_event_set_arm(ucs_sys_event_set_t *event_set);
+
+/**
+ * Get the backend which is used by the event set.
+ *
+ * @param [in]  event_set    Event set created by ucs_event_set_create.
+ *
+ * @return Event set backend.
+ */
+ucs_event_set_backend_t
+ucs_event_set_backend_get(const ucs_sys_event_set_t *event_set);
+
 #endif
@@ -24,6 +24,9 @@
 #include <unistd.h>
 #include <errno.h>
 #include <string.h>
+#if HAVE_MSG_ZEROCOPY
+#include <linux/errqueue.h>
+#endif
 
 
 #define UCS_NETIF_BOND_AD_NUM_PORTS_FMT  "/sys/class/net/%s/bonding/ad_num_ports"
@@ -579,6 +582,107 @@ ucs_socket_sendv_nb(int fd, struct iovec *iov, size_t iov_cnt, size_t *length_p)
     return ucs_socket_do_iov_nb(fd, iov, iov_cnt, length_p, sendmsg, "sendv");
 }
 
+#if HAVE_MSG_ZEROCOPY
+
+ucs_status_t ucs_socket_set_zcopy(int fd)
+{
+    int optval = 1;
+
+    if (setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, &optval, sizeof(optval)) < 0) {
+        ucs_debug("fd %d: failed to enable SO_ZEROCOPY: %m", fd);
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    return UCS_OK;
+}
+
+ucs_status_t ucs_socket_sendv_zcopy_nb(int fd, struct iovec *iov,
+                                       size_t iov_cnt, size_t *length_p)
+{
+    struct msghdr msg = {
+        .msg_iov    = iov,
+        .msg_iovlen = iov_cnt
+    };
+    ssize_t ret;
+
+    ret = sendmsg(fd, &msg, MSG_NOSIGNAL | MSG_ZEROCOPY);
+    if (ucs_unlikely((ret < 0) && (errno == ENOBUFS))) {
+        /* The socket option memory is exhausted by notifications which were
+         * not read yet */
+        *length_p = 0;
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    return ucs_socket_handle_io(fd, iov, iov_cnt, length_p, 1, ret, errno,
+                                "sendv_zcopy");
+}
+
+ucs_status_t ucs_socket_zcopy_comp_nb(int fd, uint32_t *first_id_p,
+                                      uint32_t *last_id_p, int *copied_p)
+{
+    char control[CMSG_SPACE(sizeof(struct sock_extended_err))];
+    struct sock_extended_err *serr;
+    struct cmsghdr *cmsg;
+    struct msghdr msg;
+    ssize_t ret;
+
+    for (;;) {
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_control    = control;
+        msg.msg_controllen = sizeof(control);
+
+        ret = recvmsg(fd, &msg, MSG_ERRQUEUE);
+        if (ret < 0) {
+            return ucs_socket_handle_io_error(fd, "recvmsg(MSG_ERRQUEUE)", ret,
+                                              errno);
+        }
+
+        for (cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL;
+             cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+            if (!(((cmsg->cmsg_level == SOL_IP) &&
+                   (cmsg->cmsg_type == IP_RECVERR)) ||
+                  ((cmsg->cmsg_level == SOL_IPV6) &&
+                   (cmsg->cmsg_type == IPV6_RECVERR)))) {
+                continue;
+            }
+
+            serr = (struct sock_extended_err*)CMSG_DATA(cmsg);
+            if ((serr->ee_errno != 0) ||
+                (serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY)) {
+                ucs_debug("fd %d: skipping error queue message (errno %u "
+                          "origin %u)", fd, serr->ee_errno, serr->ee_origin);
+                continue;
+            }
+
+            *first_id_p = serr->ee_info;
+            *last_id_p  = serr->ee_data;
+            *copied_p   = !!(serr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED);
+            return UCS_OK;
+        }
+    }
+}
+
+#else
+
+ucs_status_t ucs_socket_set_zcopy(int fd)
+{
+    return UCS_ERR_UNSUPPORTED;
+}
+
+ucs_status_t ucs_socket_sendv_zcopy_nb(int fd, struct iovec *iov,
+                                       size_t iov_cnt, size_t *length_p)
+{
+    return UCS_ERR_UNSUPPORTED;
+}
+
+ucs_status_t ucs_socket_zcopy_comp_nb(int fd, uint32_t *first_id_p,
+                                      uint32_t *last_id_p, int *copied_p)
+{
+    return UCS_ERR_UNSUPPORTED;
+}
+
+#endif
+
 ucs_status_t ucs_sockaddr_sizeof(const struct sockaddr *addr, size_t *size_p)
 {
     switch (addr->sa_family) {
@@ -302,6 +302,61 @@ ucs_status_t ucs_socket_sendv_nb(int fd, struct iovec *iov, size_t iov_cnt,
                                  size_t *length_p);
 
 
+/**
+ * Enable MSG_ZEROCOPY sends on the socket referred to by the file descriptor
+ * `fd`.
+ *
+ * @param [in]      fd              Socket fd.
+ *
+ * @return UCS_OK on success, UCS_ERR_UNSUPPORTED if the system does not support
+ *         MSG_ZEROCOPY, or another error code on failure.
+ */
+ucs_status_t ucs_socket_set_zcopy(int fd);
+
+
+/**
+ * Non-blocking send operation sends I/O vector on the connected socket
+ * referred to by the file descriptor `fd` with MSG_ZEROCOPY flag, so the kernel
+ * references the buffers instead of copying them. The buffers must not be
+ * modified until a completion notification which covers this send is read by
+ * @ref ucs_socket_zcopy_comp_nb. Every call which sends any data is assigned
+ * the next notification identifier of the socket, starting from 0.
+ *
+ * @param [in]      fd              Socket fd, @ref ucs_socket_set_zcopy must
+ *                                  have been called for it.
+ * @param [in]      iov             A pointer to an array of iovec buffers.
+ * @param [in]      iov_cnt         The number of buffers pointed to by
+ *                                  the iov parameter.
+ * @param [out]     length_p        The amount of data transmitted is written to
+ *                                  this argument.
+ *
+ * @return UCS_OK on success, UCS_ERR_NO_PROGRESS if the data could not be
+ *         sent now, UCS_ERR_NO_MEMORY if the kernel cannot track more
+ *         notifications until the pending ones are read, or an error code
+ *         on failure.
+ */
+ucs_status_t ucs_socket_sendv_zcopy_nb(int fd, struct iovec *iov,
+                                       size_t iov_cnt, size_t *length_p);
+
+
+/**
+ * Read a MSG_ZEROCOPY completion notification from the error queue of the
+ * socket referred to by the file descriptor `fd`. A notification covers
+ * a range of send identifiers, and the buffers of these sends can be reused.
+ *
+ * @param [in]      fd              Socket fd.
+ * @param [out]     first_id_p      First send identifier in the range.
+ * @param [out]     last_id_p       Last send identifier in the range.
+ * @param [out]     copied_p        Set to nonzero if the kernel copied the
+ *                                  data anyway, e.g. on loopback.
+ *
+ * @return UCS_OK if a notification was read, UCS_ERR_NO_PROGRESS if there are
+ *         no notifications, or an error code on failure.
+ */
+ucs_status_t ucs_socket_zcopy_comp_nb(int fd, uint32_t *first_id_p,
+                                      uint32_t *last_id_p, int *copied_p);
+
+
 /**
  * Blocking receive operation receives data from the connected (or bound
  * connectionless) socket referred to by the file descriptor `fd`.
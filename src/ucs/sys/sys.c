@@ -1487,3 +1487,31 @@ ucs_status_t ucs_sys_get_file_time(const char *name, ucs_sys_file_time_t type,
         return UCS_ERR_INVALID_PARAM;
     }
 }
+
+ucs_status_t ucs_sys_pidfd_getfd(pid_t pid, int target_fd, int *fd_p)
+{
+#if HAVE_DECL_SYS_PIDFD_OPEN && HAVE_DECL_SYS_PIDFD_GETFD
+    ucs_status_t status;
+    int pidfd, fd;
+
+    pidfd = syscall(SYS_pidfd_open, pid, 0);
+    if (pidfd < 0) {
+        ucs_debug("pidfd_open(pid=%d) failed: %m", pid);
+        return (errno == ENOSYS) ? UCS_ERR_UNSUPPORTED : UCS_ERR_IO_ERROR;
+    }
+
+    fd = syscall(SYS_pidfd_getfd, pidfd, target_fd, 0);
+    if (fd < 0) {
+        ucs_debug("pidfd_getfd(pid=%d, fd=%d) failed: %m", pid, target_fd);
+        status = (errno == ENOSYS) ? UCS_ERR_UNSUPPORTED : UCS_ERR_IO_ERROR;
+    } else {
+        *fd_p  = fd;
+        status = UCS_OK;
+    }
+
+    close(pidfd);
+    return status;
+#else
+    return UCS_ERR_UNSUPPORTED;
+#endif
+}
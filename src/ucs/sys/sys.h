@@ -609,6 +609,22 @@ ucs_status_t ucs_sys_enum_threads(ucs_sys_enum_threads_cb_t cb, void *ctx);
 ucs_status_t ucs_sys_get_file_time(const char *name, ucs_sys_file_time_t type,
                                    ucs_time_t *time);
 
+
+/**
+ * Duplicate a file descriptor of another process, using pidfd_getfd().
+ * The caller must have ptrace access to the target process.
+ *
+ * @param [in]  pid        Process id of the target process.
+ * @param [in]  target_fd  File descriptor number in the target process.
+ * @param [out] fd_p       Filled with the duplicated file descriptor, which has
+ *                         the close-on-exec flag set.
+ *
+ * @return UCS_OK if the file descriptor was duplicated, UCS_ERR_UNSUPPORTED if
+ *         the system does not support pidfd_getfd(), or an error code if the
+ *         operation failed.
+ */
+ucs_status_t ucs_sys_pidfd_getfd(pid_t pid, int target_fd, int *fd_p);
+
 END_C_DECLS
 
 #endif
@@ -94,6 +94,11 @@ typedef ucs_status_t (*uct_ep_am_zcopy_func_t)(uct_ep_h ep,
                                                unsigned flags,
                                                uct_completion_t *comp);
 
+typedef void         (*uct_ep_am_batch_begin_func_t)(uct_ep_h ep,
+                                                     unsigned count);
+
+typedef void         (*uct_ep_am_batch_commit_func_t)(uct_ep_h ep);
+
 /* endpoint - atomics */
 
 typedef ucs_status_t (*uct_ep_atomic_cswap64_func_t)(uct_ep_h ep,
@@ -306,6 +311,8 @@ typedef struct uct_iface_ops {
     uct_ep_am_short_iov_func_t          ep_am_short_iov;
     uct_ep_am_bcopy_func_t              ep_am_bcopy;
     uct_ep_am_zcopy_func_t              ep_am_zcopy;
+    uct_ep_am_batch_begin_func_t        ep_am_batch_begin;
+    uct_ep_am_batch_commit_func_t       ep_am_batch_commit;
 
     /* endpoint - atomics */
     uct_ep_atomic_cswap64_func_t        ep_atomic_cswap64;
@@ -419,6 +419,16 @@ typedef enum uct_atomic_op {
                                                        channel with remote peer is broken, even if there
                                                        are no outstanding send operations */
 
+        /* Active message receive */
+#define UCT_IFACE_FLAG_AM_RECV_DIRECT UCS_BIT(47) /**< Payload of large active messages
+                                                       can be received directly to a
+                                                       buffer provided by
+                                                       @ref uct_am_recv_direct_callback_t */
+#define UCT_IFACE_FLAG_AM_BATCH       UCS_BIT(48) /**< Active messages sent between
+                                                       @ref uct_ep_am_batch_begin and
+                                                       @ref uct_ep_am_batch_commit
+                                                       are published together */
+
         /* Tag matching operations */
 #define UCT_IFACE_FLAG_TAG_EAGER_SHORT UCS_BIT(50) /**< Hardware tag matching short eager support */
 #define UCT_IFACE_FLAG_TAG_EAGER_BCOPY UCS_BIT(51) /**< Hardware tag matching bcopy eager support */
@@ -1937,6 +1947,32 @@ ucs_status_t uct_iface_set_am_handler(uct_iface_h iface, uint8_t id,
                                       uct_am_callback_t cb, void *arg, uint32_t flags);
 
 
+/**
+ * @ingroup UCT_AM
+ * @brief Set direct receive handler for an active message ID.
+ *
+ * The handler provides a destination for the payload of large active messages
+ * with the given ID, so the payload does not have to be copied out of the
+ * transport receive buffer. It is invoked when at least @a header_length bytes
+ * of the message have arrived, from the same context as the active message
+ * handler. If cb == NULL, the current handler is removed.
+ *
+ * @param [in]  iface          Interface to set the handler for.
+ * @param [in]  id             Active message id. Must be 0..UCT_AM_ID_MAX-1.
+ * @param [in]  header_length  Length of the header which is passed to the
+ *                             handler, the rest of the message is the payload.
+ * @param [in]  cb             Direct receive callback. NULL to clear.
+ * @param [in]  arg            Callback argument.
+ *
+ * @return error code if the interface does not support
+ *         @ref UCT_IFACE_FLAG_AM_RECV_DIRECT.
+ */
+ucs_status_t uct_iface_set_am_recv_direct_handler(uct_iface_h iface, uint8_t id,
+                                                  size_t header_length,
+                                                  uct_am_recv_direct_callback_t cb,
+                                                  void *arg);
+
+
 /**
  * @ingroup UCT_AM
  * @brief Set active message tracer for the interface.
@@ -2737,6 +2773,45 @@ UCT_INLINE_API ucs_status_t uct_ep_am_zcopy(uct_ep_h ep, uint8_t id,
                                       flags, comp);
 }
 
+/**
+ * @ingroup UCT_AM
+ * @brief Start a batch of active messages on an endpoint.
+ *
+ * Active messages which are sent on @a ep after this call are not required to
+ * be visible to the remote side until @ref uct_ep_am_batch_commit is called.
+ * This allows the transport to reserve the send resources for several
+ * messages at once and to publish them together. The send operations may
+ * still return @ref UCS_ERR_NO_RESOURCE during the batch.
+ * Batches can not be nested, and only the thread which started the batch may
+ * send on @a ep until it is committed. Must be used only if the interface
+ * supports @ref UCT_IFACE_FLAG_AM_BATCH.
+ *
+ * @param [in] ep     Endpoint to start the batch on.
+ * @param [in] count  Expected number of active messages in the batch. This is
+ *                    a hint which is used to reserve the send resources; the
+ *                    batch may contain any number of messages.
+ */
+UCT_INLINE_API void uct_ep_am_batch_begin(uct_ep_h ep, unsigned count)
+{
+    ep->iface->ops.ep_am_batch_begin(ep, count);
+}
+
+
+/**
+ * @ingroup UCT_AM
+ * @brief Publish the active messages of a batch.
+ *
+ * Makes all active messages which were sent on @a ep since
+ * @ref uct_ep_am_batch_begin visible to the remote side, and ends the batch.
+ *
+ * @param [in] ep     Endpoint to commit the batch on.
+ */
+UCT_INLINE_API void uct_ep_am_batch_commit(uct_ep_h ep)
+{
+    ep->iface->ops.ep_am_batch_commit(ep);
+}
+
+
 /**
  * @ingroup UCT_AMO
  * @brief
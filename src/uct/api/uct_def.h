@@ -447,6 +447,41 @@ typedef ucs_status_t (*uct_am_callback_t)(void *arg, void *data, size_t length,
                                           unsigned flags);
 
 
+/**
+ * @ingroup UCT_AM
+ * @brief Callback to provide a destination for the payload of an incoming
+ *        active message.
+ *
+ * The callback is invoked by transports which support
+ * @ref UCT_IFACE_FLAG_AM_RECV_DIRECT when the header of a large active message
+ * has arrived, but the rest of the message has not yet arrived. If the callback
+ * returns @ref UCS_OK, the transport places the payload directly in the
+ * returned buffer. It invokes the returned completion when the payload has
+ * arrived or the receive has failed, and it does not invoke the active message
+ * handler for this message. Otherwise, the message is delivered to the active
+ * message handler as usual.
+ *
+ * @param [in]  arg        User-defined argument.
+ * @param [in]  data       Points to the header of the received message, which
+ *                         is valid only during the callback.
+ * @param [in]  length     Total length of the message, including the header.
+ * @param [out] payload_p  Filled with the buffer to receive the
+ *                         (@a length - header length) bytes after the header.
+ * @param [out] comp_p     Filled with the completion to invoke when the payload
+ *                         is received. Must not be NULL.
+ *
+ * @note This callback could be set and released
+ *       by @ref uct_iface_set_am_recv_direct_handler function.
+ *
+ * @retval UCS_OK    - the payload is placed in @a payload_p.
+ * @retval otherwise - the message is delivered to the active message handler.
+ */
+typedef ucs_status_t (*uct_am_recv_direct_callback_t)(void *arg, void *data,
+                                                      size_t length,
+                                                      void **payload_p,
+                                                      uct_completion_t **comp_p);
+
+
 /**
  * @ingroup UCT_AM
  * @brief Callback to trace active messages.
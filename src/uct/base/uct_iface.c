@@ -120,6 +120,40 @@ ucs_status_t uct_iface_set_am_handler(uct_iface_h tl_iface, uint8_t id,
     return UCS_OK;
 }
 
+ucs_status_t uct_iface_set_am_recv_direct_handler(uct_iface_h tl_iface,
+                                                  uint8_t id,
+                                                  size_t header_length,
+                                                  uct_am_recv_direct_callback_t cb,
+                                                  void *arg)
+{
+    uct_base_iface_t *iface = ucs_derived_of(tl_iface, uct_base_iface_t);
+    ucs_status_t status;
+    uct_iface_attr_t attr;
+
+    if (id >= UCT_AM_ID_MAX) {
+        ucs_error("active message id out-of-range (got: %d max: %d)", id,
+                  (int)UCT_AM_ID_MAX);
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    if (cb != NULL) {
+        status = uct_iface_query(tl_iface, &attr);
+        if (status != UCS_OK) {
+            return status;
+        }
+
+        if (!(attr.cap.flags & UCT_IFACE_FLAG_AM_RECV_DIRECT)) {
+            ucs_error("active message direct receive is not supported");
+            return UCS_ERR_UNSUPPORTED;
+        }
+    }
+
+    iface->am_recv_direct[id].cb            = cb;
+    iface->am_recv_direct[id].arg           = arg;
+    iface->am_recv_direct[id].header_length = header_length;
+    return UCS_OK;
+}
+
 ucs_status_t uct_iface_set_am_tracer(uct_iface_h tl_iface, uct_am_tracer_t tracer,
                                      void *arg)
 {
@@ -411,6 +445,9 @@ UCS_CLASS_INIT_FUNC(uct_base_iface_t, uct_iface_ops_t *ops, uct_md_h md,
 
     for (id = 0; id < UCT_AM_ID_MAX; ++id) {
         uct_iface_set_stub_am_handler(self, id);
+        self->am_recv_direct[id].cb            = NULL;
+        self->am_recv_direct[id].arg           = NULL;
+        self->am_recv_direct[id].header_length = 0;
     }
 
     /* Copy allocation methods configuration. In the process, remove duplicates. */
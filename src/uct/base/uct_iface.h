@@ -206,6 +206,16 @@ typedef struct uct_am_handler {
 } uct_am_handler_t;
 
 
+/**
+ * Active message direct receive handler table entry
+ */
+typedef struct uct_am_recv_direct_handler {
+    uct_am_recv_direct_callback_t cb;
+    void                          *arg;
+    size_t                        header_length;
+} uct_am_recv_direct_handler_t;
+
+
 /**
  * Base structure of all interfaces.
  * Includes the AM table which we don't want to expose.
@@ -215,6 +225,8 @@ typedef struct uct_base_iface {
     uct_md_h                md;               /* MD this interface is using */
     uct_priv_worker_t       *worker;          /* Worker this interface is on */
     uct_am_handler_t        am[UCT_AM_ID_MAX];/* Active message table */
+    uct_am_recv_direct_handler_t am_recv_direct[UCT_AM_ID_MAX]; /* Direct receive
+                                                                   handlers table */
     uct_am_tracer_t         am_tracer;        /* Active message tracer */
     void                    *am_tracer_arg;   /* Tracer argument */
     uct_error_handler_t     err_handler;      /* Error handler */
@@ -596,6 +608,19 @@ ucs_status_t uct_iface_mpool_init(uct_base_iface_t *iface, ucs_mpool_t *mp,
                                   const char *name);
 
 
+/**
+ * Set the NUMA placement of chunks allocated by a TL interface memory pool
+ * from now on.
+ *
+ * @param mp           Memory pool created by @ref uct_iface_mpool_init.
+ * @param placement    NUMA placement policy.
+ * @param node         NUMA node, used with UCS_NUMA_PLACEMENT_NODE.
+ */
+void uct_iface_mpool_set_numa_placement(ucs_mpool_t *mp,
+                                        ucs_numa_placement_t placement,
+                                        int node);
+
+
 /**
  * Dump active message contents using the user-defined tracer callback.
  */
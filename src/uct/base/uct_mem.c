@@ -12,6 +12,7 @@
 #include "uct_md.h"
 
 #include <ucs/arch/cpu.h>
+#include <ucs/memory/numa.h>
 #include <ucs/profile/profile.h>
 #include <ucs/sys/math.h>
 
@@ -26,6 +27,8 @@ typedef struct {
 typedef struct {
     uct_base_iface_t               *iface;
     uct_iface_mpool_init_obj_cb_t  init_obj_cb;
+    ucs_numa_placement_t           numa_placement;
+    int                            numa_node;
 } uct_iface_mp_priv_t;
 
 
@@ -399,7 +402,8 @@ static inline uct_iface_mp_priv_t* uct_iface_mp_priv(ucs_mpool_t *mp)
 UCS_PROFILE_FUNC(ucs_status_t, uct_iface_mp_chunk_alloc, (mp, size_p, chunk_p),
                  ucs_mpool_t *mp, size_t *size_p, void **chunk_p)
 {
-    uct_base_iface_t *iface = uct_iface_mp_priv(mp)->iface;
+    uct_iface_mp_priv_t *priv = uct_iface_mp_priv(mp);
+    uct_base_iface_t *iface   = priv->iface;
     uct_iface_mp_chunk_hdr_t *hdr;
     uct_allocated_memory_t mem;
     ucs_status_t status;
@@ -416,6 +420,15 @@ UCS_PROFILE_FUNC(ucs_status_t, uct_iface_mp_chunk_alloc, (mp, size_p, chunk_p),
     ucs_assert(mem.memh != UCT_MEM_HANDLE_NULL);
     ucs_assert(mem.md == iface->md);
 
+    status = ucs_numa_mem_bind(mem.address, mem.length, priv->numa_placement,
+                               priv->numa_node);
+    if (status != UCS_OK) {
+        ucs_debug("mpool %s: failed to set %s NUMA placement of chunk %p: %s",
+                  ucs_mpool_name(mp),
+                  ucs_numa_placement_names[priv->numa_placement],
+                  mem.address, ucs_status_string(status));
+    }
+
     hdr         = mem.address;
     hdr->method = mem.method;
     hdr->length = mem.length;
@@ -481,7 +494,17 @@ ucs_status_t uct_iface_mpool_init(uct_base_iface_t *iface, ucs_mpool_t *mp,
         return status;
     }
 
-    uct_iface_mp_priv(mp)->iface       = iface;
-    uct_iface_mp_priv(mp)->init_obj_cb = init_obj_cb;
+    uct_iface_mp_priv(mp)->iface          = iface;
+    uct_iface_mp_priv(mp)->init_obj_cb    = init_obj_cb;
+    uct_iface_mp_priv(mp)->numa_placement = UCS_NUMA_PLACEMENT_DEFAULT;
+    uct_iface_mp_priv(mp)->numa_node      = -1;
     return UCS_OK;
 }
+
+void uct_iface_mpool_set_numa_placement(ucs_mpool_t *mp,
+                                        ucs_numa_placement_t placement,
+                                        int node)
+{
+    uct_iface_mp_priv(mp)->numa_placement = placement;
+    uct_iface_mp_priv(mp)->numa_node      = node;
+}
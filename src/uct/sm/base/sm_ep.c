@@ -8,7 +8,9 @@
 #endif
 
 #include "sm_ep.h"
+#include "sm_iface.h"
 
+#include <uct/base/uct_iov.inl>
 #include <ucs/arch/atomic.h>
 #include <ucs/time/time.h>
 
@@ -59,6 +61,48 @@ ucs_status_t uct_sm_ep_get_bcopy(uct_ep_h tl_ep, uct_unpack_callback_t unpack_cb
     return UCS_OK;
 }
 
+ucs_status_t uct_sm_ep_put_zcopy(uct_ep_h tl_ep, const uct_iov_t *iov,
+                                 size_t iovcnt, uint64_t remote_addr,
+                                 uct_rkey_t rkey, uct_completion_t *comp)
+{
+    ucs_iov_iter_t iov_iter;
+    size_t length;
+
+    UCT_CHECK_IOV_SIZE(iovcnt, (size_t)UCT_SM_MAX_IOV, "uct_sm_ep_put_zcopy");
+
+    ucs_iov_iter_init(&iov_iter);
+    length = uct_iov_to_buffer(iov, iovcnt, &iov_iter,
+                               (void*)(rkey + remote_addr), SIZE_MAX);
+
+    uct_sm_ep_trace_data(remote_addr, rkey, "PUT_ZCOPY [iovcnt %zu length %zu]",
+                         iovcnt, length);
+    UCT_TL_EP_STAT_OP(ucs_derived_of(tl_ep, uct_base_ep_t), PUT, ZCOPY, length);
+    return UCS_OK;
+}
+
+ucs_status_t uct_sm_ep_get_zcopy(uct_ep_h tl_ep, const uct_iov_t *iov,
+                                 size_t iovcnt, uint64_t remote_addr,
+                                 uct_rkey_t rkey, uct_completion_t *comp)
+{
+    void *src     = (void*)(rkey + remote_addr);
+    size_t length = 0;
+    size_t iov_it;
+
+    UCT_CHECK_IOV_SIZE(iovcnt, (size_t)UCT_SM_MAX_IOV, "uct_sm_ep_get_zcopy");
+
+    for (iov_it = 0; iov_it < iovcnt; ++iov_it) {
+        memcpy(uct_iov_get_buffer(&iov[iov_it]),
+               UCS_PTR_BYTE_OFFSET(src, length),
+               uct_iov_get_length(&iov[iov_it]));
+        length += uct_iov_get_length(&iov[iov_it]);
+    }
+
+    uct_sm_ep_trace_data(remote_addr, rkey, "GET_ZCOPY [iovcnt %zu length %zu]",
+                         iovcnt, length);
+    UCT_TL_EP_STAT_OP(ucs_derived_of(tl_ep, uct_base_ep_t), GET, ZCOPY, length);
+    return UCS_OK;
+}
+
 ucs_status_t uct_sm_ep_atomic32_post(uct_ep_h ep, unsigned opcode, uint32_t value,
                                      uint64_t remote_addr, uct_rkey_t rkey)
 {
@@ -13,6 +13,7 @@
 #include "uct/sm/base/sm_ep.h"
 
 #include <uct/base/uct_iov.inl>
+#include <ucs/algorithm/crc.h>
 #include <ucs/arch/atomic.h>
 
 
@@ -20,10 +21,20 @@
 typedef enum {
     UCT_MM_SEND_AM_BCOPY,
     UCT_MM_SEND_AM_SHORT,
-    UCT_MM_SEND_AM_SHORT_IOV
+    UCT_MM_SEND_AM_SHORT_IOV,
+    UCT_MM_SEND_AM_ZCOPY
 } uct_mm_send_op_t;
 
 
+/* Arguments of packing a zero-copy active message to a receive descriptor */
+typedef struct {
+    const void      *header;
+    unsigned        header_length;
+    const uct_iov_t *iov;
+    size_t          iovcnt;
+} uct_mm_ep_zcopy_pack_args_t;
+
+
 /* Check if the resources on the remote peer are available for sending to it.
  * i.e. check if the remote receive FIFO has room in it.
  * return 1 if can send.
@@ -34,6 +45,13 @@ typedef enum {
     ucs_likely((int32_t)((_head) - (_tail)) < (int32_t)(_fifo_size))
 
 
+/* The receiver releases the FIFO element of a zero-copy active message right
+ * after reading its payload, so the send is completed once the remote tail
+ * has passed the element */
+#define UCT_MM_EP_IS_ZCOPY_COMPLETED(_ep, _head) \
+    ((int64_t)((_ep)->fifo_ctl->tail - (_head)) > 0)
+
+
 static UCS_F_NOINLINE ucs_status_t
 uct_mm_ep_attach_remote_seg(uct_mm_ep_t *ep, uct_mm_seg_id_t seg_id,
                             size_t length, void **address_p)
@@ -87,6 +105,35 @@ uct_mm_ep_get_remote_seg(uct_mm_ep_t *ep, uct_mm_seg_id_t seg_id, size_t length,
 }
 
 
+/* send a signal to remote interface using its eventfd */
+static void uct_mm_ep_signal_remote_eventfd(uct_mm_ep_t *ep)
+{
+    uint64_t dummy = 1;
+    int ret;
+
+    for (;;) {
+        ret = write(ep->signal.eventfd, &dummy, sizeof(dummy));
+        if (ucs_unlikely(ret < 0)) {
+            if (errno == EINTR) {
+                /* Interrupted system call - retry */
+                continue;
+            } else if (errno == EAGAIN) {
+                /* The counter is saturated, so the remote side would get a
+                 * signal anyway */
+                ucs_trace("failed to send wakeup signal: %m");
+                return;
+            } else {
+                ucs_warn("failed to send wakeup signal: %m");
+                return;
+            }
+        } else {
+            ucs_assert(ret == sizeof(dummy));
+            ucs_trace("sent wakeup to eventfd %d", ep->signal.eventfd);
+            return;
+        }
+    }
+}
+
 /* send a signal to remote interface using Unix-domain socket */
 static void uct_mm_ep_signal_remote(uct_mm_ep_t *ep)
 {
@@ -94,6 +141,11 @@ static void uct_mm_ep_signal_remote(uct_mm_ep_t *ep)
     char dummy = 0;
     int ret;
 
+    if (ep->signal.eventfd >= 0) {
+        uct_mm_ep_signal_remote_eventfd(ep);
+        return;
+    }
+
     for (;;) {
         ret = sendto(iface->signal_fd, &dummy, sizeof(dummy), 0,
                      (const struct sockaddr*)&ep->signal.sockaddr,
@@ -127,7 +179,10 @@ static UCS_CLASS_INIT_FUNC(uct_mm_ep_t, const uct_ep_params_t *params)
     uct_mm_iface_t            *iface = ucs_derived_of(params->iface, uct_mm_iface_t);
     uct_mm_md_t               *md    = ucs_derived_of(iface->super.super.md, uct_mm_md_t);
     const uct_mm_iface_addr_t *addr  = (const void *)params->iface_addr;
+    uct_mm_seg_t              *seg   = iface->recv_fifo_mem.memh;
+    uct_mm_remote_seg_t remote_seg;
     ucs_status_t status;
+    unsigned shard;
     void *fifo_ptr;
 
     UCT_EP_PARAMS_CHECK_DEV_IFACE_ADDRS(params);
@@ -151,25 +206,72 @@ static UCS_CLASS_INIT_FUNC(uct_mm_ep_t, const uct_ep_params_t *params)
 
     /* Attach the remote FIFO, use the same method as bcopy descriptors */
     status = uct_mm_ep_get_remote_seg(self, addr->fifo_seg_id,
-                                      UCT_MM_GET_FIFO_SIZE(iface), &fifo_ptr);
+                                      UCT_MM_GET_FIFO_SIZE(iface,
+                                                           addr->fifo_shards),
+                                      &fifo_ptr);
     if (status != UCS_OK) {
         ucs_error("mm ep failed to connect to remote FIFO id 0x%"PRIx64": %s",
                   addr->fifo_seg_id, ucs_status_string(status));
         goto err_free_md_addr;
     }
 
+    /* All endpoints of the local interface write to the same remote FIFO shard,
+     * selected by the identifier of the local receive FIFO */
+    shard = ucs_crc32(0, &seg->seg_id, sizeof(seg->seg_id)) % addr->fifo_shards;
+
     /* Initialize remote FIFO control structure */
-    uct_mm_iface_set_fifo_ptrs(fifo_ptr, &self->fifo_ctl, &self->fifo_elems);
+    uct_mm_iface_set_fifo_ptrs(iface, fifo_ptr, shard, &self->fifo_ctl,
+                               &self->fifo_elems);
     self->cached_tail     = self->fifo_ctl->tail;
     self->signal.addrlen  = self->fifo_ctl->signal_addrlen;
     self->signal.sockaddr = self->fifo_ctl->signal_sockaddr;
+    self->signal.eventfd  = -1;
     self->keepalive       = NULL;
+    self->zcopy_last_head = self->cached_tail - 1;
+    self->batch.active    = 0;
+    self->sim_tx_end      = ucs_get_time();
+
+    /* The receiver reads the payload of a zero-copy active message by the
+     * process id of the sender, which has to be valid in its PID namespace */
+    if (self->fifo_ctl->owner.pid_ns == ucs_sys_get_ns(UCS_SYS_NS_TYPE_PID)) {
+        self->am_zcopy_max = ucs_min(self->fifo_ctl->am_zcopy_max,
+                                     iface->config.am_zcopy_max);
+    } else {
+        self->am_zcopy_max = 0;
+    }
 
-    ucs_debug("created mm ep %p, connected to remote FIFO id 0x%"PRIx64,
-              self, addr->fifo_seg_id);
+    /* The receiver waits on an eventfd, take a duplicate of it */
+    if (self->fifo_ctl->signal_eventfd >= 0) {
+        if (!ucs_sys_ns_is_default(UCS_SYS_NS_TYPE_PID)) {
+            ucs_error("mm ep cannot signal the eventfd of remote FIFO id "
+                      "0x%"PRIx64" from a non-default PID namespace",
+                      addr->fifo_seg_id);
+            status = UCS_ERR_UNREACHABLE;
+            goto err_detach;
+        }
+
+        status = ucs_sys_pidfd_getfd(self->fifo_ctl->owner.pid,
+                                     self->fifo_ctl->signal_eventfd,
+                                     &self->signal.eventfd);
+        if (status != UCS_OK) {
+            ucs_error("mm ep failed to get signal eventfd %d of process %d: "
+                      "%s", self->fifo_ctl->signal_eventfd,
+                      self->fifo_ctl->owner.pid, ucs_status_string(status));
+            goto err_detach;
+        }
+    }
+
+    ucs_debug("created mm ep %p, connected to remote FIFO id 0x%"PRIx64
+              " shard %u/%u am_zcopy_max %zu", self, addr->fifo_seg_id, shard,
+              addr->fifo_shards, self->am_zcopy_max);
 
     return UCS_OK;
 
+err_detach:
+    kh_foreach_value(&self->remote_segs, remote_seg, {
+        uct_mm_md_mapper_call(md, mem_detach, &remote_seg);
+    })
+    kh_destroy_inplace(uct_mm_remote_seg, &self->remote_segs);
 err_free_md_addr:
     ucs_free(self->remote_iface_addr);
 err:
@@ -180,10 +282,23 @@ static UCS_CLASS_CLEANUP_FUNC(uct_mm_ep_t)
 {
     uct_mm_iface_t  *iface = ucs_derived_of(self->super.super.iface, uct_mm_iface_t);
     uct_mm_remote_seg_t remote_seg;
+    uct_mm_zcopy_tx_t *zcopy_tx;
+    ucs_queue_iter_t iter;
 
     ucs_free(self->keepalive);
     uct_mm_ep_pending_purge(&self->super.super, NULL, NULL);
 
+    ucs_queue_for_each_safe(zcopy_tx, iter, &iface->tx_zcopy_queue, queue) {
+        if (zcopy_tx->ep == self) {
+            ucs_queue_del_iter(&iface->tx_zcopy_queue, iter);
+            ucs_mpool_put(zcopy_tx);
+        }
+    }
+
+    if (self->signal.eventfd >= 0) {
+        close(self->signal.eventfd);
+    }
+
     kh_foreach_value(&self->remote_segs, remote_seg, {
         uct_mm_iface_mapper_call(iface, mem_detach, &remote_seg);
     })
@@ -225,6 +340,156 @@ static inline void uct_mm_ep_update_cached_tail(uct_mm_ep_t *ep)
     ep->cached_tail = ep->fifo_ctl->tail;
 }
 
+/* Make the written elements of the batch visible to the receiver */
+static void uct_mm_ep_batch_publish(uct_mm_ep_t *ep, uct_mm_iface_t *iface)
+{
+    uct_mm_fifo_element_t *elem;
+    uint64_t index;
+
+    if (ep->batch.start == ep->batch.head) {
+        return;
+    }
+
+    /* the elements were written with the owner bit of the previous FIFO
+     * wraparound; flush their contents before flipping it */
+    ucs_memory_cpu_store_fence();
+
+    for (index = ep->batch.start; index != ep->batch.head; ++index) {
+        elem         = UCT_MM_IFACE_GET_FIFO_ELEM(iface, ep->fifo_elems,
+                                                  index & iface->fifo_mask);
+        elem->flags ^= UCT_MM_FIFO_ELEM_FLAG_OWNER;
+    }
+
+    ep->batch.start = ep->batch.head;
+}
+
+/* Get the next element of the batch, reserving several elements of the remote
+ * FIFO with a single atomic operation when the reserved ones are used up */
+static UCS_F_NOINLINE ucs_status_t
+uct_mm_ep_batch_reserve(uct_mm_ep_t *ep, uct_mm_iface_t *iface)
+{
+    uint64_t head, prev_head, base;
+    int32_t avail;
+    unsigned count;
+
+    /* let the receiver drain the previous part of the batch */
+    uct_mm_ep_batch_publish(ep, iface);
+
+retry:
+    head = ep->fifo_ctl->head;
+    if (!UCT_MM_EP_IS_ABLE_TO_SEND(head, ep->cached_tail,
+                                   iface->config.fifo_size)) {
+        if (!ucs_arbiter_group_is_empty(&ep->arb_group)) {
+            UCS_STATS_UPDATE_COUNTER(ep->super.stats, UCT_EP_STAT_NO_RES, 1);
+            return UCS_ERR_NO_RESOURCE;
+        }
+
+        uct_mm_ep_update_cached_tail(ep);
+        if (!UCT_MM_EP_IS_ABLE_TO_SEND(head, ep->cached_tail,
+                                       iface->config.fifo_size)) {
+            UCS_STATS_UPDATE_COUNTER(ep->super.stats, UCT_EP_STAT_NO_RES, 1);
+            return UCS_ERR_NO_RESOURCE;
+        }
+    }
+
+    base  = head & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED;
+    avail = (int32_t)iface->config.fifo_size -
+            (int32_t)(head - ep->cached_tail);
+    count = ucs_min(ucs_max(ep->batch.count, 1), avail);
+
+    prev_head = ucs_atomic_cswap64(ucs_unaligned_ptr(&ep->fifo_ctl->head),
+                                   head, base + count);
+    if (prev_head != head) {
+        ucs_trace_poll("couldn't reserve FIFO elements. retrying");
+        goto retry;
+    }
+
+    if (head & UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED) {
+        ep->batch.signal = 1;
+    }
+
+    ep->batch.start = base;
+    ep->batch.head  = base;
+    ep->batch.end   = base + count;
+    return UCS_OK;
+}
+
+/* Return the reserved elements which the batch did not use */
+static void uct_mm_ep_batch_release(uct_mm_ep_t *ep, uct_mm_iface_t *iface)
+{
+    uct_mm_fifo_element_t *elem;
+    uint64_t head, index;
+    uint8_t elem_flags;
+
+    head = ep->fifo_ctl->head;
+    if ((head & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED) == ep->batch.end) {
+        if (ucs_atomic_cswap64(ucs_unaligned_ptr(&ep->fifo_ctl->head), head,
+                               ep->batch.head |
+                               (head & UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED)) ==
+            head) {
+            return;
+        }
+    }
+
+    /* other senders already took the elements after the reserved ones, so
+     * the receiver has to skip the unused elements */
+    for (index = ep->batch.head; index != ep->batch.end; ++index) {
+        elem       = UCT_MM_IFACE_GET_FIFO_ELEM(iface, ep->fifo_elems,
+                                                index & iface->fifo_mask);
+        elem_flags = UCT_MM_FIFO_ELEM_FLAG_NOP;
+        if (index & iface->config.fifo_size) {
+            elem_flags |= UCT_MM_FIFO_ELEM_FLAG_OWNER;
+        }
+        elem->flags = elem_flags;
+    }
+}
+
+static size_t uct_mm_ep_pack_zcopy(uct_mm_iface_t *iface, void *dest,
+                                   const void *header, unsigned header_length,
+                                   const uct_iov_t *iov, size_t iovcnt)
+{
+    uct_mm_zcopy_hdr_t *zcopy_hdr  = dest;
+    uct_mm_zcopy_iov_t *remote_iov = (uct_mm_zcopy_iov_t*)(zcopy_hdr + 1);
+    size_t iov_it;
+
+    zcopy_hdr->pid           = iface->recv_fifo_ctl->owner.pid;
+    zcopy_hdr->header_length = header_length;
+    zcopy_hdr->iovcnt        = 0;
+
+    for (iov_it = 0; iov_it < iovcnt; ++iov_it) {
+        if (uct_iov_get_length(&iov[iov_it]) == 0) {
+            continue;
+        }
+
+        remote_iov->address = (uintptr_t)iov[iov_it].buffer;
+        remote_iov->length  = uct_iov_get_length(&iov[iov_it]);
+        ++remote_iov;
+        ++zcopy_hdr->iovcnt;
+    }
+
+    memcpy(remote_iov, header, header_length);
+    return UCS_PTR_BYTE_DIFF(dest, remote_iov) + header_length;
+}
+
+/* Set the simulated delivery time of a message: it occupies the link of the
+ * endpoint after the previous messages, and then travels for the latency */
+static UCS_F_NOINLINE void
+uct_mm_ep_sim_stamp(uct_mm_ep_t *ep, uct_mm_iface_t *iface,
+                    uct_mm_fifo_element_t *elem, size_t length)
+{
+    ucs_time_t now = ucs_get_time();
+    ucs_time_t deliver_time;
+
+    if ((int64_t)(now - ep->sim_tx_end) > 0) {
+        ep->sim_tx_end = now;
+    }
+
+    ep->sim_tx_end += (ucs_time_t)(length * iface->sim.byte_time);
+    deliver_time    = ep->sim_tx_end + iface->sim.latency;
+    memcpy(UCT_MM_FIFO_ELEM_SIM_TIME(iface, elem), &deliver_time,
+           sizeof(deliver_time));
+}
+
 /* A common mm active message sending function.
  * The first parameter indicates the origin of the call.
  */
@@ -243,6 +508,20 @@ static UCS_F_ALWAYS_INLINE ssize_t uct_mm_ep_am_common_send(
 
     UCT_CHECK_AM_ID(am_id);
 
+    if (ucs_unlikely(ep->batch.active)) {
+        if (ep->batch.head == ep->batch.end) {
+            status = uct_mm_ep_batch_reserve(ep, iface);
+            if (status != UCS_OK) {
+                return status;
+            }
+        }
+
+        head = ep->batch.head;
+        elem = UCT_MM_IFACE_GET_FIFO_ELEM(iface, ep->fifo_elems,
+                                          head & iface->fifo_mask);
+        goto write;
+    }
+
 retry:
     head = ep->fifo_ctl->head;
     /* check if there is room in the remote process's receive FIFO to write */
@@ -269,6 +548,8 @@ retry:
         goto retry;
     }
 
+write:
+
     switch (send_op) {
     case UCT_MM_SEND_AM_SHORT:
         /* write to the remote FIFO */
@@ -310,28 +591,63 @@ retry:
                            elem + 1, elem->length, "TX: AM_SHORT");
         UCT_TL_EP_STAT_OP(&ep->super, AM, SHORT, elem->length);
         break;
+    case UCT_MM_SEND_AM_ZCOPY:
+        /* write the header and the address of the payload, the receiver reads
+         * the payload from our memory */
+        elem_flags   = UCT_MM_FIFO_ELEM_FLAG_ZCOPY;
+        elem->length = uct_mm_ep_pack_zcopy(iface, elem + 1, payload, length,
+                                            iov, iovcnt);
+        uct_iface_trace_am(&iface->super.super, UCT_AM_TRACE_TYPE_SEND, am_id,
+                           payload, length, "TX: AM_ZCOPY");
+        UCT_TL_EP_STAT_OP(&ep->super, AM, ZCOPY,
+                          length + uct_iov_total_length(iov, iovcnt));
+        ep->zcopy_last_head = head & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED;
+        break;
     }
 
     elem->am_id = am_id;
 
-    /* memory barrier - make sure that the memory is flushed before setting the
-     * 'writing is complete' flag which the reader checks */
-    ucs_memory_cpu_store_fence();
-
-    /* set the owner bit to indicate that the writing is complete.
-     * the owner bit flips after every FIFO wraparound */
-    if (head & iface->config.fifo_size) {
-        elem_flags |= UCT_MM_FIFO_ELEM_FLAG_OWNER;
+    if (ucs_unlikely(iface->sim.enable)) {
+        uct_mm_ep_sim_stamp(ep, iface, elem,
+                            (send_op == UCT_MM_SEND_AM_ZCOPY) ?
+                            (length + uct_iov_total_length(iov, iovcnt)) :
+                            elem->length);
+        elem_flags |= UCT_MM_FIFO_ELEM_FLAG_SIM;
     }
-    elem->flags = elem_flags;
 
-    if (ucs_unlikely(head & UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED)) {
-        uct_mm_ep_signal_remote(ep);
+    if (ucs_unlikely(ep->batch.active)) {
+        /* keep the owner bit of the previous wraparound, the element is
+         * published by uct_mm_ep_batch_publish() */
+        if (!(head & iface->config.fifo_size)) {
+            elem_flags |= UCT_MM_FIFO_ELEM_FLAG_OWNER;
+        }
+        elem->flags = elem_flags;
+
+        ++ep->batch.head;
+        if (ep->batch.count > 0) {
+            --ep->batch.count;
+        }
+    } else {
+        /* memory barrier - make sure that the memory is flushed before
+         * setting the 'writing is complete' flag which the reader checks */
+        ucs_memory_cpu_store_fence();
+
+        /* set the owner bit to indicate that the writing is complete.
+         * the owner bit flips after every FIFO wraparound */
+        if (head & iface->config.fifo_size) {
+            elem_flags |= UCT_MM_FIFO_ELEM_FLAG_OWNER;
+        }
+        elem->flags = elem_flags;
+
+        if (ucs_unlikely(head & UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED)) {
+            uct_mm_ep_signal_remote(ep);
+        }
     }
 
     switch (send_op) {
     case UCT_MM_SEND_AM_SHORT:
     case UCT_MM_SEND_AM_SHORT_IOV:
+    case UCT_MM_SEND_AM_ZCOPY:
         return UCS_OK;
     case UCT_MM_SEND_AM_BCOPY:
         return length;
@@ -346,8 +662,7 @@ ucs_status_t uct_mm_ep_am_short(uct_ep_h tl_ep, uint8_t id, uint64_t header,
     uct_mm_iface_t *iface = ucs_derived_of(tl_ep->iface, uct_mm_iface_t);
     uct_mm_ep_t *ep = ucs_derived_of(tl_ep, uct_mm_ep_t);
 
-    UCT_CHECK_LENGTH(length + sizeof(header), 0,
-                     iface->config.fifo_elem_size - sizeof(uct_mm_fifo_element_t),
+    UCT_CHECK_LENGTH(length + sizeof(header), 0, iface->config.am_max_short,
                      "am_short");
 
     return (ucs_status_t)uct_mm_ep_am_common_send(UCT_MM_SEND_AM_SHORT, ep,
@@ -362,9 +677,7 @@ ucs_status_t uct_mm_ep_am_short_iov(uct_ep_h tl_ep, uint8_t id,
     uct_mm_ep_t *ep       = ucs_derived_of(tl_ep, uct_mm_ep_t);
 
     UCT_CHECK_LENGTH(uct_iov_total_length(iov, iovcnt), 0,
-                     iface->config.fifo_elem_size -
-                             sizeof(uct_mm_fifo_element_t),
-                     "am_short_iov");
+                     iface->config.am_max_short, "am_short_iov");
 
     return (ucs_status_t)uct_mm_ep_am_common_send(UCT_MM_SEND_AM_SHORT_IOV, ep,
                                                   iface, id, 0, 0, NULL, NULL,
@@ -381,6 +694,149 @@ ssize_t uct_mm_ep_am_bcopy(uct_ep_h tl_ep, uint8_t id, uct_pack_callback_t pack_
                                     NULL, pack_cb, arg, NULL, 0);
 }
 
+static size_t uct_mm_ep_zcopy_pack(void *dest, void *arg)
+{
+    uct_mm_ep_zcopy_pack_args_t *args = arg;
+    ucs_iov_iter_t iov_iter;
+
+    memcpy(dest, args->header, args->header_length);
+    ucs_iov_iter_init(&iov_iter);
+    return args->header_length +
+           uct_iov_to_buffer(args->iov, args->iovcnt, &iov_iter,
+                             UCS_PTR_BYTE_OFFSET(dest, args->header_length),
+                             SIZE_MAX);
+}
+
+/* The remote side cannot read from our memory, so copy the message to its
+ * receive descriptor */
+static UCS_F_NOINLINE ucs_status_t
+uct_mm_ep_am_zcopy_copy(uct_mm_ep_t *ep, uct_mm_iface_t *iface, uint8_t id,
+                        const void *header, unsigned header_length,
+                        const uct_iov_t *iov, size_t iovcnt)
+{
+    uct_mm_ep_zcopy_pack_args_t args;
+    size_t length;
+    ssize_t packed;
+
+    length = header_length + uct_iov_total_length(iov, iovcnt);
+    if (length > iface->config.seg_size) {
+        ucs_error("mm_ep %p: remote side cannot receive zero-copy active "
+                  "message of %zu bytes", ep, length);
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    args.header        = header;
+    args.header_length = header_length;
+    args.iov           = iov;
+    args.iovcnt        = iovcnt;
+
+    packed = uct_mm_ep_am_common_send(UCT_MM_SEND_AM_BCOPY, ep, iface, id, 0, 0,
+                                      NULL, uct_mm_ep_zcopy_pack, &args, NULL,
+                                      0);
+    return (packed < 0) ? (ucs_status_t)packed : UCS_OK;
+}
+
+ucs_status_t uct_mm_ep_am_zcopy(uct_ep_h tl_ep, uint8_t id, const void *header,
+                                unsigned header_length, const uct_iov_t *iov,
+                                size_t iovcnt, unsigned flags,
+                                uct_completion_t *comp)
+{
+    uct_mm_iface_t *iface = ucs_derived_of(tl_ep->iface, uct_mm_iface_t);
+    uct_mm_ep_t *ep       = ucs_derived_of(tl_ep, uct_mm_ep_t);
+    uct_mm_zcopy_tx_t *zcopy_tx;
+    ucs_status_t status;
+
+    UCT_CHECK_IOV_SIZE(iovcnt, UCT_MM_IFACE_AM_ZCOPY_MAX_IOV,
+                       "uct_mm_ep_am_zcopy");
+    UCT_CHECK_LENGTH(header_length, 0, iface->config.am_zcopy_max_hdr,
+                     "am_zcopy header");
+    UCT_CHECK_LENGTH(header_length + uct_iov_total_length(iov, iovcnt), 0,
+                     iface->config.am_zcopy_max, "am_zcopy");
+
+    if (ucs_unlikely(header_length + uct_iov_total_length(iov, iovcnt) >
+                     ep->am_zcopy_max)) {
+        return uct_mm_ep_am_zcopy_copy(ep, iface, id, header, header_length,
+                                       iov, iovcnt);
+    }
+
+    zcopy_tx = ucs_mpool_get_inline(&iface->tx_zcopy_mp);
+    if (ucs_unlikely(zcopy_tx == NULL)) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    status = (ucs_status_t)uct_mm_ep_am_common_send(UCT_MM_SEND_AM_ZCOPY, ep,
+                                                    iface, id, header_length,
+                                                    0, header, NULL, NULL, iov,
+                                                    iovcnt);
+    if (status != UCS_OK) {
+        ucs_mpool_put_inline(zcopy_tx);
+        return status;
+    }
+
+    zcopy_tx->ep   = ep;
+    zcopy_tx->head = ep->zcopy_last_head;
+    zcopy_tx->comp = comp;
+    ucs_queue_push(&iface->tx_zcopy_queue, &zcopy_tx->queue);
+    return UCS_INPROGRESS;
+}
+
+void uct_mm_ep_am_batch_begin(uct_ep_h tl_ep, unsigned count)
+{
+    uct_mm_ep_t *ep = ucs_derived_of(tl_ep, uct_mm_ep_t);
+
+    ucs_assert(!ep->batch.active);
+
+    ep->batch.active = 1;
+    ep->batch.signal = 0;
+    ep->batch.count  = count;
+    ep->batch.start  = 0;
+    ep->batch.head   = 0;
+    ep->batch.end    = 0;
+}
+
+void uct_mm_ep_am_batch_commit(uct_ep_h tl_ep)
+{
+    uct_mm_iface_t *iface = ucs_derived_of(tl_ep->iface, uct_mm_iface_t);
+    uct_mm_ep_t *ep       = ucs_derived_of(tl_ep, uct_mm_ep_t);
+
+    ucs_assert(ep->batch.active);
+
+    uct_mm_ep_batch_publish(ep, iface);
+    if (ep->batch.head != ep->batch.end) {
+        uct_mm_ep_batch_release(ep, iface);
+    }
+
+    if (ep->batch.signal) {
+        uct_mm_ep_signal_remote(ep);
+    }
+
+    ep->batch.active = 0;
+}
+
+unsigned uct_mm_ep_progress_zcopy(uct_mm_iface_t *iface)
+{
+    unsigned count = 0;
+    uct_mm_zcopy_tx_t *zcopy_tx;
+    ucs_queue_iter_t iter;
+
+    ucs_memory_cpu_load_fence();
+
+    ucs_queue_for_each_safe(zcopy_tx, iter, &iface->tx_zcopy_queue, queue) {
+        if (!UCT_MM_EP_IS_ZCOPY_COMPLETED(zcopy_tx->ep, zcopy_tx->head)) {
+            continue;
+        }
+
+        ucs_queue_del_iter(&iface->tx_zcopy_queue, iter);
+        if (zcopy_tx->comp != NULL) {
+            uct_invoke_completion(zcopy_tx->comp, UCS_OK);
+        }
+        ucs_mpool_put_inline(zcopy_tx);
+        ++count;
+    }
+
+    return count;
+}
+
 static inline int uct_mm_ep_has_tx_resources(uct_mm_ep_t *ep)
 {
     uct_mm_iface_t *iface = ucs_derived_of(ep->super.super.iface, uct_mm_iface_t);
@@ -479,6 +935,30 @@ void uct_mm_ep_pending_purge(uct_ep_h tl_ep, uct_pending_purge_callback_t cb,
                             uct_mm_ep_arbiter_purge_cb, &args);
 }
 
+/* Wait for the zero-copy active messages sent before the flush */
+static ucs_status_t
+uct_mm_ep_flush_zcopy(uct_mm_ep_t *ep, uct_completion_t *comp)
+{
+    uct_mm_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                           uct_mm_iface_t);
+    uct_mm_zcopy_tx_t *zcopy_tx;
+
+    if (comp != NULL) {
+        zcopy_tx = ucs_mpool_get_inline(&iface->tx_zcopy_mp);
+        if (zcopy_tx == NULL) {
+            return UCS_ERR_NO_MEMORY;
+        }
+
+        zcopy_tx->ep   = ep;
+        zcopy_tx->head = ep->zcopy_last_head;
+        zcopy_tx->comp = comp;
+        ucs_queue_push(&iface->tx_zcopy_queue, &zcopy_tx->queue);
+    }
+
+    UCT_TL_EP_STAT_FLUSH_WAIT(&ep->super);
+    return UCS_INPROGRESS;
+}
+
 ucs_status_t uct_mm_ep_flush(uct_ep_h tl_ep, unsigned flags,
                              uct_completion_t *comp)
 {
@@ -495,6 +975,10 @@ ucs_status_t uct_mm_ep_flush(uct_ep_h tl_ep, unsigned flags,
         }
     }
 
+    if (!UCT_MM_EP_IS_ZCOPY_COMPLETED(ep, ep->zcopy_last_head)) {
+        return uct_mm_ep_flush_zcopy(ep, comp);
+    }
+
     ucs_memory_cpu_store_fence();
     UCT_TL_EP_STAT_FLUSH(&ep->super);
     return UCS_OK;
@@ -50,12 +50,43 @@ typedef struct uct_mm_ep {
     struct {
         struct sockaddr_un     sockaddr;  /* address of signaling socket */
         socklen_t              addrlen;   /* address length of signaling socket */
+        int                    eventfd;   /* duplicated eventfd of the remote
+                                             interface, or -1 to use the socket */
     } signal;
 
     uct_mm_keepalive_info_t    *keepalive; /* keepalive info */
+
+    size_t                     am_zcopy_max;    /* maximal zero-copy AM which the
+                                                   remote side can receive */
+    uint64_t                   zcopy_last_head; /* FIFO index of the last
+                                                   zero-copy AM */
+    ucs_time_t                 sim_tx_end;      /* when the simulated link
+                                                   becomes idle */
+
+    /* Active messages batch, see uct_ep_am_batch_begin() */
+    struct {
+        int                    active;    /* whether a batch is started */
+        int                    signal;    /* signal the remote side on commit */
+        unsigned               count;     /* expected number of messages left */
+        uint64_t               start;     /* first written, unpublished element */
+        uint64_t               head;      /* next element to write */
+        uint64_t               end;       /* end of the reserved elements */
+    } batch;
 } uct_mm_ep_t;
 
 
+/**
+ * Outstanding zero-copy active message. It is completed when the receiver
+ * releases its FIFO element, which happens after the payload was read.
+ */
+typedef struct uct_mm_zcopy_tx {
+    ucs_queue_elem_t           queue;       /* element in iface queue */
+    uct_mm_ep_t                *ep;         /* endpoint of the operation */
+    uint64_t                   head;        /* FIFO index of the element */
+    uct_completion_t           *comp;       /* user completion, can be NULL */
+} uct_mm_zcopy_tx_t;
+
+
 UCS_CLASS_DECLARE_NEW_FUNC(uct_mm_ep_t, uct_ep_t,const uct_ep_params_t *);
 UCS_CLASS_DECLARE_DELETE_FUNC(uct_mm_ep_t, uct_ep_t);
 
@@ -68,6 +99,15 @@ ucs_status_t uct_mm_ep_am_short_iov(uct_ep_h tl_ep, uint8_t id,
 ssize_t uct_mm_ep_am_bcopy(uct_ep_h tl_ep, uint8_t id, uct_pack_callback_t pack_cb,
                            void *arg, unsigned flags);
 
+ucs_status_t uct_mm_ep_am_zcopy(uct_ep_h tl_ep, uint8_t id, const void *header,
+                                unsigned header_length, const uct_iov_t *iov,
+                                size_t iovcnt, unsigned flags,
+                                uct_completion_t *comp);
+
+void uct_mm_ep_am_batch_begin(uct_ep_h tl_ep, unsigned count);
+
+void uct_mm_ep_am_batch_commit(uct_ep_h tl_ep);
+
 ucs_status_t uct_mm_ep_flush(uct_ep_h tl_ep, unsigned flags,
                              uct_completion_t *comp);
 
@@ -85,4 +125,6 @@ ucs_arbiter_cb_result_t uct_mm_ep_process_pending(ucs_arbiter_t *arbiter,
                                                   ucs_arbiter_elem_t *elem,
                                                   void *arg);
 
+unsigned uct_mm_ep_progress_zcopy(uct_mm_iface_t *iface);
+
 #endif
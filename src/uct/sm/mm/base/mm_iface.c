@@ -16,13 +16,42 @@
 #include <ucs/arch/atomic.h>
 #include <ucs/arch/bitops.h>
 #include <ucs/async/async.h>
+#include <ucs/memory/numa.h>
 #include <ucs/sys/string.h>
+#include <sys/eventfd.h>
 #include <sys/poll.h>
+#include <sys/prctl.h>
+#include <sys/uio.h>
 
 
 /* Maximal number of events to clear from the signaling pipe in single call */
 #define UCT_MM_IFACE_MAX_SIG_EVENTS  32
 
+/* Number of zero-copy receive descriptors to allocate at once */
+#define UCT_MM_IFACE_ZCOPY_DESC_GROW 8
+
+
+#ifdef ENABLE_STATS
+static ucs_stats_class_t uct_mm_iface_stats_class = {
+    .name          = "mm_iface",
+    .num_counters  = UCT_MM_IFACE_STAT_LAST,
+    .counter_names = {
+        [UCT_MM_IFACE_STAT_EMPTY_POLL]     = "empty_poll",
+        [UCT_MM_IFACE_STAT_POLL_LIMIT_INC] = "poll_limit_inc",
+        [UCT_MM_IFACE_STAT_POLL_LIMIT_DEC] = "poll_limit_dec",
+        [UCT_MM_IFACE_STAT_RELEASE_INC]    = "release_inc",
+        [UCT_MM_IFACE_STAT_RELEASE_DEC]    = "release_dec"
+    }
+};
+#endif
+
+
+static const char *uct_mm_iface_signal_mode_names[] = {
+    [UCT_MM_IFACE_SIGNAL_SOCKET]  = "socket",
+    [UCT_MM_IFACE_SIGNAL_EVENTFD] = "eventfd",
+    [UCT_MM_IFACE_SIGNAL_LAST]    = NULL
+};
+
 
 ucs_config_field_t uct_mm_iface_config_table[] = {
     {"SM_", "ALLOC=md,mmap,heap", NULL,
@@ -57,10 +86,86 @@ ucs_config_field_t uct_mm_iface_config_table[] = {
      "Size of the FIFO element size (data + header) in the MM UCTs.",
      ucs_offsetof(uct_mm_iface_config_t, fifo_elem_size), UCS_CONFIG_TYPE_UINT},
 
+    {"FIFO_SHARDS", "1",
+     "Number of independent FIFOs in the receive FIFO segment. Every remote sender\n"
+     "writes to one of them, so that senders on different shards do not contend on\n"
+     "the same FIFO head. The shards are polled in round-robin order, and each one\n"
+     "holds FIFO_SIZE elements with their receive descriptors.",
+     ucs_offsetof(uct_mm_iface_config_t, fifo_shards), UCS_CONFIG_TYPE_UINT},
+
     {"FIFO_MAX_POLL", UCS_PP_MAKE_STRING(UCT_MM_IFACE_FIFO_MAX_POLL),
      "Maximal number of receive completions to pick during RX poll",
      ucs_offsetof(uct_mm_iface_config_t, fifo_max_poll), UCS_CONFIG_TYPE_ULUNITS},
 
+    {"FIFO_ADAPTIVE", "n",
+     "Tune the receive FIFO polling by the observed load. When the FIFO is busy,\n"
+     "the number of receive completions to pick during RX poll is allowed to grow\n"
+     "up to the FIFO size, and the tail is released less often, down to\n"
+     "FIFO_RELEASE_FACTOR. When most polls find no data, both are reduced in\n"
+     "favor of latency. FIFO_MAX_POLL is used as the initial value.",
+     ucs_offsetof(uct_mm_iface_config_t, fifo_adaptive), UCS_CONFIG_TYPE_BOOL},
+
+    {"NUMA_PLACEMENT", "default",
+     "NUMA placement of the receive FIFO and the receive segments:\n"
+     " default    - Do not set a memory policy, pages are placed on first touch.\n"
+     " local      - Prefer the NUMA node of the CPU which creates the interface.\n"
+     " interleave - Interleave the pages over all NUMA nodes.\n"
+     " node       - Prefer the NUMA node specified by NUMA_NODE.",
+     ucs_offsetof(uct_mm_iface_config_t, numa_placement),
+     UCS_CONFIG_TYPE_ENUM(ucs_numa_placement_names)},
+
+    {"NUMA_NODE", "0",
+     "NUMA node of the receive FIFO and the receive segments when\n"
+     "NUMA_PLACEMENT=node.",
+     ucs_offsetof(uct_mm_iface_config_t, numa_node), UCS_CONFIG_TYPE_UINT},
+
+    {"SIGNAL_MODE", "socket",
+     "How a sender wakes up a receiver which waits for events:\n"
+     " socket  - Send a datagram to a Unix domain socket of the receiver.\n"
+     " eventfd - Write to an eventfd of the receiver, which the sender duplicates\n"
+     "           with pidfd_getfd() when it connects. This is cheaper than a\n"
+     "           socket send, but requires Linux 5.6 or newer, a shared PID\n"
+     "           namespace, and ptrace access from the senders; the receiver\n"
+     "           allows it with PR_SET_PTRACER if Yama is enabled.\n"
+     "In both modes, a sender makes the wakeup system call only if the\n"
+     "receiver has armed its event.",
+     ucs_offsetof(uct_mm_iface_config_t, signal_mode),
+     UCS_CONFIG_TYPE_ENUM(uct_mm_iface_signal_mode_names)},
+
+    {"AM_ZCOPY", "try",
+     "Enable zero-copy active messages. The sender passes the address of the\n"
+     "payload in the FIFO element, and the receiver reads it directly from the\n"
+     "sender memory with process_vm_readv(), so the payload is copied once instead\n"
+     "of twice. It requires the peers to share the PID namespace and to allow\n"
+     "ptrace access to each other.\n"
+     " y   - Enable zero-copy active messages, fail if it is not possible.\n"
+     " n   - Disable zero-copy active messages.\n"
+     " try - Enable zero-copy active messages if it is possible.",
+     ucs_offsetof(uct_mm_iface_config_t, am_zcopy), UCS_CONFIG_TYPE_TERNARY},
+
+    {"AM_ZCOPY_MAX", "256k",
+     "Maximal size of a zero-copy active message. The receiver reads the message\n"
+     "to a private descriptor of this size.",
+     ucs_offsetof(uct_mm_iface_config_t, am_zcopy_max), UCS_CONFIG_TYPE_MEMUNITS},
+
+    {"SIM_LATENCY", "0",
+     "Simulated network latency of active messages, for testing and tuning\n"
+     "protocols without the network hardware. The receiver processes a message\n"
+     "only after this time has passed since it was sent. 0 disables it.\n"
+     "The interface reports this latency instead of the shared memory one.",
+     ucs_offsetof(uct_mm_iface_config_t, sim_latency), UCS_CONFIG_TYPE_TIME},
+
+    {"SIM_BW", "auto",
+     "Simulated network bandwidth of active messages. Every endpoint sends its\n"
+     "messages one after another, each occupying the simulated link for its\n"
+     "size divided by this bandwidth. \"auto\" disables it.\n"
+     "The interface reports this bandwidth instead of the shared memory one.\n"
+     "If SIM_LATENCY or SIM_BW is set, the interface also supports PUT and GET\n"
+     "zero-copy operations, and the maximal short active message is smaller by\n"
+     "the size of the delivery time, which is written in the FIFO element.\n"
+     "The maximal send size, which models the network MTU, is set by SEG_SIZE.",
+     ucs_offsetof(uct_mm_iface_config_t, sim_bw), UCS_CONFIG_TYPE_BW},
+
     {NULL}
 };
 
@@ -74,6 +179,7 @@ static ucs_status_t uct_mm_iface_get_address(uct_iface_t *tl_iface,
     uct_mm_seg_t        *seg        = iface->recv_fifo_mem.memh;
 
     iface_addr->fifo_seg_id = seg->seg_id;
+    iface_addr->fifo_shards = iface->config.fifo_shards;
     return uct_mm_md_mapper_ops(md)->iface_addr_pack(md, iface_addr + 1);
 }
 
@@ -106,10 +212,17 @@ void uct_mm_iface_release_desc(uct_recv_desc_t *self, void *desc)
 ucs_status_t uct_mm_iface_flush(uct_iface_h tl_iface, unsigned flags,
                                 uct_completion_t *comp)
 {
+    uct_mm_iface_t *iface = ucs_derived_of(tl_iface, uct_mm_iface_t);
+
     if (comp != NULL) {
         return UCS_ERR_UNSUPPORTED;
     }
 
+    if (!ucs_queue_is_empty(&iface->tx_zcopy_queue)) {
+        UCT_TL_IFACE_STAT_FLUSH_WAIT(ucs_derived_of(tl_iface, uct_base_iface_t));
+        return UCS_INPROGRESS;
+    }
+
     ucs_memory_cpu_store_fence();
     UCT_TL_IFACE_STAT_FLUSH(ucs_derived_of(tl_iface, uct_base_iface_t));
     return UCS_OK;
@@ -130,23 +243,23 @@ static ucs_status_t uct_mm_iface_query(uct_iface_h tl_iface,
     iface_attr->cap.put.max_zcopy       = SIZE_MAX;
     iface_attr->cap.put.opt_zcopy_align = UCS_SYS_CACHE_LINE_SIZE;
     iface_attr->cap.put.align_mtu       = iface_attr->cap.put.opt_zcopy_align;
-    iface_attr->cap.put.max_iov         = 1;
+    iface_attr->cap.put.max_iov         = UCT_SM_MAX_IOV;
 
     iface_attr->cap.get.max_bcopy       = SIZE_MAX;
     iface_attr->cap.get.min_zcopy       = 0;
     iface_attr->cap.get.max_zcopy       = SIZE_MAX;
     iface_attr->cap.get.opt_zcopy_align = UCS_SYS_CACHE_LINE_SIZE;
     iface_attr->cap.get.align_mtu       = iface_attr->cap.get.opt_zcopy_align;
-    iface_attr->cap.get.max_iov         = 1;
+    iface_attr->cap.get.max_iov         = UCT_SM_MAX_IOV;
 
-    iface_attr->cap.am.max_short        = iface->config.fifo_elem_size -
-                                          sizeof(uct_mm_fifo_element_t);
+    iface_attr->cap.am.max_short        = iface->config.am_max_short;
     iface_attr->cap.am.max_bcopy        = iface->config.seg_size;
     iface_attr->cap.am.min_zcopy        = 0;
     iface_attr->cap.am.max_zcopy        = 0;
     iface_attr->cap.am.opt_zcopy_align  = UCS_SYS_CACHE_LINE_SIZE;
     iface_attr->cap.am.align_mtu        = iface_attr->cap.am.opt_zcopy_align;
     iface_attr->cap.am.max_iov          = SIZE_MAX;
+    iface_attr->cap.am.max_hdr          = 0;
 
     iface_attr->iface_addr_len          = sizeof(uct_mm_iface_addr_t) +
                                           md->iface_addr_len;
@@ -159,6 +272,7 @@ static ucs_status_t uct_mm_iface_query(uct_iface_h tl_iface,
                                           UCT_IFACE_FLAG_GET_BCOPY           |
                                           UCT_IFACE_FLAG_AM_SHORT            |
                                           UCT_IFACE_FLAG_AM_BCOPY            |
+                                          UCT_IFACE_FLAG_AM_BATCH            |
                                           UCT_IFACE_FLAG_PENDING             |
                                           UCT_IFACE_FLAG_CB_SYNC             |
                                           UCT_IFACE_FLAG_EP_CHECK            |
@@ -167,6 +281,17 @@ static ucs_status_t uct_mm_iface_query(uct_iface_h tl_iface,
                                           UCT_IFACE_FLAG_EVENT_RECV          |
                                           UCT_IFACE_FLAG_EVENT_FD;
 
+    if (iface->config.am_zcopy_max > 0) {
+        /* a message which fits a receive descriptor is cheaper to copy twice
+         * than to read with a system call */
+        iface_attr->cap.am.min_zcopy    = ucs_min(iface->config.seg_size,
+                                                  iface->config.am_zcopy_max);
+        iface_attr->cap.am.max_zcopy    = iface->config.am_zcopy_max;
+        iface_attr->cap.am.max_hdr      = iface->config.am_zcopy_max_hdr;
+        iface_attr->cap.am.max_iov      = UCT_MM_IFACE_AM_ZCOPY_MAX_IOV;
+        iface_attr->cap.flags          |= UCT_IFACE_FLAG_AM_ZCOPY;
+    }
+
     iface_attr->cap.atomic32.op_flags   =
     iface_attr->cap.atomic64.op_flags   = UCS_BIT(UCT_ATOMIC_OP_ADD)         |
                                           UCS_BIT(UCT_ATOMIC_OP_AND)         |
@@ -186,18 +311,69 @@ static ucs_status_t uct_mm_iface_query(uct_iface_h tl_iface,
     iface_attr->overhead                = 10e-9; /* 10 ns */
     iface_attr->priority                = 0;
 
+    if (iface->sim.enable) {
+        /* the remote memory is accessed by the rkey like in put/get bcopy */
+        iface_attr->cap.flags |= UCT_IFACE_FLAG_PUT_ZCOPY |
+                                 UCT_IFACE_FLAG_GET_ZCOPY;
+        if (iface->sim.latency > 0) {
+            iface_attr->latency = ucs_linear_func_make(
+                    ucs_time_to_sec(iface->sim.latency), 0);
+        }
+        if (iface->sim.byte_time > 0) {
+            iface_attr->bandwidth.dedicated = ucs_time_from_sec(1.0) /
+                                              iface->sim.byte_time;
+        }
+    }
+
+    return UCS_OK;
+}
+
+ucs_status_t
+uct_mm_query_tl_devices(uct_md_h md, uct_tl_device_resource_t **tl_devices_p,
+                        unsigned *num_tl_devices_p)
+{
+    uct_mm_md_t *mm_md = ucs_derived_of(md, uct_mm_md_t);
+    unsigned num_devices = mm_md->config->num_devices;
+    uct_tl_device_resource_t *devices;
+    unsigned i;
+
+    if (num_devices <= 1) {
+        return uct_sm_base_query_tl_devices(md, tl_devices_p,
+                                            num_tl_devices_p);
+    }
+
+    devices = ucs_calloc(num_devices, sizeof(*devices), "device resource");
+    if (devices == NULL) {
+        ucs_error("failed to allocate device resource");
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    for (i = 0; i < num_devices; ++i) {
+        if (i == 0) {
+            ucs_snprintf_zero(devices[i].name, sizeof(devices[i].name), "%s",
+                              UCT_SM_DEVICE_NAME);
+        } else {
+            ucs_snprintf_zero(devices[i].name, sizeof(devices[i].name), "%s%u",
+                              UCT_SM_DEVICE_NAME, i);
+        }
+        devices[i].type       = UCT_DEVICE_TYPE_SHM;
+        devices[i].sys_device = UCS_SYS_DEVICE_ID_UNKNOWN;
+    }
+
+    *tl_devices_p     = devices;
+    *num_tl_devices_p = num_devices;
     return UCS_OK;
 }
 
 static UCS_F_ALWAYS_INLINE void
-uct_mm_progress_fifo_tail(uct_mm_iface_t *iface)
+uct_mm_progress_fifo_tail(uct_mm_iface_t *iface, uct_mm_fifo_shard_t *shard)
 {
     /* don't progress the tail every time - release in batches. improves performance */
-    if (iface->read_index & iface->fifo_release_factor_mask) {
+    if (shard->read_index & iface->fifo_release_factor_mask) {
         return;
     }
 
-    iface->recv_fifo_ctl->tail = iface->read_index;
+    shard->fifo_ctl->tail = shard->read_index;
 }
 
 static UCS_F_ALWAYS_INLINE ucs_status_t
@@ -219,6 +395,77 @@ uct_mm_assign_desc_to_fifo_elem(uct_mm_iface_t *iface,
     return UCS_OK;
 }
 
+static UCS_F_NOINLINE void
+uct_mm_iface_process_recv_zcopy(uct_mm_iface_t *iface,
+                                uct_mm_fifo_element_t *elem)
+{
+    uct_mm_zcopy_hdr_t *zcopy_hdr  = (uct_mm_zcopy_hdr_t*)(elem + 1);
+    uct_mm_zcopy_iov_t *remote_iov = (uct_mm_zcopy_iov_t*)(zcopy_hdr + 1);
+    struct iovec remote_iovec[UCT_MM_IFACE_AM_ZCOPY_MAX_IOV];
+    struct iovec local_iovec;
+    uct_mm_recv_desc_t *desc;
+    ucs_status_t status;
+    size_t length;
+    unsigned i;
+    ssize_t ret;
+    void *data;
+
+    length = zcopy_hdr->header_length;
+    for (i = 0; i < zcopy_hdr->iovcnt; ++i) {
+        remote_iovec[i].iov_base = (void*)(uintptr_t)remote_iov[i].address;
+        remote_iovec[i].iov_len  = remote_iov[i].length;
+        length                  += remote_iov[i].length;
+    }
+
+    if ((zcopy_hdr->iovcnt > UCT_MM_IFACE_AM_ZCOPY_MAX_IOV) ||
+        (length > iface->config.am_zcopy_max)) {
+        ucs_error("mm_iface %p: invalid zero-copy active message from pid %d "
+                  "(iovcnt %u length %zu)", iface, zcopy_hdr->pid,
+                  zcopy_hdr->iovcnt, length);
+        return;
+    }
+
+    desc = ucs_mpool_get_inline(&iface->recv_zcopy_mp);
+    if (ucs_unlikely(desc == NULL)) {
+        ucs_error("mm_iface %p: failed to allocate zero-copy receive "
+                  "descriptor", iface);
+        return;
+    }
+
+    /* the header is inline in the FIFO element, followed by the payload which
+     * is read directly from the sender memory */
+    data = UCS_PTR_BYTE_OFFSET(desc + 1, iface->rx_headroom);
+    memcpy(data, remote_iov + zcopy_hdr->iovcnt, zcopy_hdr->header_length);
+
+    local_iovec.iov_base = UCS_PTR_BYTE_OFFSET(data, zcopy_hdr->header_length);
+    local_iovec.iov_len  = length - zcopy_hdr->header_length;
+    if (local_iovec.iov_len > 0) {
+#ifdef HAVE_PROCESS_VM_READV
+        ret = process_vm_readv(zcopy_hdr->pid, &local_iovec, 1, remote_iovec,
+                               zcopy_hdr->iovcnt, 0);
+#else
+        ret   = -1;
+        errno = ENOSYS;
+#endif
+        if (ret != local_iovec.iov_len) {
+            ucs_error("mm_iface %p: process_vm_readv(pid=%d length=%zu) "
+                      "returned %zd: %m", iface, zcopy_hdr->pid,
+                      local_iovec.iov_len, ret);
+            ucs_mpool_put_inline(desc);
+            return;
+        }
+    }
+
+    uct_iface_trace_am(&iface->super.super, UCT_AM_TRACE_TYPE_RECV,
+                       elem->am_id, data, length, "RX: AM_ZCOPY");
+
+    status = uct_mm_iface_invoke_am(iface, elem->am_id, data, length,
+                                    UCT_CB_PARAM_FLAG_DESC);
+    if (status == UCS_OK) {
+        ucs_mpool_put_inline(desc);
+    }
+}
+
 static UCS_F_ALWAYS_INLINE void
 uct_mm_iface_process_recv(uct_mm_iface_t *iface,
                           uct_mm_fifo_element_t* elem)
@@ -234,6 +481,16 @@ uct_mm_iface_process_recv(uct_mm_iface_t *iface,
         return;
     }
 
+    if (ucs_unlikely(elem->flags & UCT_MM_FIFO_ELEM_FLAG_NOP)) {
+        /* the sender reserved this element but did not use it */
+        return;
+    }
+
+    if (ucs_unlikely(elem->flags & UCT_MM_FIFO_ELEM_FLAG_ZCOPY)) {
+        uct_mm_iface_process_recv_zcopy(iface, elem);
+        return;
+    }
+
     /* check the memory pool to make sure that there is a new descriptor available */
     if (ucs_unlikely(iface->last_recv_desc == NULL)) {
         UCT_TL_IFACE_GET_RX_DESC(&iface->super.super, &iface->recv_desc_mp,
@@ -259,37 +516,64 @@ uct_mm_iface_process_recv(uct_mm_iface_t *iface,
 }
 
 static UCS_F_ALWAYS_INLINE int
-uct_mm_iface_fifo_has_new_data(uct_mm_iface_t *iface)
+uct_mm_iface_fifo_has_new_data(uct_mm_iface_t *iface,
+                               uct_mm_fifo_shard_t *shard)
 {
     /* check the read_index to see if there is a new item to read
      * (checking the owner bit) */
-    return (((iface->read_index >> iface->fifo_shift) & 1) ==
-            (iface->read_index_elem->flags & 1));
+    return (((shard->read_index >> iface->fifo_shift) & 1) ==
+            (shard->read_index_elem->flags & 1));
+}
+
+/* Check if the simulated delivery time of a FIFO element has passed */
+static UCS_F_NOINLINE int
+uct_mm_iface_sim_is_delivered(uct_mm_iface_t *iface,
+                              uct_mm_fifo_element_t *elem)
+{
+    ucs_time_t deliver_time;
+
+    memcpy(&deliver_time, UCT_MM_FIFO_ELEM_SIM_TIME(iface, elem),
+           sizeof(deliver_time));
+    return (int64_t)(ucs_get_time() - deliver_time) >= 0;
 }
 
 static UCS_F_ALWAYS_INLINE unsigned
-uct_mm_iface_poll_fifo(uct_mm_iface_t *iface)
+uct_mm_iface_poll_fifo(uct_mm_iface_t *iface, uct_mm_fifo_shard_t *shard)
 {
-    if (!uct_mm_iface_fifo_has_new_data(iface)) {
+    uint8_t elem_flags;
+
+    if (!uct_mm_iface_fifo_has_new_data(iface, shard)) {
         return 0;
     }
 
     /* read from read_index_elem */
     ucs_memory_cpu_load_fence();
-    ucs_assert(iface->read_index <=
-               (iface->recv_fifo_ctl->head & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED));
+    ucs_assert(shard->read_index <=
+               (shard->fifo_ctl->head & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED));
+
+    elem_flags = shard->read_index_elem->flags;
+    if (ucs_unlikely(elem_flags & UCT_MM_FIFO_ELEM_FLAG_SIM) &&
+        !uct_mm_iface_sim_is_delivered(iface, shard->read_index_elem)) {
+        /* the next messages of the shard were sent after this one */
+        return 0;
+    }
 
-    uct_mm_iface_process_recv(iface, iface->read_index_elem);
+    uct_mm_iface_process_recv(iface, shard->read_index_elem);
 
     /* raise the read_index */
-    iface->read_index++;
+    shard->read_index++;
 
     /* the next fifo_element which the read_index points to */
-    iface->read_index_elem =
-        UCT_MM_IFACE_GET_FIFO_ELEM(iface, iface->recv_fifo_elems,
-                                   (iface->read_index & iface->fifo_mask));
+    shard->read_index_elem =
+        UCT_MM_IFACE_GET_FIFO_ELEM(iface, shard->fifo_elems,
+                                   (shard->read_index & iface->fifo_mask));
 
-    uct_mm_progress_fifo_tail(iface);
+    if (ucs_unlikely(elem_flags & UCT_MM_FIFO_ELEM_FLAG_ZCOPY)) {
+        /* the sender of a zero-copy message waits for the tail to pass it */
+        shard->fifo_ctl->tail = shard->read_index;
+    } else {
+        uct_mm_progress_fifo_tail(iface, shard);
+    }
 
     return 1;
 }
@@ -316,29 +600,126 @@ uct_mm_iface_fifo_window_adjust(uct_mm_iface_t *iface,
          * is harmful to latency */
         iface->fifo_poll_count = ucs_min(iface->fifo_poll_count +
                                          UCT_MM_IFACE_FIFO_AI_VALUE,
-                                         iface->config.fifo_max_poll);
+                                         iface->adapt.max_poll);
     } else {
         iface->fifo_prev_wnd_cons = 1;
     }
 }
 
+static UCS_F_NOINLINE void uct_mm_iface_adapt_tune(uct_mm_iface_t *iface)
+{
+    unsigned max_occupancy = 0;
+    uct_mm_fifo_shard_t *shard;
+    unsigned i, occupancy;
+    uint64_t head;
+
+    UCS_STATS_UPDATE_COUNTER(iface->stats, UCT_MM_IFACE_STAT_EMPTY_POLL,
+                             iface->adapt.empty_count);
+
+    for (i = 0; i < iface->config.fifo_shards; ++i) {
+        shard         = &iface->recv_shards[i];
+        head          = shard->fifo_ctl->head &
+                        ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED;
+        occupancy     = head - shard->read_index;
+        max_occupancy = ucs_max(max_occupancy, occupancy);
+    }
+
+    if ((max_occupancy >= (iface->config.fifo_size /
+                           UCT_MM_IFACE_ADAPT_OCCUPANCY_DIV)) ||
+        (iface->adapt.empty_count < (UCT_MM_IFACE_ADAPT_INTERVAL /
+                                     UCT_MM_IFACE_ADAPT_BUSY_DIV))) {
+        /* streaming */
+        if (iface->adapt.max_poll < (iface->config.fifo_size *
+                                     iface->config.fifo_shards)) {
+            iface->adapt.max_poll = ucs_min(iface->adapt.max_poll * 2,
+                                            iface->config.fifo_size *
+                                            iface->config.fifo_shards);
+            UCS_STATS_UPDATE_COUNTER(iface->stats,
+                                     UCT_MM_IFACE_STAT_POLL_LIMIT_INC, 1);
+        }
+
+        if (iface->fifo_release_factor_mask < iface->adapt.release_mask_max) {
+            iface->fifo_release_factor_mask =
+                    (iface->fifo_release_factor_mask << 1) | 1;
+            UCS_STATS_UPDATE_COUNTER(iface->stats,
+                                     UCT_MM_IFACE_STAT_RELEASE_INC, 1);
+        }
+    } else if (iface->adapt.empty_count >= (UCT_MM_IFACE_ADAPT_INTERVAL /
+                                            UCT_MM_IFACE_ADAPT_IDLE_DIV)) {
+        /* latency */
+        if (iface->adapt.max_poll > UCT_MM_IFACE_FIFO_MIN_POLL) {
+            iface->adapt.max_poll /= 2;
+            iface->fifo_poll_count = ucs_min(iface->fifo_poll_count,
+                                             iface->adapt.max_poll);
+            UCS_STATS_UPDATE_COUNTER(iface->stats,
+                                     UCT_MM_IFACE_STAT_POLL_LIMIT_DEC, 1);
+        }
+
+        if (iface->fifo_release_factor_mask > 0) {
+            iface->fifo_release_factor_mask >>= 1;
+            UCS_STATS_UPDATE_COUNTER(iface->stats,
+                                     UCT_MM_IFACE_STAT_RELEASE_DEC, 1);
+        }
+    }
+
+    ucs_trace_poll("mm_iface %p: empty polls %u/%u occupancy %u, max_poll %u "
+                   "release_mask 0x%"PRIx64, iface, iface->adapt.empty_count,
+                   UCT_MM_IFACE_ADAPT_INTERVAL, max_occupancy,
+                   iface->adapt.max_poll, iface->fifo_release_factor_mask);
+
+    iface->adapt.progress_count = 0;
+    iface->adapt.empty_count    = 0;
+}
+
+static UCS_F_ALWAYS_INLINE void
+uct_mm_iface_adapt(uct_mm_iface_t *iface, unsigned fifo_poll_count)
+{
+    iface->adapt.empty_count += (fifo_poll_count == 0);
+    if (++iface->adapt.progress_count == UCT_MM_IFACE_ADAPT_INTERVAL) {
+        uct_mm_iface_adapt_tune(iface);
+    }
+}
+
 static unsigned uct_mm_iface_progress(uct_iface_h tl_iface)
 {
-    uct_mm_iface_t *iface = ucs_derived_of(tl_iface, uct_mm_iface_t);
-    unsigned total_count  = 0;
+    uct_mm_iface_t *iface    = ucs_derived_of(tl_iface, uct_mm_iface_t);
+    unsigned total_count     = 0;
+    unsigned shard_index     = iface->recv_shard_index;
+    unsigned num_shards_left = iface->config.fifo_shards;
     unsigned count;
 
     ucs_assert(iface->fifo_poll_count >= UCT_MM_IFACE_FIFO_MIN_POLL);
 
-    /* progress receive */
+    /* progress receive, starting from the next shard on every call so all
+     * shards get a fair share of the FIFO window */
     do {
-        count = uct_mm_iface_poll_fifo(iface);
-        ucs_assert(count < 2);
-        total_count += count;
-        ucs_assert(total_count < UINT_MAX);
-    } while ((count != 0) && (total_count < iface->fifo_poll_count));
+        do {
+            count = uct_mm_iface_poll_fifo(iface,
+                                           &iface->recv_shards[shard_index]);
+            ucs_assert(count < 2);
+            total_count += count;
+            ucs_assert(total_count < UINT_MAX);
+        } while ((count != 0) && (total_count < iface->fifo_poll_count));
+
+        if (++shard_index == iface->config.fifo_shards) {
+            shard_index = 0;
+        }
+    } while ((--num_shards_left > 0) &&
+             (total_count < iface->fifo_poll_count));
+
+    if (++iface->recv_shard_index == iface->config.fifo_shards) {
+        iface->recv_shard_index = 0;
+    }
 
     uct_mm_iface_fifo_window_adjust(iface, total_count);
+    if (ucs_unlikely(iface->adapt.enable)) {
+        uct_mm_iface_adapt(iface, total_count);
+    }
+
+    /* complete the zero-copy sends which were read by the remote side */
+    if (ucs_unlikely(!ucs_queue_is_empty(&iface->tx_zcopy_queue))) {
+        total_count += uct_mm_ep_progress_zcopy(iface);
+    }
 
     /* progress the pending sends (if there are any) */
     ucs_arbiter_dispatch(&iface->arbiter, 1, uct_mm_ep_process_pending,
@@ -349,7 +730,10 @@ static unsigned uct_mm_iface_progress(uct_iface_h tl_iface)
 
 static ucs_status_t uct_mm_iface_event_fd_get(uct_iface_h tl_iface, int *fd_p)
 {
-    *fd_p = ucs_derived_of(tl_iface, uct_mm_iface_t)->signal_fd;
+    uct_mm_iface_t *iface = ucs_derived_of(tl_iface, uct_mm_iface_t);
+
+    *fd_p = (iface->signal_eventfd >= 0) ? iface->signal_eventfd :
+            iface->signal_fd;
     return UCS_OK;
 }
 
@@ -358,24 +742,41 @@ static ucs_status_t uct_mm_iface_event_fd_arm(uct_iface_h tl_iface,
 {
     uct_mm_iface_t *iface = ucs_derived_of(tl_iface, uct_mm_iface_t);
     char dummy[UCT_MM_IFACE_MAX_SIG_EVENTS]; /* pop multiple signals at once */
+    uct_mm_fifo_shard_t *shard;
     uint64_t head, prev_head;
+    unsigned i;
     int ret;
 
-    /* Make the next sender which writes to the FIFO signal the receiver */
-    head      = iface->recv_fifo_ctl->head;
-    prev_head = ucs_atomic_cswap64(ucs_unaligned_ptr(&iface->recv_fifo_ctl->head),
-                                   head, head | UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED);
-    if (prev_head != head) {
-        /* race with sender; need to retry */
+    /* the remote side does not signal when it completes a zero-copy send */
+    if (!ucs_queue_is_empty(&iface->tx_zcopy_queue)) {
         return UCS_ERR_BUSY;
     }
 
-    if ((head & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED) > iface->read_index) {
-        /* 'read_index' is being written but not ready yet */
-        return UCS_ERR_BUSY;
+    /* Make the next sender which writes to any of the FIFO shards signal the
+     * receiver */
+    for (i = 0; i < iface->config.fifo_shards; ++i) {
+        shard     = &iface->recv_shards[i];
+        head      = shard->fifo_ctl->head;
+        prev_head = ucs_atomic_cswap64(ucs_unaligned_ptr(&shard->fifo_ctl->head),
+                                       head,
+                                       head | UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED);
+        if (prev_head != head) {
+            /* race with sender; need to retry */
+            return UCS_ERR_BUSY;
+        }
+
+        if ((head & ~UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED) > shard->read_index) {
+            /* 'read_index' is being written but not ready yet */
+            return UCS_ERR_BUSY;
+        }
     }
 
-    ret = recvfrom(iface->signal_fd, &dummy, sizeof(dummy), 0, NULL, 0);
+    if (iface->signal_eventfd >= 0) {
+        /* reading the eventfd resets its counter */
+        ret = read(iface->signal_eventfd, &dummy, sizeof(uint64_t));
+    } else {
+        ret = recvfrom(iface->signal_fd, &dummy, sizeof(dummy), 0, NULL, 0);
+    }
     if (ret > 0) {
         return UCS_ERR_BUSY;
     } else if (ret == -1) {
@@ -398,10 +799,15 @@ static UCS_CLASS_DECLARE_DELETE_FUNC(uct_mm_iface_t, uct_iface_t);
 static uct_iface_ops_t uct_mm_iface_ops = {
     .ep_put_short             = uct_sm_ep_put_short,
     .ep_put_bcopy             = uct_sm_ep_put_bcopy,
+    .ep_put_zcopy             = uct_sm_ep_put_zcopy,
     .ep_get_bcopy             = uct_sm_ep_get_bcopy,
+    .ep_get_zcopy             = uct_sm_ep_get_zcopy,
     .ep_am_short              = uct_mm_ep_am_short,
     .ep_am_short_iov          = uct_mm_ep_am_short_iov,
     .ep_am_bcopy              = uct_mm_ep_am_bcopy,
+    .ep_am_zcopy              = uct_mm_ep_am_zcopy,
+    .ep_am_batch_begin        = uct_mm_ep_am_batch_begin,
+    .ep_am_batch_commit       = uct_mm_ep_am_batch_commit,
     .ep_atomic_cswap64        = uct_sm_ep_atomic_cswap64,
     .ep_atomic64_post         = uct_sm_ep_atomic64_post,
     .ep_atomic64_fetch        = uct_sm_ep_atomic64_fetch,
@@ -453,6 +859,17 @@ static void uct_mm_iface_recv_desc_init(uct_iface_h tl_iface, void *obj,
     desc->info.offset   = offset;
 }
 
+/* FIFO elements of the receive FIFO are counted over all shards, one shard after
+ * another */
+static uct_mm_fifo_element_t *
+uct_mm_iface_recv_fifo_elem(uct_mm_iface_t *iface, unsigned index)
+{
+    uct_mm_fifo_shard_t *shard = &iface->recv_shards[index >> iface->fifo_shift];
+
+    return UCT_MM_IFACE_GET_FIFO_ELEM(iface, shard->fifo_elems,
+                                      index & iface->fifo_mask);
+}
+
 static void uct_mm_iface_free_rx_descs(uct_mm_iface_t *iface, unsigned num_elems)
 {
     uct_mm_fifo_element_t *elem;
@@ -460,21 +877,23 @@ static void uct_mm_iface_free_rx_descs(uct_mm_iface_t *iface, unsigned num_elems
     unsigned i;
 
     for (i = 0; i < num_elems; i++) {
-        elem = UCT_MM_IFACE_GET_FIFO_ELEM(iface, iface->recv_fifo_elems, i);
+        elem = uct_mm_iface_recv_fifo_elem(iface, i);
         desc = (uct_mm_recv_desc_t*)UCS_PTR_BYTE_OFFSET(elem->desc_data,
                                                         -iface->rx_headroom) - 1;
         ucs_mpool_put(desc);
     }
 }
 
-void uct_mm_iface_set_fifo_ptrs(void *fifo_mem, uct_mm_fifo_ctl_t **fifo_ctl_p,
+void uct_mm_iface_set_fifo_ptrs(uct_mm_iface_t *iface, void *fifo_mem,
+                                unsigned shard, uct_mm_fifo_ctl_t **fifo_ctl_p,
                                 void **fifo_elems_p)
 {
     uct_mm_fifo_ctl_t *fifo_ctl;
 
     /* initiate the the uct_mm_fifo_ctl struct, holding the head and the tail */
-    fifo_ctl = (uct_mm_fifo_ctl_t*)ucs_align_up_pow2
-                    ((uintptr_t)fifo_mem, UCS_SYS_CACHE_LINE_SIZE);
+    fifo_ctl = (uct_mm_fifo_ctl_t*)UCS_PTR_BYTE_OFFSET(
+                    ucs_align_up_pow2((uintptr_t)fifo_mem, UCS_SYS_CACHE_LINE_SIZE),
+                    shard * UCT_MM_FIFO_SHARD_SIZE(iface));
 
     /* Make sure head and tail are cache-aligned, and not on same cacheline, to
      * avoid false-sharing.
@@ -545,14 +964,178 @@ err:
     return status;
 }
 
+static ucs_status_t
+uct_mm_iface_create_signal_eventfd(uct_mm_iface_t *iface)
+{
+    iface->signal_eventfd = -1;
+    if (iface->config.signal_mode != UCT_MM_IFACE_SIGNAL_EVENTFD) {
+        return UCS_OK;
+    }
+
+    /* senders open the eventfd by the process id of the FIFO owner, so they
+     * must see the same process id */
+    if (!ucs_sys_ns_is_default(UCS_SYS_NS_TYPE_PID)) {
+        ucs_diag("mm_iface: not using eventfd signaling in a non-default PID "
+                 "namespace");
+        return UCS_OK;
+    }
+
+    iface->signal_eventfd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (iface->signal_eventfd < 0) {
+        ucs_error("failed to create eventfd for signal: %m");
+        return UCS_ERR_IO_ERROR;
+    }
+
+#if HAVE_DECL_PR_SET_PTRACER
+    /* allow senders to duplicate the eventfd if Yama restricts ptrace */
+    if (prctl(PR_SET_PTRACER, PR_SET_PTRACER_ANY, 0, 0, 0) < 0) {
+        ucs_debug("prctl(PR_SET_PTRACER, PR_SET_PTRACER_ANY) failed: %m");
+    }
+#endif
+
+    return UCS_OK;
+}
+
+static ucs_mpool_ops_t uct_mm_iface_zcopy_mpool_ops = {
+    .chunk_alloc   = ucs_mpool_chunk_malloc,
+    .chunk_release = ucs_mpool_chunk_free,
+    .obj_init      = NULL,
+    .obj_cleanup   = NULL
+};
+
+/* Check if the peers would be able to read the payload of zero-copy active
+ * messages from this process */
+static const char *uct_mm_iface_am_zcopy_check()
+{
+#ifdef HAVE_PROCESS_VM_READV
+    uint64_t src = 1, dst = 0;
+    struct iovec local_iov  = {.iov_base = &dst, .iov_len = sizeof(dst)};
+    struct iovec remote_iov = {.iov_base = &src, .iov_len = sizeof(src)};
+    char buffer[32];
+    ssize_t nread;
+
+    if (process_vm_readv(getpid(), &local_iov, 1, &remote_iov, 1, 0) !=
+        sizeof(dst)) {
+        return "process_vm_readv() failed";
+    }
+
+    /* Yama ptrace scope 2 and above do not allow other processes to read
+     * our memory, see https://www.kernel.org/doc/Documentation/security/Yama.txt */
+    nread = ucs_read_file(buffer, sizeof(buffer) - 1, 1,
+                          "/proc/sys/kernel/yama/ptrace_scope");
+    if (nread > 0) {
+        buffer[nread] = '\0';
+        if (strtol(buffer, NULL, 0) > 1) {
+            return "ptrace scope does not allow it";
+        }
+    }
+
+#if HAVE_DECL_PR_SET_PTRACER
+    /* ptrace scope 1 allows the peers to read only with explicit permission */
+    if (prctl(PR_SET_PTRACER, PR_SET_PTRACER_ANY, 0, 0, 0) < 0) {
+        ucs_debug("prctl(PR_SET_PTRACER, PR_SET_PTRACER_ANY) failed: %m");
+    }
+#endif
+
+    return NULL;
+#else
+    return "process_vm_readv() is not supported";
+#endif
+}
+
+static ucs_status_t
+uct_mm_iface_init_am_zcopy(uct_mm_iface_t *iface,
+                           const uct_mm_iface_config_t *mm_config)
+{
+    ssize_t max_hdr;
+    const char *reason;
+    ucs_status_t status;
+
+    iface->config.am_zcopy_max     = 0;
+    iface->config.am_zcopy_max_hdr = 0;
+    ucs_queue_head_init(&iface->tx_zcopy_queue);
+
+    if (mm_config->am_zcopy == UCS_NO) {
+        return UCS_OK;
+    }
+
+    /* the header and the remote buffers are written to the FIFO element */
+    max_hdr = (ssize_t)iface->config.am_max_short - sizeof(uct_mm_zcopy_hdr_t) -
+              (UCT_MM_IFACE_AM_ZCOPY_MAX_IOV * sizeof(uct_mm_zcopy_iov_t));
+    if (max_hdr <= 0) {
+        reason = "FIFO element is too small";
+    } else if (mm_config->am_zcopy_max > UINT32_MAX) {
+        reason = "maximal message size is too large";
+    } else {
+        reason = uct_mm_iface_am_zcopy_check();
+    }
+
+    if (reason != NULL) {
+        if (mm_config->am_zcopy == UCS_YES) {
+            ucs_error("mm_iface: zero-copy active messages are not possible: "
+                      "%s", reason);
+            return UCS_ERR_UNSUPPORTED;
+        }
+
+        ucs_debug("mm_iface: not using zero-copy active messages: %s", reason);
+        return UCS_OK;
+    }
+
+    status = ucs_mpool_init(&iface->recv_zcopy_mp, 0,
+                            sizeof(uct_mm_recv_desc_t) + iface->rx_headroom +
+                            mm_config->am_zcopy_max,
+                            sizeof(uct_mm_recv_desc_t) + iface->rx_headroom,
+                            UCS_SYS_CACHE_LINE_SIZE,
+                            UCT_MM_IFACE_ZCOPY_DESC_GROW, UINT_MAX,
+                            &uct_mm_iface_zcopy_mpool_ops,
+                            "mm_recv_zcopy_desc");
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    status = ucs_mpool_init(&iface->tx_zcopy_mp, 0, sizeof(uct_mm_zcopy_tx_t),
+                            0, UCS_SYS_CACHE_LINE_SIZE,
+                            iface->config.fifo_size, UINT_MAX,
+                            &uct_mm_iface_zcopy_mpool_ops, "mm_tx_zcopy");
+    if (status != UCS_OK) {
+        ucs_mpool_cleanup(&iface->recv_zcopy_mp, 1);
+        return status;
+    }
+
+    iface->config.am_zcopy_max     = mm_config->am_zcopy_max;
+    iface->config.am_zcopy_max_hdr = ucs_min(max_hdr, UINT16_MAX);
+    return UCS_OK;
+}
+
+static void uct_mm_iface_cleanup_am_zcopy(uct_mm_iface_t *iface)
+{
+    if (iface->config.am_zcopy_max == 0) {
+        return;
+    }
+
+    ucs_mpool_cleanup(&iface->tx_zcopy_mp, 1);
+    ucs_mpool_cleanup(&iface->recv_zcopy_mp, 1);
+}
+
 static void uct_mm_iface_log_created(uct_mm_iface_t *iface)
 {
     uct_mm_seg_t UCS_V_UNUSED *seg = iface->recv_fifo_mem.memh;
 
     ucs_debug("created mm iface %p FIFO id 0x%"PRIx64
-              " va %p size %zu (%u x %u elems)",
+              " va %p size %zu (%u x %u x %u elems) numa %s node %d",
               iface, seg->seg_id, seg->address, seg->length,
-              iface->config.fifo_elem_size, iface->config.fifo_size);
+              iface->config.fifo_elem_size, iface->config.fifo_size,
+              iface->config.fifo_shards,
+              ucs_numa_placement_names[iface->config.numa_placement],
+              ucs_numa_node_of_addr(iface->recv_fifo_ctl));
+
+    if (iface->sim.enable) {
+        ucs_debug("mm iface %p simulates latency %.3f us, bandwidth %.2f MB/s",
+                  iface, ucs_time_to_usec(iface->sim.latency),
+                  (iface->sim.byte_time > 0) ?
+                  (ucs_time_from_sec(1.0) / iface->sim.byte_time / UCS_MBYTE) :
+                  0.0);
+    }
 }
 
 static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
@@ -562,6 +1145,8 @@ static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
     uct_mm_iface_config_t *mm_config =
                     ucs_derived_of(tl_config, uct_mm_iface_config_t);
     uct_mm_fifo_element_t* fifo_elem_p;
+    uct_mm_fifo_shard_t *shard;
+    uct_mm_fifo_ctl_t *fifo_ctl;
     ucs_status_t status;
     unsigned i;
     char proc[32];
@@ -597,52 +1182,130 @@ static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
         goto err;
     }
 
+    if ((mm_config->fifo_shards < 1) ||
+        (mm_config->fifo_shards > UCT_MM_IFACE_FIFO_MAX_SHARDS)) {
+        ucs_error("The UCX_MM_FIFO_SHARDS parameter (%u) must be between 1 "
+                  "and %d.", mm_config->fifo_shards,
+                  UCT_MM_IFACE_FIFO_MAX_SHARDS);
+        status = UCS_ERR_INVALID_PARAM;
+        goto err;
+    }
+
+    if (!UCS_CONFIG_BW_IS_AUTO(mm_config->sim_bw) && (mm_config->sim_bw <= 0)) {
+        ucs_error("The UCX_MM_SIM_BW parameter must be positive or \"auto\".");
+        status = UCS_ERR_INVALID_PARAM;
+        goto err;
+    }
+
+    self->sim.latency              = ucs_time_from_sec(mm_config->sim_latency);
+    self->sim.byte_time            = UCS_CONFIG_BW_IS_AUTO(mm_config->sim_bw) ?
+                                     0 : (ucs_time_from_sec(1.0) /
+                                          mm_config->sim_bw);
+    self->sim.enable               = (self->sim.latency > 0) ||
+                                     (self->sim.byte_time > 0);
+
+    if (self->sim.enable &&
+        (mm_config->fifo_elem_size <= (sizeof(uct_mm_fifo_element_t) +
+                                       sizeof(ucs_time_t)))) {
+        ucs_error("The UCX_MM_FIFO_ELEM_SIZE parameter (%u) must be larger "
+                  "than %zu bytes to simulate the network.",
+                  mm_config->fifo_elem_size,
+                  sizeof(uct_mm_fifo_element_t) + sizeof(ucs_time_t));
+        status = UCS_ERR_INVALID_PARAM;
+        goto err;
+    }
+
     self->config.fifo_size         = mm_config->fifo_size;
     self->config.fifo_elem_size    = mm_config->fifo_elem_size;
+    self->config.fifo_shards       = mm_config->fifo_shards;
     self->config.seg_size          = mm_config->seg_size;
     self->config.fifo_max_poll     = ((mm_config->fifo_max_poll == UCS_ULUNITS_AUTO) ?
                                       UCT_MM_IFACE_FIFO_MAX_POLL :
                                       /* trim by the maximum unsigned integer value */
                                       ucs_min(mm_config->fifo_max_poll, UINT_MAX));
+    self->config.am_max_short      = self->config.fifo_elem_size -
+                                     sizeof(uct_mm_fifo_element_t) -
+                                     (self->sim.enable ? sizeof(ucs_time_t) : 0);
+    self->config.numa_placement    = mm_config->numa_placement;
+    self->config.signal_mode       = mm_config->signal_mode;
     self->fifo_prev_wnd_cons       = 0;
     self->fifo_poll_count          = self->config.fifo_max_poll;
     /* cppcheck-suppress internalAstError */
     self->fifo_release_factor_mask = UCS_MASK(ucs_ilog2(ucs_max((int)
                                      (mm_config->fifo_size * mm_config->release_fifo_factor),
                                      1)));
+    self->adapt.enable             = mm_config->fifo_adaptive;
+    self->adapt.max_poll           = self->config.fifo_max_poll;
+    self->adapt.progress_count     = 0;
+    self->adapt.empty_count        = 0;
+    self->adapt.release_mask_max   = self->fifo_release_factor_mask;
     self->fifo_mask                = self->config.fifo_size - 1;
     self->fifo_shift               = ucs_count_trailing_zero_bits(mm_config->fifo_size);
     self->rx_headroom              = (params->field_mask &
                                       UCT_IFACE_PARAM_FIELD_RX_HEADROOM) ?
                                      params->rx_headroom : 0;
     self->release_desc.cb          = uct_mm_iface_release_desc;
+    self->recv_shard_index         = 0;
+
+    status = UCS_STATS_NODE_ALLOC(&self->stats, &uct_mm_iface_stats_class,
+                                  self->super.super.stats);
+    if (status != UCS_OK) {
+        goto err;
+    }
+
+    self->recv_shards = ucs_calloc(self->config.fifo_shards,
+                                   sizeof(*self->recv_shards),
+                                   "mm_recv_shards");
+    if (self->recv_shards == NULL) {
+        ucs_error("mm_iface failed to allocate receive FIFO shards");
+        status = UCS_ERR_NO_MEMORY;
+        goto err_free_stats;
+    }
 
     /* Allocate the receive FIFO */
     status = uct_iface_mem_alloc(&self->super.super.super,
-                                 UCT_MM_GET_FIFO_SIZE(self),
+                                 UCT_MM_GET_FIFO_SIZE(self,
+                                                      self->config.fifo_shards),
                                  UCT_MD_MEM_ACCESS_ALL, "mm_recv_fifo",
                                  &self->recv_fifo_mem);
     if (status != UCS_OK) {
         ucs_error("mm_iface failed to allocate receive FIFO");
-        return status;
+        goto err_free_shards;
+    }
+
+    /* Set the placement before the FIFO memory is touched */
+    status = ucs_numa_mem_bind(self->recv_fifo_mem.address,
+                               self->recv_fifo_mem.length,
+                               self->config.numa_placement,
+                               mm_config->numa_node);
+    if (status != UCS_OK) {
+        ucs_debug("mm_iface failed to set %s NUMA placement of receive "
+                  "FIFO: %s",
+                  ucs_numa_placement_names[self->config.numa_placement],
+                  ucs_status_string(status));
+    }
+
+    for (i = 0; i < self->config.fifo_shards; i++) {
+        shard = &self->recv_shards[i];
+        uct_mm_iface_set_fifo_ptrs(self, self->recv_fifo_mem.address, i,
+                                   &shard->fifo_ctl, &shard->fifo_elems);
+        shard->fifo_ctl->head  = 0;
+        shard->fifo_ctl->tail  = 0;
+        shard->read_index      = 0;
+        shard->read_index_elem = UCT_MM_IFACE_GET_FIFO_ELEM(self,
+                                                            shard->fifo_elems,
+                                                            shard->read_index);
     }
 
-    uct_mm_iface_set_fifo_ptrs(self->recv_fifo_mem.address,
-                               &self->recv_fifo_ctl, &self->recv_fifo_elems);
-    self->recv_fifo_ctl->head      = 0;
-    self->recv_fifo_ctl->tail      = 0;
+    self->recv_fifo_ctl            = self->recv_shards[0].fifo_ctl;
     self->recv_fifo_ctl->owner.pid = getpid();
-    self->read_index               = 0;
-    self->read_index_elem          = UCT_MM_IFACE_GET_FIFO_ELEM(self,
-                                                                self->recv_fifo_elems,
-                                                                self->read_index);
     uct_sm_ep_get_process_proc_dir(proc, sizeof(proc),
                                    self->recv_fifo_ctl->owner.pid);
     status = ucs_sys_get_file_time(proc, UCS_SYS_FILE_TIME_CTIME,
                                    &self->recv_fifo_ctl->owner.starttime);
     if (status != UCS_OK) {
         ucs_error("mm_iface failed to get process starttime");
-        return status;
+        goto err_free_fifo;
     }
 
     /* create a unix file descriptor to receive event notifications */
@@ -651,6 +1314,34 @@ static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
         goto err_free_fifo;
     }
 
+    status = uct_mm_iface_create_signal_eventfd(self);
+    if (status != UCS_OK) {
+        goto err_close_signal_fd;
+    }
+
+    self->recv_fifo_ctl->signal_eventfd = self->signal_eventfd;
+
+    status = uct_mm_iface_init_am_zcopy(self, mm_config);
+    if (status != UCS_OK) {
+        goto err_close_signal_eventfd;
+    }
+
+    self->recv_fifo_ctl->owner.pid_ns = ucs_sys_get_ns(UCS_SYS_NS_TYPE_PID);
+    self->recv_fifo_ctl->am_zcopy_max = self->config.am_zcopy_max;
+
+    /* a sender attaches to a single shard, so every shard holds a copy of the
+     * owner and the signaling socket address */
+    for (i = 1; i < self->config.fifo_shards; i++) {
+        fifo_ctl                  = self->recv_shards[i].fifo_ctl;
+        fifo_ctl->owner.pid       = self->recv_fifo_ctl->owner.pid;
+        fifo_ctl->owner.starttime = self->recv_fifo_ctl->owner.starttime;
+        fifo_ctl->signal_addrlen  = self->recv_fifo_ctl->signal_addrlen;
+        fifo_ctl->signal_sockaddr = self->recv_fifo_ctl->signal_sockaddr;
+        fifo_ctl->signal_eventfd  = self->recv_fifo_ctl->signal_eventfd;
+        fifo_ctl->owner.pid_ns    = self->recv_fifo_ctl->owner.pid_ns;
+        fifo_ctl->am_zcopy_max    = self->recv_fifo_ctl->am_zcopy_max;
+    }
+
     /* create a memory pool for receive descriptors */
     status = uct_iface_mpool_init(&self->super.super,
                                   &self->recv_desc_mp,
@@ -664,9 +1355,13 @@ static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
                                   "mm_recv_desc");
     if (status != UCS_OK) {
         ucs_error("failed to create a receive descriptor memory pool for the MM transport");
-        goto err_close_signal_fd;
+        goto err_cleanup_am_zcopy;
     }
 
+    uct_iface_mpool_set_numa_placement(&self->recv_desc_mp,
+                                       self->config.numa_placement,
+                                       mm_config->numa_node);
+
     /* set the first receive descriptor */
     self->last_recv_desc = ucs_mpool_get(&self->recv_desc_mp);
     VALGRIND_MAKE_MEM_DEFINED(self->last_recv_desc, sizeof(*(self->last_recv_desc)));
@@ -678,8 +1373,8 @@ static UCS_CLASS_INIT_FUNC(uct_mm_iface_t, uct_md_h md, uct_worker_h worker,
 
     /* initiate the owner bit in all the FIFO elements and assign a receive descriptor
      * per every FIFO element */
-    for (i = 0; i < mm_config->fifo_size; i++) {
-        fifo_elem_p = UCT_MM_IFACE_GET_FIFO_ELEM(self, self->recv_fifo_elems, i);
+    for (i = 0; i < (mm_config->fifo_size * self->config.fifo_shards); i++) {
+        fifo_elem_p        = uct_mm_iface_recv_fifo_elem(self, i);
         fifo_elem_p->flags = UCT_MM_FIFO_ELEM_FLAG_OWNER;
 
         status = uct_mm_assign_desc_to_fifo_elem(self, fifo_elem_p, 1);
@@ -699,10 +1394,20 @@ destroy_descs:
     ucs_mpool_put(self->last_recv_desc);
 destroy_recv_mpool:
     ucs_mpool_cleanup(&self->recv_desc_mp, 1);
+err_cleanup_am_zcopy:
+    uct_mm_iface_cleanup_am_zcopy(self);
+err_close_signal_eventfd:
+    if (self->signal_eventfd >= 0) {
+        close(self->signal_eventfd);
+    }
 err_close_signal_fd:
     close(self->signal_fd);
 err_free_fifo:
     uct_iface_mem_free(&self->recv_fifo_mem);
+err_free_shards:
+    ucs_free(self->recv_shards);
+err_free_stats:
+    UCS_STATS_NODE_FREE(self->stats);
 err:
     return status;
 }
@@ -714,13 +1419,20 @@ static UCS_CLASS_CLEANUP_FUNC(uct_mm_iface_t)
 
     /* return all the descriptors that are now 'assigned' to the FIFO,
      * to their mpool */
-    uct_mm_iface_free_rx_descs(self, self->config.fifo_size);
+    uct_mm_iface_free_rx_descs(self, self->config.fifo_size *
+                                     self->config.fifo_shards);
 
     ucs_mpool_put(self->last_recv_desc);
     ucs_mpool_cleanup(&self->recv_desc_mp, 1);
+    uct_mm_iface_cleanup_am_zcopy(self);
+    if (self->signal_eventfd >= 0) {
+        close(self->signal_eventfd);
+    }
     close(self->signal_fd);
     uct_iface_mem_free(&self->recv_fifo_mem);
+    ucs_free(self->recv_shards);
     ucs_arbiter_cleanup(&self->arbiter);
+    UCS_STATS_NODE_FREE(self->stats);
 }
 
 UCS_CLASS_DEFINE(uct_mm_iface_t, uct_base_iface_t);
@@ -15,15 +15,33 @@
 #include <ucs/arch/cpu.h>
 #include <ucs/debug/memtrack.h>
 #include <ucs/datastruct/arbiter.h>
+#include <ucs/datastruct/queue.h>
 #include <ucs/sys/compiler.h>
 #include <ucs/sys/sys.h>
+#include <ucs/time/time.h>
 #include <sys/shm.h>
 #include <sys/un.h>
 
 
+enum {
+    UCT_MM_IFACE_STAT_EMPTY_POLL,      /* progress calls which found no data */
+    UCT_MM_IFACE_STAT_POLL_LIMIT_INC,  /* maximal FIFO window was increased */
+    UCT_MM_IFACE_STAT_POLL_LIMIT_DEC,  /* maximal FIFO window was decreased */
+    UCT_MM_IFACE_STAT_RELEASE_INC,     /* tail is released less often */
+    UCT_MM_IFACE_STAT_RELEASE_DEC,     /* tail is released more often */
+    UCT_MM_IFACE_STAT_LAST
+};
+
+
 enum {
     UCT_MM_FIFO_ELEM_FLAG_OWNER  = UCS_BIT(0), /* new/old info */
     UCT_MM_FIFO_ELEM_FLAG_INLINE = UCS_BIT(1), /* if inline or not */
+    UCT_MM_FIFO_ELEM_FLAG_ZCOPY  = UCS_BIT(2), /* payload is read from the
+                                                  sender memory */
+    UCT_MM_FIFO_ELEM_FLAG_NOP    = UCS_BIT(3), /* element was reserved by a
+                                                  batch but not used */
+    UCT_MM_FIFO_ELEM_FLAG_SIM    = UCS_BIT(4)  /* element has a simulated
+                                                  delivery time */
 };
 
 
@@ -31,10 +49,17 @@ enum {
     ucs_align_up(sizeof(uct_mm_fifo_ctl_t), UCS_SYS_CACHE_LINE_SIZE)
 
 
-#define UCT_MM_GET_FIFO_SIZE(_iface) \
+/* Each FIFO shard is a control structure followed by the FIFO elements, padded
+ * so that the control structure of the next shard is cache-aligned */
+#define UCT_MM_FIFO_SHARD_SIZE(_iface) \
     (UCT_MM_FIFO_CTL_SIZE + \
-     ((_iface)->config.fifo_size * (_iface)->config.fifo_elem_size) + \
-      (UCS_SYS_CACHE_LINE_SIZE - 1))
+     ucs_align_up((_iface)->config.fifo_size * (_iface)->config.fifo_elem_size, \
+                  UCS_SYS_CACHE_LINE_SIZE))
+
+
+#define UCT_MM_GET_FIFO_SIZE(_iface, _num_shards) \
+    (((_num_shards) * UCT_MM_FIFO_SHARD_SIZE(_iface)) + \
+     (UCS_SYS_CACHE_LINE_SIZE - 1))
 
 
 #define UCT_MM_IFACE_GET_FIFO_ELEM(_iface, _fifo, _index) \
@@ -42,6 +67,14 @@ enum {
      UCS_PTR_BYTE_OFFSET(_fifo, (_index) * (_iface)->config.fifo_elem_size))
 
 
+/* Simulated delivery time of a FIFO element, in the end of the element. It is
+ * written by a sender which simulates network latency and bandwidth, and
+ * the receiver does not process the element before that time. */
+#define UCT_MM_FIFO_ELEM_SIM_TIME(_iface, _elem) \
+    UCS_PTR_BYTE_OFFSET(_elem, (_iface)->config.fifo_elem_size - \
+                               sizeof(ucs_time_t))
+
+
 #define uct_mm_iface_mapper_call(_iface, _func, ...) \
     ({ \
         uct_mm_md_t *md = ucs_derived_of((_iface)->super.super.md, uct_mm_md_t); \
@@ -66,10 +99,41 @@ enum {
 #define UCT_MM_IFACE_FIFO_AI_VALUE              1 /* FIFO window += AI value */
 #define UCT_MM_IFACE_FIFO_MD_FACTOR             2 /* FIFO window /= MD factor */
 
+/* Adaptive FIFO polling: every UCT_MM_IFACE_ADAPT_INTERVAL progress calls, the
+ * maximal FIFO window and the tail release frequency are tuned by the observed
+ * load of the receive FIFO.
+ * - Streaming: the FIFO is at least 1/UCT_MM_IFACE_ADAPT_OCCUPANCY_DIV full,
+ *   or less than 1/UCT_MM_IFACE_ADAPT_BUSY_DIV of the progress calls are
+ *   empty. The maximal window is doubled, and the tail is released less often
+ *   (down to FIFO_RELEASE_FACTOR) to save cache line transfers to the senders.
+ * - Latency: at least 1/UCT_MM_IFACE_ADAPT_IDLE_DIV of the progress calls are
+ *   empty. The maximal window is halved, and the tail is released more often
+ *   so the senders see free elements sooner. */
+#define UCT_MM_IFACE_ADAPT_INTERVAL           256
+#define UCT_MM_IFACE_ADAPT_OCCUPANCY_DIV        4
+#define UCT_MM_IFACE_ADAPT_BUSY_DIV             8
+#define UCT_MM_IFACE_ADAPT_IDLE_DIV             2
+
+/* Maximal number of FIFO shards in the receive FIFO */
+#define UCT_MM_IFACE_FIFO_MAX_SHARDS          128
+
+/* Maximal number of payload buffers in a zero-copy active message */
+#define UCT_MM_IFACE_AM_ZCOPY_MAX_IOV           2ul
+
 /* If this bit is set in fifo_ctl.head, trigger async event on the receiver  */
 #define UCT_MM_IFACE_FIFO_HEAD_EVENT_ARMED      UCS_BIT(63)
 
 
+/**
+ * Mechanism to wake up a receiver which waits for events
+ */
+typedef enum {
+    UCT_MM_IFACE_SIGNAL_SOCKET,  /* Datagram to a Unix domain socket */
+    UCT_MM_IFACE_SIGNAL_EVENTFD, /* Write to an eventfd of the receiver */
+    UCT_MM_IFACE_SIGNAL_LAST
+} uct_mm_iface_signal_mode_t;
+
+
 /**
  * MM interface configuration
  */
@@ -81,9 +145,24 @@ typedef struct uct_mm_iface_config {
     size_t                   fifo_max_poll;       /* Maximal RX completions to pick
                                                    * during RX poll */
     double                   release_fifo_factor; /* Tail index update frequency */
+    int                      fifo_adaptive;       /* Tune FIFO polling by load */
     ucs_ternary_auto_value_t hugetlb_mode;        /* Enable using huge pages for
                                                    * shared memory buffers */
     unsigned                 fifo_elem_size;      /* Size of the FIFO element size */
+    unsigned                 fifo_shards;         /* Number of FIFO shards */
+    ucs_numa_placement_t     numa_placement;      /* NUMA placement of the FIFO
+                                                   * and receive segments */
+    unsigned                 numa_node;           /* NUMA node for "node"
+                                                   * placement */
+    uct_mm_iface_signal_mode_t signal_mode;       /* How senders wake up the
+                                                   * receiver */
+    ucs_ternary_auto_value_t am_zcopy;            /* Enable zero-copy active
+                                                   * messages */
+    size_t                   am_zcopy_max;        /* Maximal size of zero-copy
+                                                   * active message */
+    double                   sim_latency;         /* Simulated latency, or 0 */
+    double                   sim_bw;              /* Simulated bandwidth, or
+                                                   * auto */
     uct_iface_mpool_config_t mp;
 } uct_mm_iface_config_t;
 
@@ -93,6 +172,7 @@ typedef struct uct_mm_iface_config {
  */
 typedef struct uct_mm_iface_addr {
     uct_mm_seg_id_t          fifo_seg_id;     /* Shared memory identifier of FIFO */
+    uint8_t                  fifo_shards;     /* Number of FIFO shards */
     /* mapper-specific iface address follows */
 } UCS_S_PACKED uct_mm_iface_addr_t;
 
@@ -105,16 +185,22 @@ typedef struct uct_mm_fifo_ctl {
     volatile uint64_t         head;           /* Where to write next */
     socklen_t                 signal_addrlen; /* Address length of signaling socket */
     struct sockaddr_un        signal_sockaddr;/* Address of signaling socket */
+    int                       signal_eventfd; /* Signaling eventfd of the owner
+                                                 process, or -1 to use the socket */
     UCS_CACHELINE_PADDING(uint64_t,
                           socklen_t,
-                          struct sockaddr_un);
+                          struct sockaddr_un,
+                          int);
 
     /* 2nd cacheline */
     volatile uint64_t         tail;           /* How much was consumed */
     struct {
         pid_t                 pid;            /* Process owner pid */
         ucs_time_t            starttime;      /* Process starttime */
+        ucs_sys_ns_t          pid_ns;         /* PID namespace of the owner */
     } owner;
+    uint32_t                  am_zcopy_max;   /* Maximal zero-copy active message
+                                                 the owner can receive, or 0 */
 } UCS_S_PACKED UCS_V_ALIGNED(UCS_SYS_CACHE_LINE_SIZE) uct_mm_fifo_ctl_t;
 
 
@@ -146,6 +232,29 @@ typedef struct uct_mm_fifo_element {
 } UCS_S_PACKED uct_mm_fifo_element_t;
 
 
+/**
+ * Remote buffer of a zero-copy active message
+ */
+typedef struct uct_mm_zcopy_iov {
+    uint64_t                  address;        /* address in the sender process */
+    uint64_t                  length;         /* length of the buffer */
+} UCS_S_PACKED uct_mm_zcopy_iov_t;
+
+
+/**
+ * Inline data of a FIFO element of a zero-copy active message:
+ *
+ * +--------------------+----------------------------+-----------+
+ * | uct_mm_zcopy_hdr_t | uct_mm_zcopy_iov_t[iovcnt] | AM header |
+ * +--------------------+----------------------------+-----------+
+ */
+typedef struct uct_mm_zcopy_hdr {
+    pid_t                     pid;            /* sender process to read from */
+    uint16_t                  header_length;  /* length of the AM header */
+    uint8_t                   iovcnt;         /* number of remote buffers */
+} UCS_S_PACKED uct_mm_zcopy_hdr_t;
+
+
 /*
  * MM receive descriptor:
  *
@@ -161,6 +270,18 @@ typedef struct uct_mm_recv_desc {
 } uct_mm_recv_desc_t;
 
 
+/**
+ * Receive state of a single FIFO shard. Every shard is a separate FIFO with its
+ * own head and tail, and a remote sender always writes to the same shard.
+ */
+typedef struct uct_mm_fifo_shard {
+    uct_mm_fifo_ctl_t       *fifo_ctl;        /* control struct of the shard */
+    void                    *fifo_elems;      /* first FIFO element of the shard */
+    uct_mm_fifo_element_t   *read_index_elem;
+    uint64_t                read_index;       /* actual reading location */
+} uct_mm_fifo_shard_t;
+
+
 /**
  * MM trandport interface
  */
@@ -176,10 +297,9 @@ typedef struct uct_mm_iface {
                                               /* this struct is cache line aligned and */
                                               /* doesn't necessarily start where */
                                               /* shared_mem starts */
-    void                    *recv_fifo_elems; /* pointer to the first fifo element
-                                                 in the receive fifo */
-    uct_mm_fifo_element_t   *read_index_elem;
-    uint64_t                read_index;       /* actual reading location */
+    uct_mm_fifo_shard_t     *recv_shards;     /* receive state of the FIFO shards,
+                                                 the first one is at recv_fifo_ctl */
+    unsigned                recv_shard_index; /* first shard to poll */
 
     uint8_t                 fifo_shift;       /* = log2(fifo_size) */
     unsigned                fifo_mask;        /* = 2^fifo_shift - 1 */
@@ -190,10 +310,33 @@ typedef struct uct_mm_iface {
     int                     fifo_prev_wnd_cons;  /* Was FIFO window size fully consumed by
                                                   * the previous call to iface progress */
 
+    /* Adaptive FIFO polling state */
+    struct {
+        int                 enable;
+        unsigned            max_poll;         /* current limit of fifo_poll_count */
+        unsigned            progress_count;   /* progress calls in the interval */
+        unsigned            empty_count;      /* progress calls without data */
+        uint64_t            release_mask_max; /* configured release mask */
+    } adapt;
+
+    /* Simulated network, see UCT_MM_FIFO_ELEM_SIM_TIME */
+    struct {
+        int                 enable;
+        ucs_time_t          latency;          /* added to the delivery time */
+        double              byte_time;        /* link time of a byte, or 0 */
+    } sim;
+
     ucs_mpool_t             recv_desc_mp;
     uct_mm_recv_desc_t      *last_recv_desc;  /* next receive descriptor to use */
 
+    ucs_mpool_t             recv_zcopy_mp;    /* private receive descriptors
+                                                 of zero-copy active messages */
+    ucs_mpool_t             tx_zcopy_mp;      /* zero-copy send operations */
+    ucs_queue_head_t        tx_zcopy_queue;   /* outstanding zero-copy sends */
+
     int                     signal_fd;        /* Unix socket for receiving remote signal */
+    int                     signal_eventfd;   /* eventfd for receiving remote signal,
+                                                 or -1 if signaled by the socket */
 
     size_t                  rx_headroom;
     ucs_arbiter_t           arbiter;
@@ -202,9 +345,17 @@ typedef struct uct_mm_iface {
     struct {
         unsigned            fifo_size;
         unsigned            fifo_elem_size;
+        unsigned            fifo_shards;
         unsigned            seg_size;         /* size of the receive descriptor (for payload)*/
         unsigned            fifo_max_poll;
+        unsigned            am_max_short;     /* inline data in a FIFO element */
+        ucs_numa_placement_t numa_placement;
+        uct_mm_iface_signal_mode_t signal_mode;
+        size_t              am_zcopy_max;     /* 0 if zero-copy AM is disabled */
+        unsigned            am_zcopy_max_hdr;
     } config;
+
+    UCS_STATS_NODE_DECLARE(stats)
 } uct_mm_iface_t;
 
 
@@ -225,7 +376,7 @@ typedef struct uct_mm_iface {
     \
     UCT_TL_DEFINE(&(uct_##_name##_component).super, \
                   _name, \
-                  uct_sm_base_query_tl_devices, \
+                  uct_mm_query_tl_devices, \
                   uct_mm_iface_t, \
                   "MM_", \
                   uct_mm_iface_config_table, \
@@ -256,13 +407,16 @@ uct_mm_iface_invoke_am(uct_mm_iface_t *iface, uint8_t am_id, void *data,
 
 
 /**
- * Set aligned pointers of the FIFO according to the beginning of the allocated
- * memory.
+ * Set aligned pointers of a FIFO shard according to the beginning of the
+ * allocated memory.
+ * @param [in] iface         Interface which defines the FIFO geometry.
  * @param [in] fifo_mem      Pointer to the beginning of the allocated memory.
+ * @param [in] shard         Index of the FIFO shard.
  * @param [out] fifo_ctl_p   Pointer to the FIFO control structure.
  * @param [out] fifo_elems   Pointer to the array of FIFO elements.
  */
-void uct_mm_iface_set_fifo_ptrs(void *fifo_mem, uct_mm_fifo_ctl_t **fifo_ctl_p,
+void uct_mm_iface_set_fifo_ptrs(uct_mm_iface_t *iface, void *fifo_mem,
+                                unsigned shard, uct_mm_fifo_ctl_t **fifo_ctl_p,
                                 void **fifo_elems_p);
 
 
@@ -273,6 +427,11 @@ UCS_CLASS_DECLARE_NEW_FUNC(uct_mm_iface_t, uct_iface_t, uct_md_h, uct_worker_h,
 void uct_mm_iface_release_desc(uct_recv_desc_t *self, void *desc);
 
 
+ucs_status_t
+uct_mm_query_tl_devices(uct_md_h md, uct_tl_device_resource_t **tl_devices_p,
+                        unsigned *num_tl_devices_p);
+
+
 ucs_status_t uct_mm_flush();
 
 
@@ -28,6 +28,13 @@ ucs_config_field_t uct_mm_md_config_table[] = {
    " try - Try to allocate memory using huge pages and if it fails, allocate regular pages.\n",
    ucs_offsetof(uct_mm_md_config_t, hugetlb_mode), UCS_CONFIG_TYPE_TERNARY},
 
+  {"NUM_DEVICES", "1",
+   "Number of shared memory devices to create. Every device has its own\n"
+   "interfaces, so the upper layer can use them as separate lanes, for example\n"
+   "to test multi-rail protocols on a single host. The first device is named\n"
+   "\"memory\", and the other ones \"memory1\", \"memory2\", etc.",
+   ucs_offsetof(uct_mm_md_config_t, num_devices), UCS_CONFIG_TYPE_UINT},
+
   {NULL}
 };
 
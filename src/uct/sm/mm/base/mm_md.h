@@ -46,6 +46,7 @@ typedef struct uct_mm_remote_seg {
 typedef struct uct_mm_md_config {
     uct_md_config_t          super;
     ucs_ternary_auto_value_t hugetlb_mode;     /* Enable using huge pages */
+    unsigned                 num_devices;      /* Number of devices to create */
 } uct_mm_md_config_t;
 
 
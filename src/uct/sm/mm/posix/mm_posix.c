@@ -16,6 +16,7 @@
 #include <ucs/sys/string.h>
 #include <sys/mman.h>
 #include <ucs/sys/sys.h>
+#include <fcntl.h>
 
 
 /* File open flags */
@@ -41,6 +42,13 @@
 #define UCT_POSIX_PROCFS_MMID_FD_BITS   30  /* how many bits for file descriptor */
 #define UCT_POSIX_PROCFS_MMID_PID_BITS  30  /* how many bits for pid */
 
+/* memfd segment parameters */
+#define UCT_POSIX_MEMFD_NAME            "ucx_shm_posix"
+#ifdef F_ADD_SEALS
+/* the segment owner maps the whole file, so peers must not change its size */
+#  define UCT_POSIX_MEMFD_SEALS         (F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL)
+#endif
+
 /* Filesystem paths */
 #define UCT_POSIX_SHM_OPEN_DIR          "/dev/shm"       /* directory path for shm_open() */
 #define UCT_POSIX_FILE_FMT              "/ucx_shm_posix_%"PRIx64
@@ -51,6 +59,7 @@ typedef struct uct_posix_md_config {
     uct_mm_md_config_t        super;
     char                      *dir;
     int                       use_proc_link;
+    ucs_ternary_auto_value_t  use_memfd;
 } uct_posix_md_config_t;
 
 typedef struct uct_posix_packed_rkey {
@@ -74,6 +83,17 @@ static ucs_config_field_t uct_posix_md_config_table[] = {
    " n   - Use original file path to share posix file.\n",
    ucs_offsetof(uct_posix_md_config_t, use_proc_link), UCS_CONFIG_TYPE_BOOL},
 
+  {"USE_MEMFD", "n",
+   "Create shared memory segments with memfd_create() instead of a file in DIR.\n"
+   "A memfd segment does not use /dev/shm space, and it is released when the\n"
+   "owner process exits, even if it is killed. Peers open it by the\n"
+   "/proc/<pid>/fd/<fd> link, regardless of USE_PROC_LINK. The segment size is\n"
+   "sealed, and huge pages are used according to HUGETLB_MODE.\n"
+   " y   - Use memfd_create() only.\n"
+   " n   - Do not use memfd_create().\n"
+   " try - Use memfd_create() if it is supported, otherwise use DIR.",
+   ucs_offsetof(uct_posix_md_config_t, use_memfd), UCS_CONFIG_TYPE_TERNARY},
+
   {NULL}
 };
 
@@ -82,6 +102,12 @@ static int uct_posix_use_shm_open(const uct_posix_md_config_t *posix_config)
     return !strcmp(posix_config->dir, UCT_POSIX_SHM_OPEN_DIR);
 }
 
+static int uct_posix_use_proc_link(const uct_posix_md_config_t *posix_config)
+{
+    /* memfd segments have no file system path */
+    return posix_config->use_proc_link || (posix_config->use_memfd != UCS_NO);
+}
+
 static size_t uct_posix_iface_addr_length(uct_mm_md_t *md)
 {
     const uct_posix_md_config_t *posix_config =
@@ -92,7 +118,7 @@ static size_t uct_posix_iface_addr_length(uct_mm_md_t *md)
      * requested backing file is needed so that the user would know how much
      * space to allocate for the rkey.
      */
-    if (posix_config->use_proc_link) {
+    if (uct_posix_use_proc_link(posix_config)) {
         return ucs_sys_ns_is_default(UCS_SYS_NS_TYPE_PID) ? 0 : sizeof(ucs_sys_ns_t);
     }
 
@@ -260,13 +286,11 @@ static ucs_status_t uct_posix_unlink(uct_mm_md_t *md, uint64_t seg_id)
 }
 
 static ucs_status_t
-uct_posix_mmap(void **address_p, size_t *length_p, int flags, int fd,
-               const char *alloc_name, ucs_log_level_t err_level)
+uct_posix_mmap_length(size_t length, int flags, size_t *aligned_length_p)
 {
     size_t aligned_length;
-    void *result;
 
-    aligned_length = ucs_align_up_pow2(*length_p, ucs_get_page_size());
+    aligned_length = ucs_align_up_pow2(length, ucs_get_page_size());
 
 #ifdef MAP_HUGETLB
     if (flags & MAP_HUGETLB) {
@@ -287,6 +311,23 @@ uct_posix_mmap(void **address_p, size_t *length_p, int flags, int fd,
     }
 #endif
 
+    *aligned_length_p = aligned_length;
+    return UCS_OK;
+}
+
+static ucs_status_t
+uct_posix_mmap(void **address_p, size_t *length_p, int flags, int fd,
+               const char *alloc_name, ucs_log_level_t err_level)
+{
+    size_t aligned_length;
+    ucs_status_t status;
+    void *result;
+
+    status = uct_posix_mmap_length(*length_p, flags, &aligned_length);
+    if (status != UCS_OK) {
+        return status;
+    }
+
     result = ucs_mmap(*address_p, aligned_length, UCT_POSIX_MMAP_PROT,
                       MAP_SHARED | flags, fd, 0 UCS_MEMTRACK_VAL);
     if (result == MAP_FAILED) {
@@ -409,33 +450,136 @@ uct_posix_segment_open(uct_mm_md_t *md, uct_mm_seg_id_t *seg_id_p, int *fd_p)
     }
 }
 
+static uint64_t uct_posix_seg_id_procfs(int fd)
+{
+    return uct_posix_mmid_procfs_pack(fd) | UCT_POSIX_SEG_FLAG_PROCFS |
+           (ucs_sys_ns_is_default(UCS_SYS_NS_TYPE_PID) ? 0 :
+            UCT_POSIX_SEG_FLAG_PID_NS);
+}
+
+#if HAVE_MEMFD_CREATE
 static ucs_status_t
-uct_posix_mem_alloc(uct_md_h tl_md, size_t *length_p, void **address_p,
-                    ucs_memory_type_t mem_type, unsigned flags,
-                    const char *alloc_name, uct_mem_h *memh_p)
+uct_posix_memfd_map(uct_mm_seg_t *seg, int mmap_flags, int hugetlb,
+                    const char *alloc_name, ucs_log_level_t err_level,
+                    int *fd_p)
 {
-    uct_mm_md_t                     *md = ucs_derived_of(tl_md, uct_mm_md_t);
-    uct_posix_md_config_t *posix_config = ucs_derived_of(md->config,
-                                                         uct_posix_md_config_t);
+    unsigned memfd_flags = MFD_CLOEXEC | MFD_ALLOW_SEALING;
     ucs_status_t status;
-    uct_mm_seg_t *seg;
-    int force_hugetlb;
-    int mmap_flags;
-    void *address;
+    size_t length;
     int fd;
 
-    if (mem_type != UCS_MEMORY_TYPE_HOST) {
+    if (hugetlb) {
+#if defined(MFD_HUGETLB) && defined(MAP_HUGETLB)
+        memfd_flags |= MFD_HUGETLB;
+        mmap_flags  |= MAP_HUGETLB;
+#else
+        ucs_log(err_level, "memfd allocation failed: MFD_HUGETLB is not "
+                "supported on the system");
         return UCS_ERR_UNSUPPORTED;
+#endif
     }
 
-    status = uct_mm_seg_new(*address_p, *length_p, &seg);
+    /* the file size must be aligned to the page size of the memfd */
+    status = uct_posix_mmap_length(seg->length, mmap_flags, &length);
     if (status != UCS_OK) {
-        goto err;
+        return status;
+    }
+
+    fd = memfd_create(UCT_POSIX_MEMFD_NAME, memfd_flags);
+    if (fd < 0) {
+        ucs_log(err_level, "memfd_create(flags=0x%x) failed: %m", memfd_flags);
+        return (errno == ENOSYS) ? UCS_ERR_UNSUPPORTED : UCS_ERR_SHMEM_SEGMENT;
+    }
+
+    if (ftruncate(fd, length) < 0) {
+        ucs_log(err_level, "ftruncate(memfd=%d, length=%zu) failed: %m", fd,
+                length);
+        status = UCS_ERR_NO_MEMORY;
+        goto err_close;
     }
 
+#ifdef UCT_POSIX_MEMFD_SEALS
+    if (fcntl(fd, F_ADD_SEALS, UCT_POSIX_MEMFD_SEALS) < 0) {
+        ucs_debug("failed to seal memfd %d: %m", fd);
+    }
+#endif
+
+    status = uct_posix_mmap(&seg->address, &length, mmap_flags, fd,
+                            alloc_name, err_level);
+    if (status != UCS_OK) {
+        goto err_close;
+    }
+
+    seg->length = length;
+    *fd_p       = fd;
+    return UCS_OK;
+
+err_close:
+    close(fd);
+    return status;
+}
+#endif
+
+static ucs_status_t
+uct_posix_memfd_alloc(uct_mm_md_t *md, uct_mm_seg_t *seg, int mmap_flags,
+                      const char *alloc_name, int *fd_p)
+{
+    uct_posix_md_config_t *posix_config = ucs_derived_of(md->config,
+                                                         uct_posix_md_config_t);
+#if HAVE_MEMFD_CREATE
+    ucs_log_level_t err_level           = (posix_config->use_memfd == UCS_YES) ?
+                                          UCS_LOG_LEVEL_ERROR :
+                                          UCS_LOG_LEVEL_DEBUG;
+    ucs_ternary_auto_value_t hugetlb_mode = posix_config->super.hugetlb_mode;
+    ucs_status_t status;
+
+    /* try a huge page memfd */
+    if (hugetlb_mode != UCS_NO) {
+        status = uct_posix_memfd_map(seg, mmap_flags, 1, alloc_name,
+                                     (hugetlb_mode == UCS_YES) ?
+                                     UCS_LOG_LEVEL_ERROR : UCS_LOG_LEVEL_DEBUG,
+                                     fd_p);
+        if (status == UCS_OK) {
+            seg->seg_id = uct_posix_seg_id_procfs(*fd_p) |
+                          UCT_POSIX_SEG_FLAG_HUGETLB;
+            return UCS_OK;
+        } else if (hugetlb_mode == UCS_YES) {
+            return status;
+        }
+    }
+
+    /* fallback to regular pages */
+    status = uct_posix_memfd_map(seg, mmap_flags, 0, alloc_name, err_level,
+                                 fd_p);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    seg->seg_id = uct_posix_seg_id_procfs(*fd_p);
+    return UCS_OK;
+#else
+    if (posix_config->use_memfd == UCS_YES) {
+        ucs_error("shared memory allocation failed: memfd_create() is not "
+                  "supported on the system");
+    }
+    return UCS_ERR_UNSUPPORTED;
+#endif
+}
+
+static ucs_status_t
+uct_posix_file_alloc(uct_mm_md_t *md, uct_mm_seg_t *seg, int mmap_flags,
+                     const char *alloc_name, int *fd_p)
+{
+    uct_posix_md_config_t *posix_config = ucs_derived_of(md->config,
+                                                         uct_posix_md_config_t);
+    ucs_status_t status;
+    int force_hugetlb;
+    void *address;
+    int fd;
+
     status = uct_posix_segment_open(md, &seg->seg_id, &fd);
     if (status != UCS_OK) {
-        goto err_free_seg;
+        return status;
     }
 
     /* Check if the location of the backing file has enough memory for the
@@ -447,26 +591,15 @@ uct_posix_mem_alloc(uct_md_h tl_md, size_t *length_p, void **address_p,
 
     /* If using procfs link instead of mmid, remove the original file and update
      * seg->seg_id */
-    if (posix_config->use_proc_link) {
+    if (uct_posix_use_proc_link(posix_config)) {
         status = uct_posix_unlink(md, seg->seg_id);
         if (status != UCS_OK) {
             goto err_close;
         }
 
         /* Replace mmid by pid+fd. Keep previous SHM_OPEN flag for mkey_pack() */
-        seg->seg_id = uct_posix_mmid_procfs_pack(fd) |
-                      (seg->seg_id & UCT_POSIX_SEG_FLAG_SHM_OPEN) |
-                      UCT_POSIX_SEG_FLAG_PROCFS |
-                      (ucs_sys_ns_is_default(UCS_SYS_NS_TYPE_PID) ? 0 :
-                       UCT_POSIX_SEG_FLAG_PID_NS);
-    }
-
-    /* mmap the shared memory segment that was created by shm_open */
-    if (flags & UCT_MD_MEM_FLAG_FIXED) {
-        mmap_flags   = MAP_FIXED;
-    } else {
-        seg->address = NULL;
-        mmap_flags   = 0;
+        seg->seg_id = uct_posix_seg_id_procfs(fd) |
+                      (seg->seg_id & UCT_POSIX_SEG_FLAG_SHM_OPEN);
     }
 
     /* try HUGETLB mmap */
@@ -502,11 +635,68 @@ uct_posix_mem_alloc(uct_md_h tl_md, size_t *length_p, void **address_p,
         }
     }
 
+    *fd_p = fd;
+    return UCS_OK;
+
+err_close:
+    close(fd);
+    if (!(seg->seg_id & UCT_POSIX_SEG_FLAG_PROCFS)) {
+        uct_posix_unlink(md, seg->seg_id);
+    }
+    return status;
+}
+
+static ucs_status_t
+uct_posix_mem_alloc(uct_md_h tl_md, size_t *length_p, void **address_p,
+                    ucs_memory_type_t mem_type, unsigned flags,
+                    const char *alloc_name, uct_mem_h *memh_p)
+{
+    uct_mm_md_t                     *md = ucs_derived_of(tl_md, uct_mm_md_t);
+    uct_posix_md_config_t *posix_config = ucs_derived_of(md->config,
+                                                         uct_posix_md_config_t);
+    ucs_status_t status;
+    uct_mm_seg_t *seg;
+    int mmap_flags;
+    int fd;
+
+    if (mem_type != UCS_MEMORY_TYPE_HOST) {
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    status = uct_mm_seg_new(*address_p, *length_p, &seg);
+    if (status != UCS_OK) {
+        goto err;
+    }
+
+    /* mmap the shared memory segment */
+    if (flags & UCT_MD_MEM_FLAG_FIXED) {
+        mmap_flags   = MAP_FIXED;
+    } else {
+        seg->address = NULL;
+        mmap_flags   = 0;
+    }
+
+    status = UCS_ERR_UNSUPPORTED;
+    if (posix_config->use_memfd != UCS_NO) {
+        status = uct_posix_memfd_alloc(md, seg, mmap_flags, alloc_name, &fd);
+        if ((status != UCS_OK) && (posix_config->use_memfd == UCS_YES)) {
+            goto err_free_seg;
+        }
+    }
+
+    /* fallback to a backing file */
+    if (status != UCS_OK) {
+        status = uct_posix_file_alloc(md, seg, mmap_flags, alloc_name, &fd);
+        if (status != UCS_OK) {
+            goto err_free_seg;
+        }
+    }
+
     /* create new memory segment */
     ucs_debug("allocated posix shared memory at %p length %zu", seg->address,
               seg->length);
 
-    if (!posix_config->use_proc_link) {
+    if (!(seg->seg_id & UCT_POSIX_SEG_FLAG_PROCFS)) {
         /* closing the file here since the peers will open it by file system path */
         close(fd);
     }
@@ -516,11 +706,6 @@ uct_posix_mem_alloc(uct_md_h tl_md, size_t *length_p, void **address_p,
      *memh_p   = seg;
     return UCS_OK;
 
-err_close:
-    close(fd);
-    if (!(seg->seg_id & UCT_POSIX_SEG_FLAG_PROCFS)) {
-        uct_posix_unlink(md, seg->seg_id);
-    }
 err_free_seg:
     ucs_free(seg);
 err:
@@ -568,7 +753,7 @@ static ucs_status_t uct_posix_iface_addr_pack(uct_mm_md_t *md, void *buffer)
     const uct_posix_md_config_t *posix_config =
                      ucs_derived_of(md->config, uct_posix_md_config_t);
 
-    if (posix_config->use_proc_link) {
+    if (uct_posix_use_proc_link(posix_config)) {
         if (!ucs_sys_ns_is_default(UCS_SYS_NS_TYPE_PID)) {
             *(ucs_sys_ns_t*)buffer = ucs_sys_get_ns(UCS_SYS_NS_TYPE_PID);
         }
@@ -40,8 +40,9 @@ static UCS_F_ALWAYS_INLINE void
 uct_scopy_ep_tx_init_common(uct_scopy_tx_t *tx, uct_scopy_tx_op_t tx_op,
                             uct_completion_t *comp)
 {
-    tx->comp = comp;
-    tx->op   = tx_op;
+    tx->comp         = comp;
+    tx->op           = tx_op;
+    tx->mt.seg_count = 0;
     ucs_arbiter_elem_init(&tx->arb_elem);
 }
 
@@ -54,7 +55,7 @@ uct_scopy_ep_tx_init(uct_ep_h tl_ep, const uct_iov_t *iov,
     uct_scopy_iface_t *iface = ucs_derived_of(tl_ep->iface, uct_scopy_iface_t);
     uct_scopy_ep_t *ep       = ucs_derived_of(tl_ep, uct_scopy_ep_t);
     uct_scopy_tx_t *tx;
-    size_t iov_it;
+    size_t iov_it, length;
 
     ucs_assert((tx_op == UCT_SCOPY_TX_PUT_ZCOPY) ||
                (tx_op == UCT_SCOPY_TX_GET_ZCOPY));
@@ -81,12 +82,23 @@ uct_scopy_ep_tx_init(uct_ep_h tl_ep, const uct_iov_t *iov,
         tx->iov_cnt++;
     }
 
+    length = uct_iov_total_length(tx->iov, tx->iov_cnt);
     if (tx_op == UCT_SCOPY_TX_PUT_ZCOPY) {
         UCT_TL_EP_STAT_OP(ucs_derived_of(tl_ep, uct_base_ep_t), PUT, ZCOPY,
-                          uct_iov_total_length(tx->iov, tx->iov_cnt));
+                          length);
     } else {
         UCT_TL_EP_STAT_OP(ucs_derived_of(tl_ep, uct_base_ep_t), GET, ZCOPY,
-                          uct_iov_total_length(tx->iov, tx->iov_cnt));
+                          length);
+    }
+
+    if ((iface->mt.num_threads > 0) && (length >= iface->config.mt_thresh)) {
+        /* segments are distributed between the progress thread and the
+         * helper threads once the operation reaches the arbiter head */
+        tx->mt.ep        = tl_ep;
+        tx->mt.seg_count = ucs_div_round_up(length, iface->config.seg_size);
+        tx->mt.seg_next  = 0;
+        tx->mt.seg_done  = 0;
+        tx->mt.status    = UCS_OK;
     }
 
     if (tx->iov_cnt == 0) {
@@ -144,7 +156,19 @@ ucs_arbiter_cb_result_t uct_scopy_ep_progress_tx(ucs_arbiter_t *arbiter,
         return UCS_ARBITER_CB_RESULT_STOP;
     }
 
-    if (tx->op != UCT_SCOPY_TX_FLUSH_COMP) {
+    if (tx->mt.seg_count != 0) {
+        status = uct_scopy_iface_mt_progress_tx(iface, tx, count);
+        if (status == UCS_INPROGRESS) {
+            /* let other endpoints progress while the helper threads are
+             * busy with the rest of the segments */
+            return UCS_ARBITER_CB_RESULT_RESCHED_GROUP;
+        }
+
+        ucs_trace_data("%s [tx %p segments %zu length %zu] to %" PRIx64 "(%+ld)",
+                       uct_scopy_tx_op_str[tx->op], tx, tx->mt.seg_count,
+                       uct_iov_total_length(tx->iov, tx->iov_cnt),
+                       tx->remote_addr, tx->rkey);
+    } else if (tx->op != UCT_SCOPY_TX_FLUSH_COMP) {
         ucs_assert((tx->op == UCT_SCOPY_TX_GET_ZCOPY) ||
                    (tx->op == UCT_SCOPY_TX_PUT_ZCOPY));
         seg_size = iface->config.seg_size;
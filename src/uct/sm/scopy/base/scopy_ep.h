@@ -52,6 +52,16 @@ typedef struct uct_scopy_tx {
     uct_rkey_t                      rkey;               /* User-passed UCT rkey */
     uct_completion_t                *comp;              /* The pointer to the user's passed completion */
     ucs_iov_iter_t                  iov_iter;           /* UCT IOVs iterator */
+    struct {
+        uct_ep_h                    ep;                 /* The endpoint used by helper threads */
+        ucs_list_link_t             list;               /* Entry in the helper threads queue */
+        size_t                      seg_count;          /* Number of segments, 0 if the
+                                                         * operation is not parallel */
+        size_t                      seg_next;           /* Next segment to dispatch */
+        size_t                      seg_done;           /* Number of completed segments */
+        ucs_status_t                status;             /* First error of the segments */
+    } mt;                                               /* Parallel transfer state, protected
+                                                         * by the iface helper threads lock */
     size_t                          iov_cnt;            /* The number of the UCT IOVs */
     uct_iov_t                       iov[];              /* UCT IOVs */
 } uct_scopy_tx_t;
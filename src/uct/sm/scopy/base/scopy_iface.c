@@ -14,6 +14,7 @@
 #include <ucs/sys/string.h>
 
 #include <uct/sm/base/sm_iface.h>
+#include <uct/base/uct_iov.inl>
 
 
 ucs_config_field_t uct_scopy_iface_config_table[] = {
@@ -43,6 +44,17 @@ ucs_config_field_t uct_scopy_iface_config_table[] = {
     UCT_IFACE_MPOOL_CONFIG_FIELDS("TX_", -1, 8, "send",
                                   ucs_offsetof(uct_scopy_iface_config_t, tx_mpool), ""),
 
+    {"MT_THREADS", "0",
+     "Number of helper threads which transfer the segments of a single large\n"
+     "GET/PUT Zcopy operation concurrently with the progress thread.\n"
+     "0 disables the helper threads.",
+     ucs_offsetof(uct_scopy_iface_config_t, mt_threads), UCS_CONFIG_TYPE_UINT},
+
+    {"MT_THRESH", "4m",
+     "Minimal length of the GET/PUT Zcopy operation to split its segments\n"
+     "between the helper threads",
+     ucs_offsetof(uct_scopy_iface_config_t, mt_thresh), UCS_CONFIG_TYPE_MEMUNITS},
+
     {NULL}
 };
 
@@ -83,6 +95,183 @@ void uct_scopy_iface_query(uct_scopy_iface_t *iface, uct_iface_attr_t *iface_att
     iface_attr->latency                 = ucs_linear_func_make(80e-9, 0); /* 80 ns */
 }
 
+static void uct_scopy_iface_mt_tx_seg(uct_scopy_iface_t *iface,
+                                      uct_scopy_tx_t *tx, size_t seg)
+{
+    size_t total_length = uct_iov_total_length(tx->iov, tx->iov_cnt);
+    size_t offset       = seg * iface->config.seg_size;
+    size_t end          = ucs_min(offset + iface->config.seg_size,
+                                  total_length);
+    ucs_status_t status = UCS_OK;
+    ucs_iov_iter_t iov_iter;
+    size_t iov_offset, length;
+
+    while (offset < end) {
+        /* position the iterator at the flat offset of the segment */
+        ucs_iov_iter_init(&iov_iter);
+        iov_offset = offset;
+        while (iov_offset >= uct_iov_get_length(&tx->iov[iov_iter.iov_index])) {
+            iov_offset -= uct_iov_get_length(&tx->iov[iov_iter.iov_index]);
+            iov_iter.iov_index++;
+        }
+        iov_iter.buffer_offset = iov_offset;
+
+        length = end - offset;
+        status = iface->tx(tx->mt.ep, tx->iov, tx->iov_cnt, &iov_iter,
+                           &length, tx->remote_addr + offset, tx->rkey,
+                           tx->op);
+        if (UCS_STATUS_IS_ERR(status)) {
+            break;
+        }
+
+        offset += length;
+    }
+
+    pthread_mutex_lock(&iface->mt.lock);
+    if (UCS_STATUS_IS_ERR(status) && (tx->mt.status == UCS_OK)) {
+        tx->mt.status = status;
+    }
+    tx->mt.seg_done++;
+    pthread_mutex_unlock(&iface->mt.lock);
+}
+
+/* Must be called with the helper threads lock held */
+static size_t uct_scopy_iface_mt_claim_seg(uct_scopy_iface_t *iface,
+                                           uct_scopy_tx_t *tx)
+{
+    size_t seg = tx->mt.seg_next++;
+
+    ucs_assert(seg < tx->mt.seg_count);
+
+    if (seg == 0) {
+        /* The first segment is always taken by the progress thread, expose
+         * the rest of the segments to the helper threads */
+        if (tx->mt.seg_count > 1) {
+            ucs_list_add_tail(&iface->mt.queue, &tx->mt.list);
+            pthread_cond_broadcast(&iface->mt.cond);
+        }
+    } else if (tx->mt.seg_next == tx->mt.seg_count) {
+        ucs_list_del(&tx->mt.list);
+    }
+
+    return seg;
+}
+
+static void *uct_scopy_iface_mt_thread_func(void *arg)
+{
+    uct_scopy_iface_t *iface = arg;
+    uct_scopy_tx_t *tx;
+    size_t seg;
+
+    pthread_mutex_lock(&iface->mt.lock);
+    for (;;) {
+        while (ucs_list_is_empty(&iface->mt.queue) && !iface->mt.stop) {
+            pthread_cond_wait(&iface->mt.cond, &iface->mt.lock);
+        }
+
+        if (iface->mt.stop) {
+            break;
+        }
+
+        tx  = ucs_list_head(&iface->mt.queue, uct_scopy_tx_t, mt.list);
+        seg = uct_scopy_iface_mt_claim_seg(iface, tx);
+        pthread_mutex_unlock(&iface->mt.lock);
+
+        /* the TX op must not be accessed after its segment is completed,
+         * since the progress thread may release it */
+        uct_scopy_iface_mt_tx_seg(iface, tx, seg);
+        pthread_mutex_lock(&iface->mt.lock);
+    }
+    pthread_mutex_unlock(&iface->mt.lock);
+
+    return NULL;
+}
+
+ucs_status_t uct_scopy_iface_mt_progress_tx(uct_scopy_iface_t *iface,
+                                            uct_scopy_tx_t *tx,
+                                            unsigned *count)
+{
+    ucs_status_t status;
+    size_t seg;
+    int claimed;
+
+    pthread_mutex_lock(&iface->mt.lock);
+    claimed = tx->mt.seg_next < tx->mt.seg_count;
+    if (claimed) {
+        seg = uct_scopy_iface_mt_claim_seg(iface, tx);
+    }
+    pthread_mutex_unlock(&iface->mt.lock);
+
+    if (claimed) {
+        uct_scopy_iface_mt_tx_seg(iface, tx, seg);
+        (*count)++;
+    }
+
+    pthread_mutex_lock(&iface->mt.lock);
+    status = (tx->mt.seg_done < tx->mt.seg_count) ? UCS_INPROGRESS :
+             tx->mt.status;
+    pthread_mutex_unlock(&iface->mt.lock);
+
+    return status;
+}
+
+static void uct_scopy_iface_mt_stop(uct_scopy_iface_t *iface)
+{
+    unsigned i;
+
+    pthread_mutex_lock(&iface->mt.lock);
+    iface->mt.stop = 1;
+    pthread_cond_broadcast(&iface->mt.cond);
+    pthread_mutex_unlock(&iface->mt.lock);
+
+    for (i = 0; i < iface->mt.num_threads; ++i) {
+        pthread_join(iface->mt.threads[i], NULL);
+    }
+
+    ucs_free(iface->mt.threads);
+    pthread_cond_destroy(&iface->mt.cond);
+    pthread_mutex_destroy(&iface->mt.lock);
+}
+
+static ucs_status_t
+uct_scopy_iface_mt_start(uct_scopy_iface_t *iface, unsigned num_threads)
+{
+    int ret;
+
+    pthread_mutex_init(&iface->mt.lock, NULL);
+    pthread_cond_init(&iface->mt.cond, NULL);
+    ucs_list_head_init(&iface->mt.queue);
+    iface->mt.stop        = 0;
+    iface->mt.num_threads = 0;
+    iface->mt.threads     = NULL;
+
+    if (num_threads == 0) {
+        return UCS_OK;
+    }
+
+    iface->mt.threads = ucs_calloc(num_threads, sizeof(*iface->mt.threads),
+                                   "scopy_mt_threads");
+    if (iface->mt.threads == NULL) {
+        ucs_error("failed to allocate %u scopy helper threads", num_threads);
+        goto err;
+    }
+
+    for (; iface->mt.num_threads < num_threads; ++iface->mt.num_threads) {
+        ret = pthread_create(&iface->mt.threads[iface->mt.num_threads], NULL,
+                             uct_scopy_iface_mt_thread_func, iface);
+        if (ret != 0) {
+            ucs_error("pthread_create() failed: %s", strerror(ret));
+            goto err;
+        }
+    }
+
+    return UCS_OK;
+
+err:
+    uct_scopy_iface_mt_stop(iface);
+    return UCS_ERR_NO_RESOURCE;
+}
+
 UCS_CLASS_INIT_FUNC(uct_scopy_iface_t, uct_scopy_iface_ops_t *ops, uct_md_h md,
                     uct_worker_h worker, const uct_iface_params_t *params,
                     const uct_iface_config_t *tl_config)
@@ -94,10 +283,11 @@ UCS_CLASS_INIT_FUNC(uct_scopy_iface_t, uct_scopy_iface_ops_t *ops, uct_md_h md,
 
     UCS_CLASS_CALL_SUPER_INIT(uct_sm_iface_t, &ops->super, md, worker, params, tl_config);
 
-    self->tx              = ops->ep_tx;
-    self->config.max_iov  = ucs_min(config->max_iov, ucs_iov_get_max());
-    self->config.seg_size = config->seg_size;
-    self->config.tx_quota = config->tx_quota;
+    self->tx               = ops->ep_tx;
+    self->config.max_iov   = ucs_min(config->max_iov, ucs_iov_get_max());
+    self->config.seg_size  = config->seg_size;
+    self->config.tx_quota  = config->tx_quota;
+    self->config.mt_thresh = config->mt_thresh;
 
     elem_size             = sizeof(uct_scopy_tx_t) +
                             self->config.max_iov * sizeof(uct_iov_t);
@@ -110,7 +300,21 @@ UCS_CLASS_INIT_FUNC(uct_scopy_iface_t, uct_scopy_iface_ops_t *ops, uct_md_h md,
                             config->tx_mpool.max_bufs,
                             &uct_scopy_mpool_ops,
                             "uct_scopy_iface_tx_mp");
+    if (status != UCS_OK) {
+        goto err_cleanup_arbiter;
+    }
+
+    status = uct_scopy_iface_mt_start(self, config->mt_threads);
+    if (status != UCS_OK) {
+        goto err_cleanup_mpool;
+    }
 
+    return UCS_OK;
+
+err_cleanup_mpool:
+    ucs_mpool_cleanup(&self->tx_mpool, 1);
+err_cleanup_arbiter:
+    ucs_arbiter_cleanup(&self->arbiter);
     return status;
 }
 
@@ -118,6 +322,7 @@ static UCS_CLASS_CLEANUP_FUNC(uct_scopy_iface_t)
 {
     uct_worker_progress_unregister_safe(&self->super.super.worker->super,
                                         &self->super.super.prog.id);
+    uct_scopy_iface_mt_stop(self);
     ucs_mpool_cleanup(&self->tx_mpool, 1);
     ucs_arbiter_cleanup(&self->arbiter);
 }
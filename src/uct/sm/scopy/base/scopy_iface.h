@@ -11,6 +11,8 @@
 #include <uct/base/uct_iface.h>
 #include <uct/sm/base/sm_iface.h>
 
+#include <pthread.h>
+
 #define uct_scopy_trace_data(_tx) \
     ucs_trace_data("%s [tx %p iov %zu/%zu length %zu/%zu] to %" PRIx64 "(%+ld)", \
                    uct_scopy_tx_op_str[(_tx)->op], (_tx), \
@@ -32,6 +34,9 @@ typedef struct uct_scopy_iface_config {
     unsigned                      tx_quota;   /* How many TX segments can be dispatched
                                                * during iface progress */
     uct_iface_mpool_config_t      tx_mpool;   /* TX memory pool configuration */
+    unsigned                      mt_threads; /* Number of helper threads */
+    size_t                        mt_thresh;  /* Minimal length of the GET/PUT Zcopy
+                                               * operation to use helper threads */
 } uct_scopy_iface_config_t;
 
 
@@ -49,7 +54,19 @@ typedef struct uct_scopy_iface {
                                                 * Zcopy transfers */
         unsigned                  tx_quota;    /* How many TX segments can be dispatched
                                                 * during iface progress */
+        size_t                    mt_thresh;   /* Minimal length of the GET/PUT Zcopy
+                                                * operation to use helper threads */
     } config;
+    struct {
+        pthread_mutex_t           lock;        /* Protects the queue and the
+                                                * parallel state of the TX ops */
+        pthread_cond_t            cond;        /* Signals the helper threads */
+        ucs_list_link_t           queue;       /* TX ops which have segments that
+                                                * were not dispatched yet */
+        pthread_t                 *threads;    /* Helper threads */
+        unsigned                  num_threads; /* Number of helper threads */
+        int                       stop;        /* Helper threads have to exit */
+    } mt;
 } uct_scopy_iface_t;
 
 
@@ -68,6 +85,10 @@ unsigned uct_scopy_iface_progress(uct_iface_h tl_iface);
 
 ucs_status_t uct_scopy_iface_event_arm(uct_iface_h tl_iface, unsigned events);
 
+ucs_status_t uct_scopy_iface_mt_progress_tx(uct_scopy_iface_t *iface,
+                                            uct_scopy_tx_t *tx,
+                                            unsigned *count);
+
 ucs_status_t uct_scopy_iface_flush(uct_iface_h tl_iface, unsigned flags,
                                    uct_completion_t *comp);
 
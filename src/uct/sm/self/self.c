@@ -74,9 +74,12 @@ static ucs_status_t uct_self_iface_query(uct_iface_h tl_iface, uct_iface_attr_t
     attr->cap.flags              = UCT_IFACE_FLAG_CONNECT_TO_IFACE |
                                    UCT_IFACE_FLAG_AM_SHORT         |
                                    UCT_IFACE_FLAG_AM_BCOPY         |
+                                   UCT_IFACE_FLAG_AM_ZCOPY         |
                                    UCT_IFACE_FLAG_PUT_SHORT        |
                                    UCT_IFACE_FLAG_PUT_BCOPY        |
+                                   UCT_IFACE_FLAG_PUT_ZCOPY        |
                                    UCT_IFACE_FLAG_GET_BCOPY        |
+                                   UCT_IFACE_FLAG_GET_ZCOPY        |
                                    UCT_IFACE_FLAG_ATOMIC_CPU       |
                                    UCT_IFACE_FLAG_PENDING          |
                                    UCT_IFACE_FLAG_CB_SYNC          |
@@ -98,26 +101,26 @@ static ucs_status_t uct_self_iface_query(uct_iface_h tl_iface, uct_iface_attr_t
     attr->cap.put.max_short       = UINT_MAX;
     attr->cap.put.max_bcopy       = SIZE_MAX;
     attr->cap.put.min_zcopy       = 0;
-    attr->cap.put.max_zcopy       = 0;
+    attr->cap.put.max_zcopy       = SIZE_MAX;
     attr->cap.put.opt_zcopy_align = 1;
     attr->cap.put.align_mtu       = attr->cap.put.opt_zcopy_align;
-    attr->cap.put.max_iov         = 1;
+    attr->cap.put.max_iov         = UCT_SM_MAX_IOV;
 
     attr->cap.get.max_bcopy       = SIZE_MAX;
     attr->cap.get.min_zcopy       = 0;
-    attr->cap.get.max_zcopy       = 0;
+    attr->cap.get.max_zcopy       = SIZE_MAX;
     attr->cap.get.opt_zcopy_align = 1;
     attr->cap.get.align_mtu       = attr->cap.get.opt_zcopy_align;
-    attr->cap.get.max_iov         = 1;
+    attr->cap.get.max_iov         = UCT_SM_MAX_IOV;
 
     attr->cap.am.max_short        = iface->send_size;
     attr->cap.am.max_bcopy        = iface->send_size;
     attr->cap.am.min_zcopy        = 0;
-    attr->cap.am.max_zcopy        = 0;
+    attr->cap.am.max_zcopy        = iface->send_size;
     attr->cap.am.opt_zcopy_align  = 1;
     attr->cap.am.align_mtu        = attr->cap.am.opt_zcopy_align;
-    attr->cap.am.max_hdr          = 0;
-    attr->cap.am.max_iov          = SIZE_MAX;
+    attr->cap.am.max_hdr          = iface->send_size;
+    attr->cap.am.max_iov          = UCT_SM_MAX_IOV;
 
     attr->latency                 = ucs_linear_func_make(0, 0);
     attr->bandwidth.dedicated     = 6911.0 * UCS_MBYTE;
@@ -147,8 +150,9 @@ static int uct_self_iface_is_reachable(const uct_iface_h tl_iface,
     return (addr != NULL) && (iface->id == *addr);
 }
 
-static void uct_self_iface_sendrecv_am(uct_self_iface_t *iface, uint8_t am_id,
-                                       void *buffer, size_t length, const char *title)
+static void uct_self_iface_deliver_am(uct_self_iface_t *iface, uint8_t am_id,
+                                      void *buffer, size_t length,
+                                      const char *title)
 {
     ucs_status_t UCS_V_UNUSED status;
 
@@ -160,6 +164,12 @@ static void uct_self_iface_sendrecv_am(uct_self_iface_t *iface, uint8_t am_id,
     status = uct_iface_invoke_am(&iface->super, am_id, buffer,
                                  length, 0);
     ucs_assert(status == UCS_OK);
+}
+
+static void uct_self_iface_sendrecv_am(uct_self_iface_t *iface, uint8_t am_id,
+                                       void *buffer, size_t length, const char *title)
+{
+    uct_self_iface_deliver_am(iface, am_id, buffer, length, title);
     ucs_mpool_put_inline(buffer);
 }
 
@@ -338,13 +348,54 @@ ssize_t uct_self_ep_am_bcopy(uct_ep_h tl_ep, uint8_t id,
     return length;
 }
 
+ucs_status_t uct_self_ep_am_zcopy(uct_ep_h tl_ep, uint8_t id, const void *header,
+                                  unsigned header_length, const uct_iov_t *iov,
+                                  size_t iovcnt, unsigned flags,
+                                  uct_completion_t *comp)
+{
+    uct_self_iface_t *iface        = ucs_derived_of(tl_ep->iface,
+                                                    uct_self_iface_t);
+    uct_self_ep_t UCS_V_UNUSED *ep = ucs_derived_of(tl_ep, uct_self_ep_t);
+    size_t length                  = uct_iov_total_length(iov, iovcnt);
+    ucs_iov_iter_t iov_iter;
+    void *send_buffer;
+
+    UCT_CHECK_AM_ID(id);
+    UCT_CHECK_IOV_SIZE(iovcnt, (size_t)UCT_SM_MAX_IOV, "uct_self_ep_am_zcopy");
+    UCT_CHECK_LENGTH(header_length + length, 0, iface->send_size, "am_zcopy");
+    UCT_TL_EP_STAT_OP(&ep->super, AM, ZCOPY, header_length + length);
+
+    if ((header_length == 0) && (iovcnt == 1)) {
+        /* the payload is contiguous, deliver it from the user buffer */
+        uct_self_iface_deliver_am(iface, id, uct_iov_get_buffer(iov), length,
+                                  "ZCOPY");
+        return UCS_OK;
+    }
+
+    /* the handler expects contiguous data, so header and payload are gathered
+     * directly from the user buffers, without calling a pack callback */
+    send_buffer = UCT_SELF_IFACE_SEND_BUFFER_GET(iface);
+    memcpy(send_buffer, header, header_length);
+    ucs_iov_iter_init(&iov_iter);
+    uct_iov_to_buffer(iov, iovcnt, &iov_iter,
+                      UCS_PTR_BYTE_OFFSET(send_buffer, header_length),
+                      SIZE_MAX);
+
+    uct_self_iface_sendrecv_am(iface, id, send_buffer, header_length + length,
+                               "ZCOPY");
+    return UCS_OK;
+}
+
 static uct_iface_ops_t uct_self_iface_ops = {
     .ep_put_short             = uct_sm_ep_put_short,
     .ep_put_bcopy             = uct_sm_ep_put_bcopy,
+    .ep_put_zcopy             = uct_sm_ep_put_zcopy,
     .ep_get_bcopy             = uct_sm_ep_get_bcopy,
+    .ep_get_zcopy             = uct_sm_ep_get_zcopy,
     .ep_am_short              = uct_self_ep_am_short,
     .ep_am_short_iov          = uct_self_ep_am_short_iov,
     .ep_am_bcopy              = uct_self_ep_am_bcopy,
+    .ep_am_zcopy              = uct_self_ep_am_zcopy,
     .ep_atomic_cswap64        = uct_sm_ep_atomic_cswap64,
     .ep_atomic64_post         = uct_sm_ep_atomic64_post,
     .ep_atomic64_fetch        = uct_sm_ep_atomic64_fetch,
@@ -18,6 +18,8 @@
 #include <ucs/algorithm/crc.h>
 #include <ucs/sys/event_set.h>
 #include <ucs/sys/iovec.h>
+#include <ucs/type/spinlock.h>
+#include <ucs/arch/atomic.h>
 
 #include <net/if.h>
 
@@ -51,6 +53,18 @@
 #define UCT_TCP_EP_PUT_SERVICE_LENGTH        (sizeof(uct_tcp_am_hdr_t) + \
                                               sizeof(uct_tcp_ep_put_req_hdr_t))
 
+/* Maximum size of a data that can be sent by GET response
+ * of GET Zcopy operation */
+#define UCT_TCP_EP_GET_ZCOPY_MAX              SIZE_MAX
+
+/* Length of a data that is used by GET response */
+#define UCT_TCP_EP_GET_SERVICE_LENGTH        (sizeof(uct_tcp_am_hdr_t) + \
+                                              sizeof(uct_tcp_ep_get_resp_hdr_t))
+
+/* Maximum number of IOVs in GET Zcopy operation, since the data is received
+ * to a single user's buffer */
+#define UCT_TCP_EP_GET_ZCOPY_MAX_IOV          1ul
+
 #define UCT_TCP_CONFIG_MAX_CONN_RETRIES      "MAX_CONN_RETRIES"
 
 /* TX and RX caps */
@@ -67,6 +81,17 @@
 /* The seconds between individual keepalive probes */
 #define UCT_TCP_EP_DEFAULT_KEEPALIVE_INTVL   1
 
+/* Number of locks which serialize operations on EPs of a multi-threaded
+ * iface. An EP is mapped to a lock by its address, so the lock outlives the
+ * EP if it is destroyed while the lock is held */
+#define UCT_TCP_IFACE_EP_LOCKS_COUNT         64
+
+/* Size of per-thread caches of TX/RX buffers of a multi-threaded iface */
+#define UCT_TCP_IFACE_MPOOL_TCACHE_SIZE      32
+
+/* Maximal number of sockets used by a single connection */
+#define UCT_TCP_EP_MAX_STREAMS               16
+
 
 /**
  * TCP EP connection manager ID
@@ -109,7 +134,38 @@ enum {
      * method. */
     UCT_TCP_EP_FLAG_CONNECT_TO_EP      = UCS_BIT(8),
     /* EP is on EP PTR map. */
-    UCT_TCP_EP_FLAG_ON_PTR_MAP         = UCS_BIT(9)
+    UCT_TCP_EP_FLAG_ON_PTR_MAP         = UCS_BIT(9),
+    /* Zcopy TX operation on a given EP is sent with MSG_ZEROCOPY, so the
+     * kernel references the TX buffer and user's payload until a completion
+     * notification is read from the socket error queue. */
+    UCT_TCP_EP_FLAG_ZCOPY_MSG_TX       = UCS_BIT(10),
+    /* GET response data is being received to the user's buffer
+     * on a given EP. */
+    UCT_TCP_EP_FLAG_GET_RX             = UCS_BIT(11),
+    /* AM payload is being received to the buffer provided by the user's
+     * direct receive handler on a given EP. */
+    UCT_TCP_EP_FLAG_AM_RX_DIRECT       = UCS_BIT(12),
+    /* EP is an auxiliary socket of a connection, which carries stripes
+     * of large RMA operations. It is hidden from a user and owned by the
+     * EP which stripes the operations on the sender side. */
+    UCT_TCP_EP_FLAG_STREAM             = UCS_BIT(13),
+    /* Fence was requested while the stripes of RMA operations were in
+     * flight, new operations wait until all sockets of the connection
+     * are acknowledged. */
+    UCT_TCP_EP_FLAG_STREAM_FENCE       = UCS_BIT(14)
+};
+
+
+/**
+ * TCP MSG_ZEROCOPY completion flags
+ */
+enum {
+    /* The completion belongs to an AM/PUT Zcopy operation (and not to a flush
+     * or a PUT which waits for the preceding operations). */
+    UCT_TCP_EP_ZCOPY_COMP_FLAG_OP      = UCS_BIT(0),
+    /* The operation is still being sent, so more MSG_ZEROCOPY sends can be
+     * added to it. */
+    UCT_TCP_EP_ZCOPY_COMP_FLAG_SENDING = UCS_BIT(1)
 };
 
 
@@ -146,6 +202,13 @@ typedef struct uct_tcp_ep uct_tcp_ep_t;
 
 typedef ucs_callback_t uct_tcp_ep_progress_t;
 
+/* Posts an RMA operation on a single socket */
+typedef ucs_status_t (*uct_tcp_ep_rma_func_t)(uct_tcp_ep_t *ep,
+                                              const uct_iov_t *iov,
+                                              size_t iovcnt,
+                                              uint64_t remote_addr,
+                                              uct_completion_t *comp);
+
 
 /**
  * TCP Connection Manager state
@@ -183,7 +246,10 @@ typedef enum uct_tcp_cm_conn_event {
 enum {
     /* Inditicates whether both EPs of the connection has to use CONNECT_TO_EP
      * CONNECT_TO_EP of connection establishmnet */
-    UCT_TCP_CM_CONN_REQ_PKT_FLAG_CONNECT_TO_EP = UCS_BIT(0)
+    UCT_TCP_CM_CONN_REQ_PKT_FLAG_CONNECT_TO_EP = UCS_BIT(0),
+    /* The connection is an auxiliary socket of another connection, it is
+     * accepted without matching and acknowledgment */
+    UCT_TCP_CM_CONN_REQ_PKT_FLAG_STREAM        = UCS_BIT(1)
 };
 
 
@@ -218,7 +284,11 @@ typedef enum uct_tcp_ep_am_id {
     /* AM ID reserved for TCP internal PUT ACK message */
     UCT_TCP_EP_PUT_ACK_AM_ID   = UCT_AM_ID_MAX + 2,
     /* AM ID reserved for TCP internal PUT ACK message */
-    UCT_TCP_EP_KEEPALIVE_AM_ID = UCT_AM_ID_MAX + 3
+    UCT_TCP_EP_KEEPALIVE_AM_ID = UCT_AM_ID_MAX + 3,
+    /* AM ID reserved for TCP internal GET REQ message */
+    UCT_TCP_EP_GET_REQ_AM_ID   = UCT_AM_ID_MAX + 4,
+    /* AM ID reserved for TCP internal GET RESP message */
+    UCT_TCP_EP_GET_RESP_AM_ID  = UCT_AM_ID_MAX + 5
 } uct_tcp_ep_am_id_t;
 
 
@@ -254,12 +324,91 @@ typedef struct uct_tcp_ep_put_completion {
 } uct_tcp_ep_put_completion_t;
 
 
+/**
+ * TCP GET request header
+ */
+typedef struct uct_tcp_ep_get_req_hdr {
+    uint64_t                      addr;        /* Address of a remote memory buffer */
+    size_t                        length;      /* Length of a remote memory buffer */
+    uint32_t                      sn;          /* Sequence number of the current GET operation */
+} UCS_S_PACKED uct_tcp_ep_get_req_hdr_t;
+
+
+/**
+ * TCP GET response header, followed by the requested data
+ */
+typedef struct uct_tcp_ep_get_resp_hdr {
+    uint32_t                      sn;          /* Sequence number of the GET operation,
+                                                * also acknowledges the preceding PUT
+                                                * operations */
+} UCS_S_PACKED uct_tcp_ep_get_resp_hdr_t;
+
+
+/**
+ * TCP GET operation waiting for the response
+ */
+typedef struct uct_tcp_ep_get_completion {
+    uct_completion_t              *comp;           /* User's completion passed to
+                                                    * uct_ep_get_zcopy */
+    void                          *buffer;         /* Where to receive the remaining
+                                                    * part of the data */
+    size_t                        length;          /* Length of the remaining part
+                                                    * of the data */
+    uint32_t                      sn;              /* Sequence number of the GET
+                                                    * operation */
+    ucs_queue_elem_t              elem;            /* Element to insert completion into
+                                                    * TCP EP GET operation queue */
+} uct_tcp_ep_get_completion_t;
+
+
+/**
+ * TCP GET request waiting for TX resources to send the response
+ */
+typedef struct uct_tcp_ep_get_resp {
+    uct_tcp_ep_get_req_hdr_t      req;             /* Received GET request */
+    ucs_queue_elem_t              elem;            /* Element to insert the request into
+                                                    * TCP EP GET response queue */
+} uct_tcp_ep_get_resp_t;
+
+
+/**
+ * TCP MSG_ZEROCOPY completion
+ */
+typedef struct uct_tcp_ep_zcopy_comp {
+    uct_completion_t              *comp;           /* User's completion */
+    void                          *buf;            /* Memory pool element to
+                                                    * release upon completion */
+    uint32_t                      first_sn;        /* Identifier of the first
+                                                    * MSG_ZEROCOPY send */
+    uint32_t                      sn_count;        /* Number of MSG_ZEROCOPY sends
+                                                    * done for the operation */
+    uint32_t                      remaining;       /* Number of sends which were
+                                                    * not notified yet */
+    uint8_t                       flags;           /* Completion flags */
+    ucs_status_t                  status;          /* Completion status, set if
+                                                    * the EP has failed */
+    ucs_queue_elem_t              elem;            /* Element to insert completion into
+                                                    * TCP EP or iface MSG_ZEROCOPY
+                                                    * queue */
+} uct_tcp_ep_zcopy_comp_t;
+
+
+/**
+ * TCP completion of an operation striped across the sockets of a connection
+ */
+typedef struct uct_tcp_ep_stream_comp {
+    uct_completion_t              super;           /* Counts the stripes which
+                                                    * are not completed yet */
+    uct_completion_t              *comp;           /* User's completion */
+} uct_tcp_ep_stream_comp_t;
+
+
 /**
  * TCP endpoint communication context
  */
 typedef struct uct_tcp_ep_ctx {
     uint32_t                      put_sn;         /* Sequence number of last sent
-                                                   * or received PUT operation */
+                                                   * or received PUT/GET operation */
     void                          *buf;           /* Partial send/recv data */
     size_t                        length;         /* How much data in the buffer */
     size_t                        offset;         /* How much data was sent (TX) or was
@@ -272,11 +421,12 @@ typedef struct uct_tcp_ep_ctx {
  * buffer from TCP EP context
  */
 typedef struct uct_tcp_ep_zcopy_tx {
-    uct_tcp_am_hdr_t              super;     /* UCT TCP AM header */
-    uct_completion_t              *comp;     /* Local UCT completion object */
-    size_t                        iov_index; /* Current IOV index */
-    size_t                        iov_cnt;   /* Number of IOVs that should be sent */
-    struct iovec                  iov[0];    /* IOVs that should be sent */
+    uct_tcp_am_hdr_t              super;      /* UCT TCP AM header */
+    uct_completion_t              *comp;      /* Local UCT completion object */
+    uct_tcp_ep_zcopy_comp_t       zcopy_comp; /* MSG_ZEROCOPY completion */
+    size_t                        iov_index;  /* Current IOV index */
+    size_t                        iov_cnt;    /* Number of IOVs that should be sent */
+    struct iovec                  iov[0];     /* IOVs that should be sent */
 } uct_tcp_ep_zcopy_tx_t;
 
 
@@ -310,6 +460,31 @@ struct uct_tcp_ep {
     ucs_queue_head_t              pending_q;        /* Pending operations */
     ucs_queue_head_t              put_comp_q;       /* Flush completions waiting for
                                                      * outstanding PUTs acknowledgment */
+    ucs_queue_head_t              get_comp_q;       /* GET operations waiting for
+                                                     * the response data */
+    ucs_queue_head_t              get_resp_q;       /* Received GET requests waiting
+                                                     * for TX resources to respond */
+    uint32_t                      zcopy_sn;         /* Identifier of the next
+                                                     * MSG_ZEROCOPY send on the socket */
+    ucs_queue_head_t              zcopy_comp_q;     /* Operations and flush completions
+                                                     * waiting for MSG_ZEROCOPY
+                                                     * notifications */
+    struct {
+        void                      *buffer;          /* Where to receive the rest
+                                                     * of AM payload */
+        size_t                    length;           /* Remaining length of AM payload */
+        uct_completion_t          *comp;            /* User's completion to invoke
+                                                     * when AM payload is received */
+    } am_rx_direct;
+    struct {
+        uct_tcp_ep_t              **eps;            /* Auxiliary EPs which carry the
+                                                     * stripes of large RMA operations,
+                                                     * allocated on first use */
+        uct_tcp_ep_t              *main;            /* EP which owns the auxiliary EP */
+        unsigned                  index;            /* Index of the auxiliary EP */
+        ucs_list_link_t           list;             /* Element in the iface list of
+                                                     * EPs which use auxiliary EPs */
+    } stream;
     union {
         ucs_list_link_t           list;             /* List element to insert into TCP EP list */
         ucs_conn_match_elem_t     elem;             /* Connection matching element, used by EPs
@@ -329,22 +504,49 @@ typedef struct uct_tcp_iface {
     ucs_ptr_map_t                 ep_ptr_map;        /* EP PTR map that contains EPs created
                                                       * with CONNECT_TO_EP method */
     ucs_list_link_t               ep_list;           /* List of endpoints */
+    ucs_list_link_t               stream_ep_list;    /* List of endpoints which stripe
+                                                      * operations across auxiliary
+                                                      * sockets */
     char                          if_name[IFNAMSIZ]; /* Network interface name */
     ucs_sys_event_set_t           *event_set;        /* Event set identifier */
     ucs_mpool_t                   tx_mpool;          /* TX memory pool */
     ucs_mpool_t                   rx_mpool;          /* RX memory pool */
+    ucs_queue_head_t              zcopy_comp_q;      /* MSG_ZEROCOPY completions of failed
+                                                      * EPs, which are invoked from
+                                                      * progress */
     size_t                        outstanding;       /* How much data in the EP send buffers
                                                       * + how many non-blocking connections
                                                       * are in progress + how many EPs are
-                                                      * waiting for PUT Zcopy operation ACKs
-                                                      * (0/1 for each EP) */
+                                                      * waiting for PUT/GET Zcopy operation
+                                                      * ACKs (0/1 for each EP) */
     ucs_range_spec_t              port_range;        /** Range of ports to use for bind() */
+    ucs_recursive_spinlock_t      lock;              /* Protects EP list, connection matching
+                                                      * context, EP PTR map and failed
+                                                      * MSG_ZEROCOPY completions of a
+                                                      * multi-threaded iface */
+    ucs_recursive_spinlock_t      progress_lock;     /* Lets only one thread poll the event
+                                                      * set of a multi-threaded iface, and
+                                                      * excludes EP creation/destruction
+                                                      * while polling */
+    ucs_recursive_spinlock_t      ep_locks[UCT_TCP_IFACE_EP_LOCKS_COUNT]; /* Serialize
+                                                      * operations on EPs of a
+                                                      * multi-threaded iface */
 
     struct {
         size_t                    tx_seg_size;       /* TX AM buffer size */
         size_t                    rx_seg_size;       /* RX AM buffer size */
         size_t                    sendv_thresh;      /* Minimum size of user's payload from which
                                                       * non-blocking vector send should be used */
+        size_t                    msg_zcopy_thresh;  /* Minimum size of user's Zcopy payload
+                                                      * from which MSG_ZEROCOPY should be used */
+        size_t                    rx_direct_thresh;  /* Minimum AM length from which the
+                                                      * payload is received to the buffer
+                                                      * provided by the user */
+        unsigned                  num_streams;       /* Number of sockets used by
+                                                      * a connection */
+        size_t                    stripe_thresh;     /* Minimum RMA length from which the
+                                                      * operation is striped across the
+                                                      * sockets of a connection */
         size_t                    max_iov;           /* Maximum supported IOVs limited by
                                                       * user configuration and service buffers
                                                       * (TCP protocol and user's AM headers) */
@@ -357,7 +559,10 @@ typedef struct uct_tcp_iface {
         struct sockaddr_in        netmask;           /* Network address mask */
         int                       prefer_default;    /* Prefer default gateway */
         int                       put_enable;        /* Enable PUT Zcopy operation support */
+        int                       get_enable;        /* Enable GET Zcopy operation support */
         int                       conn_nb;           /* Use non-blocking connect() */
+        int                       thread_safe;       /* The iface is used by a
+                                                      * multi-threaded worker */
         unsigned                  max_poll;          /* Number of events to poll per socket*/
         uint8_t                   max_conn_retries;  /* How many connection establishment attempts
                                                       * should be done if dropped connection was
@@ -394,11 +599,17 @@ typedef struct uct_tcp_iface_config {
     size_t                         rx_seg_size;
     size_t                         max_iov;
     size_t                         sendv_thresh;
+    size_t                         msg_zcopy_thresh;
+    size_t                         rx_direct_thresh;
+    unsigned                       num_streams;
+    size_t                         stripe_thresh;
     int                            prefer_default;
     int                            put_enable;
+    int                            get_enable;
     int                            conn_nb;
     unsigned                       max_poll;
     unsigned                       max_conn_retries;
+    ucs_event_set_backend_t        event_backend;
     int                            sockopt_nodelay;
     uct_tcp_send_recv_buf_config_t sockopt;
     unsigned                       syn_cnt;
@@ -497,6 +708,12 @@ void uct_tcp_ep_mod_events(uct_tcp_ep_t *ep, ucs_event_set_types_t add,
 
 void uct_tcp_ep_pending_queue_dispatch(uct_tcp_ep_t *ep);
 
+unsigned uct_tcp_ep_progress_zcopy_comp(uct_tcp_ep_t *ep);
+
+void uct_tcp_iface_zcopy_comp_failed(uct_tcp_iface_t *iface,
+                                     uct_tcp_ep_zcopy_comp_t *zcopy_comp,
+                                     ucs_status_t status);
+
 ucs_status_t uct_tcp_ep_am_short(uct_ep_h uct_ep, uint8_t am_id, uint64_t header,
                                  const void *payload, unsigned length);
 
@@ -516,6 +733,10 @@ ucs_status_t uct_tcp_ep_put_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
                                   size_t iovcnt, uint64_t remote_addr,
                                   uct_rkey_t rkey, uct_completion_t *comp);
 
+ucs_status_t uct_tcp_ep_get_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
+                                  size_t iovcnt, uint64_t remote_addr,
+                                  uct_rkey_t rkey, uct_completion_t *comp);
+
 ucs_status_t uct_tcp_ep_pending_add(uct_ep_h tl_ep, uct_pending_req_t *req,
                                     unsigned flags);
 
@@ -525,9 +746,58 @@ void uct_tcp_ep_pending_purge(uct_ep_h tl_ep, uct_pending_purge_callback_t cb,
 ucs_status_t uct_tcp_ep_flush(uct_ep_h tl_ep, unsigned flags,
                               uct_completion_t *comp);
 
+ucs_status_t uct_tcp_ep_fence(uct_ep_h tl_ep, unsigned flags);
+
+void uct_tcp_ep_stream_fence(uct_tcp_ep_t *ep);
+
 ucs_status_t
 uct_tcp_ep_check(uct_ep_h tl_ep, unsigned flags, uct_completion_t *comp);
 
+ucs_status_t uct_tcp_ep_am_short_mt(uct_ep_h uct_ep, uint8_t am_id,
+                                    uint64_t header, const void *payload,
+                                    unsigned length);
+
+ucs_status_t uct_tcp_ep_am_short_iov_mt(uct_ep_h uct_ep, uint8_t am_id,
+                                        const uct_iov_t *iov, size_t iovcnt);
+
+ssize_t uct_tcp_ep_am_bcopy_mt(uct_ep_h uct_ep, uint8_t am_id,
+                               uct_pack_callback_t pack_cb, void *arg,
+                               unsigned flags);
+
+ucs_status_t uct_tcp_ep_am_zcopy_mt(uct_ep_h uct_ep, uint8_t am_id,
+                                    const void *header, unsigned header_length,
+                                    const uct_iov_t *iov, size_t iovcnt,
+                                    unsigned flags, uct_completion_t *comp);
+
+ucs_status_t uct_tcp_ep_put_zcopy_mt(uct_ep_h uct_ep, const uct_iov_t *iov,
+                                     size_t iovcnt, uint64_t remote_addr,
+                                     uct_rkey_t rkey, uct_completion_t *comp);
+
+ucs_status_t uct_tcp_ep_get_zcopy_mt(uct_ep_h uct_ep, const uct_iov_t *iov,
+                                     size_t iovcnt, uint64_t remote_addr,
+                                     uct_rkey_t rkey, uct_completion_t *comp);
+
+ucs_status_t uct_tcp_ep_pending_add_mt(uct_ep_h tl_ep, uct_pending_req_t *req,
+                                       unsigned flags);
+
+void uct_tcp_ep_pending_purge_mt(uct_ep_h tl_ep,
+                                 uct_pending_purge_callback_t cb, void *arg);
+
+ucs_status_t uct_tcp_ep_flush_mt(uct_ep_h tl_ep, unsigned flags,
+                                 uct_completion_t *comp);
+
+ucs_status_t
+uct_tcp_ep_check_mt(uct_ep_h tl_ep, unsigned flags, uct_completion_t *comp);
+
+ucs_status_t uct_tcp_ep_create_mt(const uct_ep_params_t *params,
+                                  uct_ep_h *ep_p);
+
+void uct_tcp_ep_destroy_mt(uct_ep_h tl_ep);
+
+ucs_status_t uct_tcp_ep_connect_to_ep_mt(uct_ep_h tl_ep,
+                                         const uct_device_addr_t *dev_addr,
+                                         const uct_ep_addr_t *ep_addr);
+
 ucs_status_t uct_tcp_cm_send_event(uct_tcp_ep_t *ep,
                                    uct_tcp_cm_conn_event_t event,
                                    int log_error);
@@ -567,15 +837,88 @@ ucs_status_t uct_tcp_cm_conn_start(uct_tcp_ep_t *ep);
 
 int uct_tcp_keepalive_is_enabled(uct_tcp_iface_t *iface);
 
+static inline void uct_tcp_iface_lock(uct_tcp_iface_t *iface)
+{
+    if (iface->config.thread_safe) {
+        ucs_recursive_spin_lock(&iface->lock);
+    }
+}
+
+static inline void uct_tcp_iface_unlock(uct_tcp_iface_t *iface)
+{
+    if (iface->config.thread_safe) {
+        ucs_recursive_spin_unlock(&iface->lock);
+    }
+}
+
+static inline ucs_recursive_spinlock_t *
+uct_tcp_ep_lock_get(uct_tcp_iface_t *iface, const uct_tcp_ep_t *ep)
+{
+    return &iface->ep_locks[((uintptr_t)ep / sizeof(*ep)) %
+                            UCT_TCP_IFACE_EP_LOCKS_COUNT];
+}
+
+static inline void uct_tcp_ep_lock(uct_tcp_iface_t *iface,
+                                   const uct_tcp_ep_t *ep)
+{
+    if (iface->config.thread_safe) {
+        ucs_recursive_spin_lock(uct_tcp_ep_lock_get(iface, ep));
+    }
+}
+
+/* Doesn't dereference the EP, which could be destroyed while it was locked */
+static inline void uct_tcp_ep_unlock(uct_tcp_iface_t *iface,
+                                     const uct_tcp_ep_t *ep)
+{
+    if (iface->config.thread_safe) {
+        ucs_recursive_spin_unlock(uct_tcp_ep_lock_get(iface, ep));
+    }
+}
+
+static inline void
+uct_tcp_iface_outstanding_add(uct_tcp_iface_t *iface, size_t value)
+{
+    if (iface->config.thread_safe) {
+        ucs_atomic_add64((volatile uint64_t*)&iface->outstanding, value);
+    } else {
+        iface->outstanding += value;
+    }
+}
+
+static inline void
+uct_tcp_iface_outstanding_sub(uct_tcp_iface_t *iface, size_t value)
+{
+    ucs_assert(iface->outstanding >= value);
+    if (iface->config.thread_safe) {
+        ucs_atomic_sub64((volatile uint64_t*)&iface->outstanding, value);
+    } else {
+        iface->outstanding -= value;
+    }
+}
+
 static inline void uct_tcp_iface_outstanding_inc(uct_tcp_iface_t *iface)
 {
-    iface->outstanding++;
+    uct_tcp_iface_outstanding_add(iface, 1);
 }
 
 static inline void uct_tcp_iface_outstanding_dec(uct_tcp_iface_t *iface)
 {
-    ucs_assert(iface->outstanding > 0);
-    iface->outstanding--;
+    uct_tcp_iface_outstanding_sub(iface, 1);
+}
+
+static inline void
+uct_tcp_iface_zcopy_comp_release(uct_tcp_iface_t *iface,
+                                 uct_tcp_ep_zcopy_comp_t *zcopy_comp)
+{
+    if (zcopy_comp->flags & UCT_TCP_EP_ZCOPY_COMP_FLAG_OP) {
+        uct_tcp_iface_outstanding_dec(iface);
+    }
+
+    /* TX buffer of the operation which is being sent is still owned by the
+     * EP TX context */
+    if (!(zcopy_comp->flags & UCT_TCP_EP_ZCOPY_COMP_FLAG_SENDING)) {
+        ucs_mpool_put_inline(zcopy_comp->buf);
+    }
 }
 
 /**
@@ -197,10 +197,14 @@ ucs_status_t uct_tcp_cm_send_event(uct_tcp_ep_t *ep,
         conn_pkt->event      = UCT_TCP_CM_CONN_REQ;
         conn_pkt->flags      = (ep->flags & UCT_TCP_EP_FLAG_CONNECT_TO_EP) ?
                                UCT_TCP_CM_CONN_REQ_PKT_FLAG_CONNECT_TO_EP : 0;
+        if (ep->flags & UCT_TCP_EP_FLAG_STREAM) {
+            conn_pkt->flags |= UCT_TCP_CM_CONN_REQ_PKT_FLAG_STREAM;
+        }
         conn_pkt->iface_addr = iface->config.ifaddr;
         conn_pkt->cm_id      = ep->cm_id;
         ucs_assert((conn_pkt->flags &
-                    UCT_TCP_CM_CONN_REQ_PKT_FLAG_CONNECT_TO_EP) ||
+                    (UCT_TCP_CM_CONN_REQ_PKT_FLAG_CONNECT_TO_EP |
+                     UCT_TCP_CM_CONN_REQ_PKT_FLAG_STREAM)) ||
                    (ep->cm_id.conn_sn < UCT_TCP_CM_CONN_SN_MAX));
     } else {
         /* CM events (except CONN_REQ) are not sent for EPs connected with
@@ -282,8 +286,10 @@ void uct_tcp_cm_ep_set_conn_sn(uct_tcp_ep_t *ep)
 
     ucs_assert(!(ep->flags & UCT_TCP_EP_FLAG_CONNECT_TO_EP));
 
+    uct_tcp_iface_lock(iface);
     ep->cm_id.conn_sn = ucs_conn_match_get_next_sn(&iface->conn_match_ctx,
                                                    &ep->peer_addr);
+    uct_tcp_iface_unlock(iface);
 }
 
 uct_tcp_ep_t *uct_tcp_cm_get_ep(uct_tcp_iface_t *iface,
@@ -317,8 +323,10 @@ uct_tcp_ep_t *uct_tcp_cm_get_ep(uct_tcp_iface_t *iface,
         remove_from_ctx = 1;
     }
 
+    uct_tcp_iface_lock(iface);
     elem = ucs_conn_match_get_elem(&iface->conn_match_ctx, dest_address,
                                    conn_sn, queue_type, remove_from_ctx);
+    uct_tcp_iface_unlock(iface);
     if (elem == NULL) {
         return NULL;
     }
@@ -356,11 +364,13 @@ void uct_tcp_cm_insert_ep(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep)
     ucs_assert(!(ep->flags & UCT_TCP_EP_FLAG_ON_MATCH_CTX));
     ucs_assert(!(ep->flags & UCT_TCP_EP_FLAG_CONNECT_TO_EP));
 
+    uct_tcp_iface_lock(iface);
     ucs_conn_match_insert(&iface->conn_match_ctx, &ep->peer_addr,
                           ep->cm_id.conn_sn, &ep->elem,
                           (ctx_caps & UCT_TCP_EP_FLAG_CTX_TYPE_TX) ?
                           UCS_CONN_MATCH_QUEUE_EXP :
                           UCS_CONN_MATCH_QUEUE_UNEXP);
+    uct_tcp_iface_unlock(iface);
 
     ep->flags |= UCT_TCP_EP_FLAG_ON_MATCH_CTX;
 }
@@ -374,10 +384,12 @@ void uct_tcp_cm_remove_ep(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep)
     ucs_assert(ep->flags & UCT_TCP_EP_FLAG_ON_MATCH_CTX);
     ucs_assert(!(ep->flags & UCT_TCP_EP_FLAG_CONNECT_TO_EP));
 
+    uct_tcp_iface_lock(iface);
     ucs_conn_match_remove_elem(&iface->conn_match_ctx, &ep->elem,
                                (ctx_caps & UCT_TCP_EP_FLAG_CTX_TYPE_TX) ?
                                UCS_CONN_MATCH_QUEUE_EXP :
                                UCS_CONN_MATCH_QUEUE_UNEXP);
+    uct_tcp_iface_unlock(iface);
 
     ep->flags &= ~UCT_TCP_EP_FLAG_ON_MATCH_CTX;
 }
@@ -537,6 +549,9 @@ uct_tcp_cm_handle_conn_req(uct_tcp_ep_t **ep_p,
         if (cm_req_pkt->flags & UCT_TCP_CM_CONN_REQ_PKT_FLAG_CONNECT_TO_EP) {
             ep->flags |= UCT_TCP_EP_FLAG_CONNECT_TO_EP;
         }
+        if (cm_req_pkt->flags & UCT_TCP_CM_CONN_REQ_PKT_FLAG_STREAM) {
+            ep->flags |= UCT_TCP_EP_FLAG_STREAM;
+        }
     }
 
     uct_tcp_cm_trace_conn_pkt(ep, UCS_LOG_LEVEL_TRACE,
@@ -551,6 +566,14 @@ uct_tcp_cm_handle_conn_req(uct_tcp_ep_t **ep_p,
     ucs_assertv(!(ep->flags & UCT_TCP_EP_FLAG_CTX_TYPE_TX),
                 "ep %p mustn't have TX cap", ep);
 
+    if (ep->flags & UCT_TCP_EP_FLAG_STREAM) {
+        /* The auxiliary socket only receives the stripes of RMA operations
+         * and responds to them, so it is not matched with any EP and the
+         * peer doesn't wait for an acknowledgment */
+        uct_tcp_cm_change_conn_state(ep, UCT_TCP_EP_CONN_STATE_CONNECTED);
+        return 1;
+    }
+
     connect_to_self = uct_tcp_ep_is_self(ep);
     if (connect_to_self) {
         goto accept_conn;
@@ -561,7 +584,10 @@ uct_tcp_cm_handle_conn_req(uct_tcp_ep_t **ep_p,
                                     cm_req_pkt->cm_id.conn_sn,
                                     UCT_TCP_EP_FLAG_CTX_TYPE_TX);
         if (peer_ep != NULL) {
+            /* The peer EP may be used for sending by other threads */
+            uct_tcp_ep_lock(iface, peer_ep);
             progress_count = uct_tcp_cm_handle_simult_conn(iface, ep, peer_ep);
+            uct_tcp_ep_unlock(iface, peer_ep);
             ucs_assert(!(ep->flags & UCT_TCP_EP_FLAG_CTX_TYPE_TX));
             goto out_destroy_ep;
         }
@@ -574,6 +600,7 @@ uct_tcp_cm_handle_conn_req(uct_tcp_ep_t **ep_p,
             goto out_destroy_ep;
         }
 
+        uct_tcp_ep_lock(iface, peer_ep);
         peer_ep->peer_addr = ep->peer_addr;
         peer_ep->conn_retries++;
         uct_tcp_ep_add_ctx_cap(peer_ep, UCT_TCP_EP_FLAG_CTX_TYPE_TX);
@@ -581,6 +608,7 @@ uct_tcp_cm_handle_conn_req(uct_tcp_ep_t **ep_p,
         uct_tcp_ep_replace_ep(peer_ep, ep);
         uct_tcp_cm_change_conn_state(peer_ep,
                                      UCT_TCP_EP_CONN_STATE_CONNECTED);
+        uct_tcp_ep_unlock(iface, peer_ep);
         goto out_destroy_ep;
     }
 
@@ -663,7 +691,7 @@ static void uct_tcp_cm_conn_complete(uct_tcp_ep_t *ep)
         return;
     }
 
-    if (ep->flags & UCT_TCP_EP_FLAG_CONNECT_TO_EP) {
+    if (ep->flags & (UCT_TCP_EP_FLAG_CONNECT_TO_EP | UCT_TCP_EP_FLAG_STREAM)) {
         uct_tcp_cm_change_conn_state(ep, UCT_TCP_EP_CONN_STATE_CONNECTED);
     } else {
         uct_tcp_cm_change_conn_state(ep, UCT_TCP_EP_CONN_STATE_WAITING_ACK);
@@ -16,6 +16,7 @@
 /* Forward declarations */
 static unsigned uct_tcp_ep_progress_data_tx(void *arg);
 static unsigned uct_tcp_ep_progress_data_rx(void *arg);
+static unsigned uct_tcp_ep_progress_moved_rx(void *arg);
 static unsigned uct_tcp_ep_progress_magic_number_rx(void *arg);
 static unsigned uct_tcp_ep_destroy_progress(void *arg);
 
@@ -92,6 +93,18 @@ static inline ucs_status_t uct_tcp_ep_check_tx_res(uct_tcp_ep_t *ep)
     return UCS_ERR_NO_RESOURCE;
 }
 
+/* Operations posted after a fence wait until the stripes of the preceding
+ * operations are acknowledged on all sockets of the connection */
+static UCS_F_ALWAYS_INLINE ucs_status_t uct_tcp_ep_check_fence(uct_tcp_ep_t *ep)
+{
+    if (ucs_likely(!(ep->flags & UCT_TCP_EP_FLAG_STREAM_FENCE))) {
+        return UCS_OK;
+    }
+
+    UCS_STATS_UPDATE_COUNTER(ep->super.stats, UCT_EP_STAT_NO_RES, 1);
+    return UCS_ERR_NO_RESOURCE;
+}
+
 static inline void uct_tcp_ep_ctx_rewind(uct_tcp_ep_ctx_t *ctx)
 {
     ctx->offset = 0;
@@ -112,6 +125,17 @@ static inline void uct_tcp_ep_ctx_reset(uct_tcp_ep_ctx_t *ctx)
     uct_tcp_ep_ctx_rewind(ctx);
 }
 
+static void uct_tcp_ep_am_rx_direct_cancel(uct_tcp_ep_t *ep,
+                                           ucs_status_t status)
+{
+    if (!(ep->flags & UCT_TCP_EP_FLAG_AM_RX_DIRECT)) {
+        return;
+    }
+
+    ep->flags &= ~UCT_TCP_EP_FLAG_AM_RX_DIRECT;
+    uct_invoke_completion(ep->am_rx_direct.comp, status);
+}
+
 static void uct_tcp_ep_addr_cleanup(struct sockaddr_in *sock_addr)
 {
     memset(sock_addr, 0, sizeof(*sock_addr));
@@ -135,6 +159,100 @@ int uct_tcp_ep_is_self(const uct_tcp_ep_t *ep)
     return uct_tcp_iface_is_self_addr(iface, &ep->peer_addr);
 }
 
+static void uct_tcp_ep_stream_comp_func(uct_completion_t *self)
+{
+    uct_tcp_ep_stream_comp_t *stream_comp = ucs_derived_of(self,
+                                                           uct_tcp_ep_stream_comp_t);
+    uct_completion_t *comp                = stream_comp->comp;
+    ucs_status_t status                   = self->status;
+
+    ucs_mpool_put_inline(stream_comp);
+    uct_invoke_completion(comp, status);
+}
+
+static uct_completion_t *
+uct_tcp_ep_stream_comp_create(uct_tcp_iface_t *iface, uct_completion_t *comp)
+{
+    uct_tcp_ep_stream_comp_t *stream_comp;
+
+    stream_comp = ucs_mpool_get_inline(&iface->tx_mpool);
+    if (ucs_unlikely(stream_comp == NULL)) {
+        return NULL;
+    }
+
+    /* The initial reference is held while the stripes are posted */
+    stream_comp->super.func   = uct_tcp_ep_stream_comp_func;
+    stream_comp->super.count  = 1;
+    stream_comp->super.status = UCS_OK;
+    stream_comp->comp         = comp;
+    return &stream_comp->super;
+}
+
+/* Release the reference held while the stripes are posted, returns the
+ * status of the operation if all the stripes were completed */
+static ucs_status_t uct_tcp_ep_stream_comp_release(uct_completion_t *self)
+{
+    ucs_status_t status = self->status;
+
+    if (--self->count != 0) {
+        return UCS_INPROGRESS;
+    }
+
+    ucs_mpool_put_inline(ucs_derived_of(self, uct_tcp_ep_stream_comp_t));
+    return status;
+}
+
+/* Drop the stripe of a destroyed EP without notifying the user */
+static void uct_tcp_ep_stream_comp_drop(uct_completion_t *comp)
+{
+    if ((comp == NULL) || (comp->func != uct_tcp_ep_stream_comp_func)) {
+        return;
+    }
+
+    ucs_assert(comp->count > 0);
+    if (--comp->count == 0) {
+        ucs_mpool_put_inline(ucs_derived_of(comp, uct_tcp_ep_stream_comp_t));
+    }
+}
+
+static void uct_tcp_ep_stream_destroy_eps(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_ep_t *stream_ep;
+    unsigned i;
+
+    for (i = 0; i < (iface->config.num_streams - 1); ++i) {
+        stream_ep = ep->stream.eps[i];
+        if (stream_ep != NULL) {
+            stream_ep->stream.main = NULL;
+            ep->stream.eps[i]      = NULL;
+            uct_tcp_ep_destroy_internal(&stream_ep->super.super);
+        }
+    }
+}
+
+static void uct_tcp_ep_stream_cleanup(uct_tcp_ep_t *ep)
+{
+    if (ep->stream.main != NULL) {
+        /* The auxiliary EP is destroyed before the EP which owns it, e.g.
+         * during the iface cleanup */
+        ucs_assert(ep->stream.main->stream.eps[ep->stream.index] == ep);
+        ep->stream.main->stream.eps[ep->stream.index] = NULL;
+        ep->stream.main                               = NULL;
+        return;
+    }
+
+    if (ep->stream.eps == NULL) {
+        return;
+    }
+
+    uct_tcp_ep_stream_destroy_eps(ep);
+    ucs_list_del(&ep->stream.list);
+    ucs_free(ep->stream.eps);
+    ep->stream.eps = NULL;
+}
+
 static void uct_tcp_ep_cleanup(uct_tcp_ep_t *ep)
 {
     if (ep->tx.buf != NULL) {
@@ -169,8 +287,10 @@ static void uct_tcp_ep_ptr_map_add(uct_tcp_ep_t *ep)
 
     uct_tcp_ep_ptr_map_verify(ep, 0);
 
+    uct_tcp_iface_lock(iface);
     status = ucs_ptr_map_put(&iface->ep_ptr_map, ep, 1,
                              &ep->cm_id.ptr_map_key);
+    uct_tcp_iface_unlock(iface);
     ucs_assert_always(status == UCS_OK);
 
     ep->flags |= UCT_TCP_EP_FLAG_ON_PTR_MAP;
@@ -188,7 +308,9 @@ static void uct_tcp_ep_ptr_map_del(uct_tcp_ep_t *ep)
                                             uct_tcp_iface_t);
     ucs_status_t status;
 
+    uct_tcp_iface_lock(iface);
     status = ucs_ptr_map_del(&iface->ep_ptr_map, ep->cm_id.ptr_map_key);
+    uct_tcp_iface_unlock(iface);
     ucs_assert_always(status == UCS_OK);
     uct_tcp_ep_ptr_map_removed(ep);
 }
@@ -200,7 +322,9 @@ uct_tcp_ep_ptr_map_get(uct_tcp_iface_t *iface, ucs_ptr_map_key_t ptr_map_key)
     uct_tcp_ep_t *ep;
     void *ptr;
 
+    uct_tcp_iface_lock(iface);
     status = ucs_ptr_map_get(&iface->ep_ptr_map, ptr_map_key, 0, &ptr);
+    uct_tcp_iface_unlock(iface);
     if (ucs_likely(status == UCS_OK)) {
         ep = ptr;
         uct_tcp_ep_ptr_map_verify(ep, 1);
@@ -217,7 +341,9 @@ uct_tcp_ep_t *uct_tcp_ep_ptr_map_retrieve(uct_tcp_iface_t *iface,
     uct_tcp_ep_t *ep;
     void *ptr;
 
+    uct_tcp_iface_lock(iface);
     status = ucs_ptr_map_get(&iface->ep_ptr_map, ptr_map_key, 1, &ptr);
+    uct_tcp_iface_unlock(iface);
     if (ucs_likely(status == UCS_OK)) {
         ep = ptr;
         uct_tcp_ep_ptr_map_removed(ep);
@@ -248,6 +374,16 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_ep_t, uct_tcp_iface_t *iface,
     ucs_list_head_init(&self->list);
     ucs_queue_head_init(&self->pending_q);
     ucs_queue_head_init(&self->put_comp_q);
+    ucs_queue_head_init(&self->get_comp_q);
+    ucs_queue_head_init(&self->get_resp_q);
+    ucs_queue_head_init(&self->zcopy_comp_q);
+    self->zcopy_sn            = 0;
+    self->am_rx_direct.buffer = NULL;
+    self->am_rx_direct.length = 0;
+    self->am_rx_direct.comp   = NULL;
+    self->stream.eps          = NULL;
+    self->stream.main         = NULL;
+    self->stream.index        = 0;
 
     if (self->fd != -1) /* EP is created during accepting a connection */ {
         self->conn_retries++;
@@ -321,7 +457,7 @@ uct_tcp_ep_progress_rx_remove_filter(const ucs_callbackq_elem_t *elem,
 {
     uct_tcp_ep_t *ep = (uct_tcp_ep_t*)arg;
 
-    return (elem->cb == uct_tcp_ep_progress_data_rx) && (elem->arg == ep);
+    return (elem->cb == uct_tcp_ep_progress_moved_rx) && (elem->arg == ep);
 }
 
 static UCS_CLASS_CLEANUP_FUNC(uct_tcp_ep_t)
@@ -329,6 +465,11 @@ static UCS_CLASS_CLEANUP_FUNC(uct_tcp_ep_t)
     uct_tcp_iface_t *iface = ucs_derived_of(self->super.super.iface,
                                             uct_tcp_iface_t);
     uct_tcp_ep_put_completion_t *put_comp;
+    uct_tcp_ep_get_completion_t *get_comp;
+    uct_tcp_ep_get_resp_t *get_resp;
+    uct_tcp_ep_zcopy_comp_t *zcopy_comp;
+
+    uct_tcp_ep_stream_cleanup(self);
 
     if (self->flags & UCT_TCP_EP_FLAG_ON_MATCH_CTX) {
         uct_tcp_cm_remove_ep(iface, self);
@@ -343,7 +484,23 @@ static UCS_CLASS_CLEANUP_FUNC(uct_tcp_ep_t)
     uct_tcp_ep_remove_ctx_cap(self, UCT_TCP_EP_CTX_CAPS);
 
     ucs_queue_for_each_extract(put_comp, &self->put_comp_q, elem, 1) {
-        ucs_free(put_comp);
+        uct_tcp_ep_stream_comp_drop(put_comp->comp);
+        ucs_mpool_put_inline(put_comp);
+    }
+
+    ucs_queue_for_each_extract(get_comp, &self->get_comp_q, elem, 1) {
+        uct_tcp_ep_stream_comp_drop(get_comp->comp);
+        ucs_mpool_put_inline(get_comp);
+    }
+
+    ucs_queue_for_each_extract(get_resp, &self->get_resp_q, elem, 1) {
+        ucs_mpool_put_inline(get_resp);
+    }
+
+    uct_tcp_ep_am_rx_direct_cancel(self, UCS_ERR_CANCELED);
+
+    ucs_queue_for_each_extract(zcopy_comp, &self->zcopy_comp_q, elem, 1) {
+        uct_tcp_iface_zcopy_comp_release(iface, zcopy_comp);
     }
 
     if (self->flags & UCT_TCP_EP_FLAG_FAILED) {
@@ -395,13 +552,25 @@ void uct_tcp_ep_destroy(uct_ep_h tl_ep)
 
 static unsigned uct_tcp_ep_destroy_progress(void *arg)
 {
-    uct_tcp_ep_t *ep = (uct_tcp_ep_t*)arg;
+    uct_tcp_ep_t *ep       = (uct_tcp_ep_t*)arg;
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
 
     ucs_assert(!(ep->flags & UCT_TCP_EP_FLAG_CTX_TYPE_TX));
     ucs_assert(ep->flags & UCT_TCP_EP_FLAG_FAILED);
+
+    if (iface->config.thread_safe) {
+        ucs_recursive_spin_lock(&iface->progress_lock);
+    }
+
     /* Reset FAILED flag to not remove callback in the EP destructor */
     ep->flags &= ~UCT_TCP_EP_FLAG_FAILED;
     uct_tcp_ep_destroy_internal(&ep->super.super);
+
+    if (iface->config.thread_safe) {
+        ucs_recursive_spin_unlock(&iface->progress_lock);
+    }
+
     return 1;
 }
 
@@ -415,6 +584,17 @@ void uct_tcp_ep_set_failed(uct_tcp_ep_t *ep)
         return;
     }
 
+    if (ep->stream.main != NULL) {
+        /* Stripes of the operations can't be delivered anymore, so the
+         * failure of an auxiliary socket fails the whole connection */
+        uct_tcp_ep_mod_events(ep, 0, ep->events);
+        uct_tcp_cm_change_conn_state(ep, UCT_TCP_EP_CONN_STATE_CLOSED);
+        if (ep->stream.main->conn_state != UCT_TCP_EP_CONN_STATE_CLOSED) {
+            uct_tcp_ep_set_failed(ep->stream.main);
+        }
+        return;
+    }
+
     if (ep->flags & UCT_TCP_EP_FLAG_ON_MATCH_CTX) {
         uct_tcp_cm_remove_ep(iface, ep);
         uct_tcp_iface_add_ep(ep);
@@ -425,6 +605,8 @@ void uct_tcp_ep_set_failed(uct_tcp_ep_t *ep)
     if (ep->flags & UCT_TCP_EP_FLAG_CTX_TYPE_TX) {
         ucs_debug("tcp_ep %p: calling error handler (flags: %x)", ep,
                   ep->flags);
+        /* Let the operations fail instead of waiting for the fence */
+        ep->flags &= ~UCT_TCP_EP_FLAG_STREAM_FENCE;
         uct_tcp_cm_change_conn_state(ep, UCT_TCP_EP_CONN_STATE_CLOSED);
         uct_iface_handle_ep_err(ep->super.super.iface, &ep->super.super,
                                 UCS_ERR_ENDPOINT_TIMEOUT);
@@ -560,16 +742,28 @@ void uct_tcp_ep_replace_ep(uct_tcp_ep_t *to_ep, uct_tcp_ep_t *from_ep)
 
     ucs_queue_splice(&to_ep->pending_q, &from_ep->pending_q);
     ucs_queue_splice(&to_ep->put_comp_q, &from_ep->put_comp_q);
+    ucs_queue_splice(&to_ep->get_comp_q, &from_ep->get_comp_q);
+    ucs_queue_splice(&to_ep->get_resp_q, &from_ep->get_resp_q);
+
+    /* MSG_ZEROCOPY notification identifiers belong to the socket */
+    ucs_queue_splice(&to_ep->zcopy_comp_q, &from_ep->zcopy_comp_q);
+    to_ep->zcopy_sn = from_ep->zcopy_sn;
+
+    to_ep->am_rx_direct = from_ep->am_rx_direct;
+    from_ep->flags      &= ~UCT_TCP_EP_FLAG_AM_RX_DIRECT;
 
     to_ep->flags |= from_ep->flags & (UCT_TCP_EP_FLAG_ZCOPY_TX           |
+                                      UCT_TCP_EP_FLAG_ZCOPY_MSG_TX       |
                                       UCT_TCP_EP_FLAG_PUT_RX             |
+                                      UCT_TCP_EP_FLAG_GET_RX             |
+                                      UCT_TCP_EP_FLAG_AM_RX_DIRECT       |
                                       UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK |
                                       UCT_TCP_EP_FLAG_PUT_RX_SENDING_ACK);
 
     if (uct_tcp_ep_ctx_buf_need_progress(&to_ep->rx)) {
         /* If some data was already read, we have to process it */
         uct_worker_progress_register_safe(&iface->super.worker->super,
-                                          uct_tcp_ep_progress_data_rx, to_ep,
+                                          uct_tcp_ep_progress_moved_rx, to_ep,
                                           UCS_CALLBACKQ_FLAG_ONESHOT, &cb_id);
     }
 
@@ -804,37 +998,237 @@ void uct_tcp_ep_mod_events(uct_tcp_ep_t *ep, ucs_event_set_types_t add,
     }
 }
 
-static inline void uct_tcp_ep_handle_put_ack(uct_tcp_ep_t *ep,
-                                             uct_tcp_ep_put_ack_hdr_t *put_ack)
+static void uct_tcp_ep_zcopy_comp_purge(uct_tcp_ep_t *ep, ucs_status_t status)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_ep_zcopy_comp_t *zcopy_comp;
+
+    ucs_queue_for_each_extract(zcopy_comp, &ep->zcopy_comp_q, elem, 1) {
+        if (zcopy_comp->flags & UCT_TCP_EP_ZCOPY_COMP_FLAG_SENDING) {
+            /* The operation which is being sent is completed together with
+             * the EP TX context */
+            uct_tcp_iface_zcopy_comp_release(iface, zcopy_comp);
+        } else {
+            /* Can't invoke the completion here, since the EP may be failed
+             * from a send operation of the same user's request */
+            uct_tcp_iface_zcopy_comp_failed(iface, zcopy_comp, status);
+        }
+    }
+
+    ep->flags &= ~UCT_TCP_EP_FLAG_ZCOPY_MSG_TX;
+}
+
+static void uct_tcp_ep_zcopy_comp_dispatch(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_ep_zcopy_comp_t *zcopy_comp;
+
+    /* Complete operations in the order they were posted */
+    ucs_queue_for_each_extract(zcopy_comp, &ep->zcopy_comp_q, elem,
+                               !(zcopy_comp->flags &
+                                 UCT_TCP_EP_ZCOPY_COMP_FLAG_SENDING) &&
+                               (zcopy_comp->remaining == 0)) {
+        if (zcopy_comp->comp != NULL) {
+            uct_invoke_completion(zcopy_comp->comp, UCS_OK);
+        }
+        uct_tcp_iface_zcopy_comp_release(iface, zcopy_comp);
+    }
+
+    if (ucs_queue_is_empty(&ep->zcopy_comp_q)) {
+        uct_tcp_ep_mod_events(ep, 0, UCS_EVENT_SET_EVERR);
+    }
+}
+
+static void uct_tcp_ep_zcopy_comp_notify(uct_tcp_ep_t *ep, uint32_t first_sn,
+                                         uint32_t last_sn)
+{
+    uct_tcp_ep_zcopy_comp_t *zcopy_comp;
+    uint32_t comp_last_sn, start_sn, end_sn;
+
+    /* Notifications may cover sends of several operations and may arrive
+     * out of order, so account the intersection with every operation */
+    ucs_queue_for_each(zcopy_comp, &ep->zcopy_comp_q, elem) {
+        if (zcopy_comp->sn_count == 0) {
+            continue;
+        }
+
+        comp_last_sn = zcopy_comp->first_sn + zcopy_comp->sn_count - 1;
+        start_sn     = UCS_CIRCULAR_COMPARE32(first_sn, >,
+                                              zcopy_comp->first_sn) ?
+                       first_sn : zcopy_comp->first_sn;
+        end_sn       = UCS_CIRCULAR_COMPARE32(last_sn, <, comp_last_sn) ?
+                       last_sn : comp_last_sn;
+        if (UCS_CIRCULAR_COMPARE32(start_sn, <=, end_sn)) {
+            ucs_assertv(zcopy_comp->remaining >= (end_sn - start_sn + 1),
+                        "ep=%p remaining=%u notified=%u..%u", ep,
+                        zcopy_comp->remaining, start_sn, end_sn);
+            zcopy_comp->remaining -= end_sn - start_sn + 1;
+        }
+    }
+}
+
+unsigned uct_tcp_ep_progress_zcopy_comp(uct_tcp_ep_t *ep)
+{
+    unsigned count = 0;
+    uint32_t first_sn, last_sn;
+    int copied;
+
+    if (ucs_queue_is_empty(&ep->zcopy_comp_q)) {
+        /* Socket errors are detected by RX/TX progress */
+        return 0;
+    }
+
+    while (ucs_socket_zcopy_comp_nb(ep->fd, &first_sn, &last_sn,
+                                    &copied) == UCS_OK) {
+        ucs_trace_data("tcp_ep %p: MSG_ZEROCOPY sends %u..%u completed%s", ep,
+                       first_sn, last_sn, copied ? " (copied)" : "");
+        uct_tcp_ep_zcopy_comp_notify(ep, first_sn, last_sn);
+        count++;
+    }
+
+    uct_tcp_ep_zcopy_comp_dispatch(ep);
+    return count;
+}
+
+/* Add the completion which is invoked when all operations posted before
+ * are notified by MSG_ZEROCOPY */
+static ucs_status_t
+uct_tcp_ep_zcopy_comp_add(uct_tcp_ep_t *ep, uct_completion_t *comp)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_ep_zcopy_comp_t *zcopy_comp;
+
+    if (comp == NULL) {
+        return UCS_OK;
+    }
+
+    zcopy_comp = ucs_mpool_get_inline(&iface->tx_mpool);
+    if (ucs_unlikely(zcopy_comp == NULL)) {
+        ucs_error("tcp_ep %p: unable to allocate MSG_ZEROCOPY completion "
+                  "from mpool", ep);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    zcopy_comp->comp      = comp;
+    zcopy_comp->buf       = zcopy_comp;
+    zcopy_comp->first_sn  = ep->zcopy_sn;
+    zcopy_comp->sn_count  = 0;
+    zcopy_comp->remaining = 0;
+    zcopy_comp->flags     = 0;
+    zcopy_comp->status    = UCS_OK;
+    ucs_queue_push(&ep->zcopy_comp_q, &zcopy_comp->elem);
+
+    return UCS_OK;
+}
+
+static int uct_tcp_ep_stream_is_busy(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_ep_t *stream_ep;
+    unsigned i;
+
+    if (ep->flags & UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK) {
+        return 1;
+    }
+
+    for (i = 0; i < (iface->config.num_streams - 1); ++i) {
+        stream_ep = ep->stream.eps[i];
+        if ((stream_ep != NULL) &&
+            (stream_ep->flags & UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK)) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+void uct_tcp_ep_stream_fence(uct_tcp_ep_t *ep)
+{
+    if ((ep->stream.eps != NULL) && uct_tcp_ep_stream_is_busy(ep)) {
+        ep->flags |= UCT_TCP_EP_FLAG_STREAM_FENCE;
+    }
+}
+
+/* Resume the operations of the connection which waited for the fence, if no
+ * more operations are in flight on its sockets */
+static void uct_tcp_ep_stream_fence_release(uct_tcp_ep_t *ep)
+{
+    uct_tcp_ep_t *main_ep = (ep->stream.main != NULL) ? ep->stream.main : ep;
+
+    if (ucs_likely(!(main_ep->flags & UCT_TCP_EP_FLAG_STREAM_FENCE)) ||
+        uct_tcp_ep_stream_is_busy(main_ep)) {
+        return;
+    }
+
+    main_ep->flags &= ~UCT_TCP_EP_FLAG_STREAM_FENCE;
+    if (main_ep->conn_state == UCT_TCP_EP_CONN_STATE_CONNECTED) {
+        uct_tcp_ep_pending_queue_dispatch(main_ep);
+    }
+}
+
+/* Complete the flush operations waiting for the PUT/GET operations with
+ * sequence numbers up to ack_sn */
+static inline void uct_tcp_ep_handle_put_ack(uct_tcp_ep_t *ep, uint32_t ack_sn)
 {
     uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
                                             uct_tcp_iface_t);
     uct_tcp_ep_put_completion_t *put_comp;
+    ucs_status_t status;
 
-    if (put_ack->sn == ep->tx.put_sn) {
+    if (ack_sn == ep->tx.put_sn) {
         /* Since there are no other PUT operations in-flight, can remove flag
          * and decrement iface outstanding operations counter */
         ucs_assert(ep->flags & UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK);
         ep->flags &= ~UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK;
         uct_tcp_iface_outstanding_dec(iface);
+        uct_tcp_ep_stream_fence_release(ep);
     }
 
     ucs_queue_for_each_extract(put_comp, &ep->put_comp_q, elem,
                                (UCS_CIRCULAR_COMPARE32(put_comp->wait_put_sn,
-                                                       <=, put_ack->sn))) {
-        uct_invoke_completion(put_comp->comp, UCS_OK);
+                                                       <=, ack_sn))) {
+        if (ucs_queue_is_empty(&ep->zcopy_comp_q)) {
+            uct_invoke_completion(put_comp->comp, UCS_OK);
+        } else {
+            /* The kernel may still reference PUT payload sent with
+             * MSG_ZEROCOPY, complete after the preceding operations */
+            status = uct_tcp_ep_zcopy_comp_add(ep, put_comp->comp);
+            if (status != UCS_OK) {
+                uct_invoke_completion(put_comp->comp, status);
+            }
+        }
         ucs_mpool_put_inline(put_comp);
     }
 }
 
+static void uct_tcp_ep_get_comp_purge(uct_tcp_ep_t *ep, ucs_status_t status)
+{
+    uct_tcp_ep_get_completion_t *get_comp;
+
+    ucs_queue_for_each_extract(get_comp, &ep->get_comp_q, elem, 1) {
+        if (get_comp->comp != NULL) {
+            uct_invoke_completion(get_comp->comp, status);
+        }
+        ucs_mpool_put_inline(get_comp);
+    }
+
+    ep->flags &= ~UCT_TCP_EP_FLAG_GET_RX;
+}
+
 void uct_tcp_ep_pending_queue_dispatch(uct_tcp_ep_t *ep)
 {
     uct_pending_req_priv_queue_t *priv;
 
     uct_pending_queue_dispatch(priv, &ep->pending_q,
-                               uct_tcp_ep_ctx_buf_empty(&ep->tx));
+                               uct_tcp_ep_ctx_buf_empty(&ep->tx) &&
+                               !(ep->flags & UCT_TCP_EP_FLAG_STREAM_FENCE));
     if (uct_tcp_ep_ctx_buf_empty(&ep->tx)) {
-        ucs_assert(ucs_queue_is_empty(&ep->pending_q));
+        ucs_assert(ucs_queue_is_empty(&ep->pending_q) ||
+                   (ep->flags & UCT_TCP_EP_FLAG_STREAM_FENCE));
         uct_tcp_ep_mod_events(ep, 0, UCS_EVENT_SET_EVWRITE);
     }
 }
@@ -845,8 +1239,8 @@ uct_tcp_ep_tx_started(uct_tcp_ep_t *ep, const uct_tcp_am_hdr_t *hdr)
     uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
                                             uct_tcp_iface_t);
 
-    ep->tx.length      += sizeof(*hdr) + hdr->length;
-    iface->outstanding += ep->tx.length;
+    ep->tx.length += sizeof(*hdr) + hdr->length;
+    uct_tcp_iface_outstanding_add(iface, ep->tx.length);
 }
 
 static UCS_F_ALWAYS_INLINE void
@@ -855,8 +1249,8 @@ uct_tcp_ep_tx_completed(uct_tcp_ep_t *ep, size_t sent_length)
     uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
                                             uct_tcp_iface_t);
 
-    iface->outstanding -= sent_length;
-    ep->tx.offset      += sent_length;
+    uct_tcp_iface_outstanding_sub(iface, sent_length);
+    ep->tx.offset += sent_length;
 }
 
 static UCS_F_ALWAYS_INLINE void
@@ -877,6 +1271,9 @@ static void uct_tcp_ep_handle_disconnected(uct_tcp_ep_t *ep, ucs_status_t status
 
     ucs_debug("tcp_ep %p: remote disconnected", ep);
 
+    /* AM payload will not be received anymore */
+    uct_tcp_ep_am_rx_direct_cancel(ep, status);
+
     if (ep->flags & UCT_TCP_EP_FLAG_CTX_TYPE_TX) {
         if (ep->flags & UCT_TCP_EP_FLAG_CTX_TYPE_RX) {
             uct_tcp_ep_remove_ctx_cap(ep, UCT_TCP_EP_FLAG_CTX_TYPE_RX);
@@ -897,6 +1294,12 @@ static void uct_tcp_ep_handle_disconnected(uct_tcp_ep_t *ep, ucs_status_t status
             ep->flags &= ~UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK;
         }
 
+        /* GET responses will not be received anymore */
+        uct_tcp_ep_get_comp_purge(ep, status);
+
+        /* MSG_ZEROCOPY notifications will not be read anymore */
+        uct_tcp_ep_zcopy_comp_purge(ep, status);
+
         uct_tcp_ep_tx_completed(ep, ep->tx.length - ep->tx.offset);
     }
 
@@ -956,6 +1359,33 @@ static inline ssize_t uct_tcp_ep_send(uct_tcp_ep_t *ep)
     return sent_length;
 }
 
+static UCS_F_ALWAYS_INLINE ucs_status_t
+uct_tcp_ep_sendv_iov(uct_tcp_ep_t *ep, struct iovec *iov, size_t iov_cnt,
+                     size_t *sent_length_p)
+{
+    uct_tcp_ep_zcopy_tx_t *ctx;
+    ucs_status_t status;
+
+    if (ucs_likely(!(ep->flags & UCT_TCP_EP_FLAG_ZCOPY_MSG_TX))) {
+        return ucs_socket_sendv_nb(ep->fd, iov, iov_cnt, sent_length_p);
+    }
+
+    status = ucs_socket_sendv_zcopy_nb(ep->fd, iov, iov_cnt, sent_length_p);
+    if (ucs_likely(status == UCS_OK)) {
+        /* Each MSG_ZEROCOPY send which queued data gets the next
+         * notification identifier */
+        ctx = (uct_tcp_ep_zcopy_tx_t*)ep->tx.buf;
+        ctx->zcopy_comp.sn_count++;
+        ctx->zcopy_comp.remaining++;
+        ep->zcopy_sn++;
+    } else if (status == UCS_ERR_NO_MEMORY) {
+        /* Too many notifications were not read yet, copy the data */
+        status = ucs_socket_sendv_nb(ep->fd, iov, iov_cnt, sent_length_p);
+    }
+
+    return status;
+}
+
 static inline ssize_t uct_tcp_ep_sendv(uct_tcp_ep_t *ep)
 {
     uct_tcp_ep_zcopy_tx_t *ctx = (uct_tcp_ep_zcopy_tx_t*)ep->tx.buf;
@@ -965,8 +1395,8 @@ static inline ssize_t uct_tcp_ep_sendv(uct_tcp_ep_t *ep)
     ucs_assertv((ep->tx.offset < ep->tx.length) &&
                 (ctx->iov_cnt > 0), "ep=%p", ep);
 
-    status = ucs_socket_sendv_nb(ep->fd, &ctx->iov[ctx->iov_index],
-                                 ctx->iov_cnt - ctx->iov_index, &sent_length);
+    status = uct_tcp_ep_sendv_iov(ep, &ctx->iov[ctx->iov_index],
+                                  ctx->iov_cnt - ctx->iov_index, &sent_length);
     if (ucs_unlikely(status != UCS_OK)) {
         if (status == UCS_ERR_NO_PROGRESS) {
             ucs_assert(sent_length == 0);
@@ -983,7 +1413,7 @@ static inline ssize_t uct_tcp_ep_sendv(uct_tcp_ep_t *ep)
     if (ep->tx.offset != ep->tx.length) {
         ucs_iov_advance(ctx->iov, ctx->iov_cnt,
                         &ctx->iov_index, sent_length);
-    } else {
+    } else if (!(ep->flags & UCT_TCP_EP_FLAG_ZCOPY_MSG_TX)) {
         uct_tcp_ep_zcopy_completed(ep, ctx->comp, UCS_OK);
     }
 
@@ -1135,18 +1565,37 @@ static inline unsigned uct_tcp_ep_recv(uct_tcp_ep_t *ep, size_t recv_length)
     return 1;
 }
 
+static void uct_tcp_ep_zcopy_msg_tx_completed(uct_tcp_ep_t *ep)
+{
+    uct_tcp_ep_zcopy_tx_t *ctx = (uct_tcp_ep_zcopy_tx_t*)ep->tx.buf;
+
+    /* The kernel may still reference the TX buffer, so it is detached from
+     * the EP TX context and released upon MSG_ZEROCOPY completion */
+    ctx->zcopy_comp.comp   = ctx->comp;
+    ctx->zcopy_comp.flags &= ~UCT_TCP_EP_ZCOPY_COMP_FLAG_SENDING;
+    ep->flags             &= ~(UCT_TCP_EP_FLAG_ZCOPY_TX |
+                               UCT_TCP_EP_FLAG_ZCOPY_MSG_TX);
+    ep->tx.buf             = NULL;
+    uct_tcp_ep_ctx_rewind(&ep->tx);
+}
+
 static inline void uct_tcp_ep_check_tx_completion(uct_tcp_ep_t *ep)
 {
     if (ucs_likely(!uct_tcp_ep_ctx_buf_need_progress(&ep->tx))) {
-        uct_tcp_ep_ctx_reset(&ep->tx);
+        if (ucs_unlikely(ep->flags & UCT_TCP_EP_FLAG_ZCOPY_MSG_TX)) {
+            uct_tcp_ep_zcopy_msg_tx_completed(ep);
+        } else {
+            uct_tcp_ep_ctx_reset(&ep->tx);
+        }
     } else {
         uct_tcp_ep_mod_events(ep, UCS_EVENT_SET_EVWRITE, 0);
     }
 }
 
-/* Forward declaration - the function depends on AM send
+/* Forward declarations - the functions depend on AM send
  * functions implemented below */
 static void uct_tcp_ep_post_put_ack(uct_tcp_ep_t *ep);
+static void uct_tcp_ep_post_get_resp(uct_tcp_ep_t *ep);
 
 static unsigned uct_tcp_ep_progress_data_tx(void *arg)
 {
@@ -1171,6 +1620,10 @@ static unsigned uct_tcp_ep_progress_data_tx(void *arg)
         uct_tcp_ep_check_tx_completion(ep);
     }
 
+    if (!ucs_queue_is_empty(&ep->get_resp_q)) {
+        uct_tcp_ep_post_get_resp(ep);
+    }
+
     if (ep->flags & UCT_TCP_EP_FLAG_PUT_RX_SENDING_ACK) {
         uct_tcp_ep_post_put_ack(ep);
     }
@@ -1259,68 +1712,209 @@ static inline void uct_tcp_ep_handle_put_req(uct_tcp_ep_t *ep,
     ep->flags |= UCT_TCP_EP_FLAG_PUT_RX;
 }
 
-static unsigned uct_tcp_ep_progress_am_rx(uct_tcp_ep_t *ep)
+static inline void uct_tcp_ep_handle_get_req(uct_tcp_ep_t *ep,
+                                             uct_tcp_ep_get_req_hdr_t *get_req)
 {
     uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
                                             uct_tcp_iface_t);
-    unsigned handled       = 0;
-    uct_tcp_am_hdr_t *hdr;
-    size_t recv_length;
-    size_t recvd_length;
-    size_t remaining;
+    uct_tcp_ep_get_resp_t *get_resp;
 
-    ucs_trace_func("ep=%p", ep);
+    ucs_assert(get_req->addr || !get_req->length);
 
-    if (!uct_tcp_ep_ctx_buf_need_progress(&ep->rx)) {
-        ucs_assert(ep->rx.buf == NULL);
-        ep->rx.buf = ucs_mpool_get_inline(&iface->rx_mpool);
-        if (ucs_unlikely(ep->rx.buf == NULL)) {
-            ucs_warn("tcp_ep %p: unable to get a buffer from RX memory pool", ep);
-            return 0;
-        }
+    /* GET response acknowledges all PUT operations received before, so
+     * the pending PUT ACK is not needed anymore */
+    ep->rx.put_sn  = get_req->sn;
+    ep->flags     &= ~UCT_TCP_EP_FLAG_PUT_RX_SENDING_ACK;
 
-        /* post the entire AM buffer */
-        recv_length = iface->config.rx_seg_size;
-    } else if (ep->rx.length < sizeof(*hdr)) {
-        ucs_assert((ep->rx.buf != NULL) && (ep->rx.offset == 0));
+    get_resp = ucs_mpool_get_inline(&iface->tx_mpool);
+    if (ucs_unlikely(get_resp == NULL)) {
+        ucs_error("tcp_ep %p: unable to allocate GET response from mpool", ep);
+        return;
+    }
 
-        /* do partial receive of the remaining part of the hdr
-         * and post the entire AM buffer */
-        recv_length = iface->config.rx_seg_size - ep->rx.length;
-    } else {
-        ucs_assert((ep->rx.buf != NULL) &&
-                   ((ep->rx.length - ep->rx.offset) >= sizeof(*hdr)));
+    get_resp->req = *get_req;
+    ucs_queue_push(&ep->get_resp_q, &get_resp->elem);
+    uct_tcp_ep_post_get_resp(ep);
+}
 
-        /* do partial receive of the remaining user data */
-        hdr          = UCS_PTR_BYTE_OFFSET(ep->rx.buf, ep->rx.offset);
-        recvd_length = ep->rx.length - ep->rx.offset - sizeof(*hdr);
-        recv_length  = ucs_max(0, (ssize_t)(hdr->length - recvd_length));
+static inline ucs_status_t
+uct_tcp_ep_get_rx_advance(uct_tcp_ep_t *ep, size_t recv_length)
+{
+    uct_tcp_ep_get_completion_t *get_comp;
+    uct_completion_t *comp;
+    uint32_t sn;
+
+    get_comp = ucs_queue_head_elem_non_empty(&ep->get_comp_q,
+                                             uct_tcp_ep_get_completion_t, elem);
+    ucs_assert(recv_length <= get_comp->length);
+    get_comp->buffer  = UCS_PTR_BYTE_OFFSET(get_comp->buffer, recv_length);
+    get_comp->length -= recv_length;
+
+    if (get_comp->length != 0) {
+        return UCS_INPROGRESS;
     }
 
-    if (!uct_tcp_ep_recv(ep, recv_length)) {
-        goto out;
+    ucs_queue_pull_non_empty(&ep->get_comp_q);
+
+    if (ep->flags & UCT_TCP_EP_FLAG_GET_RX) {
+        ep->flags &= ~UCT_TCP_EP_FLAG_GET_RX;
+        uct_tcp_ep_ctx_reset(&ep->rx);
     }
 
-    /* Parse received active messages */
-    while (uct_tcp_ep_ctx_buf_need_progress(&ep->rx)) {
-        remaining = ep->rx.length - ep->rx.offset;
-        if (remaining < sizeof(*hdr)) {
-            /* Move the partially received hdr to the beginning of the buffer */
-            memmove(ep->rx.buf, UCS_PTR_BYTE_OFFSET(ep->rx.buf, ep->rx.offset),
-                    remaining);
-            ep->rx.offset = 0;
-            ep->rx.length = remaining;
-            handled++;
-            goto out;
-        }
+    sn   = get_comp->sn;
+    comp = get_comp->comp;
+    ucs_mpool_put_inline(get_comp);
 
-        hdr = UCS_PTR_BYTE_OFFSET(ep->rx.buf, ep->rx.offset);
-        ucs_assertv(hdr->length <= (iface->config.rx_seg_size - sizeof(*hdr)),
-                    "tcp_ep %p (conn state - %s): %u vs %zu",
-                    ep, uct_tcp_ep_cm_state[ep->conn_state].name, hdr->length,
+    if (comp != NULL) {
+        uct_invoke_completion(comp, UCS_OK);
+    }
+
+    /* GET response is also the acknowledgment of PUT operations */
+    uct_tcp_ep_handle_put_ack(ep, sn);
+    return UCS_OK;
+}
+
+static inline void
+uct_tcp_ep_handle_get_resp(uct_tcp_ep_t *ep, uct_tcp_ep_get_resp_hdr_t *get_resp,
+                           size_t extra_recvd_length)
+{
+    uct_tcp_ep_get_completion_t UCS_V_UNUSED *get_comp;
+    size_t copied_length;
+    ucs_status_t status;
+
+    ucs_assertv(!ucs_queue_is_empty(&ep->get_comp_q), "ep=%p", ep);
+    get_comp = ucs_queue_head_elem_non_empty(&ep->get_comp_q,
+                                             uct_tcp_ep_get_completion_t, elem);
+    ucs_assertv(get_comp->sn == get_resp->sn, "ep=%p get_comp->sn=%u "
+                "get_resp->sn=%u", ep, get_comp->sn, get_resp->sn);
+
+    copied_length  = ucs_min(get_comp->length, extra_recvd_length);
+    memcpy(get_comp->buffer, UCS_PTR_BYTE_OFFSET(ep->rx.buf, ep->rx.offset),
+           copied_length);
+    ep->rx.offset += copied_length;
+
+    status = uct_tcp_ep_get_rx_advance(ep, copied_length);
+    if (status == UCS_OK) {
+        return;
+    }
+
+    /* The rest of the data is received directly to the user's buffer, the
+     * RX buffer is kept to be reused when the GET operation is completed */
+    ucs_assert(ep->rx.offset == ep->rx.length);
+    uct_tcp_ep_ctx_rewind(&ep->rx);
+    ep->flags |= UCT_TCP_EP_FLAG_GET_RX;
+}
+
+/* Switch to receiving the rest of the AM payload to the buffer provided by the
+ * user's direct receive handler, if the handler accepts the message */
+static inline void
+uct_tcp_ep_am_rx_direct_start(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
+                              uct_tcp_am_hdr_t *hdr, size_t recvd_length)
+{
+    uct_am_recv_direct_handler_t *handler;
+    uct_completion_t *comp;
+    size_t copied_length;
+    ucs_status_t status;
+    void *payload;
+
+    if ((hdr->am_id >= UCT_AM_ID_MAX) ||
+        (hdr->length < iface->config.rx_direct_thresh)) {
+        return;
+    }
+
+    handler = &iface->super.am_recv_direct[hdr->am_id];
+    if ((handler->cb == NULL) || (recvd_length < handler->header_length)) {
+        return;
+    }
+
+    status = handler->cb(handler->arg, hdr + 1, hdr->length, &payload, &comp);
+    if (status != UCS_OK) {
+        return;
+    }
+
+    ucs_assert(comp != NULL);
+    ucs_assert(recvd_length < hdr->length);
+
+    copied_length = recvd_length - handler->header_length;
+    memcpy(payload, UCS_PTR_BYTE_OFFSET(hdr + 1, handler->header_length),
+           copied_length);
+
+    ucs_trace_data("tcp_ep %p: receiving %u bytes of AM id %d directly to "
+                   "%p", ep, hdr->length, hdr->am_id, payload);
+
+    ep->am_rx_direct.buffer = UCS_PTR_BYTE_OFFSET(payload, copied_length);
+    ep->am_rx_direct.length = hdr->length - recvd_length;
+    ep->am_rx_direct.comp   = comp;
+    ep->flags              |= UCT_TCP_EP_FLAG_AM_RX_DIRECT;
+
+    /* The RX buffer is kept to be reused when the AM payload is received */
+    uct_tcp_ep_ctx_rewind(&ep->rx);
+}
+
+static unsigned uct_tcp_ep_progress_am_rx(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    unsigned handled       = 0;
+    uct_tcp_am_hdr_t *hdr;
+    size_t recv_length;
+    size_t recvd_length;
+    size_t remaining;
+
+    ucs_trace_func("ep=%p", ep);
+
+    if (!uct_tcp_ep_ctx_buf_need_progress(&ep->rx)) {
+        ucs_assert(ep->rx.buf == NULL);
+        ep->rx.buf = ucs_mpool_get_inline(&iface->rx_mpool);
+        if (ucs_unlikely(ep->rx.buf == NULL)) {
+            ucs_warn("tcp_ep %p: unable to get a buffer from RX memory pool", ep);
+            return 0;
+        }
+
+        /* post the entire AM buffer */
+        recv_length = iface->config.rx_seg_size;
+    } else if (ep->rx.length < sizeof(*hdr)) {
+        ucs_assert((ep->rx.buf != NULL) && (ep->rx.offset == 0));
+
+        /* do partial receive of the remaining part of the hdr
+         * and post the entire AM buffer */
+        recv_length = iface->config.rx_seg_size - ep->rx.length;
+    } else {
+        ucs_assert((ep->rx.buf != NULL) &&
+                   ((ep->rx.length - ep->rx.offset) >= sizeof(*hdr)));
+
+        /* do partial receive of the remaining user data */
+        hdr          = UCS_PTR_BYTE_OFFSET(ep->rx.buf, ep->rx.offset);
+        recvd_length = ep->rx.length - ep->rx.offset - sizeof(*hdr);
+        recv_length  = ucs_max(0, (ssize_t)(hdr->length - recvd_length));
+    }
+
+    if (!uct_tcp_ep_recv(ep, recv_length)) {
+        goto out;
+    }
+
+    /* Parse received active messages */
+    while (uct_tcp_ep_ctx_buf_need_progress(&ep->rx)) {
+        remaining = ep->rx.length - ep->rx.offset;
+        if (remaining < sizeof(*hdr)) {
+            /* Move the partially received hdr to the beginning of the buffer */
+            memmove(ep->rx.buf, UCS_PTR_BYTE_OFFSET(ep->rx.buf, ep->rx.offset),
+                    remaining);
+            ep->rx.offset = 0;
+            ep->rx.length = remaining;
+            handled++;
+            goto out;
+        }
+
+        hdr = UCS_PTR_BYTE_OFFSET(ep->rx.buf, ep->rx.offset);
+        ucs_assertv(hdr->length <= (iface->config.rx_seg_size - sizeof(*hdr)),
+                    "tcp_ep %p (conn state - %s): %u vs %zu",
+                    ep, uct_tcp_ep_cm_state[ep->conn_state].name, hdr->length,
                     (iface->config.rx_seg_size - sizeof(*hdr)));
 
         if (remaining < (sizeof(*hdr) + hdr->length)) {
+            uct_tcp_ep_am_rx_direct_start(iface, ep, hdr,
+                                          remaining - sizeof(*hdr));
             handled++;
             goto out;
         }
@@ -1343,9 +1937,24 @@ static unsigned uct_tcp_ep_progress_am_rx(uct_tcp_ep_t *ep)
                  * release a EP RX buffer */
                 goto out;
             }
+        } else if (hdr->am_id == UCT_TCP_EP_GET_REQ_AM_ID) {
+            ucs_assert(hdr->length == sizeof(uct_tcp_ep_get_req_hdr_t));
+            uct_tcp_ep_handle_get_req(ep, (uct_tcp_ep_get_req_hdr_t*)(hdr + 1));
+            handled++;
+        } else if (hdr->am_id == UCT_TCP_EP_GET_RESP_AM_ID) {
+            ucs_assert(hdr->length == sizeof(uct_tcp_ep_get_resp_hdr_t));
+            uct_tcp_ep_handle_get_resp(ep, (uct_tcp_ep_get_resp_hdr_t*)(hdr + 1),
+                                       ep->rx.length - ep->rx.offset);
+            handled++;
+            if (ep->flags & UCT_TCP_EP_FLAG_GET_RX) {
+                /* GET RX is in progress, the EP RX buffer is kept until
+                 * the GET response data is received */
+                goto out;
+            }
         } else if (hdr->am_id == UCT_TCP_EP_PUT_ACK_AM_ID) {
             ucs_assert(hdr->length == sizeof(uint32_t));
-            uct_tcp_ep_handle_put_ack(ep, (uct_tcp_ep_put_ack_hdr_t*)(hdr + 1));
+            uct_tcp_ep_handle_put_ack(ep,
+                                      ((uct_tcp_ep_put_ack_hdr_t*)(hdr + 1))->sn);
             handled++;
         } else if (hdr->am_id == UCT_TCP_EP_KEEPALIVE_AM_ID) {
             /* just ignore keepalive requests */
@@ -1422,17 +2031,96 @@ static unsigned uct_tcp_ep_progress_put_rx(uct_tcp_ep_t *ep)
     return 1;
 }
 
+static unsigned uct_tcp_ep_progress_get_rx(uct_tcp_ep_t *ep)
+{
+    uct_tcp_ep_get_completion_t *get_comp;
+    size_t recv_length;
+    ucs_status_t status;
+
+    get_comp    = ucs_queue_head_elem_non_empty(&ep->get_comp_q,
+                                                uct_tcp_ep_get_completion_t,
+                                                elem);
+    recv_length = get_comp->length;
+    status      = ucs_socket_recv_nb(ep->fd, get_comp->buffer, &recv_length);
+    if (ucs_unlikely(status != UCS_OK)) {
+        if (status != UCS_ERR_NO_PROGRESS) {
+            uct_tcp_ep_handle_recv_err(ep, status);
+        }
+        return 0;
+    }
+
+    ucs_assertv(recv_length, "ep=%p", ep);
+
+    uct_tcp_ep_get_rx_advance(ep, recv_length);
+
+    return 1;
+}
+
+static unsigned uct_tcp_ep_progress_am_rx_direct(uct_tcp_ep_t *ep)
+{
+    size_t recv_length;
+    ucs_status_t status;
+
+    recv_length = ep->am_rx_direct.length;
+    status      = ucs_socket_recv_nb(ep->fd, ep->am_rx_direct.buffer,
+                                     &recv_length);
+    if (ucs_unlikely(status != UCS_OK)) {
+        if (status != UCS_ERR_NO_PROGRESS) {
+            uct_tcp_ep_handle_recv_err(ep, status);
+        }
+        return 0;
+    }
+
+    ucs_assertv(recv_length <= ep->am_rx_direct.length, "ep=%p", ep);
+
+    ep->am_rx_direct.buffer  = UCS_PTR_BYTE_OFFSET(ep->am_rx_direct.buffer,
+                                                   recv_length);
+    ep->am_rx_direct.length -= recv_length;
+    if (ep->am_rx_direct.length == 0) {
+        ep->flags &= ~UCT_TCP_EP_FLAG_AM_RX_DIRECT;
+        uct_tcp_ep_ctx_reset(&ep->rx);
+        uct_invoke_completion(ep->am_rx_direct.comp, UCS_OK);
+    }
+
+    return 1;
+}
+
 static unsigned uct_tcp_ep_progress_data_rx(void *arg)
 {
     uct_tcp_ep_t *ep = (uct_tcp_ep_t*)arg;
 
-    if (!(ep->flags & UCT_TCP_EP_FLAG_PUT_RX)) {
-        return uct_tcp_ep_progress_am_rx(ep);
-    } else {
+    if (ep->flags & UCT_TCP_EP_FLAG_PUT_RX) {
         return uct_tcp_ep_progress_put_rx(ep);
+    } else if (ep->flags & UCT_TCP_EP_FLAG_GET_RX) {
+        return uct_tcp_ep_progress_get_rx(ep);
+    } else if (ep->flags & UCT_TCP_EP_FLAG_AM_RX_DIRECT) {
+        return uct_tcp_ep_progress_am_rx_direct(ep);
+    } else {
+        return uct_tcp_ep_progress_am_rx(ep);
     }
 }
 
+/* Progress the data which was received by an internal EP before its socket
+ * was moved to the EP, since no more events may come for this data */
+static unsigned uct_tcp_ep_progress_moved_rx(void *arg)
+{
+    uct_tcp_ep_t *ep       = (uct_tcp_ep_t*)arg;
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    unsigned count;
+
+    if (!iface->config.thread_safe) {
+        return uct_tcp_ep_progress_data_rx(ep);
+    }
+
+    ucs_recursive_spin_lock(&iface->progress_lock);
+    uct_tcp_ep_lock(iface, ep);
+    count = uct_tcp_ep_progress_data_rx(ep);
+    uct_tcp_ep_unlock(iface, ep);
+    ucs_recursive_spin_unlock(&iface->progress_lock);
+    return count;
+}
+
 static unsigned uct_tcp_ep_progress_magic_number_rx(void *arg)
 {
     uct_tcp_ep_t *ep       = (uct_tcp_ep_t*)arg;
@@ -1498,6 +2186,8 @@ uct_tcp_ep_set_outstanding_zcopy(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
     ep->flags |= UCT_TCP_EP_FLAG_ZCOPY_TX;
 
     if ((header_length != 0) &&
+        /* with MSG_ZEROCOPY the header was copied before sending */
+        !(ep->flags & UCT_TCP_EP_FLAG_ZCOPY_MSG_TX) &&
         /* check whether a user's header was sent or not */
         (ep->tx.offset < (sizeof(uct_tcp_am_hdr_t) + header_length))) {
         ucs_assert(header_length <= iface->config.zcopy.max_hdr);
@@ -1569,7 +2259,7 @@ uct_tcp_ep_am_sendv(uct_tcp_ep_t *ep, int short_sendv, uct_tcp_am_hdr_t *hdr,
     ucs_assertv((ep->tx.length <= send_limit) &&
                 (iov_cnt > 0), "ep=%p", ep);
 
-    status = ucs_socket_sendv_nb(ep->fd, iov, iov_cnt, &sent_length);
+    status = uct_tcp_ep_sendv_iov(ep, iov, iov_cnt, &sent_length);
     if (ucs_unlikely((status != UCS_OK) && (status != UCS_ERR_NO_PROGRESS))) {
         return uct_tcp_ep_handle_send_err(ep, status);
     }
@@ -1607,6 +2297,13 @@ static void uct_tcp_ep_post_put_ack(uct_tcp_ep_t *ep)
     uct_tcp_ep_put_ack_hdr_t *put_ack;
     ucs_status_t status;
 
+    if (!ucs_queue_is_empty(&ep->get_resp_q)) {
+        /* Send PUT ACK after the GET responses to not acknowledge GET
+         * operations whose data was not sent yet */
+        ep->flags |= UCT_TCP_EP_FLAG_PUT_RX_SENDING_ACK;
+        return;
+    }
+
     /* Make sure that we are sending nothing through this EP at the moment.
      * This check is needed to avoid mixing AM/PUT data sent from this EP
      * and this PUT ACK message */
@@ -1677,6 +2374,11 @@ ucs_status_t uct_tcp_ep_am_short(uct_ep_h uct_ep, uint8_t am_id, uint64_t header
                      "am_short");
     UCT_CHECK_AM_ID(am_id);
 
+    status = uct_tcp_ep_check_fence(ep);
+    if (ucs_unlikely(status != UCS_OK)) {
+        return status;
+    }
+
     status = uct_tcp_ep_am_prepare(iface, ep, am_id, &hdr);
     if (status != UCS_OK) {
         return status;
@@ -1731,6 +2433,11 @@ ucs_status_t uct_tcp_ep_am_short_iov(uct_ep_h uct_ep, uint8_t am_id,
                      iface->config.tx_seg_size - sizeof(uct_tcp_am_hdr_t),
                      "am_short_iov");
 
+    status = uct_tcp_ep_check_fence(ep);
+    if (ucs_unlikely(status != UCS_OK)) {
+        return status;
+    }
+
     status = uct_tcp_ep_am_prepare(iface, ep, am_id, &hdr);
     if (status != UCS_OK) {
         return status;
@@ -1767,6 +2474,11 @@ ssize_t uct_tcp_ep_am_bcopy(uct_ep_h uct_ep, uint8_t am_id,
 
     UCT_CHECK_AM_ID(am_id);
 
+    status = uct_tcp_ep_check_fence(ep);
+    if (ucs_unlikely(status != UCS_OK)) {
+        return status;
+    }
+
     status = uct_tcp_ep_am_prepare(iface, ep, am_id, &hdr);
     if (status != UCS_OK) {
         return status;
@@ -1837,6 +2549,39 @@ uct_tcp_ep_prepare_zcopy(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep, uint8_t am_id
     return UCS_OK;
 }
 
+static void
+uct_tcp_ep_zcopy_msg_start(uct_tcp_iface_t *iface, uct_tcp_ep_t *ep,
+                           uct_tcp_ep_zcopy_tx_t *ctx, const void *header,
+                           unsigned header_length, uct_completion_t *comp)
+{
+    uct_tcp_ep_zcopy_comp_t *zcopy_comp = &ctx->zcopy_comp;
+
+    if (header_length != 0) {
+        /* The header is referenced by the kernel after the operation returns,
+         * so send it from the EP TX buffer */
+        ucs_assert(header_length <= iface->config.zcopy.max_hdr);
+        ctx->iov[1].iov_base = UCS_PTR_BYTE_OFFSET(ep->tx.buf,
+                                                   iface->config.zcopy.hdr_offset);
+        memcpy(ctx->iov[1].iov_base, header, header_length);
+    }
+
+    ctx->comp             = comp;
+    zcopy_comp->comp      = NULL;
+    zcopy_comp->buf       = ctx;
+    zcopy_comp->first_sn  = ep->zcopy_sn;
+    zcopy_comp->sn_count  = 0;
+    zcopy_comp->remaining = 0;
+    zcopy_comp->flags     = UCT_TCP_EP_ZCOPY_COMP_FLAG_OP |
+                            UCT_TCP_EP_ZCOPY_COMP_FLAG_SENDING;
+    zcopy_comp->status    = UCS_OK;
+    ucs_queue_push(&ep->zcopy_comp_q, &zcopy_comp->elem);
+
+    /* Keep the operation outstanding until the kernel releases the buffers */
+    uct_tcp_iface_outstanding_inc(iface);
+    ep->flags |= UCT_TCP_EP_FLAG_ZCOPY_MSG_TX;
+    uct_tcp_ep_mod_events(ep, UCS_EVENT_SET_EVERR, 0);
+}
+
 ucs_status_t uct_tcp_ep_am_zcopy(uct_ep_h uct_ep, uint8_t am_id, const void *header,
                                  unsigned header_length, const uct_iov_t *iov,
                                  size_t iovcnt, unsigned flags,
@@ -1847,12 +2592,18 @@ ucs_status_t uct_tcp_ep_am_zcopy(uct_ep_h uct_ep, uint8_t am_id, const void *hea
     uct_tcp_ep_zcopy_tx_t *ctx = NULL;
     size_t payload_length      = 0;
     ucs_status_t status;
+    int msg_zcopy;
 
     UCT_CHECK_LENGTH(header_length + uct_iov_total_length(iov, iovcnt), 0,
                      iface->config.rx_seg_size - sizeof(uct_tcp_am_hdr_t),
                      "am_zcopy");
     UCT_CHECK_AM_ID(am_id);
 
+    status = uct_tcp_ep_check_fence(ep);
+    if (ucs_unlikely(status != UCS_OK)) {
+        return status;
+    }
+
     status = uct_tcp_ep_prepare_zcopy(iface, ep, am_id, header, header_length,
                                       iov, iovcnt, "am_zcopy", &payload_length,
                                       &ctx);
@@ -1861,6 +2612,11 @@ ucs_status_t uct_tcp_ep_am_zcopy(uct_ep_h uct_ep, uint8_t am_id, const void *hea
     }
 
     ctx->super.length = payload_length + header_length;
+    msg_zcopy         = payload_length >= iface->config.msg_zcopy_thresh;
+    if (msg_zcopy) {
+        uct_tcp_ep_zcopy_msg_start(iface, ep, ctx, header, header_length,
+                                   comp);
+    }
 
     status = uct_tcp_ep_am_sendv(ep, 0, &ctx->super, iface->config.rx_seg_size,
                                  header, ctx->iov, ctx->iov_cnt);
@@ -1876,7 +2632,8 @@ ucs_status_t uct_tcp_ep_am_zcopy(uct_ep_h uct_ep, uint8_t am_id, const void *hea
         return UCS_INPROGRESS;
     }
 
-    return UCS_OK;
+    /* MSG_ZEROCOPY operation is completed by the kernel notification */
+    return msg_zcopy ? UCS_INPROGRESS : UCS_OK;
 }
 
 static UCS_F_ALWAYS_INLINE ucs_status_t
@@ -1904,21 +2661,16 @@ uct_tcp_ep_put_comp_add(uct_tcp_ep_t *ep, uct_completion_t *comp, int wait_sn)
     return UCS_OK;
 }
 
-ucs_status_t uct_tcp_ep_put_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
-                                  size_t iovcnt, uint64_t remote_addr,
-                                  uct_rkey_t rkey, uct_completion_t *comp)
+static ucs_status_t
+uct_tcp_ep_post_put_req(uct_tcp_ep_t *ep, const uct_iov_t *iov, size_t iovcnt,
+                        uint64_t remote_addr, uct_completion_t *comp)
 {
-    uct_tcp_ep_t *ep                 = ucs_derived_of(uct_ep, uct_tcp_ep_t);
-    uct_tcp_iface_t *iface           = ucs_derived_of(uct_ep->iface,
+    uct_tcp_iface_t *iface           = ucs_derived_of(ep->super.super.iface,
                                                       uct_tcp_iface_t);
     uct_tcp_ep_zcopy_tx_t *ctx       = NULL;
     uct_tcp_ep_put_req_hdr_t put_req = {0}; /* Suppress Cppcheck false-positive */
     ucs_status_t status;
 
-    UCT_CHECK_LENGTH(sizeof(put_req) + uct_iov_total_length(iov, iovcnt), 0,
-                     UCT_TCP_EP_PUT_ZCOPY_MAX - sizeof(uct_tcp_am_hdr_t),
-                     "put_zcopy");
-
     status = uct_tcp_ep_prepare_zcopy(iface, ep, UCT_TCP_EP_PUT_REQ_AM_ID,
                                       &put_req, sizeof(put_req),
                                       iov, iovcnt, "put_zcopy",
@@ -1935,6 +2687,11 @@ ucs_status_t uct_tcp_ep_put_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
     put_req.length    = ep->tx.length;
     put_req.sn        = ep->tx.put_sn + 1;
 
+    if (put_req.length >= iface->config.msg_zcopy_thresh) {
+        uct_tcp_ep_zcopy_msg_start(iface, ep, ctx, &put_req, sizeof(put_req),
+                                   NULL);
+    }
+
     status = uct_tcp_ep_am_sendv(ep, 0, &ctx->super, UCT_TCP_EP_PUT_ZCOPY_MAX,
                                  &put_req, ctx->iov, ctx->iov_cnt);
     if (ucs_unlikely(status != UCS_OK)) {
@@ -1968,12 +2725,328 @@ ucs_status_t uct_tcp_ep_put_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
     return UCS_INPROGRESS;
 }
 
+static void uct_tcp_ep_post_get_resp(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface             = ucs_derived_of(ep->super.super.iface,
+                                                        uct_tcp_iface_t);
+    uct_tcp_ep_zcopy_tx_t *ctx         = NULL;
+    uct_tcp_ep_get_resp_hdr_t resp_hdr = {0}; /* Suppress Cppcheck false-positive */
+    uct_tcp_ep_get_resp_t *get_resp;
+    uct_iov_t iov;
+    ucs_status_t status;
+
+    while (!ucs_queue_is_empty(&ep->get_resp_q)) {
+        get_resp     = ucs_queue_head_elem_non_empty(&ep->get_resp_q,
+                                                     uct_tcp_ep_get_resp_t,
+                                                     elem);
+        iov.buffer   = (void*)(uintptr_t)get_resp->req.addr;
+        iov.length   = get_resp->req.length;
+        iov.memh     = UCT_MEM_HANDLE_NULL;
+        iov.stride   = 0;
+        iov.count    = 1;
+        resp_hdr.sn  = get_resp->req.sn;
+
+        /* Keep the request queued until the EP TX resources are available */
+        status = uct_tcp_ep_prepare_zcopy(iface, ep, UCT_TCP_EP_GET_RESP_AM_ID,
+                                          &resp_hdr, sizeof(resp_hdr), &iov, 1,
+                                          "get_resp", &ep->tx.length, &ctx);
+        if (status != UCS_OK) {
+            if (status != UCS_ERR_NO_RESOURCE) {
+                ucs_error("tcp_ep %p: failed to prepare GET response", ep);
+            }
+            return;
+        }
+
+        ucs_queue_pull_non_empty(&ep->get_resp_q);
+        ucs_mpool_put_inline(get_resp);
+
+        ctx->super.length = sizeof(resp_hdr);
+        if (ep->tx.length >= iface->config.msg_zcopy_thresh) {
+            uct_tcp_ep_zcopy_msg_start(iface, ep, ctx, &resp_hdr,
+                                       sizeof(resp_hdr), NULL);
+        }
+
+        status = uct_tcp_ep_am_sendv(ep, 0, &ctx->super,
+                                     UCT_TCP_EP_GET_ZCOPY_MAX, &resp_hdr,
+                                     ctx->iov, ctx->iov_cnt);
+        if (ucs_unlikely(status != UCS_OK)) {
+            return;
+        }
+
+        if (uct_tcp_ep_ctx_buf_need_progress(&ep->tx)) {
+            uct_tcp_ep_set_outstanding_zcopy(iface, ep, ctx, &resp_hdr,
+                                             sizeof(resp_hdr), NULL);
+            return;
+        }
+    }
+}
+
+static ucs_status_t
+uct_tcp_ep_post_get_req(uct_tcp_ep_t *ep, const uct_iov_t *iov, size_t iovcnt,
+                        uint64_t remote_addr, uct_completion_t *comp)
+{
+    uct_tcp_iface_t *iface                = ucs_derived_of(ep->super.super.iface,
+                                                           uct_tcp_iface_t);
+    uct_tcp_am_hdr_t *hdr                 = NULL;
+    size_t length                         = uct_iov_total_length(iov, iovcnt);
+    uct_tcp_ep_get_completion_t *get_comp;
+    uct_tcp_ep_get_req_hdr_t *get_req;
+    ucs_status_t status;
+
+    status = uct_tcp_ep_am_prepare(iface, ep, UCT_TCP_EP_GET_REQ_AM_ID, &hdr);
+    if (ucs_unlikely(status != UCS_OK)) {
+        return status;
+    }
+
+    ucs_assertv(hdr != NULL, "ep=%p", ep);
+
+    get_comp = ucs_mpool_get_inline(&iface->tx_mpool);
+    if (ucs_unlikely(get_comp == NULL)) {
+        uct_tcp_ep_ctx_reset(&ep->tx);
+        UCS_STATS_UPDATE_COUNTER(ep->super.stats, UCT_EP_STAT_NO_RES, 1);
+        return UCS_ERR_NO_RESOURCE;
+    }
+
+    hdr->length     = sizeof(*get_req);
+    get_req         = (uct_tcp_ep_get_req_hdr_t*)(hdr + 1);
+    get_req->addr   = remote_addr;
+    get_req->length = length;
+    get_req->sn     = ep->tx.put_sn + 1;
+
+    status = uct_tcp_ep_am_send(ep, hdr);
+    if (ucs_unlikely(status != UCS_OK)) {
+        ucs_mpool_put_inline(get_comp);
+        return status;
+    }
+
+    ep->tx.put_sn++;
+
+    get_comp->comp   = comp;
+    get_comp->buffer = (iovcnt != 0) ? iov[0].buffer : NULL;
+    get_comp->length = length;
+    get_comp->sn     = ep->tx.put_sn;
+    ucs_queue_push(&ep->get_comp_q, &get_comp->elem);
+
+    if (!(ep->flags & UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK)) {
+        /* GET response acknowledges the operation like PUT ACK does, so
+         * flush waits for it in the same way */
+        ep->flags |= UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK;
+        uct_tcp_iface_outstanding_inc(iface);
+    }
+
+    UCT_TL_EP_STAT_OP(&ep->super, GET, ZCOPY, length);
+
+    return UCS_INPROGRESS;
+}
+
+static ucs_status_t uct_tcp_ep_stream_create(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_ep_t *stream_ep;
+    ucs_status_t status;
+    unsigned i;
+
+    ep->stream.eps = ucs_calloc(iface->config.num_streams - 1,
+                                sizeof(*ep->stream.eps), "tcp_stream_eps");
+    if (ep->stream.eps == NULL) {
+        ucs_error("tcp_ep %p: failed to allocate stream EPs array", ep);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    ucs_list_add_tail(&iface->stream_ep_list, &ep->stream.list);
+
+    for (i = 0; i < (iface->config.num_streams - 1); ++i) {
+        status = uct_tcp_ep_init(iface, -1, &ep->peer_addr, &stream_ep);
+        if (status != UCS_OK) {
+            goto err;
+        }
+
+        stream_ep->flags       |= UCT_TCP_EP_FLAG_STREAM;
+        stream_ep->stream.main  = ep;
+        stream_ep->stream.index = i;
+        ep->stream.eps[i]       = stream_ep;
+
+        uct_tcp_ep_add_ctx_cap(stream_ep, UCT_TCP_EP_FLAG_CTX_TYPE_TX);
+        status = uct_tcp_ep_create_socket_and_connect(stream_ep);
+        if (status != UCS_OK) {
+            goto err;
+        }
+    }
+
+    ucs_debug("tcp_ep %p: created %u auxiliary sockets", ep,
+              iface->config.num_streams - 1);
+    return UCS_OK;
+
+err:
+    /* Keep the empty array to not retry, the operations of the EP will use
+     * only the primary socket */
+    uct_tcp_ep_stream_destroy_eps(ep);
+    return status;
+}
+
+static UCS_F_ALWAYS_INLINE int uct_tcp_ep_stream_is_ready(uct_tcp_ep_t *ep)
+{
+    return (ep != NULL) &&
+           (ep->conn_state == UCT_TCP_EP_CONN_STATE_CONNECTED) &&
+           uct_tcp_ep_ctx_buf_empty(&ep->tx);
+}
+
+static UCS_F_ALWAYS_INLINE void
+uct_tcp_ep_stream_iov_set_buffer(uct_iov_t *iov, void *buffer)
+{
+    iov->buffer = buffer;
+}
+
+static UCS_F_ALWAYS_INLINE void
+uct_tcp_ep_stream_iov_set_length(uct_iov_t *iov, size_t length)
+{
+    iov->length = length;
+    iov->memh   = UCT_MEM_HANDLE_NULL;
+    iov->stride = 0;
+    iov->count  = 1;
+}
+
+/* Split the RMA operation to stripes of the same size and post them to the
+ * sockets of the connection which have no data to send. The operation is
+ * completed when all its stripes are acknowledged by the peer */
+static ucs_status_t
+uct_tcp_ep_stream_rma(uct_tcp_ep_t *ep, uct_tcp_ep_rma_func_t post_func,
+                      const uct_iov_t *iov, size_t iovcnt,
+                      uint64_t remote_addr, uct_completion_t *comp)
+{
+    uct_tcp_iface_t *iface          = ucs_derived_of(ep->super.super.iface,
+                                                     uct_tcp_iface_t);
+    size_t length                   = uct_iov_total_length(iov, iovcnt);
+    uct_completion_t *stream_comp   = NULL;
+    ucs_status_t ret_status         = UCS_INPROGRESS;
+    uct_tcp_ep_t *stripe_eps[UCT_TCP_EP_MAX_STREAMS];
+    size_t stripe_iovcnt, stripe_length, max_length, offset;
+    ucs_iov_iter_t iov_iter;
+    uct_iov_t *stripe_iov;
+    unsigned i, num_stripes;
+    ucs_status_t status;
+
+    if ((length < iface->config.stripe_thresh) ||
+        !uct_tcp_ep_stream_is_ready(ep) ||
+        ((ep->stream.eps == NULL) && (uct_tcp_ep_stream_create(ep) != UCS_OK))) {
+        return post_func(ep, iov, iovcnt, remote_addr, comp);
+    }
+
+    num_stripes               = 0;
+    stripe_eps[num_stripes++] = ep;
+    for (i = 0; i < (iface->config.num_streams - 1); ++i) {
+        if (uct_tcp_ep_stream_is_ready(ep->stream.eps[i])) {
+            stripe_eps[num_stripes++] = ep->stream.eps[i];
+        }
+    }
+
+    if (num_stripes == 1) {
+        return post_func(ep, iov, iovcnt, remote_addr, comp);
+    }
+
+    if (comp != NULL) {
+        stream_comp = uct_tcp_ep_stream_comp_create(iface, comp);
+        if (ucs_unlikely(stream_comp == NULL)) {
+            return post_func(ep, iov, iovcnt, remote_addr, comp);
+        }
+    }
+
+    stripe_iov    = ucs_alloca(iovcnt * sizeof(*stripe_iov));
+    max_length    = ucs_div_round_up(length, num_stripes);
+    offset        = 0;
+    ucs_iov_iter_init(&iov_iter);
+
+    for (i = 0; offset < length; ++i) {
+        ucs_assert(i < num_stripes);
+        stripe_iovcnt = iovcnt;
+        stripe_length = ucs_iov_converter(stripe_iov, &stripe_iovcnt,
+                                          uct_tcp_ep_stream_iov_set_buffer,
+                                          uct_tcp_ep_stream_iov_set_length,
+                                          iov, iovcnt, uct_iov_get_buffer,
+                                          uct_iov_get_length, max_length,
+                                          &iov_iter);
+        if (stream_comp != NULL) {
+            ++stream_comp->count;
+        }
+
+        status  = post_func(stripe_eps[i], stripe_iov, stripe_iovcnt,
+                            remote_addr + offset, stream_comp);
+        offset += stripe_length;
+        if (status == UCS_INPROGRESS) {
+            continue;
+        }
+
+        if (stream_comp != NULL) {
+            uct_invoke_completion(stream_comp, status);
+        } else if (UCS_STATUS_IS_ERR(status)) {
+            ret_status = status;
+        }
+    }
+
+    return (stream_comp != NULL) ? uct_tcp_ep_stream_comp_release(stream_comp) :
+                                   ret_status;
+}
+
+ucs_status_t uct_tcp_ep_put_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
+                                  size_t iovcnt, uint64_t remote_addr,
+                                  uct_rkey_t rkey, uct_completion_t *comp)
+{
+    uct_tcp_ep_t *ep       = ucs_derived_of(uct_ep, uct_tcp_ep_t);
+    uct_tcp_iface_t *iface = ucs_derived_of(uct_ep->iface, uct_tcp_iface_t);
+    ucs_status_t status;
+
+    UCT_CHECK_LENGTH(sizeof(uct_tcp_ep_put_req_hdr_t) +
+                     uct_iov_total_length(iov, iovcnt), 0,
+                     UCT_TCP_EP_PUT_ZCOPY_MAX - sizeof(uct_tcp_am_hdr_t),
+                     "put_zcopy");
+
+    status = uct_tcp_ep_check_fence(ep);
+    if (ucs_unlikely(status != UCS_OK)) {
+        return status;
+    }
+
+    if (iface->config.num_streams > 1) {
+        return uct_tcp_ep_stream_rma(ep, uct_tcp_ep_post_put_req, iov, iovcnt,
+                                     remote_addr, comp);
+    }
+
+    return uct_tcp_ep_post_put_req(ep, iov, iovcnt, remote_addr, comp);
+}
+
+ucs_status_t uct_tcp_ep_get_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
+                                  size_t iovcnt, uint64_t remote_addr,
+                                  uct_rkey_t rkey, uct_completion_t *comp)
+{
+    uct_tcp_ep_t *ep       = ucs_derived_of(uct_ep, uct_tcp_ep_t);
+    uct_tcp_iface_t *iface = ucs_derived_of(uct_ep->iface, uct_tcp_iface_t);
+    ucs_status_t status;
+
+    UCT_CHECK_IOV_SIZE(iovcnt, UCT_TCP_EP_GET_ZCOPY_MAX_IOV, "get_zcopy");
+    UCT_CHECK_LENGTH(uct_iov_total_length(iov, iovcnt), 0,
+                     UCT_TCP_EP_GET_ZCOPY_MAX - UCT_TCP_EP_GET_SERVICE_LENGTH,
+                     "get_zcopy");
+
+    status = uct_tcp_ep_check_fence(ep);
+    if (ucs_unlikely(status != UCS_OK)) {
+        return status;
+    }
+
+    if (iface->config.num_streams > 1) {
+        return uct_tcp_ep_stream_rma(ep, uct_tcp_ep_post_get_req, iov, iovcnt,
+                                     remote_addr, comp);
+    }
+
+    return uct_tcp_ep_post_get_req(ep, iov, iovcnt, remote_addr, comp);
+}
+
 ucs_status_t uct_tcp_ep_pending_add(uct_ep_h tl_ep, uct_pending_req_t *req,
                                     unsigned flags)
 {
     uct_tcp_ep_t *ep = ucs_derived_of(tl_ep, uct_tcp_ep_t);
 
-    if (uct_tcp_ep_check_tx_res(ep) == UCS_OK) {
+    if (!(ep->flags & UCT_TCP_EP_FLAG_STREAM_FENCE) &&
+        (uct_tcp_ep_check_tx_res(ep) == UCS_OK)) {
         return UCS_ERR_BUSY;
     }
 
@@ -1991,6 +3064,76 @@ void uct_tcp_ep_pending_purge(uct_ep_h tl_ep, uct_pending_purge_callback_t cb,
     uct_pending_queue_purge(priv, &ep->pending_q, 1, cb, arg);
 }
 
+static ucs_status_t
+uct_tcp_ep_flush_outstanding(uct_tcp_ep_t *ep, uct_completion_t *comp)
+{
+    ucs_status_t status;
+
+    if (ep->flags & UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK) {
+        status = uct_tcp_ep_put_comp_add(ep, comp, ep->tx.put_sn);
+        if (status != UCS_OK) {
+            return status;
+        }
+
+        return UCS_INPROGRESS;
+    }
+
+    if (!ucs_queue_is_empty(&ep->zcopy_comp_q)) {
+        status = uct_tcp_ep_zcopy_comp_add(ep, comp);
+        if (status != UCS_OK) {
+            return status;
+        }
+
+        return UCS_INPROGRESS;
+    }
+
+    return UCS_OK;
+}
+
+/* The stripes of the operations are acknowledged independently on each
+ * socket of the connection, so wait for all of them */
+static ucs_status_t
+uct_tcp_ep_stream_flush(uct_tcp_ep_t *ep, uct_completion_t *comp)
+{
+    uct_tcp_iface_t *iface        = ucs_derived_of(ep->super.super.iface,
+                                                   uct_tcp_iface_t);
+    uct_completion_t *stream_comp = NULL;
+    ucs_status_t ret_status       = UCS_OK;
+    uct_tcp_ep_t *stream_ep;
+    ucs_status_t status;
+    unsigned i;
+
+    if (comp != NULL) {
+        stream_comp = uct_tcp_ep_stream_comp_create(iface, comp);
+        if (ucs_unlikely(stream_comp == NULL)) {
+            return UCS_ERR_NO_MEMORY;
+        }
+    }
+
+    for (i = 0; i < iface->config.num_streams; ++i) {
+        stream_ep = (i == 0) ? ep : ep->stream.eps[i - 1];
+        if (stream_ep == NULL) {
+            continue;
+        }
+
+        if (stream_comp != NULL) {
+            ++stream_comp->count;
+        }
+
+        status = uct_tcp_ep_flush_outstanding(stream_ep, stream_comp);
+        if (status == UCS_INPROGRESS) {
+            ret_status = UCS_INPROGRESS;
+        } else if (stream_comp != NULL) {
+            uct_invoke_completion(stream_comp, status);
+        } else if (UCS_STATUS_IS_ERR(status)) {
+            return status;
+        }
+    }
+
+    return (stream_comp != NULL) ? uct_tcp_ep_stream_comp_release(stream_comp) :
+                                   ret_status;
+}
+
 ucs_status_t uct_tcp_ep_flush(uct_ep_h tl_ep, unsigned flags,
                               uct_completion_t *comp)
 {
@@ -2013,16 +3156,22 @@ ucs_status_t uct_tcp_ep_flush(uct_ep_h tl_ep, unsigned flags,
         return UCS_ERR_NO_RESOURCE;
     }
 
-    if (ep->flags & UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK) {
-        status = uct_tcp_ep_put_comp_add(ep, comp, ep->tx.put_sn);
-        if (status != UCS_OK) {
-            return status;
-        }
-
-        return UCS_INPROGRESS;
+    status = (ep->stream.eps != NULL) ?
+             uct_tcp_ep_stream_flush(ep, comp) :
+             uct_tcp_ep_flush_outstanding(ep, comp);
+    if (status == UCS_OK) {
+        UCT_TL_EP_STAT_FLUSH(&ep->super);
     }
 
-    UCT_TL_EP_STAT_FLUSH(&ep->super);
+    return status;
+}
+
+ucs_status_t uct_tcp_ep_fence(uct_ep_h tl_ep, unsigned flags)
+{
+    uct_tcp_ep_t *ep = ucs_derived_of(tl_ep, uct_tcp_ep_t);
+
+    uct_tcp_ep_stream_fence(ep);
+    UCT_TL_EP_STAT_FENCE(&ep->super);
     return UCS_OK;
 }
 
@@ -2045,3 +3194,188 @@ uct_tcp_ep_check(uct_ep_h tl_ep, unsigned flags, uct_completion_t *comp)
     hdr->length = 0;
     return uct_tcp_ep_am_send(ep, hdr);
 }
+
+/*
+ * Operations of EPs on a multi-threaded iface: every operation is serialized
+ * with the other ones on the same EP and with the progress of the EP events,
+ * so only the threads which use the same EP contend. EP creation and
+ * destruction also exclude the iface progress, since connection establishment
+ * may move a socket between the EPs.
+ */
+
+ucs_status_t uct_tcp_ep_am_short_mt(uct_ep_h uct_ep, uint8_t am_id,
+                                    uint64_t header, const void *payload,
+                                    unsigned length)
+{
+    uct_tcp_ep_t *ep       = ucs_derived_of(uct_ep, uct_tcp_ep_t);
+    uct_tcp_iface_t *iface = ucs_derived_of(uct_ep->iface, uct_tcp_iface_t);
+    ucs_status_t status;
+
+    uct_tcp_ep_lock(iface, ep);
+    status = uct_tcp_ep_am_short(uct_ep, am_id, header, payload, length);
+    uct_tcp_ep_unlock(iface, ep);
+    return status;
+}
+
+ucs_status_t uct_tcp_ep_am_short_iov_mt(uct_ep_h uct_ep, uint8_t am_id,
+                                        const uct_iov_t *iov, size_t iovcnt)
+{
+    uct_tcp_ep_t *ep       = ucs_derived_of(uct_ep, uct_tcp_ep_t);
+    uct_tcp_iface_t *iface = ucs_derived_of(uct_ep->iface, uct_tcp_iface_t);
+    ucs_status_t status;
+
+    uct_tcp_ep_lock(iface, ep);
+    status = uct_tcp_ep_am_short_iov(uct_ep, am_id, iov, iovcnt);
+    uct_tcp_ep_unlock(iface, ep);
+    return status;
+}
+
+ssize_t uct_tcp_ep_am_bcopy_mt(uct_ep_h uct_ep, uint8_t am_id,
+                               uct_pack_callback_t pack_cb, void *arg,
+                               unsigned flags)
+{
+    uct_tcp_ep_t *ep       = ucs_derived_of(uct_ep, uct_tcp_ep_t);
+    uct_tcp_iface_t *iface = ucs_derived_of(uct_ep->iface, uct_tcp_iface_t);
+    ssize_t packed_length;
+
+    uct_tcp_ep_lock(iface, ep);
+    packed_length = uct_tcp_ep_am_bcopy(uct_ep, am_id, pack_cb, arg, flags);
+    uct_tcp_ep_unlock(iface, ep);
+    return packed_length;
+}
+
+ucs_status_t uct_tcp_ep_am_zcopy_mt(uct_ep_h uct_ep, uint8_t am_id,
+                                    const void *header, unsigned header_length,
+                                    const uct_iov_t *iov, size_t iovcnt,
+                                    unsigned flags, uct_completion_t *comp)
+{
+    uct_tcp_ep_t *ep       = ucs_derived_of(uct_ep, uct_tcp_ep_t);
+    uct_tcp_iface_t *iface = ucs_derived_of(uct_ep->iface, uct_tcp_iface_t);
+    ucs_status_t status;
+
+    uct_tcp_ep_lock(iface, ep);
+    status = uct_tcp_ep_am_zcopy(uct_ep, am_id, header, header_length, iov,
+                                 iovcnt, flags, comp);
+    uct_tcp_ep_unlock(iface, ep);
+    return status;
+}
+
+ucs_status_t uct_tcp_ep_put_zcopy_mt(uct_ep_h uct_ep, const uct_iov_t *iov,
+                                     size_t iovcnt, uint64_t remote_addr,
+                                     uct_rkey_t rkey, uct_completion_t *comp)
+{
+    uct_tcp_ep_t *ep       = ucs_derived_of(uct_ep, uct_tcp_ep_t);
+    uct_tcp_iface_t *iface = ucs_derived_of(uct_ep->iface, uct_tcp_iface_t);
+    ucs_status_t status;
+
+    uct_tcp_ep_lock(iface, ep);
+    status = uct_tcp_ep_put_zcopy(uct_ep, iov, iovcnt, remote_addr, rkey,
+                                  comp);
+    uct_tcp_ep_unlock(iface, ep);
+    return status;
+}
+
+ucs_status_t uct_tcp_ep_get_zcopy_mt(uct_ep_h uct_ep, const uct_iov_t *iov,
+                                     size_t iovcnt, uint64_t remote_addr,
+                                     uct_rkey_t rkey, uct_completion_t *comp)
+{
+    uct_tcp_ep_t *ep       = ucs_derived_of(uct_ep, uct_tcp_ep_t);
+    uct_tcp_iface_t *iface = ucs_derived_of(uct_ep->iface, uct_tcp_iface_t);
+    ucs_status_t status;
+
+    uct_tcp_ep_lock(iface, ep);
+    status = uct_tcp_ep_get_zcopy(uct_ep, iov, iovcnt, remote_addr, rkey,
+                                  comp);
+    uct_tcp_ep_unlock(iface, ep);
+    return status;
+}
+
+ucs_status_t uct_tcp_ep_pending_add_mt(uct_ep_h tl_ep, uct_pending_req_t *req,
+                                       unsigned flags)
+{
+    uct_tcp_ep_t *ep       = ucs_derived_of(tl_ep, uct_tcp_ep_t);
+    uct_tcp_iface_t *iface = ucs_derived_of(tl_ep->iface, uct_tcp_iface_t);
+    ucs_status_t status;
+
+    uct_tcp_ep_lock(iface, ep);
+    status = uct_tcp_ep_pending_add(tl_ep, req, flags);
+    uct_tcp_ep_unlock(iface, ep);
+    return status;
+}
+
+void uct_tcp_ep_pending_purge_mt(uct_ep_h tl_ep,
+                                 uct_pending_purge_callback_t cb, void *arg)
+{
+    uct_tcp_ep_t *ep       = ucs_derived_of(tl_ep, uct_tcp_ep_t);
+    uct_tcp_iface_t *iface = ucs_derived_of(tl_ep->iface, uct_tcp_iface_t);
+
+    uct_tcp_ep_lock(iface, ep);
+    uct_tcp_ep_pending_purge(tl_ep, cb, arg);
+    uct_tcp_ep_unlock(iface, ep);
+}
+
+ucs_status_t uct_tcp_ep_flush_mt(uct_ep_h tl_ep, unsigned flags,
+                                 uct_completion_t *comp)
+{
+    uct_tcp_ep_t *ep       = ucs_derived_of(tl_ep, uct_tcp_ep_t);
+    uct_tcp_iface_t *iface = ucs_derived_of(tl_ep->iface, uct_tcp_iface_t);
+    ucs_status_t status;
+
+    uct_tcp_ep_lock(iface, ep);
+    status = uct_tcp_ep_flush(tl_ep, flags, comp);
+    uct_tcp_ep_unlock(iface, ep);
+    return status;
+}
+
+ucs_status_t
+uct_tcp_ep_check_mt(uct_ep_h tl_ep, unsigned flags, uct_completion_t *comp)
+{
+    uct_tcp_ep_t *ep       = ucs_derived_of(tl_ep, uct_tcp_ep_t);
+    uct_tcp_iface_t *iface = ucs_derived_of(tl_ep->iface, uct_tcp_iface_t);
+    ucs_status_t status;
+
+    uct_tcp_ep_lock(iface, ep);
+    status = uct_tcp_ep_check(tl_ep, flags, comp);
+    uct_tcp_ep_unlock(iface, ep);
+    return status;
+}
+
+ucs_status_t uct_tcp_ep_create_mt(const uct_ep_params_t *params,
+                                  uct_ep_h *ep_p)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(params->iface, uct_tcp_iface_t);
+    ucs_status_t status;
+
+    ucs_recursive_spin_lock(&iface->progress_lock);
+    status = uct_tcp_ep_create(params, ep_p);
+    ucs_recursive_spin_unlock(&iface->progress_lock);
+    return status;
+}
+
+void uct_tcp_ep_destroy_mt(uct_ep_h tl_ep)
+{
+    uct_tcp_ep_t *ep       = ucs_derived_of(tl_ep, uct_tcp_ep_t);
+    uct_tcp_iface_t *iface = ucs_derived_of(tl_ep->iface, uct_tcp_iface_t);
+
+    ucs_recursive_spin_lock(&iface->progress_lock);
+    uct_tcp_ep_lock(iface, ep);
+    uct_tcp_ep_destroy(tl_ep);
+    uct_tcp_ep_unlock(iface, ep);
+    ucs_recursive_spin_unlock(&iface->progress_lock);
+}
+
+ucs_status_t uct_tcp_ep_connect_to_ep_mt(uct_ep_h tl_ep,
+                                         const uct_device_addr_t *dev_addr,
+                                         const uct_ep_addr_t *ep_addr)
+{
+    uct_tcp_ep_t *ep       = ucs_derived_of(tl_ep, uct_tcp_ep_t);
+    uct_tcp_iface_t *iface = ucs_derived_of(tl_ep->iface, uct_tcp_iface_t);
+    ucs_status_t status;
+
+    ucs_recursive_spin_lock(&iface->progress_lock);
+    uct_tcp_ep_lock(iface, ep);
+    status = uct_tcp_ep_connect_to_ep(tl_ep, dev_addr, ep_addr);
+    uct_tcp_ep_unlock(iface, ep);
+    ucs_recursive_spin_unlock(&iface->progress_lock);
+    return status;
+}
@@ -43,6 +43,34 @@ static ucs_config_field_t uct_tcp_iface_config_table[] = {
    "Threshold for switching from send() to sendmsg() for short active messages",
    ucs_offsetof(uct_tcp_iface_config_t, sendv_thresh), UCS_CONFIG_TYPE_MEMUNITS},
 
+  {"MSG_ZEROCOPY_THRESH", "inf",
+   "Threshold for sending AM and PUT Zcopy payload with MSG_ZEROCOPY, so the\n"
+   "kernel does not copy the user's buffer to the socket buffer. The operation\n"
+   "is completed when the kernel notifies that it released the buffer.",
+   ucs_offsetof(uct_tcp_iface_config_t, msg_zcopy_thresh),
+   UCS_CONFIG_TYPE_MEMUNITS},
+
+  {"RX_DIRECT_THRESH", "16kb",
+   "Threshold for receiving the payload of active messages directly to the\n"
+   "user's buffer, if the user provides it once the message header arrives.\n"
+   "This saves copying the payload out of the receive buffer, but needs a\n"
+   "separate recv() call for the payload.",
+   ucs_offsetof(uct_tcp_iface_config_t, rx_direct_thresh),
+   UCS_CONFIG_TYPE_MEMUNITS},
+
+  {"NUM_STREAMS", "1",
+   "Number of sockets used by a connection. The additional sockets are\n"
+   "established on first use and carry the stripes of large PUT and GET Zcopy\n"
+   "operations, so a single connection is not limited by the bandwidth of one\n"
+   "TCP flow. Additional sockets are not used by a multi-threaded worker.",
+   ucs_offsetof(uct_tcp_iface_config_t, num_streams), UCS_CONFIG_TYPE_UINT},
+
+  {"STRIPE_THRESH", "256kb",
+   "Threshold for striping PUT and GET Zcopy operations across the sockets of\n"
+   "a connection, if NUM_STREAMS is greater than 1.",
+   ucs_offsetof(uct_tcp_iface_config_t, stripe_thresh),
+   UCS_CONFIG_TYPE_MEMUNITS},
+
   {"PREFER_DEFAULT", "y",
    "Give higher priority to the default network interface on the host",
    ucs_offsetof(uct_tcp_iface_config_t, prefer_default), UCS_CONFIG_TYPE_BOOL},
@@ -51,6 +79,11 @@ static ucs_config_field_t uct_tcp_iface_config_table[] = {
    "Enable PUT Zcopy support",
    ucs_offsetof(uct_tcp_iface_config_t, put_enable), UCS_CONFIG_TYPE_BOOL},
 
+  {"GET_ENABLE", "y",
+   "Enable GET Zcopy support. GET is emulated by a request which is answered\n"
+   "by the peer with the data sent from the remote memory buffer.",
+   ucs_offsetof(uct_tcp_iface_config_t, get_enable), UCS_CONFIG_TYPE_BOOL},
+
   {"CONN_NB", "n",
    "Enable non-blocking connection establishment. It may improve startup "
    "time, but can lead to connection resets due to high load on TCP/IP stack",
@@ -70,6 +103,16 @@ static ucs_config_field_t uct_tcp_iface_config_table[] = {
    "option usually provides better performance",
    ucs_offsetof(uct_tcp_iface_config_t, sockopt_nodelay), UCS_CONFIG_TYPE_BOOL},
 
+  {"EVENT_BACKEND", "epoll",
+   "Mechanism to wait for socket events:\n"
+   " epoll    - Use epoll(7).\n"
+   " io_uring - Use poll requests on io_uring(7) ring, which submits all socket\n"
+   "            event changes in one system call per progress and does not enter\n"
+   "            the kernel when there are no changes. Falls back to epoll if\n"
+   "            io_uring is not supported by the system.",
+   ucs_offsetof(uct_tcp_iface_config_t, event_backend),
+   UCS_CONFIG_TYPE_ENUM(ucs_event_set_backend_names)},
+
   UCT_TCP_SEND_RECV_BUF_FIELDS(ucs_offsetof(uct_tcp_iface_config_t, sockopt)),
 
   UCT_TCP_SYN_CNT(ucs_offsetof(uct_tcp_iface_config_t, syn_cnt)),
@@ -169,6 +212,10 @@ static ucs_status_t uct_tcp_iface_query(uct_iface_h tl_iface, uct_iface_attr_t *
     attr->cap.am.max_short = am_buf_size;
     attr->cap.am.max_bcopy = am_buf_size;
 
+    if (iface->config.rx_direct_thresh != UCS_MEMUNITS_INF) {
+        attr->cap.flags   |= UCT_IFACE_FLAG_AM_RECV_DIRECT;
+    }
+
     if (uct_tcp_keepalive_is_enabled(iface)) {
         attr->cap.flags   |= UCT_IFACE_FLAG_EP_KEEPALIVE;
     }
@@ -192,6 +239,15 @@ static ucs_status_t uct_tcp_iface_query(uct_iface_h tl_iface, uct_iface_attr_t *
             attr->cap.put.opt_zcopy_align  = 1;
             attr->cap.flags               |= UCT_IFACE_FLAG_PUT_ZCOPY;
         }
+
+        if (iface->config.get_enable) {
+            /* GET */
+            attr->cap.get.max_iov          = UCT_TCP_EP_GET_ZCOPY_MAX_IOV;
+            attr->cap.get.max_zcopy        = UCT_TCP_EP_GET_ZCOPY_MAX -
+                                             UCT_TCP_EP_GET_SERVICE_LENGTH;
+            attr->cap.get.opt_zcopy_align  = 1;
+            attr->cap.flags               |= UCT_IFACE_FLAG_GET_ZCOPY;
+        }
     }
 
     attr->bandwidth.dedicated = 0;
@@ -219,6 +275,16 @@ static ucs_status_t uct_tcp_iface_event_fd_get(uct_iface_h tl_iface, int *fd_p)
     return ucs_event_set_fd_get(iface->event_set, fd_p);
 }
 
+static ucs_status_t uct_tcp_iface_event_arm(uct_iface_h tl_iface,
+                                            unsigned events)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(tl_iface, uct_tcp_iface_t);
+
+    /* Sockets may be added to the event set from the async context while the
+     * iface is not progressed, make sure they are reported through the fd */
+    return ucs_event_set_arm(iface->event_set);
+}
+
 static void uct_tcp_iface_handle_events(void *callback_data,
                                         ucs_event_set_types_t events,
                                         void *arg)
@@ -228,6 +294,9 @@ static void uct_tcp_iface_handle_events(void *callback_data,
 
     ucs_assertv(ep->conn_state != UCT_TCP_EP_CONN_STATE_CLOSED, "ep=%p", ep);
 
+    if (events & UCS_EVENT_SET_EVERR) {
+        *count += uct_tcp_ep_progress_zcopy_comp(ep);
+    }
     if (events & UCS_EVENT_SET_EVREAD) {
         *count += uct_tcp_ep_cm_state[ep->conn_state].rx_progress(ep);
     }
@@ -236,19 +305,33 @@ static void uct_tcp_iface_handle_events(void *callback_data,
     }
 }
 
-unsigned uct_tcp_iface_progress(uct_iface_h tl_iface)
+static void uct_tcp_iface_handle_events_mt(void *callback_data,
+                                           ucs_event_set_types_t events,
+                                           void *arg)
 {
-    uct_tcp_iface_t *iface = ucs_derived_of(tl_iface, uct_tcp_iface_t);
-    unsigned max_events    = iface->config.max_poll;
-    unsigned count         = 0;
+    uct_tcp_ep_t *ep       = (uct_tcp_ep_t*)callback_data;
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+
+    /* Exclude the operations posted on the EP by other threads */
+    uct_tcp_ep_lock(iface, ep);
+    uct_tcp_iface_handle_events(callback_data, events, arg);
+    uct_tcp_ep_unlock(iface, ep);
+}
+
+static UCS_F_ALWAYS_INLINE unsigned
+uct_tcp_iface_do_progress(uct_tcp_iface_t *iface,
+                          ucs_event_set_handler_t event_set_handler)
+{
+    unsigned max_events = iface->config.max_poll;
+    unsigned count      = 0;
     unsigned read_events;
     ucs_status_t status;
 
     do {
         read_events = ucs_min(ucs_sys_event_set_max_wait_events, max_events);
         status = ucs_event_set_wait(iface->event_set, &read_events,
-                                    0, uct_tcp_iface_handle_events,
-                                    (void *)&count);
+                                    0, event_set_handler, (void *)&count);
         max_events -= read_events;
         ucs_trace_poll("iface=%p ucs_event_set_wait() returned %d: "
                        "read events=%u, total=%u",
@@ -260,6 +343,29 @@ unsigned uct_tcp_iface_progress(uct_iface_h tl_iface)
     return count;
 }
 
+unsigned uct_tcp_iface_progress(uct_iface_h tl_iface)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(tl_iface, uct_tcp_iface_t);
+
+    return uct_tcp_iface_do_progress(iface, uct_tcp_iface_handle_events);
+}
+
+static unsigned uct_tcp_iface_progress_mt(uct_iface_h tl_iface)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(tl_iface, uct_tcp_iface_t);
+    unsigned count;
+
+    /* Only one thread polls the event set, the others don't wait for it and
+     * continue posting operations */
+    if (!ucs_recursive_spin_trylock(&iface->progress_lock)) {
+        return 0;
+    }
+
+    count = uct_tcp_iface_do_progress(iface, uct_tcp_iface_handle_events_mt);
+    ucs_recursive_spin_unlock(&iface->progress_lock);
+    return count;
+}
+
 static ucs_status_t uct_tcp_iface_flush(uct_iface_h tl_iface, unsigned flags,
                                         uct_completion_t *comp)
 {
@@ -278,6 +384,19 @@ static ucs_status_t uct_tcp_iface_flush(uct_iface_h tl_iface, unsigned flags,
     return UCS_OK;
 }
 
+static ucs_status_t uct_tcp_iface_fence(uct_iface_h tl_iface, unsigned flags)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(tl_iface, uct_tcp_iface_t);
+    uct_tcp_ep_t *ep;
+
+    ucs_list_for_each(ep, &iface->stream_ep_list, stream.list) {
+        uct_tcp_ep_stream_fence(ep);
+    }
+
+    UCT_TL_IFACE_STAT_FENCE(&iface->super);
+    return UCS_OK;
+}
+
 static void
 uct_tcp_iface_connect_handler(int listen_fd, ucs_event_set_types_t events,
                               void *arg)
@@ -335,6 +454,13 @@ ucs_status_t uct_tcp_iface_set_sockopt(uct_tcp_iface_t *iface, int fd,
         return status;
     }
 
+    if ((iface->config.msg_zcopy_thresh != UCS_MEMUNITS_INF) &&
+        (ucs_socket_set_zcopy(fd) != UCS_OK)) {
+        ucs_diag("tcp_iface %p: MSG_ZEROCOPY is not supported, disabling it",
+                 iface);
+        iface->config.msg_zcopy_thresh = UCS_MEMUNITS_INF;
+    }
+
     return ucs_tcp_base_set_syn_cnt(fd, iface->config.syn_cnt);
 }
 
@@ -344,22 +470,53 @@ static uct_iface_ops_t uct_tcp_iface_ops = {
     .ep_am_bcopy              = uct_tcp_ep_am_bcopy,
     .ep_am_zcopy              = uct_tcp_ep_am_zcopy,
     .ep_put_zcopy             = uct_tcp_ep_put_zcopy,
+    .ep_get_zcopy             = uct_tcp_ep_get_zcopy,
     .ep_pending_add           = uct_tcp_ep_pending_add,
     .ep_pending_purge         = uct_tcp_ep_pending_purge,
     .ep_flush                 = uct_tcp_ep_flush,
-    .ep_fence                 = uct_base_ep_fence,
+    .ep_fence                 = uct_tcp_ep_fence,
     .ep_check                 = uct_tcp_ep_check,
     .ep_create                = uct_tcp_ep_create,
     .ep_destroy               = uct_tcp_ep_destroy,
     .ep_get_address           = uct_tcp_ep_get_address,
     .ep_connect_to_ep         = uct_tcp_ep_connect_to_ep,
     .iface_flush              = uct_tcp_iface_flush,
-    .iface_fence              = uct_base_iface_fence,
+    .iface_fence              = uct_tcp_iface_fence,
     .iface_progress_enable    = uct_base_iface_progress_enable,
     .iface_progress_disable   = uct_base_iface_progress_disable,
     .iface_progress           = uct_tcp_iface_progress,
     .iface_event_fd_get       = uct_tcp_iface_event_fd_get,
-    .iface_event_arm          = ucs_empty_function_return_success,
+    .iface_event_arm          = uct_tcp_iface_event_arm,
+    .iface_close              = UCS_CLASS_DELETE_FUNC_NAME(uct_tcp_iface_t),
+    .iface_query              = uct_tcp_iface_query,
+    .iface_get_address        = uct_tcp_iface_get_address,
+    .iface_get_device_address = uct_tcp_iface_get_device_address,
+    .iface_is_reachable       = uct_tcp_iface_is_reachable
+};
+
+static uct_iface_ops_t uct_tcp_iface_mt_ops = {
+    .ep_am_short              = uct_tcp_ep_am_short_mt,
+    .ep_am_short_iov          = uct_tcp_ep_am_short_iov_mt,
+    .ep_am_bcopy              = uct_tcp_ep_am_bcopy_mt,
+    .ep_am_zcopy              = uct_tcp_ep_am_zcopy_mt,
+    .ep_put_zcopy             = uct_tcp_ep_put_zcopy_mt,
+    .ep_get_zcopy             = uct_tcp_ep_get_zcopy_mt,
+    .ep_pending_add           = uct_tcp_ep_pending_add_mt,
+    .ep_pending_purge         = uct_tcp_ep_pending_purge_mt,
+    .ep_flush                 = uct_tcp_ep_flush_mt,
+    .ep_fence                 = uct_base_ep_fence,
+    .ep_check                 = uct_tcp_ep_check_mt,
+    .ep_create                = uct_tcp_ep_create_mt,
+    .ep_destroy               = uct_tcp_ep_destroy_mt,
+    .ep_get_address           = uct_tcp_ep_get_address,
+    .ep_connect_to_ep         = uct_tcp_ep_connect_to_ep_mt,
+    .iface_flush              = uct_tcp_iface_flush,
+    .iface_fence              = uct_base_iface_fence,
+    .iface_progress_enable    = uct_base_iface_progress_enable,
+    .iface_progress_disable   = uct_base_iface_progress_disable,
+    .iface_progress           = uct_tcp_iface_progress_mt,
+    .iface_event_fd_get       = uct_tcp_iface_event_fd_get,
+    .iface_event_arm          = uct_tcp_iface_event_arm,
     .iface_close              = UCS_CLASS_DELETE_FUNC_NAME(uct_tcp_iface_t),
     .iface_query              = uct_tcp_iface_query,
     .iface_get_address        = uct_tcp_iface_get_address,
@@ -501,12 +658,36 @@ static ucs_mpool_ops_t uct_tcp_mpool_ops = {
     NULL
 };
 
+static void uct_tcp_iface_locks_init(uct_tcp_iface_t *iface)
+{
+    int i;
+
+    ucs_recursive_spinlock_init(&iface->lock, 0);
+    ucs_recursive_spinlock_init(&iface->progress_lock, 0);
+    for (i = 0; i < UCT_TCP_IFACE_EP_LOCKS_COUNT; ++i) {
+        ucs_recursive_spinlock_init(&iface->ep_locks[i], 0);
+    }
+}
+
+static void uct_tcp_iface_locks_cleanup(uct_tcp_iface_t *iface)
+{
+    int i;
+
+    for (i = 0; i < UCT_TCP_IFACE_EP_LOCKS_COUNT; ++i) {
+        ucs_recursive_spinlock_destroy(&iface->ep_locks[i]);
+    }
+    ucs_recursive_spinlock_destroy(&iface->progress_lock);
+    ucs_recursive_spinlock_destroy(&iface->lock);
+}
+
 static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
                            const uct_iface_params_t *params,
                            const uct_iface_config_t *tl_config)
 {
     uct_tcp_iface_config_t *config = ucs_derived_of(tl_config,
                                                     uct_tcp_iface_config_t);
+    int thread_safe                = ucs_derived_of(worker, uct_priv_worker_t)->
+                                     thread_mode == UCS_THREAD_MODE_MULTI;
     ucs_status_t status;
 
     UCT_CHECK_PARAM(params->field_mask & UCT_IFACE_PARAM_FIELD_OPEN_MODE,
@@ -516,13 +697,10 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
         return UCS_ERR_UNSUPPORTED;
     }
 
-    if (ucs_derived_of(worker, uct_priv_worker_t)->thread_mode == UCS_THREAD_MODE_MULTI) {
-        ucs_error("TCP transport does not support multi-threaded worker");
-        return UCS_ERR_INVALID_PARAM;
-    }
-
-    UCS_CLASS_CALL_SUPER_INIT(uct_base_iface_t, &uct_tcp_iface_ops, md, worker,
-                              params, tl_config
+    UCS_CLASS_CALL_SUPER_INIT(uct_base_iface_t,
+                              thread_safe ? &uct_tcp_iface_mt_ops :
+                                            &uct_tcp_iface_ops,
+                              md, worker, params, tl_config
                               UCS_STATS_ARG((params->field_mask &
                                              UCT_IFACE_PARAM_FIELD_STATS_ROOT) ?
                                             params->stats_root : NULL)
@@ -531,6 +709,7 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
     ucs_strncpy_zero(self->if_name, params->mode.device.dev_name,
                      sizeof(self->if_name));
     self->outstanding        = 0;
+    self->config.thread_safe = thread_safe;
     self->config.tx_seg_size = config->tx_seg_size +
                                sizeof(uct_tcp_am_hdr_t);
     self->config.rx_seg_size = config->rx_seg_size +
@@ -543,6 +722,27 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
         self->config.sendv_thresh = UCS_MEMUNITS_INF;
     }
 
+    self->config.msg_zcopy_thresh = config->msg_zcopy_thresh;
+    self->config.rx_direct_thresh = config->rx_direct_thresh;
+    self->config.stripe_thresh    = config->stripe_thresh;
+
+    if ((config->num_streams == 0) ||
+        (config->num_streams > UCT_TCP_EP_MAX_STREAMS)) {
+        ucs_error("unsupported number of streams (%u), expected 1..%u",
+                  config->num_streams, UCT_TCP_EP_MAX_STREAMS);
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    if (thread_safe && (config->num_streams > 1)) {
+        /* Striping would have to lock the auxiliary EPs from operations on
+         * the user's EP, while their progress locks them in reverse order */
+        ucs_debug("tcp_iface %p: multi-threaded iface uses a single socket "
+                  "per connection", self);
+        self->config.num_streams = 1;
+    } else {
+        self->config.num_streams = config->num_streams;
+    }
+
     /* Maximum IOV count allowed by user's configuration (considering TCP
      * protocol and user's AM headers that use 1st and 2nd IOVs
      * correspondingly) and system constraints */
@@ -572,6 +772,7 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
                                      self->config.zcopy.hdr_offset;
     self->config.prefer_default    = config->prefer_default;
     self->config.put_enable        = config->put_enable;
+    self->config.get_enable        = config->get_enable;
     self->config.conn_nb           = config->conn_nb;
     self->config.max_poll          = config->max_poll;
     self->config.max_conn_retries  = config->max_conn_retries;
@@ -600,6 +801,8 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
     }
 
     ucs_list_head_init(&self->ep_list);
+    ucs_list_head_init(&self->stream_ep_list);
+    ucs_queue_head_init(&self->zcopy_comp_q);
     ucs_conn_match_init(&self->conn_match_ctx,
                         ucs_field_sizeof(uct_tcp_ep_t, peer_addr),
                         &uct_tcp_cm_conn_match_ops);
@@ -612,6 +815,8 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
         return UCS_ERR_INVALID_PARAM;
     }
 
+    uct_tcp_iface_locks_init(self);
+
     status = ucs_mpool_init(&self->tx_mpool, 0, self->config.tx_seg_size,
                             0, UCS_SYS_CACHE_LINE_SIZE,
                             (config->tx_mpool.bufs_grow == 0) ?
@@ -619,7 +824,7 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
                             config->tx_mpool.max_bufs,
                             &uct_tcp_mpool_ops, "uct_tcp_iface_tx_buf_mp");
     if (status != UCS_OK) {
-        goto err;
+        goto err_cleanup_locks;
     }
 
     status = ucs_mpool_init(&self->rx_mpool, 0, self->config.rx_seg_size * 2,
@@ -632,18 +837,38 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
         goto err_cleanup_tx_mpool;
     }
 
+    if (thread_safe) {
+        /* Let the threads get and put the buffers without a lock */
+        status = ucs_mpool_tcache_enable(&self->tx_mpool,
+                                         UCT_TCP_IFACE_MPOOL_TCACHE_SIZE);
+        if (status != UCS_OK) {
+            goto err_cleanup_rx_mpool;
+        }
+
+        status = ucs_mpool_tcache_enable(&self->rx_mpool,
+                                         UCT_TCP_IFACE_MPOOL_TCACHE_SIZE);
+        if (status != UCS_OK) {
+            goto err_cleanup_rx_mpool;
+        }
+    }
+
     status = uct_tcp_netif_inaddr(self->if_name, &self->config.ifaddr,
                                   &self->config.netmask);
     if (status != UCS_OK) {
         goto err_cleanup_rx_mpool;
     }
 
-    status = ucs_event_set_create(&self->event_set);
+    status = ucs_event_set_create_backend(&self->event_set,
+                                          config->event_backend);
     if (status != UCS_OK) {
         status = UCS_ERR_IO_ERROR;
         goto err_cleanup_rx_mpool;
     }
 
+    ucs_debug("tcp_iface %p: using %s event set", self,
+              ucs_event_set_backend_names[
+                      ucs_event_set_backend_get(self->event_set)]);
+
     status = uct_tcp_iface_listener_init(self);
     if (status != UCS_OK) {
         goto err_cleanup_event_set;
@@ -657,15 +882,20 @@ err_cleanup_rx_mpool:
     ucs_mpool_cleanup(&self->rx_mpool, 1);
 err_cleanup_tx_mpool:
     ucs_mpool_cleanup(&self->tx_mpool, 1);
+err_cleanup_locks:
+    uct_tcp_iface_locks_cleanup(self);
 err:
     return status;
 }
 
 static void uct_tcp_iface_ep_list_cleanup(uct_tcp_iface_t *iface)
 {
-    uct_tcp_ep_t *ep, *tmp;
+    uct_tcp_ep_t *ep;
 
-    ucs_list_for_each_safe(ep, tmp, &iface->ep_list, list) {
+    /* Destroying an EP also destroys its auxiliary EPs, so always take
+     * the head of the list */
+    while (!ucs_list_is_empty(&iface->ep_list)) {
+        ep = ucs_list_head(&iface->ep_list, uct_tcp_ep_t, list);
         uct_tcp_ep_destroy_internal(&ep->super.super);
     }
 }
@@ -675,8 +905,10 @@ void uct_tcp_iface_add_ep(uct_tcp_ep_t *ep)
     uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
                                             uct_tcp_iface_t);
     UCS_ASYNC_BLOCK(iface->super.worker->async);
+    uct_tcp_iface_lock(iface);
     ucs_assert(!(ep->flags & UCT_TCP_EP_FLAG_ON_MATCH_CTX));
     ucs_list_add_tail(&iface->ep_list, &ep->list);
+    uct_tcp_iface_unlock(iface);
     UCS_ASYNC_UNBLOCK(iface->super.worker->async);
 }
 
@@ -685,11 +917,66 @@ void uct_tcp_iface_remove_ep(uct_tcp_ep_t *ep)
     uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
                                             uct_tcp_iface_t);
     UCS_ASYNC_BLOCK(iface->super.worker->async);
+    uct_tcp_iface_lock(iface);
     ucs_assert(!(ep->flags & UCT_TCP_EP_FLAG_ON_MATCH_CTX));
     ucs_list_del(&ep->list);
+    uct_tcp_iface_unlock(iface);
     UCS_ASYNC_UNBLOCK(iface->super.worker->async);
 }
 
+static unsigned uct_tcp_iface_zcopy_comp_progress(void *arg)
+{
+    uct_tcp_iface_t *iface = (uct_tcp_iface_t*)arg;
+    uct_tcp_ep_zcopy_comp_t *zcopy_comp;
+    unsigned count         = 0;
+
+    uct_tcp_iface_lock(iface);
+    while (!ucs_queue_is_empty(&iface->zcopy_comp_q)) {
+        zcopy_comp = ucs_queue_pull_elem_non_empty(&iface->zcopy_comp_q,
+                                                   uct_tcp_ep_zcopy_comp_t,
+                                                   elem);
+        /* The completion callback may post new operations */
+        uct_tcp_iface_unlock(iface);
+        if (zcopy_comp->comp != NULL) {
+            uct_invoke_completion(zcopy_comp->comp, zcopy_comp->status);
+        }
+        uct_tcp_iface_zcopy_comp_release(iface, zcopy_comp);
+        count++;
+        uct_tcp_iface_lock(iface);
+    }
+    uct_tcp_iface_unlock(iface);
+
+    return count;
+}
+
+static int
+uct_tcp_iface_zcopy_comp_remove_filter(const ucs_callbackq_elem_t *elem,
+                                       void *arg)
+{
+    return (elem->cb == uct_tcp_iface_zcopy_comp_progress) &&
+           (elem->arg == arg);
+}
+
+void uct_tcp_iface_zcopy_comp_failed(uct_tcp_iface_t *iface,
+                                     uct_tcp_ep_zcopy_comp_t *zcopy_comp,
+                                     ucs_status_t status)
+{
+    uct_worker_cb_id_t cb_id = UCS_CALLBACKQ_ID_NULL;
+
+    zcopy_comp->status = status;
+
+    uct_tcp_iface_lock(iface);
+    if (ucs_queue_is_empty(&iface->zcopy_comp_q)) {
+        uct_worker_progress_register_safe(&iface->super.worker->super,
+                                          uct_tcp_iface_zcopy_comp_progress,
+                                          iface, UCS_CALLBACKQ_FLAG_ONESHOT,
+                                          &cb_id);
+    }
+
+    ucs_queue_push(&iface->zcopy_comp_q, &zcopy_comp->elem);
+    uct_tcp_iface_unlock(iface);
+}
+
 int uct_tcp_iface_is_self_addr(uct_tcp_iface_t *iface,
                                const struct sockaddr_in *peer_addr)
 {
@@ -705,6 +992,7 @@ int uct_tcp_iface_is_self_addr(uct_tcp_iface_t *iface,
 
 static UCS_CLASS_CLEANUP_FUNC(uct_tcp_iface_t)
 {
+    uct_tcp_ep_zcopy_comp_t *zcopy_comp;
     ucs_status_t status;
 
     ucs_debug("tcp_iface %p: destroying", self);
@@ -722,11 +1010,18 @@ static UCS_CLASS_CLEANUP_FUNC(uct_tcp_iface_t)
     ucs_conn_match_cleanup(&self->conn_match_ctx);
     ucs_ptr_map_destroy(&self->ep_ptr_map);
 
+    ucs_callbackq_remove_if(&self->super.worker->super.progress_q,
+                            uct_tcp_iface_zcopy_comp_remove_filter, self);
+    ucs_queue_for_each_extract(zcopy_comp, &self->zcopy_comp_q, elem, 1) {
+        uct_tcp_iface_zcopy_comp_release(self, zcopy_comp);
+    }
+
     ucs_mpool_cleanup(&self->rx_mpool, 1);
     ucs_mpool_cleanup(&self->tx_mpool, 1);
 
     ucs_close_fd(&self->listen_fd);
     ucs_event_set_cleanup(self->event_set);
+    uct_tcp_iface_locks_cleanup(self);
 }
 
 UCS_CLASS_DEFINE(uct_tcp_iface_t, uct_base_iface_t);
@@ -30,17 +30,36 @@ extern "C" {
 
 class test_ucp_am_base : public ucp_test {
 public:
+    enum {
+        ENABLE_PROTO = UCS_BIT(30)
+    };
+
     static void get_test_variants(std::vector<ucp_test_variant>& variants) {
         add_variant(variants, UCP_FEATURE_AM);
     }
 
+    static void
+    get_test_variants_proto(std::vector<ucp_test_variant>& variants) {
+        add_variant_values(variants, get_test_variants, 0);
+        add_variant_values(variants, get_test_variants, ENABLE_PROTO, "proto");
+    }
+
     virtual void init() {
         modify_config("MAX_EAGER_LANES", "2");
+        if (enable_proto()) {
+            modify_config("PROTO_ENABLE", "y");
+        }
 
         ucp_test::init();
         sender().connect(&receiver(), get_ep_params());
         receiver().connect(&sender(), get_ep_params());
     }
+
+protected:
+    virtual bool enable_proto()
+    {
+        return false;
+    }
 };
 
 class test_ucp_am : public test_ucp_am_base {
@@ -783,6 +802,9 @@ public:
     {
         add_variant_values(variants, get_test_dts, 0);
         add_variant_values(variants, get_test_dts, UCP_AM_SEND_REPLY, "reply");
+        add_variant_values(variants, get_test_dts, ENABLE_PROTO, "proto");
+        add_variant_values(variants, get_test_dts,
+                           UCP_AM_SEND_REPLY | ENABLE_PROTO, "reply_proto");
     }
 
     void init()
@@ -800,11 +822,17 @@ public:
 
     virtual unsigned get_send_flag()
     {
-        return get_variant_value(1);
+        return get_variant_value(1) & ~ENABLE_PROTO;
+    }
+
+protected:
+    virtual bool enable_proto()
+    {
+        return get_variant_value(1) & ENABLE_PROTO;
     }
 };
 
-UCS_TEST_P(test_ucp_am_nbx_dts, short_send)
+UCS_TEST_P(test_ucp_am_nbx_dts, short_send, "RNDV_THRESH=-1")
 {
     test_am(1);
 }
@@ -843,6 +871,11 @@ UCP_INSTANTIATE_TEST_CASE(test_ucp_am_nbx_dts)
 
 class test_ucp_am_nbx_rndv : public test_ucp_am_nbx {
 public:
+    static void get_test_variants(std::vector<ucp_test_variant>& variants)
+    {
+        get_test_variants_proto(variants);
+    }
+
     test_ucp_am_nbx_rndv()
     {
         m_rx_dt      = ucp_dt_make_contig(1);
@@ -924,6 +957,11 @@ public:
         return UCS_INPROGRESS;
     }
 
+    virtual bool enable_proto()
+    {
+        return get_variant_value() & ENABLE_PROTO;
+    }
+
     ucp_datatype_t               m_rx_dt;
     ucs_memory_type_t            m_rx_memtype;
     ucs_status_t                 m_status;
@@ -21,6 +21,11 @@ public:
         add_variant_with_value(variants, features, UCP_ATOMIC_MODE_CPU, "cpu");
         add_variant_with_value(variants, features, UCP_ATOMIC_MODE_DEVICE, "device");
         add_variant_with_value(variants, features, UCP_ATOMIC_MODE_GUESS, "guess");
+        add_variant_with_value(variants, features,
+                               UCP_ATOMIC_MODE_CPU | ENABLE_PROTO, "cpu_proto");
+        add_variant_with_value(variants, features,
+                               UCP_ATOMIC_MODE_GUESS | ENABLE_PROTO,
+                               "guess_proto");
     }
 
     void post(size_t size, void *target_ptr, ucp_rkey_h rkey,
@@ -72,6 +77,10 @@ public:
     }
 
 protected:
+    enum {
+        ENABLE_PROTO = UCS_BIT(4)
+    };
+
     static const uint64_t POST_ATOMIC_OPS  = UCS_BIT(UCP_ATOMIC_OP_ADD) |
                                              UCS_BIT(UCP_ATOMIC_OP_AND) |
                                              UCS_BIT(UCP_ATOMIC_OP_OR)  |
@@ -81,12 +90,16 @@ protected:
                                              UCS_BIT(UCP_ATOMIC_OP_CSWAP);
 
     virtual void init() {
+        int mode                = get_variant_value() & ~ENABLE_PROTO;
         const char *atomic_mode =
-                        (get_variant_value() == UCP_ATOMIC_MODE_CPU)    ? "cpu" :
-                        (get_variant_value() == UCP_ATOMIC_MODE_DEVICE) ? "device" :
-                        (get_variant_value() == UCP_ATOMIC_MODE_GUESS)  ? "guess" :
+                        (mode == UCP_ATOMIC_MODE_CPU)    ? "cpu" :
+                        (mode == UCP_ATOMIC_MODE_DEVICE) ? "device" :
+                        (mode == UCP_ATOMIC_MODE_GUESS)  ? "guess" :
                         "";
         modify_config("ATOMIC_MODE", atomic_mode);
+        if (get_variant_value() & ENABLE_PROTO) {
+            modify_config("PROTO_ENABLE", "y");
+        }
         test_ucp_memheap::init();
     }
 
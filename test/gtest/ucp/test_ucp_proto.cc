@@ -14,6 +14,7 @@ extern "C" {
 #include <ucp/proto/proto_select.h>
 #include <ucp/proto/proto_select.inl>
 #include <ucp/core/ucp_worker.inl>
+#include <ucp/core/ucp_ep.inl>
 }
 
 class test_ucp_proto : public ucp_test {
@@ -111,4 +112,39 @@ UCS_TEST_P(test_ucp_proto, worker_print_info_rkey)
     ucp_worker_print_info(worker(), stdout);
 }
 
+UCS_TEST_P(test_ucp_proto, rndv_rtr_select, "RNDV_SCHEME=put_zcopy")
+{
+    ucp_worker_cfg_index_t ep_cfg_index = sender().ep()->cfg_index;
+    const ucp_proto_threshold_elem_t *thresh_elem;
+    ucp_proto_select_param_t select_param;
+    ucp_rkey_config_key_t rkey_config_key;
+    ucp_worker_cfg_index_t rkey_cfg_index;
+    ucs_memory_info_t mem_info;
+
+    rkey_config_key.ep_cfg_index = ep_cfg_index;
+    rkey_config_key.md_map       = ucp_ep_config(sender().ep())->key.rma_bw_md_map;
+    rkey_config_key.mem_type     = UCS_MEMORY_TYPE_HOST;
+
+    ucs_status_t status = ucp_worker_get_rkey_config(worker(), &rkey_config_key,
+                                                     &rkey_cfg_index);
+    ASSERT_UCS_OK(status);
+
+    mem_info.type    = UCS_MEMORY_TYPE_HOST;
+    mem_info.sys_dev = UCS_SYS_DEVICE_ID_UNKNOWN;
+    ucp_proto_select_param_init(&select_param, UCP_OP_ID_RNDV_RECV, 0,
+                                UCP_DATATYPE_CONTIG, &mem_info, 1);
+
+    thresh_elem = ucp_proto_select_lookup(
+            worker(), &worker()->rkey_config[rkey_cfg_index].proto_select,
+            ep_cfg_index, rkey_cfg_index, &select_param, UCS_MBYTE);
+    if (thresh_elem == NULL) {
+        UCS_TEST_SKIP_R("no rendezvous receive protocol");
+    }
+
+    /* get_zcopy is disabled, so the receiver must ask the sender for data */
+    EXPECT_TRUE(thresh_elem->proto_config.proto->flags &
+                UCP_PROTO_FLAG_RNDV_RTR)
+            << thresh_elem->proto_config.proto->name;
+}
+
 UCP_INSTANTIATE_TEST_CASE(test_ucp_proto)
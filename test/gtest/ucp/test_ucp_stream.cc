@@ -177,7 +177,19 @@ UCP_INSTANTIATE_TEST_CASE(test_ucp_stream_onesided)
 class test_ucp_stream : public test_ucp_stream_base
 {
 public:
+    static void get_test_variants(std::vector<ucp_test_variant>& variants) {
+        add_variant_values(variants, test_ucp_stream_base::get_test_variants,
+                           0);
+        add_variant_values(variants, test_ucp_stream_base::get_test_variants,
+                           1, "proto");
+    }
+
     virtual void init() {
+        if (get_variant_value()) {
+            modify_config("PROTO_ENABLE", "y");
+            modify_config("MAX_EAGER_LANES", "2");
+        }
+
         ucp_test::init();
 
         sender().connect(&receiver(), get_ep_params());
@@ -193,6 +205,7 @@ protected:
     template <typename T, unsigned recv_flags>
     void do_send_exp_recv_test(ucp_datatype_t datatype);
     void do_send_recv_data_recv_test(ucp_datatype_t datatype);
+    void do_send_recv_data_no_wait_test();
 
     /* for self-validation of generic datatype
      * NOTE: it's tested only with byte array data since it's recv completion
@@ -643,6 +656,58 @@ UCS_TEST_P(test_ucp_stream, send_zero_ending_iov_recv_data) {
     }
 }
 
+void test_ucp_stream::do_send_recv_data_no_wait_test()
+{
+    const size_t max_size = 4 * UCS_MBYTE;
+    std::vector<char> sbuf(max_size * 2);
+    std::vector<char> check_pattern;
+    std::vector<void*> sreqs;
+    size_t ssize = 0;
+
+    ucs::fill_random(sbuf, sbuf.size());
+
+    /* Messages of different sizes are sent back to back, so the short and
+     * eager data may arrive while the preceding large messages are still
+     * being received */
+    for (size_t size = 1; size <= max_size; size *= 3) {
+        for (size_t i = 0; i < 2; ++i) {
+            char *buffer = &sbuf[ssize % max_size];
+            ucp::data_type_desc_t dt_desc(DATATYPE, buffer, size);
+            void *sreq = stream_send_nb(dt_desc);
+            ASSERT_FALSE(UCS_PTR_IS_ERR(sreq));
+            sreqs.push_back(sreq);
+            check_pattern.insert(check_pattern.end(), buffer, buffer + size);
+            ssize += size;
+        }
+    }
+
+    std::vector<char> rbuf(ssize, 'r');
+    size_t roffset = 0;
+    do {
+        progress();
+        size_t length;
+        void *rdata = ucp_stream_recv_data_nb(receiver().ep(), &length);
+        ASSERT_FALSE(UCS_PTR_IS_ERR(rdata));
+        if (rdata != NULL) {
+            ASSERT_LE(roffset + length, ssize);
+            memcpy(&rbuf[roffset], rdata, length);
+            roffset += length;
+            ucp_stream_data_release(receiver().ep(), rdata);
+        }
+    } while (roffset < ssize);
+
+    requests_wait(sreqs);
+    EXPECT_EQ(check_pattern, rbuf);
+}
+
+UCS_TEST_P(test_ucp_stream, send_recv_data_no_wait) {
+    do_send_recv_data_no_wait_test();
+}
+
+UCS_TEST_P(test_ucp_stream, send_recv_data_no_wait_rndv, "RNDV_THRESH=16k") {
+    do_send_recv_data_no_wait_test();
+}
+
 UCP_INSTANTIATE_TEST_CASE(test_ucp_stream)
 
 class test_ucp_stream_many2one : public test_ucp_stream_base {
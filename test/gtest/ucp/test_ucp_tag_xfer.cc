@@ -766,6 +766,39 @@ UCS_TEST_P(test_ucp_tag_xfer, send_contig_recv_contig_exp_rndv_probe, "RNDV_THRE
     test_xfer_probe(true, true, true, false);
 }
 
+UCS_TEST_P(test_ucp_tag_xfer, send_contig_recv_contig_exp_rndv_multi,
+           "RNDV_THRESH=1000", "RKEY_PTR_SEG_SIZE=4k",
+           "RKEY_PTR_NT_THRESH=64k") {
+    /* several outstanding rendezvous messages, some of them above the
+     * non-temporal copy threshold, are progressed in turns */
+    static const unsigned num_msgs = 8;
+    std::vector<std::vector<uint8_t> > sendbufs(num_msgs), recvbufs(num_msgs);
+    std::vector<request*> reqs;
+
+    for (unsigned i = 0; i < num_msgs; ++i) {
+        size_t size = (i + 1) * 24 * UCS_KBYTE + i;
+        sendbufs[i].resize(size);
+        recvbufs[i].resize(size, 0);
+        ucs::fill_random(sendbufs[i]);
+        reqs.push_back(recv_nb(&recvbufs[i][0], size, DATATYPE, i, (ucp_tag_t)-1));
+    }
+
+    for (unsigned i = 0; i < num_msgs; ++i) {
+        reqs.push_back(send_nb(&sendbufs[i][0], sendbufs[i].size(), DATATYPE,
+                               i));
+    }
+
+    for (std::vector<request*>::iterator it = reqs.begin(); it != reqs.end();
+         ++it) {
+        ASSERT_FALSE(UCS_PTR_IS_ERR(*it));
+        wait_and_validate(*it);
+    }
+
+    for (unsigned i = 0; i < num_msgs; ++i) {
+        EXPECT_EQ(sendbufs[i], recvbufs[i]) << "message " << i;
+    }
+}
+
 /* rndv send_generic_recv_generic am_rndv with bcopy on the sender side */
 
 UCS_TEST_P(test_ucp_tag_xfer, send_generic_recv_generic_exp_rndv, "RNDV_THRESH=1000") {
@@ -19,6 +19,7 @@ static const int   UCS_EVENT_SET_EXTRA_NUM    = 0xFF;
 
 enum {
     UCS_EVENT_SET_EXTERNAL_FD = UCS_BIT(0),
+    UCS_EVENT_SET_IO_URING    = UCS_BIT(1)
 };
 
 class test_event_set : public ucs::test_base,
@@ -73,10 +74,33 @@ protected:
         return 0;
     }
 
-    void event_set_init(event_set_pthread_callback_t func) {
+    void event_set_create() {
         ucs_status_t status;
+
+        if (GetParam() & UCS_EVENT_SET_EXTERNAL_FD) {
+            status = ucs_event_set_create_from_fd(&m_event_set, m_ext_fd);
+        } else if (GetParam() & UCS_EVENT_SET_IO_URING) {
+            status = ucs_event_set_create_backend(&m_event_set,
+                                                  UCS_EVENT_SET_BACKEND_IO_URING);
+        } else {
+            status = ucs_event_set_create(&m_event_set);
+        }
+        ASSERT_UCS_OK(status);
+        EXPECT_TRUE(m_event_set != NULL);
+
+        if ((GetParam() & UCS_EVENT_SET_IO_URING) &&
+            (ucs_event_set_backend_get(m_event_set) !=
+             UCS_EVENT_SET_BACKEND_IO_URING)) {
+            ucs_event_set_cleanup(m_event_set);
+            UCS_TEST_SKIP_R("io_uring is not supported");
+        }
+    }
+
+    void event_set_init(event_set_pthread_callback_t func) {
         int ret;
 
+        event_set_create();
+
         if (pipe(m_pipefd) == -1) {
             UCS_TEST_ABORT("pipe() failed with error - " <<
                            strerror(errno));
@@ -93,14 +117,6 @@ protected:
             UCS_TEST_ABORT("pthread_create() failed with error - " <<
                            strerror(errno));
         }
-
-        if (GetParam() & UCS_EVENT_SET_EXTERNAL_FD) {
-            status = ucs_event_set_create_from_fd(&m_event_set, m_ext_fd);
-        } else {
-            status = ucs_event_set_create(&m_event_set);
-        }
-        ASSERT_UCS_OK(status);
-        EXPECT_TRUE(m_event_set != NULL);
     }
 
     void event_set_cleanup() {
@@ -141,7 +157,8 @@ protected:
         ucs_status_t status;
 
         /* Check for events on pipe fd */
-        status = ucs_event_set_wait(m_event_set, &nread, 0, handler, arg);
+        status = ucs_event_set_wait(m_event_set, &nread, timeout_ms, handler,
+                                    arg);
         EXPECT_EQ(exp_event, nread);
         EXPECT_UCS_OK(status);
     }
@@ -279,7 +296,32 @@ UCS_TEST_P(test_event_set, ucs_event_set_trig_modes) {
     event_set_cleanup();
 }
 
+UCS_TEST_P(test_event_set, ucs_event_set_mod_batch) {
+    event_set_init(event_set_read_func);
+    event_set_ctl(EVENT_SET_OP_ADD, m_pipefd[0], UCS_EVENT_SET_EVWRITE);
+
+    thread_barrier();
+
+    /* Only the last modification takes effect */
+    for (int i = 0; i < 100; i++) {
+        event_set_ctl(EVENT_SET_OP_MOD, m_pipefd[0],
+                      (i % 2) ? UCS_EVENT_SET_EVREAD : UCS_EVENT_SET_EVWRITE);
+    }
+
+    event_set_wait(1u, 0, event_set_func4, NULL);
+    event_set_wait(1u, 0, event_set_func4, NULL);
+
+    event_set_ctl(EVENT_SET_OP_MOD, m_pipefd[0], UCS_EVENT_SET_EVWRITE);
+    event_set_wait(0u, 0, event_set_func3, NULL);
+
+    event_set_ctl(EVENT_SET_OP_DEL, m_pipefd[0], 0);
+    event_set_cleanup();
+}
+
 INSTANTIATE_TEST_CASE_P(ext_fd, test_event_set,
                         ::testing::Values(static_cast<int>(
                                               UCS_EVENT_SET_EXTERNAL_FD)));
 INSTANTIATE_TEST_CASE_P(int_fd, test_event_set, ::testing::Values(0));
+INSTANTIATE_TEST_CASE_P(io_uring, test_event_set,
+                        ::testing::Values(static_cast<int>(
+                                              UCS_EVENT_SET_IO_URING)));
@@ -7,6 +7,7 @@
 #include <common/test.h>
 extern "C" {
 #include <ucs/datastruct/mpool.h>
+#include <ucs/memory/numa.h>
 }
 
 #include <limits.h>
@@ -244,3 +245,151 @@ UCS_TEST_F(test_mpool, leak_check) {
     scoped_log_handler log_handler(mpool_log_leak_handler);
     ucs_mpool_cleanup(&mp, 1);
 }
+
+UCS_TEST_F(test_mpool, tcache_basic) {
+    static const unsigned max_elems = 18;
+    ucs_status_t status;
+    ucs_mpool_t mp;
+
+    ucs_mpool_ops_t ops = {
+       ucs_mpool_chunk_malloc,
+       ucs_mpool_chunk_free,
+       NULL,
+       NULL
+    };
+
+    status = ucs_mpool_init(&mp, 0, header_size + data_size, header_size, align,
+                            6, max_elems, &ops, "test");
+    ASSERT_UCS_OK(status);
+
+    status = ucs_mpool_tcache_enable(&mp, 8);
+    ASSERT_UCS_OK(status);
+
+    for (unsigned loop = 0; loop < 10; ++loop) {
+        std::vector<void*> objs;
+        for (unsigned i = 0; i < max_elems; ++i) {
+            void *ptr = ucs_mpool_get(&mp);
+            ASSERT_TRUE(ptr != NULL);
+            ASSERT_EQ(0ul, ((uintptr_t)ptr + header_size) % align) << ptr;
+            memset(ptr, 0xAA, header_size + data_size);
+            objs.push_back(ptr);
+        }
+
+        ASSERT_TRUE(NULL == ucs_mpool_get(&mp));
+        EXPECT_TRUE(ucs_mpool_is_empty(&mp));
+
+        for (std::vector<void*>::iterator iter = objs.begin();
+             iter != objs.end(); ++iter) {
+            ucs_mpool_put(*iter);
+        }
+    }
+
+    /* Elements in the thread cache are not reported as leaks */
+    ucs_mpool_cleanup(&mp, 1);
+}
+
+UCS_TEST_F(test_mpool, numa_placement) {
+    static const size_t elem_size = 4096;
+    ucs_status_t status;
+    ucs_mpool_t mp;
+
+    ucs_mpool_ops_t ops = {
+       ucs_mpool_chunk_malloc,
+       ucs_mpool_chunk_free,
+       NULL,
+       NULL
+    };
+
+    for (int placement = UCS_NUMA_PLACEMENT_DEFAULT;
+         placement < UCS_NUMA_PLACEMENT_LAST; ++placement) {
+        push_config();
+        modify_config("MPOOL_NUMA_PLACEMENT",
+                      ucs_numa_placement_names[placement]);
+
+        status = ucs_mpool_init(&mp, 0, elem_size, 0, align, 16, 16, &ops,
+                                "test");
+        ASSERT_UCS_OK(status);
+
+        std::vector<void*> objs;
+        for (unsigned i = 0; i < 16; ++i) {
+            void *ptr = ucs_mpool_get(&mp);
+            ASSERT_TRUE(ptr != NULL);
+            memset(ptr, 0, elem_size);
+            objs.push_back(ptr);
+        }
+
+        /* On a single-node system, pages can only reside on node 0 */
+        int node = ucs_numa_node_of_addr(objs[objs.size() / 2]);
+        if ((ucs_numa_num_nodes() == 1) && (node >= 0)) {
+            EXPECT_EQ(0, node);
+        }
+
+        for (std::vector<void*>::iterator iter = objs.begin();
+             iter != objs.end(); ++iter) {
+            ucs_mpool_put(*iter);
+        }
+
+        ucs_mpool_cleanup(&mp, 1);
+        pop_config();
+    }
+}
+
+class test_mpool_tcache_mt : public test_mpool {
+protected:
+    static const unsigned num_threads = 4;
+    static const unsigned num_objs    = 64;
+
+    static void *thread_func(void *arg) {
+        ucs_mpool_t *mp = reinterpret_cast<ucs_mpool_t*>(arg);
+        const unsigned count = 10000 / ucs::test_time_multiplier();
+        std::vector<uint64_t*> objs;
+
+        for (unsigned loop = 0; loop < count; ++loop) {
+            for (unsigned i = 0; i < num_objs; ++i) {
+                uint64_t *obj = reinterpret_cast<uint64_t*>(ucs_mpool_get(mp));
+                EXPECT_TRUE(obj != NULL);
+                /* Object must not be used by another thread */
+                *obj = pthread_self();
+                objs.push_back(obj);
+            }
+
+            while (!objs.empty()) {
+                EXPECT_EQ((uint64_t)pthread_self(), *objs.back());
+                ucs_mpool_put(objs.back());
+                objs.pop_back();
+            }
+        }
+
+        return NULL;
+    }
+};
+
+UCS_TEST_F(test_mpool_tcache_mt, get_put) {
+    ucs_status_t status;
+    ucs_mpool_t mp;
+    pthread_t threads[num_threads];
+
+    ucs_mpool_ops_t ops = {
+       ucs_mpool_chunk_malloc,
+       ucs_mpool_chunk_free,
+       NULL,
+       NULL
+    };
+
+    status = ucs_mpool_init(&mp, 0, header_size + data_size, header_size, align,
+                            32, UINT_MAX, &ops, "test");
+    ASSERT_UCS_OK(status);
+
+    status = ucs_mpool_tcache_enable(&mp, 16);
+    ASSERT_UCS_OK(status);
+
+    for (unsigned i = 0; i < num_threads; ++i) {
+        pthread_create(&threads[i], NULL, thread_func, &mp);
+    }
+
+    for (unsigned i = 0; i < num_threads; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+
+    ucs_mpool_cleanup(&mp, 1);
+}
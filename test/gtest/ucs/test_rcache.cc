@@ -15,6 +15,7 @@ extern "C" {
 #include <ucm/api/ucm.h>
 }
 #include <set>
+#include <vector>
 
 
 class test_rcache_basic : public ucs::test {
@@ -32,7 +33,9 @@ UCS_TEST_F(test_rcache_basic, create_fail) {
         1000,
         &ops,
         NULL,
-        0
+        0,
+        ULONG_MAX,
+        SIZE_MAX
     };
 
     ucs_rcache_t *rcache;
@@ -57,8 +60,7 @@ protected:
     test_rcache() : m_reg_count(0), m_ptr(NULL) {
     }
 
-    virtual void init() {
-        ucs::test::init();
+    virtual ucs_rcache_params_t rcache_params() {
         static const ucs_rcache_ops_t ops = {
             mem_reg_cb,
             mem_dereg_cb,
@@ -72,8 +74,16 @@ protected:
             1000,
             &ops,
             reinterpret_cast<void*>(this),
-            0
+            0,
+            ULONG_MAX,
+            SIZE_MAX
         };
+        return params;
+    }
+
+    virtual void init() {
+        ucs::test::init();
+        ucs_rcache_params_t params = rcache_params();
         UCS_TEST_CREATE_HANDLE_IF_SUPPORTED(ucs_rcache_t*, m_rcache, ucs_rcache_destroy,
                                             ucs_rcache_create, &params, "test", ucs_stats_get_root());
     }
@@ -542,6 +552,38 @@ UCS_MT_TEST_F(test_rcache, shared_region, 6) {
     shared_free(mem);
 }
 
+/*
+ * Measure the rate of cache hits when several threads look up the page table
+ * concurrently, each one using its own region.
+ */
+UCS_MT_TEST_F(test_rcache, mt_hit_rate, 8) {
+    static const size_t size = 64 * 1024;
+    const unsigned count     = 200000 / ucs::test_time_multiplier();
+
+    /* Add a gap after the region to prevent merging with other threads */
+    void *mem   = alloc_pages(size * 2, PROT_READ|PROT_WRITE);
+    region *reg = get(mem, size);
+    uint32_t id = reg->id;
+    put(reg);
+
+    barrier();
+    ucs_time_t start_time = ucs_get_time();
+    for (unsigned i = 0; i < count; ++i) {
+        reg = get(mem, size);
+        put(reg);
+    }
+    double elapsed = ucs_time_to_sec(ucs_get_time() - start_time);
+    barrier();
+
+    /* All lookups should hit the same region */
+    reg = get(mem, size);
+    EXPECT_EQ(id, reg->id);
+    put(reg);
+
+    UCS_TEST_MESSAGE << count / elapsed / 1e6 << " million hits/sec per thread";
+    munmap(mem, size * 2);
+}
+
 class test_rcache_no_register : public test_rcache {
 protected:
     bool m_fail_reg;
@@ -640,6 +682,98 @@ UCS_MT_TEST_F(test_rcache_no_register, merge_invalid_prot_slow, 5)
     munmap(mem, size1+size2);
 }
 
+class test_rcache_lru : public test_rcache {
+protected:
+    static const unsigned long MAX_REGIONS = 4;
+
+    virtual ucs_rcache_params_t rcache_params() {
+        ucs_rcache_params_t params = test_rcache::rcache_params();
+        params.max_regions         = MAX_REGIONS;
+        params.max_size            = MAX_REGIONS * ucs_get_page_size();
+        return params;
+    }
+};
+
+const unsigned long test_rcache_lru::MAX_REGIONS;
+
+UCS_TEST_F(test_rcache_lru, evict_unused) {
+    static const unsigned num_regions = MAX_REGIONS * 2;
+    const size_t page_size            = ucs_get_page_size();
+    void *mem = alloc_pages(num_regions * 2 * page_size,
+                            PROT_READ|PROT_WRITE);
+    std::vector<uint32_t> ids;
+
+    /* Leave a gap between the regions to prevent merging */
+    for (unsigned i = 0; i < num_regions; ++i) {
+        region *r = get(UCS_PTR_BYTE_OFFSET(mem, i * 2 * page_size), page_size);
+        ids.push_back(r->id);
+        put(r);
+        EXPECT_LE(m_reg_count, MAX_REGIONS);
+    }
+
+    EXPECT_EQ(MAX_REGIONS, m_reg_count);
+    EXPECT_EQ(MAX_REGIONS, m_rcache->num_regions);
+
+    /* Most recently used regions are still in the cache */
+    for (unsigned i = num_regions - MAX_REGIONS; i < num_regions; ++i) {
+        region *r = get(UCS_PTR_BYTE_OFFSET(mem, i * 2 * page_size), page_size);
+        EXPECT_EQ(ids[i], r->id);
+        put(r);
+    }
+
+    /* Least recently used region was evicted */
+    region *r = get(mem, page_size);
+    EXPECT_NE(ids[0], r->id);
+    put(r);
+
+    munmap(mem, num_regions * 2 * page_size);
+}
+
+UCS_TEST_F(test_rcache_lru, inuse_not_evicted) {
+    static const unsigned num_regions = MAX_REGIONS * 2;
+    const size_t page_size            = ucs_get_page_size();
+    void *mem = alloc_pages(num_regions * 2 * page_size,
+                            PROT_READ|PROT_WRITE);
+    std::vector<region*> regions;
+
+    for (unsigned i = 0; i < num_regions; ++i) {
+        regions.push_back(get(UCS_PTR_BYTE_OFFSET(mem, i * 2 * page_size),
+                              page_size));
+    }
+
+    /* All regions are in use, so nothing can be evicted */
+    EXPECT_EQ(num_regions, m_reg_count);
+    for (unsigned i = 0; i < num_regions; ++i) {
+        EXPECT_EQ(uint32_t(MAGIC), regions[i]->magic);
+    }
+
+    /* Released regions are evicted down to the limit */
+    for (unsigned i = 0; i < num_regions; ++i) {
+        put(regions[i]);
+    }
+    EXPECT_EQ(MAX_REGIONS, m_reg_count);
+
+    munmap(mem, num_regions * 2 * page_size);
+}
+
+UCS_TEST_F(test_rcache_lru, max_size) {
+    const size_t page_size = ucs_get_page_size();
+    const size_t size      = (MAX_REGIONS - 1) * page_size;
+    void *mem              = alloc_pages(size * 4, PROT_READ|PROT_WRITE);
+
+    region *r1 = get(mem, size);
+    put(r1);
+    EXPECT_EQ(1u, m_reg_count);
+
+    /* The second region exceeds the size limit, so the first is evicted */
+    region *r2 = get(UCS_PTR_BYTE_OFFSET(mem, size * 2), size);
+    put(r2);
+    EXPECT_EQ(1u, m_reg_count);
+    EXPECT_LE(m_rcache->total_size, MAX_REGIONS * page_size);
+
+    munmap(mem, size * 4);
+}
+
 #ifdef ENABLE_STATS
 class test_rcache_stats : public test_rcache {
 protected:
@@ -668,7 +802,7 @@ protected:
     /* a helper function for stats tests debugging */
     void dump_stats() {
         printf("gets %d hf %d hs %d misses %d merges %d unmaps %d"
-               " unmaps_inv %d puts %d regs %d deregs %d\n",
+               " unmaps_inv %d puts %d regs %d deregs %d evicts %d\n",
                get_counter(UCS_RCACHE_GETS),
                get_counter(UCS_RCACHE_HITS_FAST),
                get_counter(UCS_RCACHE_HITS_SLOW),
@@ -678,7 +812,8 @@ protected:
                get_counter(UCS_RCACHE_UNMAP_INVALIDATES),
                get_counter(UCS_RCACHE_PUTS),
                get_counter(UCS_RCACHE_REGS),
-               get_counter(UCS_RCACHE_DEREGS));
+               get_counter(UCS_RCACHE_DEREGS),
+               get_counter(UCS_RCACHE_EVICTS));
     }
 };
 
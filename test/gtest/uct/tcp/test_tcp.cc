@@ -260,3 +260,572 @@ UCS_TEST_P(test_uct_tcp, listener_flood_connect_and_close) {
 }
 
 _UCT_INSTANTIATE_TEST_CASE(test_uct_tcp, tcp)
+
+
+class test_uct_tcp_msg_zcopy : public uct_test {
+public:
+    static const uint8_t  AM_ID = 1;
+    static const uint64_t SEED  = 0x1122334455667788ul;
+
+    void init() {
+        modify_config("MSG_ZEROCOPY_THRESH", "0");
+        uct_test::init();
+
+        m_sender = uct_test::create_entity(0);
+        m_entities.push_back(m_sender);
+
+        m_receiver = uct_test::create_entity(0);
+        m_entities.push_back(m_receiver);
+
+        m_sender->connect(0, *m_receiver, 0);
+
+        // the option is disabled on the iface if the socket does not support it
+        uct_tcp_iface *iface = (uct_tcp_iface*)m_sender->iface();
+        if (iface->config.msg_zcopy_thresh == UCS_MEMUNITS_INF) {
+            UCS_TEST_SKIP_R("MSG_ZEROCOPY is not supported");
+        }
+
+        m_am_count    = 0;
+        m_hdr         = 0;
+        m_comp.func   = comp_cb;
+        m_comp.count  = 0;
+        m_comp.status = UCS_OK;
+    }
+
+    static void comp_cb(uct_completion_t *self) {
+        EXPECT_UCS_OK(self->status);
+    }
+
+    static ucs_status_t am_handler(void *arg, void *data, size_t length,
+                                   unsigned flags) {
+        test_uct_tcp_msg_zcopy *self =
+                reinterpret_cast<test_uct_tcp_msg_zcopy*>(arg);
+
+        EXPECT_EQ(self->m_am_count, *static_cast<uint64_t*>(data));
+        mem_buffer::pattern_check(UCS_PTR_BYTE_OFFSET(data, sizeof(uint64_t)),
+                                  length - sizeof(uint64_t), SEED);
+        self->m_am_count++;
+        return UCS_OK;
+    }
+
+protected:
+    size_t payload_size() {
+        return ucs_min(m_sender->iface_attr().cap.am.max_zcopy -
+                       sizeof(m_hdr), 16384ul);
+    }
+
+    entity           *m_sender;
+    entity           *m_receiver;
+    volatile size_t  m_am_count;
+    uint64_t         m_hdr;
+    uct_completion_t m_comp;
+};
+
+UCS_TEST_P(test_uct_tcp_msg_zcopy, am_zcopy) {
+    const size_t num_sends = 1000 / ucs::test_time_multiplier();
+    mapped_buffer sendbuf(payload_size(), SEED, *m_sender);
+    ucs_status_t status;
+
+    status = uct_iface_set_am_handler(m_receiver->iface(), AM_ID, am_handler,
+                                      this, 0);
+    ASSERT_UCS_OK(status);
+
+    m_comp.count = num_sends;
+    for (size_t i = 0; i < num_sends; ++i) {
+        m_hdr = i;
+        do {
+            status = uct_ep_am_zcopy(m_sender->ep(0), AM_ID, &m_hdr,
+                                     sizeof(m_hdr), sendbuf.iov(), 1, 0,
+                                     &m_comp);
+            if (status == UCS_ERR_NO_RESOURCE) {
+                progress();
+            }
+        } while (status == UCS_ERR_NO_RESOURCE);
+
+        // the operation is completed by the kernel notification
+        ASSERT_EQ(UCS_INPROGRESS, status);
+        // the header must not be referenced after the operation returns
+        m_hdr = UINT64_MAX;
+    }
+
+    wait_for_value(&m_comp.count, 0, true);
+    EXPECT_EQ(0, m_comp.count);
+    wait_for_value(&m_am_count, num_sends, true);
+    EXPECT_EQ(num_sends, m_am_count);
+
+    flush();
+}
+
+UCS_TEST_SKIP_COND_P(test_uct_tcp_msg_zcopy, put_zcopy_flush,
+                     !check_caps(UCT_IFACE_FLAG_PUT_ZCOPY)) {
+    mapped_buffer sendbuf(payload_size(), SEED, *m_sender);
+    mapped_buffer recvbuf(payload_size(), 0, *m_receiver);
+    ucs_status_t status;
+
+    m_comp.count = 2;
+    do {
+        status = uct_ep_put_zcopy(m_sender->ep(0), sendbuf.iov(), 1,
+                                  recvbuf.addr(), recvbuf.rkey(), &m_comp);
+        if (status == UCS_ERR_NO_RESOURCE) {
+            progress();
+        }
+    } while (status == UCS_ERR_NO_RESOURCE);
+    ASSERT_EQ(UCS_INPROGRESS, status);
+
+    do {
+        status = uct_ep_flush(m_sender->ep(0), 0, &m_comp);
+        if (status == UCS_ERR_NO_RESOURCE) {
+            progress();
+        }
+    } while (status == UCS_ERR_NO_RESOURCE);
+    ASSERT_EQ(UCS_INPROGRESS, status);
+
+    wait_for_value(&m_comp.count, 0, true);
+    EXPECT_EQ(0, m_comp.count);
+    recvbuf.pattern_check(SEED);
+}
+
+_UCT_INSTANTIATE_TEST_CASE(test_uct_tcp_msg_zcopy, tcp)
+
+
+class test_uct_tcp_get_zcopy : public uct_test {
+public:
+    void init() {
+        uct_test::init();
+
+        m_sender = uct_test::create_entity(0);
+        m_entities.push_back(m_sender);
+
+        m_receiver = uct_test::create_entity(0);
+        m_entities.push_back(m_receiver);
+
+        m_sender->connect(0, *m_receiver, 0);
+    }
+
+protected:
+    void put_zcopy(mapped_buffer &sendbuf, mapped_buffer &recvbuf,
+                   uct_completion_t *comp) {
+        ucs_status_t status;
+
+        do {
+            status = uct_ep_put_zcopy(m_sender->ep(0), sendbuf.iov(), 1,
+                                      recvbuf.addr(), recvbuf.rkey(), comp);
+            if (status == UCS_ERR_NO_RESOURCE) {
+                progress();
+            }
+        } while (status == UCS_ERR_NO_RESOURCE);
+        ASSERT_EQ(UCS_INPROGRESS, status);
+    }
+
+    void get_zcopy(mapped_buffer &recvbuf, mapped_buffer &remote_buf,
+                   uct_completion_t *comp) {
+        ucs_status_t status;
+
+        do {
+            status = uct_ep_get_zcopy(m_sender->ep(0), recvbuf.iov(), 1,
+                                      remote_buf.addr(), remote_buf.rkey(),
+                                      comp);
+            if (status == UCS_ERR_NO_RESOURCE) {
+                progress();
+            }
+        } while (status == UCS_ERR_NO_RESOURCE);
+        ASSERT_EQ(UCS_INPROGRESS, status);
+    }
+
+    void flush_ep(uct_completion_t *comp) {
+        ucs_status_t status;
+
+        do {
+            status = uct_ep_flush(m_sender->ep(0), 0, comp);
+            if (status == UCS_ERR_NO_RESOURCE) {
+                progress();
+            }
+        } while (status == UCS_ERR_NO_RESOURCE);
+        ASSERT_EQ(UCS_INPROGRESS, status);
+    }
+
+    entity *m_sender;
+    entity *m_receiver;
+};
+
+UCS_TEST_SKIP_COND_P(test_uct_tcp_get_zcopy, get_after_put,
+                     !check_caps(UCT_IFACE_FLAG_PUT_ZCOPY |
+                                 UCT_IFACE_FLAG_GET_ZCOPY)) {
+    const size_t num_iters = 100 / ucs::test_time_multiplier();
+    const size_t max_size  = 256 * UCS_KBYTE;
+    uct_completion_t comp;
+
+    comp.func   = (uct_completion_callback_t)ucs_empty_function;
+    comp.status = UCS_OK;
+
+    for (size_t i = 0; i < num_iters; ++i) {
+        size_t size = ucs::rand() % max_size;
+        mapped_buffer sendbuf(size, i, *m_sender);
+        mapped_buffer remote_buf(size, 0, *m_receiver);
+        mapped_buffer recvbuf(size, 0, *m_sender);
+
+        // GET must observe the data written by the preceding PUT, and the
+        // flush must not complete before the GET data arrived
+        comp.count = 2;
+        put_zcopy(sendbuf, remote_buf, NULL);
+        get_zcopy(recvbuf, remote_buf, &comp);
+        flush_ep(&comp);
+
+        wait_for_value(&comp.count, 0, true);
+        ASSERT_EQ(0, comp.count);
+        ASSERT_UCS_OK(comp.status);
+        remote_buf.pattern_check(i);
+        recvbuf.pattern_check(i);
+    }
+}
+
+_UCT_INSTANTIATE_TEST_CASE(test_uct_tcp_get_zcopy, tcp)
+
+
+class test_uct_tcp_stream : public test_uct_tcp_get_zcopy {
+public:
+    void init() {
+        modify_config("NUM_STREAMS", "4");
+        modify_config("STRIPE_THRESH", "16k");
+        test_uct_tcp_get_zcopy::init();
+    }
+
+protected:
+    void fence_ep() {
+        ASSERT_UCS_OK(uct_ep_fence(m_sender->ep(0), 0));
+    }
+};
+
+UCS_TEST_SKIP_COND_P(test_uct_tcp_stream, put_fence_get,
+                     !check_caps(UCT_IFACE_FLAG_PUT_ZCOPY |
+                                 UCT_IFACE_FLAG_GET_ZCOPY)) {
+    const size_t num_iters = 50 / ucs::test_time_multiplier();
+    const size_t max_size  = UCS_MBYTE;
+    uct_completion_t comp;
+
+    comp.func   = (uct_completion_callback_t)ucs_empty_function;
+    comp.status = UCS_OK;
+
+    for (size_t i = 0; i < num_iters; ++i) {
+        size_t size = ucs::rand() % max_size;
+        mapped_buffer sendbuf(size, i, *m_sender);
+        mapped_buffer remote_buf(size, 0, *m_receiver);
+        mapped_buffer recvbuf(size, 0, *m_sender);
+
+        // Stripes of the PUT may be sent on other sockets than the stripes
+        // of the GET, so the GET is ordered after the PUT by the fence
+        comp.count = 3;
+        put_zcopy(sendbuf, remote_buf, &comp);
+        fence_ep();
+        get_zcopy(recvbuf, remote_buf, &comp);
+        flush_ep(&comp);
+
+        wait_for_value(&comp.count, 0, true);
+        ASSERT_EQ(0, comp.count);
+        ASSERT_UCS_OK(comp.status);
+        remote_buf.pattern_check(i);
+        recvbuf.pattern_check(i);
+    }
+}
+
+UCS_TEST_SKIP_COND_P(test_uct_tcp_stream, put_multi,
+                     !check_caps(UCT_IFACE_FLAG_PUT_ZCOPY)) {
+    const size_t num_bufs = 8;
+    const size_t size     = 512 * UCS_KBYTE;
+    std::vector<mapped_buffer*> sendbufs, remote_bufs;
+    uct_completion_t comp;
+
+    comp.func   = (uct_completion_callback_t)ucs_empty_function;
+    comp.count  = num_bufs + 1;
+    comp.status = UCS_OK;
+
+    for (size_t i = 0; i < num_bufs; ++i) {
+        sendbufs.push_back(new mapped_buffer(size, i + 1, *m_sender));
+        remote_bufs.push_back(new mapped_buffer(size, 0, *m_receiver));
+        put_zcopy(*sendbufs.back(), *remote_bufs.back(), &comp);
+    }
+
+    flush_ep(&comp);
+    wait_for_value(&comp.count, 0, true);
+    EXPECT_EQ(0, comp.count);
+    EXPECT_UCS_OK(comp.status);
+
+    for (size_t i = 0; i < num_bufs; ++i) {
+        remote_bufs[i]->pattern_check(i + 1);
+        delete sendbufs[i];
+        delete remote_bufs[i];
+    }
+}
+
+_UCT_INSTANTIATE_TEST_CASE(test_uct_tcp_stream, tcp)
+
+
+class test_uct_tcp_am_recv_direct : public uct_test {
+public:
+    static const uint8_t  AM_ID = 3;
+    static const uint64_t SEED  = 0x8877665544332211ul;
+
+    typedef struct {
+        uct_completion_t            super;
+        test_uct_tcp_am_recv_direct *test;
+        uint64_t                    seq;
+    } recv_comp_t;
+
+    void init() {
+        modify_config("RX_DIRECT_THRESH", "1k");
+        uct_test::init();
+
+        m_sender = uct_test::create_entity(0);
+        m_entities.push_back(m_sender);
+
+        m_receiver = uct_test::create_entity(0);
+        m_entities.push_back(m_receiver);
+
+        m_sender->connect(0, *m_receiver, 0);
+
+        m_am_count     = 0;
+        m_direct_calls = 0;
+        m_direct_count = 0;
+    }
+
+    static ucs_status_t am_handler(void *arg, void *data, size_t length,
+                                   unsigned flags) {
+        test_uct_tcp_am_recv_direct *self =
+                reinterpret_cast<test_uct_tcp_am_recv_direct*>(arg);
+        uint64_t seq = *static_cast<uint64_t*>(data);
+
+        mem_buffer::pattern_check(UCS_PTR_BYTE_OFFSET(data, sizeof(seq)),
+                                  length - sizeof(seq), SEED);
+        self->m_am_count++;
+        return UCS_OK;
+    }
+
+    static ucs_status_t
+    am_recv_direct_cb(void *arg, void *data, size_t length, void **payload_p,
+                      uct_completion_t **comp_p) {
+        test_uct_tcp_am_recv_direct *self =
+                reinterpret_cast<test_uct_tcp_am_recv_direct*>(arg);
+        uint64_t seq = *static_cast<uint64_t*>(data);
+
+        // decline every other message to exercise both receive paths
+        if (self->m_direct_calls++ % 2) {
+            return UCS_ERR_UNSUPPORTED;
+        }
+
+        recv_comp_t *comp = new recv_comp_t;
+        comp->super.func   = recv_comp_cb;
+        comp->super.count  = 1;
+        comp->super.status = UCS_OK;
+        comp->test         = self;
+        comp->seq          = seq;
+
+        self->m_buffers[seq].resize(length - sizeof(seq));
+        *payload_p = &self->m_buffers[seq][0];
+        *comp_p    = &comp->super;
+        return UCS_OK;
+    }
+
+    static void recv_comp_cb(uct_completion_t *self) {
+        recv_comp_t *comp = ucs_container_of(self, recv_comp_t, super);
+        std::vector<char> &buffer = comp->test->m_buffers[comp->seq];
+
+        EXPECT_UCS_OK(self->status);
+        mem_buffer::pattern_check(&buffer[0], buffer.size(), SEED);
+        comp->test->m_direct_count++;
+        comp->test->m_am_count++;
+        delete comp;
+    }
+
+protected:
+    entity                           *m_sender;
+    entity                           *m_receiver;
+    volatile size_t                  m_am_count;
+    size_t                           m_direct_calls;
+    size_t                           m_direct_count;
+    std::map<uint64_t, std::vector<char> > m_buffers;
+};
+
+UCS_TEST_SKIP_COND_P(test_uct_tcp_am_recv_direct, am_zcopy,
+                     !check_caps(UCT_IFACE_FLAG_AM_ZCOPY |
+                                 UCT_IFACE_FLAG_AM_RECV_DIRECT)) {
+    const size_t num_sends = 200 / ucs::test_time_multiplier();
+    const size_t batch     = 8;
+    const size_t size      = ucs_min(m_sender->iface_attr().cap.am.max_zcopy -
+                                     sizeof(uint64_t), 20000ul);
+    mapped_buffer sendbuf(size, SEED, *m_sender);
+    uct_completion_t comp;
+    ucs_status_t status;
+
+    comp.func   = (uct_completion_callback_t)ucs_empty_function;
+    comp.count  = 1;
+    comp.status = UCS_OK;
+
+    status = uct_iface_set_am_handler(m_receiver->iface(), AM_ID, am_handler,
+                                      this, 0);
+    ASSERT_UCS_OK(status);
+
+    status = uct_iface_set_am_recv_direct_handler(m_receiver->iface(), AM_ID,
+                                                  sizeof(uint64_t),
+                                                  am_recv_direct_cb, this);
+    ASSERT_UCS_OK(status);
+
+    for (uint64_t seq = 0; seq < num_sends; ++seq) {
+        do {
+            status = uct_ep_am_zcopy(m_sender->ep(0), AM_ID, &seq, sizeof(seq),
+                                     sendbuf.iov(), 1, 0, &comp);
+            if (status == UCS_ERR_NO_RESOURCE) {
+                progress();
+            }
+        } while (status == UCS_ERR_NO_RESOURCE);
+        ASSERT_UCS_OK_OR_INPROGRESS(status);
+        if (status == UCS_INPROGRESS) {
+            ++comp.count;
+        }
+
+        // let several messages accumulate in the socket before the receiver
+        // reads them, so that some of them are received partially
+        if ((seq % batch) == (batch - 1)) {
+            wait_for_value(&m_am_count, seq + 1, true);
+        }
+    }
+
+    --comp.count;
+    wait_for_value(&comp.count, 0, true);
+    wait_for_value(&m_am_count, num_sends, true);
+    EXPECT_EQ(num_sends, m_am_count);
+    EXPECT_GT(m_direct_count, 0ul);
+
+    status = uct_iface_set_am_recv_direct_handler(m_receiver->iface(), AM_ID,
+                                                  0, NULL, NULL);
+    ASSERT_UCS_OK(status);
+    flush();
+}
+
+_UCT_INSTANTIATE_TEST_CASE(test_uct_tcp_am_recv_direct, tcp)
+
+
+class test_uct_tcp_mt : public uct_test {
+public:
+    static const uint8_t  AM_ID       = 2;
+    static const unsigned NUM_THREADS = 4;
+
+    typedef struct {
+        uint64_t thread_index;
+        uint64_t sn;
+    } am_data_t;
+
+    typedef struct {
+        test_uct_tcp_mt *test;
+        unsigned        index;
+        am_data_t       data;
+    } thread_arg_t;
+
+    void init() {
+        uct_iface_params_t params;
+
+        uct_test::init();
+
+        params.field_mask  = UCT_IFACE_PARAM_FIELD_OPEN_MODE |
+                             UCT_IFACE_PARAM_FIELD_RX_HEADROOM;
+        params.open_mode   = UCT_IFACE_OPEN_MODE_DEVICE;
+        params.rx_headroom = 0;
+        m_sender           = uct_test::create_entity(params,
+                                                     UCS_THREAD_MODE_MULTI);
+        m_entities.push_back(m_sender);
+
+        m_receiver = uct_test::create_entity(0);
+        m_entities.push_back(m_receiver);
+
+        for (unsigned i = 0; i < NUM_THREADS; ++i) {
+            m_sender->connect(i, *m_receiver, i);
+            m_expected_sn[i] = 0;
+        }
+
+        m_num_sends = 10000 / ucs::test_time_multiplier();
+        m_am_count  = 0;
+    }
+
+    static ucs_status_t am_handler(void *arg, void *data, size_t length,
+                                   unsigned flags) {
+        test_uct_tcp_mt *self = reinterpret_cast<test_uct_tcp_mt*>(arg);
+        am_data_t *am_data    = static_cast<am_data_t*>(data);
+
+        EXPECT_EQ(sizeof(*am_data), length);
+        EXPECT_LT(am_data->thread_index, (uint64_t)NUM_THREADS);
+        // messages sent on the same EP arrive in order
+        EXPECT_EQ(self->m_expected_sn[am_data->thread_index]++, am_data->sn);
+        self->m_am_count++;
+        return UCS_OK;
+    }
+
+    static size_t pack_cb(void *dest, void *arg) {
+        memcpy(dest, arg, sizeof(am_data_t));
+        return sizeof(am_data_t);
+    }
+
+    static void *send_thread_func(void *arg) {
+        thread_arg_t *thread_arg = static_cast<thread_arg_t*>(arg);
+        test_uct_tcp_mt *self    = thread_arg->test;
+        uct_ep_h ep              = self->m_sender->ep(thread_arg->index);
+        ssize_t packed_length;
+
+        thread_arg->data.thread_index = thread_arg->index;
+        for (thread_arg->data.sn = 0; thread_arg->data.sn < self->m_num_sends;
+             ++thread_arg->data.sn) {
+            do {
+                packed_length = uct_ep_am_bcopy(ep, AM_ID, pack_cb,
+                                                &thread_arg->data, 0);
+                if (packed_length == UCS_ERR_NO_RESOURCE) {
+                    // only one of the threads polls the events at a time
+                    self->m_sender->progress();
+                }
+            } while (packed_length == UCS_ERR_NO_RESOURCE);
+
+            EXPECT_EQ((ssize_t)sizeof(am_data_t), packed_length);
+        }
+
+        return NULL;
+    }
+
+protected:
+    entity           *m_sender;
+    entity           *m_receiver;
+    size_t           m_num_sends;
+    volatile size_t  m_am_count;
+    uint64_t         m_expected_sn[NUM_THREADS];
+};
+
+UCS_TEST_P(test_uct_tcp_mt, am_bcopy_multi_thread) {
+    pthread_t threads[NUM_THREADS];
+    thread_arg_t args[NUM_THREADS];
+    ucs_status_t status;
+    int ret;
+
+    status = uct_iface_set_am_handler(m_receiver->iface(), AM_ID, am_handler,
+                                      this, 0);
+    ASSERT_UCS_OK(status);
+
+    for (unsigned i = 0; i < NUM_THREADS; ++i) {
+        args[i].test  = this;
+        args[i].index = i;
+        ret = pthread_create(&threads[i], NULL, send_thread_func, &args[i]);
+        ASSERT_EQ(0, ret);
+    }
+
+    // the main thread progresses the sender concurrently with the senders
+    ucs_time_t deadline = ucs_get_time() +
+                          ucs_time_from_sec(60.0 * ucs::test_time_multiplier());
+    while ((m_am_count < (m_num_sends * NUM_THREADS)) &&
+           (ucs_get_time() < deadline)) {
+        progress();
+    }
+
+    for (unsigned i = 0; i < NUM_THREADS; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+
+    EXPECT_EQ(m_num_sends * NUM_THREADS, m_am_count);
+    flush();
+}
+
+_UCT_INSTANTIATE_TEST_CASE(test_uct_tcp_mt, tcp)
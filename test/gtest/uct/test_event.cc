@@ -6,6 +6,7 @@
 */
 
 extern "C" {
+#include <ucs/sys/sys.h>
 #include <ucs/time/time.h>
 }
 #include <common/test.h>
@@ -212,3 +213,35 @@ UCS_TEST_SKIP_COND_P(test_uct_event, sig_am,
 }
 
 UCT_INSTANTIATE_NO_SELF_TEST_CASE(test_uct_event);
+
+
+class test_uct_event_mm : public test_uct_event {
+public:
+    void init() {
+        ucs_status_t status;
+        int fd;
+
+        /* the eventfd signal mode duplicates the receiver's eventfd */
+        status = ucs_sys_pidfd_getfd(getpid(), 0, &fd);
+        if (status != UCS_OK) {
+            UCS_TEST_SKIP_R(std::string("pidfd_getfd() is not supported: ") +
+                            ucs_status_string(status));
+        }
+
+        close(fd);
+        test_uct_event::init();
+    }
+};
+
+UCS_TEST_SKIP_COND_P(test_uct_event_mm, am_eventfd,
+                     !check_caps(UCT_IFACE_FLAG_CB_SYNC |
+                                 UCT_IFACE_FLAG_AM_BCOPY) ||
+                     !check_event_caps(UCT_IFACE_FLAG_EVENT_RECV),
+                     "SIGNAL_MODE=eventfd")
+{
+    test_recv_am(UCT_EVENT_RECV, 0);
+}
+
+_UCT_INSTANTIATE_TEST_CASE(test_uct_event_mm, posix)
+_UCT_INSTANTIATE_TEST_CASE(test_uct_event_mm, sysv)
+_UCT_INSTANTIATE_TEST_CASE(test_uct_event_mm, xpmem)
@@ -100,10 +100,71 @@ public:
 
     static const size_t NUM_SENDERS = 10;
 
+    void test_am_bcopy()
+    {
+        const unsigned num_sends = 1000 / ucs::test_time_multiplier();
+        ucs_status_t status;
+
+        ucs::ptr_vector<mapped_buffer> buffers;
+        for (unsigned i = 0; i < NUM_SENDERS; ++i) {
+            entity *sender = create_entity(0);
+            mapped_buffer *buffer = new mapped_buffer(
+                    sender->iface_attr().cap.am.max_bcopy, 0, *sender);
+            sender->connect(0, *m_receiver, i);
+            m_entities.push_back(sender);
+            buffers.push_back(buffer);
+        }
+
+        m_am_count = 0;
+
+        status = uct_iface_set_am_handler(m_receiver->iface(), AM_ID,
+                                          am_handler, (void*)this, 0);
+        ASSERT_UCS_OK(status);
+
+        for (unsigned i = 0; i < num_sends; ++i) {
+            unsigned sender_num = ucs::rand() % NUM_SENDERS;
+
+            mapped_buffer& buffer = buffers.at(sender_num);
+            buffer.pattern_fill(i);
+
+            ssize_t packed_len;
+            for (;;) {
+                const entity& sender = ent(sender_num + 1);
+                packed_len = uct_ep_am_bcopy(sender.ep(0), AM_ID,
+                                             mapped_buffer::pack,
+                                             (void*)&buffer, 0);
+                if (packed_len != UCS_ERR_NO_RESOURCE) {
+                    break;
+                }
+                sender.progress();
+                m_receiver->progress();
+            }
+            if (packed_len < 0) {
+                ASSERT_UCS_OK((ucs_status_t)packed_len);
+            }
+        }
+
+        while (m_am_count < num_sends) {
+            progress();
+        }
+
+        status = uct_iface_set_am_handler(m_receiver->iface(), AM_ID,
+                                          NULL, NULL, 0);
+        ASSERT_UCS_OK(status);
+
+        check_backlog();
+
+        for (unsigned i = 0; i < NUM_SENDERS; ++i) {
+            ent(i + 1).flush();
+        }
+
+        buffers.clear();
+    }
+
 protected:
     volatile uint32_t             m_am_count;
     std::vector<receive_desc_t*>  m_backlog;
-    entity                       *m_receiver;  
+    entity                       *m_receiver;
 };
 
 
@@ -111,63 +172,101 @@ UCS_TEST_SKIP_COND_P(test_many2one_am, am_bcopy,
                      !check_caps(UCT_IFACE_FLAG_AM_BCOPY |
                                  UCT_IFACE_FLAG_CB_SYNC))
 {
-    const unsigned num_sends = 1000 / ucs::test_time_multiplier();
+    test_am_bcopy();
+}
+
+UCT_INSTANTIATE_NO_SELF_TEST_CASE(test_many2one_am)
+
+
+class test_many2one_am_fifo_shards : public test_many2one_am {
+public:
+    static const unsigned NUM_SHARDS = 4;
+
+    void init() {
+        modify_config("FIFO_SHARDS", ucs::to_string(NUM_SHARDS));
+        test_many2one_am::init();
+    }
+
+    static ucs_status_t am_order_handler(void *arg, void *data, size_t length,
+                                         unsigned flags) {
+        test_many2one_am_fifo_shards *self =
+                reinterpret_cast<test_many2one_am_fifo_shards*>(arg);
+        uint64_t hdr = *(uint64_t*)data;
+        unsigned sender_num = hdr >> 32;
+
+        EXPECT_EQ(self->m_expected_sn.at(sender_num), uint32_t(hdr));
+        self->m_expected_sn.at(sender_num) = uint32_t(hdr) + 1;
+        ucs_atomic_add32(&self->m_am_count, 1);
+        return UCS_OK;
+    }
+
+protected:
+    std::vector<uint32_t> m_expected_sn;
+};
+
+
+UCS_TEST_SKIP_COND_P(test_many2one_am_fifo_shards, am_bcopy,
+                     !check_caps(UCT_IFACE_FLAG_AM_BCOPY |
+                                 UCT_IFACE_FLAG_CB_SYNC))
+{
+    test_am_bcopy();
+}
+
+UCS_TEST_SKIP_COND_P(test_many2one_am_fifo_shards, am_short_order,
+                     !check_caps(UCT_IFACE_FLAG_AM_SHORT |
+                                 UCT_IFACE_FLAG_CB_SYNC))
+{
+    const unsigned num_sends = 10000 / ucs::test_time_multiplier();
+    std::vector<uint32_t> sn(NUM_SENDERS, 0);
     ucs_status_t status;
 
-    ucs::ptr_vector<mapped_buffer> buffers;
     for (unsigned i = 0; i < NUM_SENDERS; ++i) {
         entity *sender = create_entity(0);
-        mapped_buffer *buffer = new mapped_buffer(
-                            sender->iface_attr().cap.am.max_bcopy, 0, *sender);
         sender->connect(0, *m_receiver, i);
         m_entities.push_back(sender);
-        buffers.push_back(buffer);
     }
 
     m_am_count = 0;
+    m_expected_sn.assign(NUM_SENDERS, 0);
 
-    status = uct_iface_set_am_handler(m_receiver->iface(), AM_ID, am_handler,
-                                      (void*)this, 0);
+    status = uct_iface_set_am_handler(m_receiver->iface(), AM_ID,
+                                      am_order_handler, (void*)this, 0);
     ASSERT_UCS_OK(status);
 
+    /* messages of every sender must arrive in order, regardless of the shard
+     * which the sender was assigned to */
     for (unsigned i = 0; i < num_sends; ++i) {
         unsigned sender_num = ucs::rand() % NUM_SENDERS;
+        const entity& sender = ent(sender_num + 1);
+        uint64_t hdr         = (uint64_t(sender_num) << 32) | sn[sender_num];
 
-        mapped_buffer& buffer = buffers.at(sender_num);
-        buffer.pattern_fill(i);
-
-        ssize_t packed_len;
         for (;;) {
-            const entity& sender = ent(sender_num + 1);
-            packed_len = uct_ep_am_bcopy(sender.ep(0), AM_ID,
-                                         mapped_buffer::pack,
-                                         (void*)&buffer, 0);
-            if (packed_len != UCS_ERR_NO_RESOURCE) {
+            status = uct_ep_am_short(sender.ep(0), AM_ID, hdr, NULL, 0);
+            if (status != UCS_ERR_NO_RESOURCE) {
                 break;
             }
             sender.progress();
             m_receiver->progress();
         }
-        if (packed_len < 0) {
-            ASSERT_UCS_OK((ucs_status_t)packed_len);
-        }
+        ASSERT_UCS_OK(status);
+        ++sn[sender_num];
     }
 
     while (m_am_count < num_sends) {
         progress();
     }
 
+    EXPECT_EQ(sn, m_expected_sn);
+
     status = uct_iface_set_am_handler(m_receiver->iface(), AM_ID,
                                       NULL, NULL, 0);
     ASSERT_UCS_OK(status);
 
-    check_backlog();
-
     for (unsigned i = 0; i < NUM_SENDERS; ++i) {
         ent(i + 1).flush();
     }
-
-    buffers.clear();
 }
 
-UCT_INSTANTIATE_NO_SELF_TEST_CASE(test_many2one_am)
+_UCT_INSTANTIATE_TEST_CASE(test_many2one_am_fifo_shards, posix)
+_UCT_INSTANTIATE_TEST_CASE(test_many2one_am_fifo_shards, sysv)
+_UCT_INSTANTIATE_TEST_CASE(test_many2one_am_fifo_shards, xpmem)
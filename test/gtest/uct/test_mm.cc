@@ -7,6 +7,7 @@
 extern "C" {
 #include <uct/api/uct.h>
 #include <uct/sm/mm/base/mm_md.h>
+#include <uct/sm/mm/base/mm_iface.h>
 #include <ucs/time/time.h>
 }
 #include "uct_p2p_test.h"
@@ -19,17 +20,21 @@ public:
 
     struct mm_resource : public resource {
         std::string  shm_dir;
+        bool         use_memfd;
 
-        mm_resource(const resource& res, const std::string& shm_dir = "") :
+        mm_resource(const resource& res, const std::string& shm_dir = "",
+                    bool use_memfd = false) :
             resource(res.component, res.component_name, res.md_name,
                      res.local_cpus, res.tl_name, res.dev_name, res.dev_type),
-            shm_dir(shm_dir)
+            shm_dir(shm_dir), use_memfd(use_memfd)
         {
         }
 
         virtual std::string name() const {
             std::string name = resource::name();
-            if (!shm_dir.empty()) {
+            if (use_memfd) {
+                name += ",memfd";
+            } else if (!shm_dir.empty()) {
                 name += ",dir=" + shm_dir;
             }
             return name;
@@ -74,10 +79,17 @@ public:
                                     std::vector<mm_resource> &variants) {
         variants.push_back(mm_resource(res, "."       ));
         variants.push_back(mm_resource(res, "/dev/shm"));
+#ifdef HAVE_MEMFD_CREATE
+        variants.push_back(mm_resource(res, "", true));
+#endif
     }
 
     void set_posix_config() {
-        set_config("DIR=" + GetParam()->shm_dir);
+        if (GetParam()->use_memfd) {
+            set_config("USE_MEMFD=y");
+        } else {
+            set_config("DIR=" + GetParam()->shm_dir);
+        }
     }
 
     virtual void init() {
@@ -110,6 +122,31 @@ public:
         return UCS_OK;
     }
 
+    static ucs_status_t mm_am_zcopy_handler(void *arg, void *data,
+                                            size_t length, unsigned flags) {
+        std::string *recv_data = (std::string*)arg;
+
+        recv_data->assign((char*)data, length);
+        return UCS_OK;
+    }
+
+    static ucs_status_t mm_am_batch_handler(void *arg, void *data,
+                                            size_t length, unsigned flags) {
+        std::vector<uint64_t> *recv_hdrs = (std::vector<uint64_t>*)arg;
+
+        recv_hdrs->push_back(*(uint64_t*)data);
+        return UCS_OK;
+    }
+
+    void wait_for_recv(const std::vector<uint64_t> &recv_hdrs, size_t count) {
+        ucs_time_t deadline = ucs_get_time() +
+                              ucs_time_from_sec(DEFAULT_TIMEOUT_SEC);
+
+        while ((recv_hdrs.size() < count) && (ucs_get_time() < deadline)) {
+            progress();
+        }
+    }
+
     bool check_md_caps(uint64_t flags) {
         FOR_EACH_ENTITY(iter) {
             if (!(ucs_test_all_flags((*iter)->md_attr().cap.flags, flags))) {
@@ -218,6 +255,238 @@ UCS_TEST_SKIP_COND_P(test_uct_mm, open_for_posix,
     free(recv_buffer);
 }
 
+UCS_TEST_SKIP_COND_P(test_uct_mm, am_zcopy,
+                     !check_caps(UCT_IFACE_FLAG_AM_ZCOPY |
+                                 UCT_IFACE_FLAG_CB_SYNC))
+{
+    const size_t length = ucs_min(m_e1->iface_attr().cap.am.max_zcopy,
+                                  64 * UCS_KBYTE) - sizeof(uint64_t);
+    uint64_t hdr        = 0xbeef;
+    uct_completion_t comp;
+    std::string send_data, recv_data;
+    uct_iov_t iov[2];
+    ucs_status_t status;
+
+    /* the payload does not fit to a receive descriptor */
+    EXPECT_GT(length, m_e1->iface_attr().cap.am.max_bcopy);
+
+    send_data.resize(length);
+    ucs::fill_random(send_data);
+
+    uct_iface_set_am_handler(m_e2->iface(), 0, mm_am_zcopy_handler, &recv_data,
+                             0);
+
+    for (unsigned i = 0; i < 2; ++i) {
+        iov[i].buffer = &send_data[i * (length / 2)];
+        iov[i].length = (i == 0) ? (length / 2) : (length - (length / 2));
+        iov[i].memh   = UCT_MEM_HANDLE_NULL;
+        iov[i].stride = 0;
+        iov[i].count  = 1;
+    }
+
+    comp.func   = NULL;
+    comp.count  = 2;
+    comp.status = UCS_OK;
+
+    status = uct_ep_am_zcopy(m_e1->ep(0), 0, &hdr, sizeof(hdr), iov, 2, 0,
+                             &comp);
+    ASSERT_EQ(UCS_INPROGRESS, status);
+
+    /* the receiver did not read the payload yet */
+    for (unsigned i = 0; i < 10; ++i) {
+        m_e1->progress();
+    }
+    EXPECT_EQ(2, comp.count);
+
+    wait_for_value(&comp.count, 1, true);
+    EXPECT_EQ(1, comp.count);
+
+    ASSERT_EQ(sizeof(hdr) + length, recv_data.size());
+    EXPECT_EQ(hdr, *(uint64_t*)&recv_data[0]);
+    EXPECT_TRUE(recv_data.compare(sizeof(hdr), length, send_data) == 0);
+}
+
+UCS_TEST_SKIP_COND_P(test_uct_mm, am_batch,
+                     !check_caps(UCT_IFACE_FLAG_AM_BATCH |
+                                 UCT_IFACE_FLAG_AM_SHORT |
+                                 UCT_IFACE_FLAG_CB_SYNC))
+{
+    const unsigned num_msgs = 16;
+    std::vector<uint64_t> recv_hdrs;
+    ucs_status_t status;
+
+    uct_iface_set_am_handler(m_e2->iface(), 0, mm_am_batch_handler,
+                             &recv_hdrs, 0);
+
+    /* reserve more elements than used, the rest is returned on commit */
+    uct_ep_am_batch_begin(m_e1->ep(0), num_msgs * 2);
+    for (uint64_t i = 0; i < num_msgs; ++i) {
+        status = uct_ep_am_short(m_e1->ep(0), 0, i, NULL, 0);
+        ASSERT_UCS_OK(status);
+    }
+
+    /* the messages are not published before commit */
+    for (unsigned i = 0; i < 10; ++i) {
+        m_e2->progress();
+    }
+    EXPECT_TRUE(recv_hdrs.empty());
+
+    uct_ep_am_batch_commit(m_e1->ep(0));
+    wait_for_recv(recv_hdrs, num_msgs);
+
+    ASSERT_EQ(num_msgs, recv_hdrs.size());
+    for (uint64_t i = 0; i < num_msgs; ++i) {
+        EXPECT_EQ(i, recv_hdrs[i]);
+    }
+
+    /* another sender takes FIFO elements after the reserved ones, so the
+     * unused elements of the batch are skipped by the receiver */
+    entity *e3 = uct_test::create_entity(0);
+    m_entities.push_back(e3);
+    e3->connect(0, *m_e2, 0);
+
+    recv_hdrs.clear();
+    uct_ep_am_batch_begin(m_e1->ep(0), 8);
+    status = uct_ep_am_short(m_e1->ep(0), 0, 1, NULL, 0);
+    ASSERT_UCS_OK(status);
+
+    status = uct_ep_am_short(e3->ep(0), 0, 3, NULL, 0);
+    ASSERT_UCS_OK(status);
+
+    status = uct_ep_am_short(m_e1->ep(0), 0, 2, NULL, 0);
+    ASSERT_UCS_OK(status);
+    uct_ep_am_batch_commit(m_e1->ep(0));
+
+    wait_for_recv(recv_hdrs, 3);
+    short_progress_loop();
+
+    ASSERT_EQ(3u, recv_hdrs.size());
+    EXPECT_EQ(1u, recv_hdrs[0]);
+    EXPECT_EQ(2u, recv_hdrs[1]);
+    EXPECT_EQ(3u, recv_hdrs[2]);
+
+    /* the FIFO is usable after the batch */
+    status = uct_ep_am_short(m_e1->ep(0), 0, 4, NULL, 0);
+    ASSERT_UCS_OK(status);
+    wait_for_recv(recv_hdrs, 4);
+
+    ASSERT_EQ(4u, recv_hdrs.size());
+    EXPECT_EQ(4u, recv_hdrs[3]);
+}
+
+UCS_TEST_SKIP_COND_P(test_uct_mm, fifo_adaptive,
+                     !check_caps(UCT_IFACE_FLAG_AM_SHORT |
+                                 UCT_IFACE_FLAG_CB_SYNC),
+                     "FIFO_ADAPTIVE=y")
+{
+    uct_mm_iface_t *iface = ucs_derived_of(m_e2->iface(), uct_mm_iface_t);
+    std::vector<uint64_t> recv_hdrs;
+    ucs_status_t status;
+
+    uct_iface_set_am_handler(m_e2->iface(), 0, mm_am_batch_handler,
+                             &recv_hdrs, 0);
+
+    /* idle receiver is tuned for latency */
+    for (unsigned i = 0; i < UCT_MM_IFACE_ADAPT_INTERVAL * 8; ++i) {
+        m_e2->progress();
+    }
+    EXPECT_EQ(UCT_MM_IFACE_FIFO_MIN_POLL, iface->adapt.max_poll);
+    EXPECT_EQ(0u, iface->fifo_release_factor_mask);
+
+    /* receiver which finds a full FIFO is tuned for throughput */
+    for (unsigned i = 0; i < UCT_MM_IFACE_ADAPT_INTERVAL * 8; ++i) {
+        do {
+            status = uct_ep_am_short(m_e1->ep(0), 0, i, NULL, 0);
+        } while (status == UCS_OK);
+        ASSERT_EQ(UCS_ERR_NO_RESOURCE, status);
+
+        m_e2->progress();
+        recv_hdrs.clear();
+    }
+    EXPECT_EQ(iface->config.fifo_size * iface->config.fifo_shards,
+              iface->adapt.max_poll);
+    EXPECT_EQ(iface->adapt.release_mask_max, iface->fifo_release_factor_mask);
+
+    /* drain the FIFO */
+    short_progress_loop();
+}
+
+UCS_TEST_SKIP_COND_P(test_uct_mm, sim_latency,
+                     !check_caps(UCT_IFACE_FLAG_AM_SHORT |
+                                 UCT_IFACE_FLAG_CB_SYNC),
+                     "SIM_LATENCY=50ms")
+{
+    const double latency = 50e-3;
+    const uct_iface_attr_t &attr = m_e1->iface_attr();
+    std::vector<uint64_t> recv_hdrs;
+    ucs_time_t start, recv_time;
+    ucs_status_t status;
+
+    EXPECT_NEAR(latency, attr.latency.c, latency / 100);
+    EXPECT_TRUE(ucs_test_all_flags(attr.cap.flags, UCT_IFACE_FLAG_PUT_ZCOPY |
+                                                   UCT_IFACE_FLAG_GET_ZCOPY));
+    EXPECT_EQ(m_e1->iface_attr().cap.am.max_short,
+              ucs_derived_of(m_e1->iface(), uct_mm_iface_t)->config.fifo_elem_size -
+              sizeof(uct_mm_fifo_element_t) - sizeof(ucs_time_t));
+
+    uct_iface_set_am_handler(m_e2->iface(), 0, mm_am_batch_handler,
+                             &recv_hdrs, 0);
+
+    start  = ucs_get_time();
+    status = uct_ep_am_short(m_e1->ep(0), 0, 1, NULL, 0);
+    ASSERT_UCS_OK(status);
+
+    /* the message is in the FIFO, but was not delivered yet */
+    while (ucs_time_to_sec(ucs_get_time() - start) < (latency / 2)) {
+        progress();
+    }
+    EXPECT_TRUE(recv_hdrs.empty());
+
+    wait_for_recv(recv_hdrs, 1);
+    recv_time = ucs_get_time();
+    ASSERT_EQ(1u, recv_hdrs.size());
+    EXPECT_GE(ucs_time_to_sec(recv_time - start), latency);
+}
+
+UCS_TEST_SKIP_COND_P(test_uct_mm, sim_bw,
+                     !check_caps(UCT_IFACE_FLAG_AM_SHORT |
+                                 UCT_IFACE_FLAG_CB_SYNC),
+                     "SIM_BW=1MBs")
+{
+    const double bw = UCS_MBYTE;
+    const unsigned count = 32;
+    const uct_iface_attr_t &attr = m_e1->iface_attr();
+    std::vector<char> payload(attr.cap.am.max_short - sizeof(uint64_t));
+    std::vector<uint64_t> recv_hdrs;
+    ucs_time_t start;
+    ucs_status_t status;
+    unsigned i;
+
+    EXPECT_NEAR(bw, attr.bandwidth.dedicated, bw / 100);
+
+    uct_iface_set_am_handler(m_e2->iface(), 0, mm_am_batch_handler,
+                             &recv_hdrs, 0);
+
+    /* the messages are delivered one after another by the link bandwidth */
+    start = ucs_get_time();
+    for (i = 0; i < count; ++i) {
+        do {
+            status = uct_ep_am_short(m_e1->ep(0), 0, i, &payload[0],
+                                     payload.size());
+            progress();
+        } while (status == UCS_ERR_NO_RESOURCE);
+        ASSERT_UCS_OK(status);
+    }
+
+    wait_for_recv(recv_hdrs, count);
+    ASSERT_EQ(count, recv_hdrs.size());
+    EXPECT_GE(ucs_time_to_sec(ucs_get_time() - start),
+              count * attr.cap.am.max_short / bw);
+    for (i = 0; i < count; ++i) {
+        EXPECT_EQ(i, recv_hdrs[i]);
+    }
+}
+
 UCS_TEST_SKIP_COND_P(test_uct_mm, alloc,
                      !check_md_caps(UCT_MD_FLAG_ALLOC)) {
 
@@ -160,3 +160,30 @@ UCS_TEST_SKIP_COND_P(test_p2p_rma_madvise, madvise,
 }
 
 UCT_INSTANTIATE_TEST_CASE(test_p2p_rma_madvise)
+
+class test_p2p_rma_scopy_mt : public uct_p2p_rma_test {
+public:
+    void init() {
+        /* small segments and no threshold, to make every multi-segment
+         * operation be split between the progress and the helper threads */
+        modify_config("SCOPY_SEG_SIZE", "8k");
+        modify_config("SCOPY_MT_THREADS", "3");
+        modify_config("SCOPY_MT_THRESH", "0");
+        uct_p2p_rma_test::init();
+    }
+};
+
+UCS_TEST_SKIP_COND_P(test_p2p_rma_scopy_mt, put_zcopy,
+                     !check_caps(UCT_IFACE_FLAG_PUT_ZCOPY)) {
+    test_xfer_multi(static_cast<send_func_t>(&uct_p2p_rma_test::put_zcopy),
+                    0ul, 4 * UCS_MBYTE, TEST_UCT_FLAG_SEND_ZCOPY);
+}
+
+UCS_TEST_SKIP_COND_P(test_p2p_rma_scopy_mt, get_zcopy,
+                     !check_caps(UCT_IFACE_FLAG_GET_ZCOPY)) {
+    test_xfer_multi(static_cast<send_func_t>(&uct_p2p_rma_test::get_zcopy),
+                    1ul, 4 * UCS_MBYTE, TEST_UCT_FLAG_RECV_ZCOPY);
+}
+
+_UCT_INSTANTIATE_TEST_CASE(test_p2p_rma_scopy_mt, cma)
+_UCT_INSTANTIATE_TEST_CASE(test_p2p_rma_scopy_mt, knem)
@@ -677,9 +677,10 @@ uct_test::entity* uct_test::create_entity(size_t rx_headroom,
     return new entity(*GetParam(), m_iface_config, &iface_params, m_md_config);
 }
 
-uct_test::entity* uct_test::create_entity(uct_iface_params_t &params) {
+uct_test::entity* uct_test::create_entity(uct_iface_params_t &params,
+                                          ucs_thread_mode_t thread_mode) {
     entity *new_ent = new entity(*GetParam(), m_iface_config, &params,
-                                 m_md_config);
+                                 m_md_config, thread_mode);
     return new_ent;
 }
 
@@ -769,7 +770,8 @@ void uct_test::reduce_tl_send_queues()
 }
 
 uct_test::entity::entity(const resource& resource, uct_iface_config_t *iface_config,
-                         uct_iface_params_t *params, uct_md_config_t *md_config) :
+                         uct_iface_params_t *params, uct_md_config_t *md_config,
+                         ucs_thread_mode_t thread_mode) :
     m_resource(resource)
 {
     ucs_status_t status;
@@ -786,8 +788,7 @@ uct_test::entity::entity(const resource& resource, uct_iface_config_t *iface_con
     UCS_CPU_ZERO(&params->cpu_mask);
 
     UCS_TEST_CREATE_HANDLE(uct_worker_h, m_worker, uct_worker_destroy,
-                           uct_worker_create, &m_async.m_async,
-                           UCS_THREAD_MODE_SINGLE);
+                           uct_worker_create, &m_async.m_async, thread_mode);
 
     UCS_TEST_CREATE_HANDLE(uct_md_h, m_md, uct_md_close, uct_md_open,
                            resource.component, resource.md_name.c_str(),
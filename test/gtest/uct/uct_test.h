@@ -131,7 +131,8 @@ protected:
         typedef std::vector< ucs::handle<uct_ep_h> > eps_vec_t;
 
         entity(const resource& resource, uct_iface_config_t *iface_config,
-               uct_iface_params_t *params, uct_md_config_t *md_config);
+               uct_iface_params_t *params, uct_md_config_t *md_config,
+               ucs_thread_mode_t thread_mode = UCS_THREAD_MODE_SINGLE);
 
         entity(const resource& resource, uct_md_config_t *md_config,
                uct_cm_config_t *cm_config);
@@ -405,7 +406,9 @@ protected:
                                     void *rndv_arg = NULL,
                                     uct_async_event_cb_t async_event_cb = NULL,
                                     void *async_event_arg = NULL);
-    uct_test::entity* create_entity(uct_iface_params_t &params);
+    uct_test::entity* create_entity(uct_iface_params_t &params,
+                                    ucs_thread_mode_t thread_mode =
+                                    UCS_THREAD_MODE_SINGLE);
     uct_test::entity* create_entity();
     int max_connections();
     int max_connect_batch();